@@ -46,6 +46,18 @@ function(set_compile_flags target)
         set(SAN_CLG_RWD   "$<AND:${IS_CLANG},$<BOOL:0>>")
     endif()
 
+    # Target ISA — FawnAlgebra_Portable trades the host tuning for the x86-64-v2 baseline,
+    # kernels dispatched through FawnAlgebra:CPU still reach AVX2/AVX-512 at runtime
+    if (FawnAlgebra_Portable AND CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64")
+        set(GNU_ARCH  -march=x86-64-v2)
+        set(GNU_TUNE  -mtune=generic)
+        set(MSVC_ARCH "")
+    else()
+        set(GNU_ARCH  -march=native)
+        set(GNU_TUNE  -mtune=native)
+        set(MSVC_ARCH /arch:AVX2)
+    endif()
+
     # =========================================================================
     # COMPILE OPTIONS
     # =========================================================================
@@ -70,7 +82,7 @@ function(set_compile_flags target)
             /Qpar
             /fp:fast
             /GS-
-            /arch:AVX2
+            ${MSVC_ARCH}
             /favor:blend
             /EHs-c-
             /GR-
@@ -88,6 +100,7 @@ function(set_compile_flags target)
         # ── GCC / Clang shared ────────────────────────────────────────────────
         $<$<OR:${IS_GCC},${IS_CLANG}>:
             -Wall -Wextra -Wpedantic -Wconversion -Werror
+            -Wno-psabi
             -fno-omit-frame-pointer
             -fvisibility=hidden
             -fvisibility-inlines-hidden
@@ -114,7 +127,7 @@ function(set_compile_flags target)
         # ── GCC/Clang RelWithDebInfo ──────────────────────────────────────────
         $<$<OR:${GNU_RWD},${CLG_RWD}>:
             -O2 -g
-            -march=native
+            ${GNU_ARCH}
             -fno-omit-frame-pointer
             -fno-strict-aliasing
         >
@@ -124,7 +137,7 @@ function(set_compile_flags target)
         # ── GCC/Clang Release ─────────────────────────────────────────────────
         $<$<OR:${GNU_REL},${CLG_REL}>:
             -O3
-            -march=native -mtune=native
+            ${GNU_ARCH} ${GNU_TUNE}
             -funroll-loops
             -ffast-math
             -fomit-frame-pointer
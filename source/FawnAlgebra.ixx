@@ -7,9 +7,18 @@ export module FawnAlgebra;
 export import :Arithmetics;
 export import :Bezier;
 export import :Constants;
+export import :CPU;
+export import :Distributions;
 export import :Hashing;
+export import :HashMap;
 export import :Interpolation;
+export import :LowDiscrepancy;
+export import :Noise;
+export import :NoiseBaker;
+export import :PerfectHash;
 export import :Random;
 export import :Statistics;
 export import :SIMD;
+export import :SIMDMath;
+export import :Sketches;
 export import :Trigonometric;
@@ -19,6 +19,8 @@ module;
 #endif
 
 export module FawnAlgebra:Arithmetics;
+import :CPU;
+import :SIMD;
 import std;
 
 namespace fawn_algebra
@@ -3740,15 +3742,15 @@ struct alignas(16) QuatSimd
 
         // Prepare shuffled versions of q2 for cross products
         // q2 = [a2, e23_2, e31_2, e12_2]
-        const __m128 q2_wzyx = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(0, 1, 2, 3));
-        const __m128 q2_zwxy = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(1, 0, 3, 2));
-        const __m128 q2_yxwz = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 q2_wzyx = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(0, 1, 2, 3)); // [e12_2, e31_2, e23_2, a2]
+        const __m128 q2_zwxy = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(1, 0, 3, 2)); // [e31_2, e12_2, a2, e23_2]
+        const __m128 q2_yxwz = _mm_shuffle_ps(q2.data, q2.data, _MM_SHUFFLE(2, 3, 0, 1)); // [e23_2, a2, e12_2, e31_2]
 
         // Compute each term
         __m128 t0 = _mm_mul_ps(a1, q2.data);    // a1 * q2
-        __m128 t1 = _mm_mul_ps(e23_1, q2_wzyx); // e23_1 * [a2, e12_2, e31_2, e23_2]
-        __m128 t2 = _mm_mul_ps(e31_1, q2_zwxy); // e31_1 * [e12_2, a2, e23_2, e31_2]
-        __m128 t3 = _mm_mul_ps(e12_1, q2_yxwz); // e12_1 * [e31_2, e23_2, a2, e12_2]
+        __m128 t1 = _mm_mul_ps(e23_1, q2_yxwz); // e23_1 * [e23_2, a2, e12_2, e31_2]
+        __m128 t2 = _mm_mul_ps(e31_1, q2_zwxy); // e31_1 * [e31_2, e12_2, a2, e23_2]
+        __m128 t3 = _mm_mul_ps(e12_1, q2_wzyx); // e12_1 * [e12_2, e31_2, e23_2, a2]
 
         // Apply signs for geometric product
         // Result: [a, e23, e31, e12]
@@ -4058,6 +4060,538 @@ struct alignas(16) QuatSimd
     }
 };
 export using quadf_simd = QuatSimd<float>;
+
+// Dual Quaternion (rigid motion: rotation followed by translation)
+// real: rotation rotor, dual: 0.5 * translation * real
+// Layout: [real.a, real.e23, real.e31, real.e12, dual.a, dual.e23, dual.e31, dual.e12]
+template <typename T>
+struct DualQuat
+{
+    Quat<T> real{T(1), T(0), T(0), T(0)};
+    Quat<T> dual{T(0), T(0), T(0), T(0)};
+
+    /// Returns the identity dual quaternion (no rotation, no translation)
+    /// @return Dual quaternion representing identity
+    static constexpr DualQuat Identity()
+    {
+        return {Quat<T>::Identity(), Quat<T>{T(0), T(0), T(0), T(0)}};
+    }
+
+    /// Creates a dual quaternion that first rotates and then translates
+    /// @param rotation Unit rotation quaternion
+    /// @param translation Translation applied after the rotation
+    /// @return Dual quaternion representing the rigid motion
+    static constexpr DualQuat FromRotationTranslation(const Quat<T>& rotation, const Vec<T, 3>& translation)
+    {
+        const Quat<T> t{T(0), translation.x * T(0.5), translation.y * T(0.5), translation.z * T(0.5)};
+        return {rotation, t * rotation};
+    }
+
+    /// Creates a dual quaternion representing a pure rotation
+    /// @param rotation Unit rotation quaternion
+    /// @return Dual quaternion representing the rotation
+    static constexpr DualQuat FromRotation(const Quat<T>& rotation)
+    {
+        return {rotation, Quat<T>{T(0), T(0), T(0), T(0)}};
+    }
+
+    /// Creates a dual quaternion representing a pure translation
+    /// @param translation Translation vector
+    /// @return Dual quaternion representing the translation
+    static constexpr DualQuat FromTranslation(const Vec<T, 3>& translation)
+    {
+        return FromRotationTranslation(Quat<T>::Identity(), translation);
+    }
+
+    /// Creates a dual quaternion from a rigid 4x4 transform
+    /// @param m Column-major matrix without scale or shear, translation in column 3
+    /// @return Dual quaternion representing the same rigid motion
+    static constexpr DualQuat FromMat4(const Mat<Vec<T, 4>, 4>& m)
+    {
+        const Mat<Vec<T, 3>, 3> rotation{m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]};
+        return FromRotationTranslation(Quat<T>::ToQuaternion(rotation), Vec<T, 3>{m[3][0], m[3][1], m[3][2]});
+    }
+
+    /// Blends dual quaternions with dual quaternion linear blending (DLB)
+    /// @param dqs Unit dual quaternions to blend
+    /// @param weights Blend weight for each dual quaternion
+    /// @return Normalized blended dual quaternion
+    /// @note Each input is flipped onto the hemisphere of the first one so the blend takes the shortest path
+    static constexpr DualQuat LinearBlend(std::span<const DualQuat> dqs, std::span<const T> weights)
+    {
+        if (dqs.empty())
+        {
+            return Identity();
+        }
+
+        DualQuat result{Quat<T>{T(0), T(0), T(0), T(0)}, Quat<T>{T(0), T(0), T(0), T(0)}};
+        for (std::size_t i = 0; i < dqs.size() && i < weights.size(); ++i)
+        {
+            const T weight = Quat<T>::Dot(dqs[0].real, dqs[i].real) < T(0) ? -weights[i] : weights[i];
+            result         = result + dqs[i] * weight;
+        }
+        return result.Normalize();
+    }
+
+    /// Returns the rotation part
+    /// @return Unit rotation quaternion
+    constexpr Quat<T> Rotation() const
+    {
+        return real;
+    }
+
+    /// Returns the translation part
+    /// @return Translation vector (2 * dual * conjugate(real))
+    constexpr Vec<T, 3> Translation() const
+    {
+        const Quat<T> t = dual * real.Conjugate();
+        return {T(2) * t.e23, T(2) * t.e31, T(2) * t.e12};
+    }
+
+    /// Returns the quaternion conjugate of both parts
+    /// @return Conjugated dual quaternion
+    constexpr DualQuat Conjugate() const
+    {
+        return {real.Conjugate(), dual.Conjugate()};
+    }
+
+    /// Returns the inverse rigid motion
+    /// @return Inverse dual quaternion
+    /// @note Only valid for unit dual quaternions, where it equals the conjugate
+    constexpr DualQuat Inverse() const
+    {
+        return Conjugate();
+    }
+
+    /// Returns a unit dual quaternion
+    /// @return Dual quaternion with a unit real part and a dual part orthogonal to it, or the identity when the real part is
+    /// (nearly) zero
+    constexpr DualQuat Normalize() const
+    {
+        const T lenSqr = real.LengthSqr();
+        if (lenSqr <= std::numeric_limits<T>::min())
+        {
+            return Identity();
+        }
+
+        const T inv     = T(1) / std::sqrt(lenSqr);
+        const Quat<T> r = Scale(real, inv);
+        const Quat<T> d = Scale(dual, inv);
+        const T rd      = Quat<T>::Dot(r, d);
+        return {r, Quat<T>{d.a - r.a * rd, d.e23 - r.e23 * rd, d.e31 - r.e31 * rd, d.e12 - r.e12 * rd}};
+    }
+
+    /// Transforms a point (rotation followed by translation)
+    /// @param p Point to transform
+    /// @return Transformed point
+    constexpr Vec<T, 3> TransformPoint(const Vec<T, 3>& p) const
+    {
+        const Vec<T, 3> rv{real.e23, real.e31, real.e12};
+        const Vec<T, 3> dv{dual.e23, dual.e31, dual.e12};
+        const Vec<T, 3> t = T(2) * (real.a * dv - dual.a * rv + Vec<T, 3>::Cross(rv, dv));
+        return real * p + t;
+    }
+
+    /// Transforms a direction (rotation only)
+    /// @param v Direction to transform
+    /// @return Rotated direction
+    constexpr Vec<T, 3> TransformVector(const Vec<T, 3>& v) const
+    {
+        return real * v;
+    }
+
+    /// Converts the dual quaternion to a 4x4 homogeneous transform
+    /// @return Column-major rigid transform with translation in column 3
+    constexpr Mat<Vec<T, 4>, 4> ToMat4() const
+    {
+        Mat<Vec<T, 4>, 4> m = real.ToMat4();
+        const Vec<T, 3> t   = Translation();
+        m[3]                = Vec<T, 4>{t.x, t.y, t.z, T(1)};
+        return m;
+    }
+
+    /// Composes two rigid motions
+    /// @param b Right-hand dual quaternion
+    /// @return Motion that applies b first, then this
+    constexpr DualQuat operator*(const DualQuat& b) const
+    {
+        const Quat<T> d0 = real * b.dual;
+        const Quat<T> d1 = dual * b.real;
+        return {real * b.real, Quat<T>{d0.a + d1.a, d0.e23 + d1.e23, d0.e31 + d1.e31, d0.e12 + d1.e12}};
+    }
+
+    /// Compound composition
+    /// @param b Right-hand dual quaternion
+    /// @return Reference to this dual quaternion after composition
+    constexpr DualQuat& operator*=(const DualQuat& b)
+    {
+        *this = *this * b;
+        return *this;
+    }
+
+    /// Component-wise sum, used when blending
+    constexpr DualQuat operator+(const DualQuat& b) const
+    {
+        return {Quat<T>{real.a + b.real.a, real.e23 + b.real.e23, real.e31 + b.real.e31, real.e12 + b.real.e12},
+                Quat<T>{dual.a + b.dual.a, dual.e23 + b.dual.e23, dual.e31 + b.dual.e31, dual.e12 + b.dual.e12}};
+    }
+
+    /// Component-wise scale, used when blending
+    constexpr DualQuat operator*(const T s) const
+    {
+        return {Scale(real, s), Scale(dual, s)};
+    }
+
+  private:
+    static constexpr Quat<T> Scale(const Quat<T>& q, const T s)
+    {
+        return {q.a * s, q.e23 * s, q.e31 * s, q.e12 * s};
+    }
+};
+
+export using dualquatf = DualQuat<float>;
+export using dualquatd = DualQuat<double>;
+
+#if BALBINO_SIMD_SSE
+// SIMD Dual Quaternion built from two QuatSimd rotors
+// real: [a, e23, e31, e12], dual: [a, e23, e31, e12]
+template <typename>
+struct alignas(16) DualQuatSimd
+{
+    QuatSimd<float> real;                        // defaults to identity
+    QuatSimd<float> dual{_mm_setzero_ps()};
+
+    // ========================================================================
+    // Static Factory Methods
+    // ========================================================================
+
+    static DualQuatSimd Identity()
+    {
+        return DualQuatSimd{QuatSimd<float>::Identity(), QuatSimd<float>(_mm_setzero_ps())};
+    }
+
+    static DualQuatSimd FromRotationTranslation(const QuatSimd<float>& rotation, const __m128 translation)
+    {
+        // translation is [x, y, z, _]; shift up one lane and zero the scalar: [0, x/2, y/2, z/2]
+        const __m128 half  = _mm_mul_ps(translation, _mm_set1_ps(0.5F));
+        const __m128 moved = _mm_shuffle_ps(half, half, _MM_SHUFFLE(2, 1, 0, 0));
+        const QuatSimd<float> t(_mm_move_ss(moved, _mm_setzero_ps()));
+        return DualQuatSimd{rotation, QuatSimd<float>::Multiply(t, rotation)};
+    }
+
+    static DualQuatSimd FromMatrix(const float* matrix)
+    {
+        // `matrix` is a column-major 4x4 rigid transform, matching ToMatrix4x4 below.
+        const float rotation[9]{matrix[0], matrix[1], matrix[2], matrix[4], matrix[5], matrix[6], matrix[8], matrix[9], matrix[10]};
+        return FromRotationTranslation(QuatSimd<float>::FromMatrix(rotation), _mm_setr_ps(matrix[12], matrix[13], matrix[14], 0.0F));
+    }
+
+    static DualQuatSimd FromMat4(const Mat<Vec<float, 4>, 4>& m)
+    {
+        const float matrix[16]{m[0].x, m[0].y, m[0].z, m[0].w, m[1].x, m[1].y, m[1].z, m[1].w, m[2].x, m[2].y, m[2].z, m[2].w, m[3].x, m[3].y, m[3].z, m[3].w};
+        return FromMatrix(matrix);
+    }
+
+    // ========================================================================
+    // Static Utility Methods
+    // ========================================================================
+
+    // (r1, d1) * (r2, d2) = (r1 r2, r1 d2 + d1 r2): applies b first, then a
+    static DualQuatSimd Multiply(const DualQuatSimd& a, const DualQuatSimd& b)
+    {
+        const __m128 d0 = QuatSimd<float>::Multiply(a.real, b.dual).data;
+        const __m128 d1 = QuatSimd<float>::Multiply(a.dual, b.real).data;
+        return DualQuatSimd{QuatSimd<float>::Multiply(a.real, b.real), QuatSimd<float>(_mm_add_ps(d0, d1))};
+    }
+
+    static DualQuatSimd Conjugate(const DualQuatSimd& q)
+    {
+        return DualQuatSimd{QuatSimd<float>::Reverse(q.real), QuatSimd<float>::Reverse(q.dual)};
+    }
+
+    static DualQuatSimd Normalize(const DualQuatSimd& q)
+    {
+        // a zero or denormal real part has no rotation to normalize, as in DualQuat::Normalize
+        const float lenSq = QuatSimd<float>::Dot(q.real, q.real);
+        if (lenSq <= std::numeric_limits<float>::min())
+        {
+            return Identity();
+        }
+
+        const __m128 inv = _mm_set1_ps(1.0F / Sqrt(lenSq));
+        const __m128 r   = _mm_mul_ps(q.real.data, inv);
+        const __m128 d   = _mm_mul_ps(q.dual.data, inv);
+
+        // remove the part of the dual that is parallel to the real, so r . d == 0
+        const float rd = QuatSimd<float>::Dot(QuatSimd<float>(r), QuatSimd<float>(d));
+        return DualQuatSimd{QuatSimd<float>(r), QuatSimd<float>(_mm_sub_ps(d, _mm_mul_ps(r, _mm_set1_ps(rd))))};
+    }
+
+    // t = 2 * dual * conjugate(real), returned as [x, y, z, 0]
+    static __m128 Translation(const DualQuatSimd& q)
+    {
+        const __m128 t = QuatSimd<float>::Multiply(q.dual, QuatSimd<float>::Reverse(q.real)).data; // [_, x, y, z]
+        const __m128 v = _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 3, 2, 1));                           // [x, y, z, _]
+        return _mm_mul_ps(v, _mm_setr_ps(2.0F, 2.0F, 2.0F, 0.0F));
+    }
+
+    static __m128 TransformPoint(const DualQuatSimd& q, const __m128 p)
+    {
+        return _mm_add_ps(QuatSimd<float>::RotateVector(q.real, p), Translation(q));
+    }
+
+    static __m128 TransformVector(const DualQuatSimd& q, const __m128 v)
+    {
+        return QuatSimd<float>::RotateVector(q.real, v);
+    }
+
+    DualQuatSimd Conjugate() const
+    {
+        return Conjugate(*this);
+    }
+
+    DualQuatSimd Inverse() const
+    {
+        // unit dual quaternions only
+        return Conjugate(*this);
+    }
+
+    DualQuatSimd Normalize() const
+    {
+        return Normalize(*this);
+    }
+
+    __m128 Translation() const
+    {
+        return Translation(*this);
+    }
+
+    // ========================================================================
+    // Conversion Methods
+    // ========================================================================
+
+    void ToMatrix4x4(float* matrix) const
+    {
+        // Column-major 4x4, translation in matrix[12..14]
+        real.ToMatrix4x4(matrix);
+        alignas(16) float t[4];
+        _mm_store_ps(t, Translation());
+        matrix[12] = t[0];
+        matrix[13] = t[1];
+        matrix[14] = t[2];
+    }
+
+    Mat<Vec<float, 4>, 4> ToMat4() const
+    {
+        alignas(16) float m[16];
+        ToMatrix4x4(m);
+        return Mat<Vec<float, 4>, 4>{Vec<float, 4>{m[0], m[1], m[2], m[3]}, Vec<float, 4>{m[4], m[5], m[6], m[7]}, Vec<float, 4>{m[8], m[9], m[10], m[11]},
+                                     Vec<float, 4>{m[12], m[13], m[14], m[15]}};
+    }
+
+    // ========================================================================
+    // Operators
+    // ========================================================================
+
+    DualQuatSimd operator*(const DualQuatSimd& other) const
+    {
+        return Multiply(*this, other);
+    }
+
+    DualQuatSimd& operator*=(const DualQuatSimd& other)
+    {
+        *this = Multiply(*this, other);
+        return *this;
+    }
+
+    __m128 operator*(const __m128 p) const
+    {
+        return TransformPoint(*this, p);
+    }
+};
+export using dualquatf_simd = DualQuatSimd<float>;
+#endif // BALBINO_SIMD_SSE
+
+// ============================================================================
+// Dual Quaternion Skinning
+// ============================================================================
+
+// Structure-of-arrays vertex input for skinning with four bone influences per vertex.
+// Every stream holds one entry per vertex.
+export struct SkinningStreams
+{
+    std::span<const float> x;
+    std::span<const float> y;
+    std::span<const float> z;
+    std::array<std::span<const std::uint32_t>, 4> bone;
+    std::array<std::span<const float>, 4> weight;
+};
+
+namespace Detail
+{
+// Dual quaternion linear blending of the four influences of a single vertex
+inline DualQuat<float> BlendInfluences(std::span<const DualQuat<float>> bones, const SkinningStreams& in, const std::size_t vertex) noexcept
+{
+    const DualQuat<float> dqs[4]{bones[in.bone[0][vertex]], bones[in.bone[1][vertex]], bones[in.bone[2][vertex]], bones[in.bone[3][vertex]]};
+    const float weights[4]{in.weight[0][vertex], in.weight[1][vertex], in.weight[2][vertex], in.weight[3][vertex]};
+    return DualQuat<float>::LinearBlend(dqs, weights);
+}
+
+// Eight vertices per iteration in simd::f32x8 lanes, the remainder takes the scalar path.
+// Force-inlined so every dispatch wrapper below compiles it for its own target.
+BALBINO_FORCE_INLINE void SkinDualQuatLinearBlendKernel(std::span<const DualQuat<float>> bones, const SkinningStreams& in, std::span<float> outX,
+                                                        std::span<float> outY, std::span<float> outZ) noexcept
+{
+    using simd::f32x8;
+    constexpr std::size_t lanes = f32x8::lanes;
+    const std::size_t count     = in.x.size();
+
+    std::size_t v = 0;
+    for (; v + lanes <= count; v += lanes)
+    {
+        // blended real (ra, rx, ry, rz) and dual (da, dx, dy, dz) parts, one vertex per lane
+        f32x8 blend[8]{};
+        f32x8 pivot[4]{};
+        for (int k = 0; k < 4; ++k)
+        {
+            // gather the eight bone dual quaternions into component-major lanes
+            alignas(32) float c[8][lanes];
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+            {
+                const DualQuat<float>& dq = bones[in.bone[k][v + lane]];
+                c[0][lane]                = dq.real.a;
+                c[1][lane]                = dq.real.e23;
+                c[2][lane]                = dq.real.e31;
+                c[3][lane]                = dq.real.e12;
+                c[4][lane]                = dq.dual.a;
+                c[5][lane]                = dq.dual.e23;
+                c[6][lane]                = dq.dual.e31;
+                c[7][lane]                = dq.dual.e12;
+            }
+
+            f32x8 comp[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                comp[i] = f32x8::load(c[i]);
+            }
+
+            f32x8 w = f32x8::load(in.weight[k].data() + v);
+            if (k == 0)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    pivot[i] = comp[i];
+                }
+            }
+            else
+            {
+                // antipodality: keep every influence on the hemisphere of the first one
+                const f32x8 d = pivot[0] * comp[0] + pivot[1] * comp[1] + pivot[2] * comp[2] + pivot[3] * comp[3];
+                w             = simd::select(d < f32x8::splat(0.0F), -w, w);
+            }
+
+            for (int i = 0; i < 8; ++i)
+            {
+                blend[i] = simd::fma(comp[i], w, blend[i]);
+            }
+        }
+
+        // normalize by the length of the real part; lanes whose weights are all zero or whose real
+        // parts cancel get the identity, as DualQuat::Normalize gives the scalar tail
+        const f32x8 lenSq = blend[0] * blend[0] + blend[1] * blend[1] + blend[2] * blend[2] + blend[3] * blend[3];
+        const auto valid  = lenSq > f32x8::splat(std::numeric_limits<float>::min());
+        const f32x8 inv   = simd::select(valid, f32x8::splat(1.0F) / simd::sqrt(lenSq), f32x8::splat(0.0F));
+        for (f32x8& b : blend)
+        {
+            b *= inv;
+        }
+        blend[0] = simd::select(valid, blend[0], f32x8::splat(1.0F));
+
+        const f32x8& ra = blend[0];
+        const f32x8& rx = blend[1];
+        const f32x8& ry = blend[2];
+        const f32x8& rz = blend[3];
+        const f32x8& da = blend[4];
+        const f32x8& dx = blend[5];
+        const f32x8& dy = blend[6];
+        const f32x8& dz = blend[7];
+
+        const f32x8 px = f32x8::load(in.x.data() + v);
+        const f32x8 py = f32x8::load(in.y.data() + v);
+        const f32x8 pz = f32x8::load(in.z.data() + v);
+
+        // rotation: p + 2 * rv x (rv x p + ra * p)
+        const f32x8 cx = ry * pz - rz * py + ra * px;
+        const f32x8 cy = rz * px - rx * pz + ra * py;
+        const f32x8 cz = rx * py - ry * px + ra * pz;
+        const f32x8 two = f32x8::splat(2.0F);
+
+        // translation: 2 * (ra * dv - da * rv + rv x dv)
+        const f32x8 tx = two * (ra * dx - da * rx + ry * dz - rz * dy);
+        const f32x8 ty = two * (ra * dy - da * ry + rz * dx - rx * dz);
+        const f32x8 tz = two * (ra * dz - da * rz + rx * dy - ry * dx);
+
+        (px + two * (ry * cz - rz * cy) + tx).store(outX.data() + v);
+        (py + two * (rz * cx - rx * cz) + ty).store(outY.data() + v);
+        (pz + two * (rx * cy - ry * cx) + tz).store(outZ.data() + v);
+    }
+
+    for (; v < count; ++v)
+    {
+        const Vec<float, 3> p = BlendInfluences(bones, in, v).TransformPoint(Vec<float, 3>{in.x[v], in.y[v], in.z[v]});
+        outX[v]               = p.x;
+        outY[v]               = p.y;
+        outZ[v]               = p.z;
+    }
+}
+
+using SkinDualQuatLinearBlendFn = void (*)(std::span<const DualQuat<float>>, const SkinningStreams&, std::span<float>, std::span<float>, std::span<float>) noexcept;
+
+inline void SkinDualQuatLinearBlendBaseline(std::span<const DualQuat<float>> bones, const SkinningStreams& in, std::span<float> outX, std::span<float> outY,
+                                            std::span<float> outZ) noexcept
+{
+    SkinDualQuatLinearBlendKernel(bones, in, outX, outY, outZ);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+BALBINO_TARGET_AVX2 inline void SkinDualQuatLinearBlendAvx2(std::span<const DualQuat<float>> bones, const SkinningStreams& in, std::span<float> outX,
+                                                            std::span<float> outY, std::span<float> outZ) noexcept
+{
+    SkinDualQuatLinearBlendKernel(bones, in, outX, outY, outZ);
+}
+#endif
+} // namespace Detail
+
+/// Skins a vertex stream with dual quaternion linear blending (DLB)
+/// @param bones Unit dual quaternion per bone (bind pose to current pose)
+/// @param in Bind-pose positions with four bone indices and weights per vertex
+/// @param outX Skinned x coordinates, one per vertex
+/// @param outY Skinned y coordinates, one per vertex
+/// @param outZ Skinned z coordinates, one per vertex
+/// @note The 8-wide kernel is built for the baseline and for AVX2, the path is picked once through ActiveSimdLevel
+export inline void SkinDualQuatLinearBlend(std::span<const DualQuat<float>> bones, const SkinningStreams& in, std::span<float> outX, std::span<float> outY,
+                                           std::span<float> outZ) noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const Detail::SkinDualQuatLinearBlendFn kernel =
+        DispatchTable<Detail::SkinDualQuatLinearBlendFn>{Detail::SkinDualQuatLinearBlendBaseline, nullptr, Detail::SkinDualQuatLinearBlendAvx2, nullptr}.Select(
+            ActiveSimdLevel());
+#else
+    static const Detail::SkinDualQuatLinearBlendFn kernel = Detail::SkinDualQuatLinearBlendBaseline;
+#endif
+    kernel(bones, in, outX, outY, outZ);
+}
+
+namespace Detail
+{
+// Folds one more component hash into a running hash. A multiply spreads every input bit over the
+// upper bits, so equal components in different positions and small integer coordinates (whose
+// std::hash is the identity) don't cancel out the way a plain shifted xor does.
+constexpr std::size_t HashCombine(const std::size_t hash, const std::size_t value) noexcept
+{
+    return (std::rotl(hash, 23) ^ value) * 0x9E3779B97F4A7C15ULL;
+}
+} // namespace Detail
 } // namespace fawn_algebra
 
 template <typename T, std::uint8_t N>
@@ -4067,9 +4601,9 @@ struct std::hash<fawn_algebra::Vec<T, N>>
     {
         std::size_t hash = 0;
         std::hash<T> hasher;
-        for (size_t i = 0; i < N; i++)
+        for (std::uint8_t i = 0; i < N; i++)
         {
-            hash ^= hasher(vec[i]) << i;
+            hash = fawn_algebra::Detail::HashCombine(hash, hasher(vec[i]));
         }
         return hash;
     }
@@ -4082,9 +4616,9 @@ struct std::hash<fawn_algebra::VecSimd<T, N>>
     {
         std::size_t hash = 0;
         std::hash<T> hasher;
-        for (size_t i = 0; i < N; i++)
+        for (std::uint8_t i = 0; i < N; i++)
         {
-            hash ^= hasher(vec[i]) << i;
+            hash = fawn_algebra::Detail::HashCombine(hash, hasher(vec[i]));
         }
         return hash;
     }
@@ -4097,9 +4631,9 @@ struct std::hash<fawn_algebra::Mat<T, N>>
     {
         std::size_t hash = 0;
         std::hash<T> hasher;
-        for (size_t i = 0; i < N; i++)
+        for (std::uint8_t i = 0; i < N; i++)
         {
-            hash ^= hasher(mat[i]) << i;
+            hash = fawn_algebra::Detail::HashCombine(hash, hasher(mat[i]));
         }
         return hash;
     }
@@ -4112,10 +4646,10 @@ struct std::hash<fawn_algebra::Quat<T>>
     {
         std::size_t hash = 0;
         std::hash<T> hasher;
-        hash ^= hasher(quat.a) << 0;
-        hash ^= hasher(quat.e23) << 1;
-        hash ^= hasher(quat.e31) << 2;
-        hash ^= hasher(quat.e12) << 3;
+        hash = fawn_algebra::Detail::HashCombine(hash, hasher(quat.a));
+        hash = fawn_algebra::Detail::HashCombine(hash, hasher(quat.e23));
+        hash = fawn_algebra::Detail::HashCombine(hash, hasher(quat.e31));
+        hash = fawn_algebra::Detail::HashCombine(hash, hasher(quat.e12));
         return hash;
     }
 };
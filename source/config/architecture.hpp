@@ -71,3 +71,22 @@
 #else
 #    define BALBINO_SIMD_AVX512F 0
 #endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define BALBINO_ARCH_X86 1
+#else
+#    define BALBINO_ARCH_X86 0
+#endif
+
+// per-function ISA targets, used to build runtime dispatched kernels above the compile-time baseline
+#if BALBINO_ARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#    define BALBINO_RUNTIME_DISPATCH 1
+#    define BALBINO_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#    define BALBINO_TARGET_AVX2 __attribute__((target("avx2,fma,bmi,bmi2,popcnt")))
+#    define BALBINO_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,bmi,bmi2,popcnt")))
+#else
+#    define BALBINO_RUNTIME_DISPATCH 0
+#    define BALBINO_TARGET_SSE42
+#    define BALBINO_TARGET_AVX2
+#    define BALBINO_TARGET_AVX512
+#endif
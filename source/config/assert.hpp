@@ -21,8 +21,11 @@ inline void balbino_assert(const char* condition, const std::string& message, co
     balbino_assert(condition, message.c_str(), fileline);
 }
 
+#define BALBINO_STRINGIZE_DETAIL(x) #x
+#define BALBINO_STRINGIZE(x) BALBINO_STRINGIZE_DETAIL(x)
+
 #ifdef BALBINO_DEBUG
-#    define BALBINO_ASSERT(expr, message) static_cast<bool>(expr) ? static_cast<void>(0) : balbino_assert(#expr, message, BALBINO_FILE ":" _STRINGIZE(__LINE__))
+#    define BALBINO_ASSERT(expr, message) (static_cast<bool>(expr) ? static_cast<void>(0) : balbino_assert(#expr, message, __FILE__ ":" BALBINO_STRINGIZE(__LINE__)))
 #else
 #    define BALBINO_ASSERT(expr, message) (static_cast<void>(0))
 #endif
@@ -0,0 +1,282 @@
+//
+// Copyright (c) 2025.
+// Author: Joran.
+//
+
+module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
+
+#if BALBINO_ARCH_X86
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#endif
+
+export module FawnAlgebra:CPU;
+import std;
+
+namespace fawn_algebra
+{
+/*
+ * Instruction set levels the bulk kernels are compiled for.
+ * Ordered, so a level implies every level below it.
+ *  Scalar: the compile-time baseline of the build (SSE2 on x86-64)
+ *  SSE42:  x86-64-v2 (SSE4.2, POPCNT)
+ *  AVX2:   x86-64-v3 (AVX2, FMA, BMI1/2)
+ *  AVX512: x86-64-v4 (AVX-512 F/BW/DQ/VL)
+ */
+export enum class SimdLevel : std::uint8_t
+{
+    Scalar,
+    SSE42,
+    AVX2,
+    AVX512
+};
+
+export struct CpuFeatures
+{
+    bool sse2{};
+    bool sse3{};
+    bool ssse3{};
+    bool sse41{};
+    bool sse42{};
+    bool popcnt{};
+    bool avx{};
+    bool avx2{};
+    bool fma{};
+    bool bmi1{};
+    bool bmi2{};
+    bool avx512f{};
+    bool avx512bw{};
+    bool avx512dq{};
+    bool avx512vl{};
+};
+
+export constexpr std::string_view ToString(const SimdLevel level) noexcept
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::SSE42: return "sse4.2";
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+/*
+ * Parses the names produced by ToString, returns std::nullopt for anything else.
+ */
+export constexpr std::optional<SimdLevel> SimdLevelFromString(const std::string_view name) noexcept
+{
+    for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (ToString(level) == name)
+        {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
+
+namespace Detail
+{
+#if BALBINO_ARCH_X86
+inline void Cpuid(const std::uint32_t leaf, const std::uint32_t subLeaf, std::uint32_t (&regs)[4]) noexcept
+{
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    for (int i = 0; i < 4; ++i)
+    {
+        regs[i] = static_cast<std::uint32_t>(info[i]);
+    }
+#    else
+    if (__get_cpuid_count(leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3]) == 0)
+    {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    }
+#    endif
+}
+
+// XCR0: which register states the OS saves on a context switch
+inline std::uint64_t Xgetbv() noexcept
+{
+#    if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#    else
+    std::uint32_t eax;
+    std::uint32_t edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32U) | eax;
+#    endif
+}
+
+constexpr bool Bit(const std::uint32_t reg, const std::uint32_t bit) noexcept
+{
+    return ((reg >> bit) & 1U) != 0U;
+}
+#endif
+
+inline CpuFeatures QueryCpuFeatures() noexcept
+{
+    CpuFeatures features{};
+#if BALBINO_ARCH_X86
+    std::uint32_t regs[4]{};
+    Cpuid(0, 0, regs);
+    const std::uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 1)
+    {
+        return features;
+    }
+
+    Cpuid(1, 0, regs);
+    const std::uint32_t ecx1 = regs[2];
+    const std::uint32_t edx1 = regs[3];
+
+    features.sse2   = Bit(edx1, 26);
+    features.sse3   = Bit(ecx1, 0);
+    features.ssse3  = Bit(ecx1, 9);
+    features.sse41  = Bit(ecx1, 19);
+    features.sse42  = Bit(ecx1, 20);
+    features.popcnt = Bit(ecx1, 23);
+
+    // AVX state (XMM | YMM) and AVX-512 state (opmask | ZMM_Hi256 | Hi16_ZMM) must both be enabled by the OS
+    const bool osxsave       = Bit(ecx1, 27);
+    const std::uint64_t xcr0 = osxsave ? Xgetbv() : 0;
+    const bool osAvx         = (xcr0 & 0x06U) == 0x06U;
+    const bool osAvx512      = (xcr0 & 0xE6U) == 0xE6U;
+
+    features.avx = osAvx && Bit(ecx1, 28);
+    features.fma = osAvx && Bit(ecx1, 12);
+
+    if (maxLeaf >= 7)
+    {
+        Cpuid(7, 0, regs);
+        const std::uint32_t ebx7 = regs[1];
+        features.bmi1     = Bit(ebx7, 3);
+        features.bmi2     = Bit(ebx7, 8);
+        features.avx2     = osAvx && Bit(ebx7, 5);
+        features.avx512f  = osAvx512 && Bit(ebx7, 16);
+        features.avx512dq = osAvx512 && Bit(ebx7, 17);
+        features.avx512bw = osAvx512 && Bit(ebx7, 30);
+        features.avx512vl = osAvx512 && Bit(ebx7, 31);
+    }
+#endif
+    return features;
+}
+
+inline SimdLevel LevelFromFeatures(const CpuFeatures& f) noexcept
+{
+    if (!(f.sse42 && f.popcnt))
+    {
+        return SimdLevel::Scalar;
+    }
+    if (!(f.avx2 && f.fma && f.bmi1 && f.bmi2))
+    {
+        return SimdLevel::SSE42;
+    }
+    if (!(f.avx512f && f.avx512bw && f.avx512dq && f.avx512vl))
+    {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::AVX512;
+}
+
+inline SimdLevel InitialSimdLevel() noexcept
+{
+    const SimdLevel detected = LevelFromFeatures(QueryCpuFeatures());
+
+    // FAWN_ALGEBRA_SIMD_LEVEL=<scalar|sse4.2|avx2|avx512> caps the level, handy to reproduce another machine
+    if (const char* env = std::getenv("FAWN_ALGEBRA_SIMD_LEVEL"); env != nullptr)
+    {
+        if (const std::optional<SimdLevel> requested = SimdLevelFromString(env); requested.has_value())
+        {
+            return std::min(*requested, detected);
+        }
+    }
+    return detected;
+}
+
+inline std::atomic<SimdLevel>& ActiveSimdLevelStorage() noexcept
+{
+    static std::atomic<SimdLevel> level{InitialSimdLevel()};
+    return level;
+}
+} // namespace Detail
+
+/*
+ * Features reported by cpuid, masked by what the OS enables through XCR0.
+ * Queried once; all false on non-x86 targets.
+ */
+export inline const CpuFeatures& DetectedCpuFeatures() noexcept
+{
+    static const CpuFeatures features{Detail::QueryCpuFeatures()};
+    return features;
+}
+
+/*
+ * Highest SimdLevel this CPU supports, regardless of overrides.
+ */
+export inline SimdLevel DetectedSimdLevel() noexcept
+{
+    return Detail::LevelFromFeatures(DetectedCpuFeatures());
+}
+
+/*
+ * SimdLevel the dispatched kernels select from.
+ * Defaults to DetectedSimdLevel, capped by the FAWN_ALGEBRA_SIMD_LEVEL environment variable.
+ */
+export inline SimdLevel ActiveSimdLevel() noexcept
+{
+    return Detail::ActiveSimdLevelStorage().load(std::memory_order_relaxed);
+}
+
+/*
+ * Sets the active level, clamped to DetectedSimdLevel so it can never enable unsupported instructions.
+ * It replaces the FAWN_ALGEBRA_SIMD_LEVEL cap, and it only reaches kernels that have not run yet: each one
+ * caches its pick on first use. Call it at startup, before any dispatched kernel runs.
+ * Returns the level that is now active.
+ */
+export inline SimdLevel ForceSimdLevel(const SimdLevel level) noexcept
+{
+    const SimdLevel applied = std::min(level, DetectedSimdLevel());
+    Detail::ActiveSimdLevelStorage().store(applied, std::memory_order_relaxed);
+    return applied;
+}
+
+/*
+ * One function pointer per SimdLevel, null where no specialised build exists.
+ * Select returns the best entry at or below the requested level, scalar must always be set.
+ * Kernels cache the result in a function-local static, so the choice is made once per process:
+ *   static const auto kernel = DispatchTable<Fn>{scalar, sse42, avx2, avx512}.Select(ActiveSimdLevel());
+ */
+export template <typename Fn>
+struct DispatchTable
+{
+    Fn scalar{};
+    Fn sse42{};
+    Fn avx2{};
+    Fn avx512{};
+
+    constexpr Fn Select(const SimdLevel level) const noexcept
+    {
+        if (level >= SimdLevel::AVX512 && avx512 != nullptr)
+        {
+            return avx512;
+        }
+        if (level >= SimdLevel::AVX2 && avx2 != nullptr)
+        {
+            return avx2;
+        }
+        if (level >= SimdLevel::SSE42 && sse42 != nullptr)
+        {
+            return sse42;
+        }
+        return scalar;
+    }
+};
+} // namespace fawn_algebra
@@ -0,0 +1,605 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/architecture.hpp"
+#include "config/assert.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:Distributions;
+import :CPU;
+import :Hashing;
+import :Random;
+import :SIMD;
+import :SIMDMath;
+import std;
+
+// Samplers for the non-uniform distributions, over any FullRangeGenerator.
+//
+// Single draws:
+//   SampleNormal, SampleExponential   256-layer ziggurat (Marsaglia & Tsang 2000, with
+//                                     the layer and the abscissa from disjoint bits as in
+//                                     Doornik 2005), ~1.02 draws per sample
+//   SamplePoisson                     inversion below lambda 10, PTRS above (Hoermann 1993)
+//   SampleGamma, SampleBeta           Marsaglia & Tsang 2000 squeeze
+// Batches:
+//   FillNormal, FillExponential       SIMD Box-Muller / -log(U) over staged uniforms;
+//                                     for Philox4x32 the draws come from its own bulk Fill
+//   AliasTable::Sample(g, span)       Walker / Vose, O(1) per sample; SIMD column picks and
+//                                     gathered thresholds
+namespace fawn_algebra
+{
+namespace detail
+{
+// Layer i of a ziggurat is the box [0, x[i]] x [f(x[i]), f(x[i + 1])]; layer 0 is the base
+// box [0, R] x [0, f(R)] together with the tail, folded into the width x[0] = V / f(R).
+struct ziggurat_table
+{
+    static constexpr int layers{256};
+
+    std::array<double, layers + 1> x;
+    std::array<double, layers + 1> f;
+};
+
+template <typename Density, typename Inverse>
+ziggurat_table MakeZiggurat(const double r, const double v, Density density, Inverse inverse)
+{
+    ziggurat_table table{};
+    table.x[0] = v / density(r);
+    table.x[1] = r;
+    for (int i = 1; i < ziggurat_table::layers - 1; ++i)
+    {
+        table.x[i + 1] = inverse(density(table.x[i]) + v / table.x[i]);
+    }
+    table.x[ziggurat_table::layers] = 0.0;
+    for (int i = 0; i <= ziggurat_table::layers; ++i)
+    {
+        table.f[i] = density(table.x[i]);
+    }
+    table.f[0] = 0.0;
+    return table;
+}
+
+inline const ziggurat_table& NormalZiggurat()
+{
+    static const ziggurat_table table{MakeZiggurat(
+        3.6541528853610088, 0.00492867323399, [](const double x) { return std::exp(-0.5 * x * x); }, [](const double y) { return std::sqrt(-2.0 * std::log(y)); })};
+    return table;
+}
+
+inline const ziggurat_table& ExponentialZiggurat()
+{
+    static const ziggurat_table table{
+        MakeZiggurat(7.69711747013104972, 0.0039496598225815571993, [](const double x) { return std::exp(-x); }, [](const double y) { return -std::log(y); })};
+    return table;
+}
+
+// (0, 1]: never zero, so -log is finite
+template <FullRangeGenerator G>
+double UniformPositive(G& generator)
+{
+    return static_cast<double>((UniformBits64(generator) >> 11U) + 1U) * 0x1.0p-53;
+}
+
+// the draws behind UniformBits32 (wide == false) or UniformBits64 (wide == true, each as two
+// words, high first), in bulk where the engine can
+template <FullRangeGenerator G>
+void StageBits(G& generator, const std::span<std::uint32_t> words, const bool wide)
+{
+    if constexpr (requires { generator.Fill(words); })
+    {
+        if (G::max() == std::numeric_limits<std::uint32_t>::max())
+        {
+            generator.Fill(words);
+            return;
+        }
+    }
+    if (wide)
+    {
+        for (std::size_t i = 0; i + 1 < words.size(); i += 2)
+        {
+            const std::uint64_t bits{UniformBits64(generator)};
+            words[i]     = static_cast<std::uint32_t>(bits >> 32U);
+            words[i + 1] = static_cast<std::uint32_t>(bits);
+        }
+    }
+    else
+    {
+        for (std::uint32_t& word : words)
+        {
+            word = UniformBits32(generator);
+        }
+    }
+}
+
+inline constexpr std::size_t stage_words{1024};
+} // namespace detail
+
+// ---- normal / exponential -------------------------------------------------
+
+export template <std::floating_point T = double, FullRangeGenerator G>
+T SampleNormal(G& generator, const T mean = T(0), const T stddev = T(1))
+{
+    const detail::ziggurat_table& table{detail::NormalZiggurat()};
+    for (;;)
+    {
+        // layer from the low byte, a signed abscissa from the top 53 bits
+        const std::uint64_t bits{UniformBits64(generator)};
+        const auto layer{static_cast<std::size_t>(bits & 0xFFU)};
+        const double u{static_cast<double>(bits >> 11U) * 0x1.0p-52 - 1.0};
+        const double x{u * table.x[layer]};
+        if (std::abs(x) < table.x[layer + 1])
+        {
+            return mean + stddev * static_cast<T>(x);
+        }
+        if (layer == 0)
+        {
+            // Marsaglia's tail beyond R
+            double tail;
+            double y;
+            do
+            {
+                tail = -std::log(detail::UniformPositive(generator)) / table.x[1];
+                y    = -std::log(detail::UniformPositive(generator));
+            } while (y + y < tail * tail);
+            return mean + stddev * static_cast<T>(u < 0.0 ? -(table.x[1] + tail) : table.x[1] + tail);
+        }
+        if (table.f[layer] + UniformDouble(generator) * (table.f[layer + 1] - table.f[layer]) < std::exp(-0.5 * x * x))
+        {
+            return mean + stddev * static_cast<T>(x);
+        }
+    }
+}
+
+// rate lambda, mean 1 / lambda
+export template <std::floating_point T = double, FullRangeGenerator G>
+T SampleExponential(G& generator, const T lambda = T(1))
+{
+    const detail::ziggurat_table& table{detail::ExponentialZiggurat()};
+    double offset{};
+    for (;;)
+    {
+        const std::uint64_t bits{UniformBits64(generator)};
+        const auto layer{static_cast<std::size_t>(bits & 0xFFU)};
+        const double x{static_cast<double>(bits >> 11U) * 0x1.0p-53 * table.x[layer]};
+        if (x < table.x[layer + 1])
+        {
+            return static_cast<T>(offset + x) / lambda;
+        }
+        if (layer == 0)
+        {
+            // memoryless: the tail beyond R is R plus another exponential
+            offset += table.x[1];
+            continue;
+        }
+        if (table.f[layer] + UniformDouble(generator) * (table.f[layer + 1] - table.f[layer]) < std::exp(-x))
+        {
+            return static_cast<T>(offset + x) / lambda;
+        }
+    }
+}
+
+namespace detail
+{
+// -log(U) * scale for count staged 32-bit draws, U as in UniformFloat nudged off zero
+template <int N>
+BALBINO_FORCE_INLINE void ExponentialKernel(const std::uint32_t* bits, float* out, const std::size_t count, const float scale) noexcept
+{
+    using U = simd::vec<std::uint32_t, N>;
+    using V = simd::vec<float, N>;
+    using I = simd::vec<std::int32_t, N>::raw_type;
+    std::size_t i{};
+    for (; count - i >= N; i += N)
+    {
+        // the shifted draws fit 24 bits, so the signed convert is exact
+        const V u{V{__builtin_convertvector(std::bit_cast<I>(U::load(bits + i).r >> 8U) + 1, typename V::raw_type)} * 0x1.0p-24F};
+        (simd::log(u) * scale).store(out + i);
+    }
+    if (i < count)
+    {
+        // the zeros past the end become U = 2^-24, whose lanes are never stored
+        const int active{static_cast<int>(count - i)};
+        const V u{V{__builtin_convertvector(std::bit_cast<I>(U::load_partial(bits + i, active).r >> 8U) + 1, typename V::raw_type)} * 0x1.0p-24F};
+        (simd::log(u) * scale).store_partial(out + i, active);
+    }
+}
+
+// the same for 64-bit draws, each two words high first, U as in UniformDouble nudged off zero
+template <int N>
+BALBINO_FORCE_INLINE void ExponentialKernel(const std::uint32_t* bits, double* out, const std::size_t count, const double scale) noexcept
+{
+    constexpr int lanes{N / 2};
+    using U = simd::vec<std::uint32_t, N>;
+    using V = simd::vec<double, lanes>;
+    std::size_t i{};
+    for (; count - i >= N; i += N)
+    {
+        const auto [high, low]{simd::deinterleave(U::load(bits + 2 * i), U::load(bits + 2 * i + N))};
+        const auto top{Top53(high, low)};
+        (simd::log((top[0] + 1.0) * 0x1.0p-53) * scale).store(out + i);
+        (simd::log((top[1] + 1.0) * 0x1.0p-53) * scale).store(out + i + lanes);
+    }
+    for (; i < count; i += lanes)
+    {
+        const int active{static_cast<int>(std::min<std::size_t>(lanes, count - i))};
+        V u;
+        for (int l = 0; l < lanes; ++l)
+        {
+            const std::uint32_t* word{bits + 2 * (i + static_cast<std::size_t>(std::min(l, active - 1)))};
+            u[l] = static_cast<double>((((static_cast<std::uint64_t>(word[0]) << 32U) | word[1]) >> 11U) + 1U) * 0x1.0p-53;
+        }
+        (simd::log(u) * scale).store_partial(out + i, active);
+    }
+}
+
+template <typename T>
+using ExponentialFn = void (*)(const std::uint32_t*, T*, std::size_t, T) noexcept;
+
+template <typename T>
+void ExponentialBaseline(const std::uint32_t* bits, T* out, const std::size_t count, const T scale) noexcept
+{
+    ExponentialKernel<fill_lanes>(bits, out, count, scale);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+template <typename T>
+BALBINO_TARGET_AVX2 void ExponentialAvx2(const std::uint32_t* bits, T* out, const std::size_t count, const T scale) noexcept
+{
+    ExponentialKernel<8>(bits, out, count, scale);
+}
+
+template <typename T>
+BALBINO_TARGET_AVX512 void ExponentialAvx512(const std::uint32_t* bits, T* out, const std::size_t count, const T scale) noexcept
+{
+    ExponentialKernel<16>(bits, out, count, scale);
+}
+#endif
+
+template <typename T>
+void Exponential(const std::uint32_t* bits, T* out, const std::size_t count, const T scale) noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const ExponentialFn<T> kernel = DispatchTable<ExponentialFn<T>>{ExponentialBaseline<T>, nullptr, ExponentialAvx2<T>, ExponentialAvx512<T>}.Select(ActiveSimdLevel());
+#else
+    static const ExponentialFn<T> kernel = ExponentialBaseline<T>;
+#endif
+    kernel(bits, out, count, scale);
+}
+
+// Alias table columns for count staged 64-bit draws (two words each, high first) over whole
+// steps of N; returns how many draws that covered. columns holds four words per column
+// (threshold low, threshold high, alias, padding) and size * 4 must fit the int32 gather index.
+using AliasPickFn = std::size_t (*)(const std::uint32_t* columns, std::uint32_t size, const std::uint32_t* bits, std::uint32_t* out, std::size_t count) noexcept;
+
+template <int N, auto MulEven, auto Gather>
+BALBINO_FORCE_INLINE std::size_t AliasPickKernel(const std::uint32_t* columns, const std::uint32_t size, const std::uint32_t* bits, std::uint32_t* out, const std::size_t count) noexcept
+{
+    using U = simd::vec<std::uint32_t, N>;
+    using I = simd::vec<std::int32_t, N>;
+    using R = U::raw_type;
+    const auto* words{reinterpret_cast<const std::int32_t*>(columns)};
+    const U n{U::splat(size)};
+    std::size_t i{};
+    for (; count - i >= N; i += N)
+    {
+        // draw * n = high * n * 2^32 + low * n: the column is the word above bit 64 of the sum, the
+        // coin the 64 bits below it, as in the 128-bit product of Pick
+        const auto [high, low]{simd::deinterleave(U::load(bits + 2 * i), U::load(bits + 2 * i + N))};
+        const auto [highTop, highBottom]{simd::mul_wide<N, MulEven>(high, n)};
+        const auto [lowTop, lowBottom]{simd::mul_wide<N, MulEven>(low, n)};
+        const R middle{highBottom.r + lowTop.r};
+        // a true compare is all ones, so subtracting it adds the carry
+        const R column{highTop.r - std::bit_cast<R>(middle < highBottom.r)};
+        const I index{std::bit_cast<typename I::raw_type>(column << 2U)};
+        const R thresholdLow{std::bit_cast<R>(Gather(words, index).r)};
+        const R thresholdHigh{std::bit_cast<R>(Gather(words + 1, index).r)};
+        const R alias{std::bit_cast<R>(Gather(words + 2, index).r)};
+        // coin < threshold over two words; the compares become words before they combine, as
+        // GCC splits a combination of compares into lanes on the dispatched AVX-512 path
+        const R below{std::bit_cast<R>(middle < thresholdHigh)};
+        const R equal{std::bit_cast<R>(middle == thresholdHigh)};
+        const R belowLow{std::bit_cast<R>(lowBottom.r < thresholdLow)};
+        const R keep{below | (equal & belowLow)};
+        U{(column & keep) | (alias & ~keep)}.store(out + i);
+    }
+    return i;
+}
+
+inline std::size_t AliasPickBaseline(const std::uint32_t* columns, const std::uint32_t size, const std::uint32_t* bits, std::uint32_t* out, const std::size_t count) noexcept
+{
+    return AliasPickKernel<fill_lanes, simd::detail::mul_even<simd::detail::raw<std::uint64_t, fill_lanes / 2>>, simd::gather<std::int32_t, fill_lanes>>(columns, size, bits, out, count);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+BALBINO_TARGET_AVX2 inline std::size_t AliasPickAvx2(const std::uint32_t* columns, const std::uint32_t size, const std::uint32_t* bits, std::uint32_t* out, const std::size_t count) noexcept
+{
+    return AliasPickKernel<8, simd::detail::mul_even_avx2, simd::detail::gather_avx2>(columns, size, bits, out, count);
+}
+
+BALBINO_TARGET_AVX512 inline std::size_t AliasPickAvx512(const std::uint32_t* columns, const std::uint32_t size, const std::uint32_t* bits, std::uint32_t* out, const std::size_t count) noexcept
+{
+    return AliasPickKernel<16, simd::detail::mul_even_avx512, simd::detail::gather_avx512>(columns, size, bits, out, count);
+}
+#endif
+
+inline AliasPickFn AliasPickKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const AliasPickFn kernel = DispatchTable<AliasPickFn>{AliasPickBaseline, nullptr, AliasPickAvx2, AliasPickAvx512}.Select(ActiveSimdLevel());
+#else
+    static const AliasPickFn kernel = AliasPickBaseline;
+#endif
+    return kernel;
+}
+} // namespace detail
+
+// Box-Muller in SIMD lanes, the same pairing as Philox4x32::FillNormal; for Philox4x32 the
+// output is identical to that member.
+export template <FullRangeGenerator G, std::floating_point T>
+void FillNormal(G& generator, const std::span<T> out, const T mean = T(0), const T stddev = T(1))
+{
+    constexpr bool wide{std::is_same_v<T, double>};
+    constexpr std::size_t words_per_pair{wide ? 4 : 2};
+    std::array<std::uint32_t, detail::stage_words> bits;
+    const std::size_t pairs{(out.size() + 1) / 2};
+    for (std::size_t i{}; i < pairs; i += detail::stage_words / words_per_pair)
+    {
+        const std::size_t count{std::min(detail::stage_words / words_per_pair, pairs - i)};
+        detail::StageBits(generator, std::span{bits}.first(words_per_pair * count), wide);
+        if (2 * (i + count) <= out.size())
+        {
+            detail::NormalPairs(bits.data(), out.data() + 2 * i, count);
+        }
+        else
+        {
+            detail::NormalPairs(bits.data(), out.data() + 2 * i, count - 1);
+            T last[2];
+            detail::NormalPairs(bits.data() + words_per_pair * (count - 1), last, 1);
+            out.back() = last[0];
+        }
+    }
+    if (mean != T(0) || stddev != T(1))
+    {
+        for (T& value : out)
+        {
+            value = mean + stddev * value;
+        }
+    }
+}
+
+// -log(U) / lambda in SIMD lanes, U from UniformFloat / UniformDouble nudged off zero
+export template <FullRangeGenerator G, std::floating_point T>
+void FillExponential(G& generator, const std::span<T> out, const T lambda = T(1))
+{
+    constexpr bool wide{std::is_same_v<T, double>};
+    constexpr std::size_t words_per_value{wide ? 2 : 1};
+    std::array<std::uint32_t, detail::stage_words> bits;
+    for (std::size_t i{}; i < out.size(); i += detail::stage_words / words_per_value)
+    {
+        const std::size_t count{std::min(detail::stage_words / words_per_value, out.size() - i)};
+        detail::StageBits(generator, std::span{bits}.first(words_per_value * count), wide);
+        detail::Exponential(bits.data(), out.data() + i, count, T(-1) / lambda);
+    }
+}
+
+// ---- Poisson / gamma / beta ------------------------------------------------
+
+export template <FullRangeGenerator G>
+std::uint64_t SamplePoisson(G& generator, const double lambda)
+{
+    if (lambda < 10.0)
+    {
+        // sequential inversion, lambda + 1 steps on average
+        std::uint64_t k{};
+        double probability{std::exp(-lambda)};
+        double cumulative{probability};
+        const double u{UniformDouble(generator)};
+        while (u > cumulative && probability > 0.0)
+        {
+            ++k;
+            probability *= lambda / static_cast<double>(k);
+            cumulative += probability;
+        }
+        return k;
+    }
+
+    // PTRS, transformed rejection with squeeze: ~1.1 uniform pairs per sample for any lambda
+    const double root{std::sqrt(lambda)};
+    const double logLambda{std::log(lambda)};
+    const double b{0.931 + 2.53 * root};
+    const double a{-0.059 + 0.02483 * b};
+    const double inverseAlpha{1.1239 + 1.1328 / (b - 3.4)};
+    const double vr{0.9277 - 3.6224 / (b - 2.0)};
+    for (;;)
+    {
+        const double u{UniformDouble(generator) - 0.5};
+        const double v{UniformDouble(generator)};
+        const double us{0.5 - std::abs(u)};
+        const double k{std::floor((2.0 * a / us + b) * u + lambda + 0.43)};
+        if (us >= 0.07 && v <= vr)
+        {
+            return static_cast<std::uint64_t>(k);
+        }
+        if (k < 0.0 || (us < 0.013 && v > us))
+        {
+            continue;
+        }
+        if (std::log(v) + std::log(inverseAlpha) - std::log(a / (us * us) + b) <= -lambda + k * logLambda - std::lgamma(k + 1.0))
+        {
+            return static_cast<std::uint64_t>(k);
+        }
+    }
+}
+
+// shape k > 0, scale theta: mean k theta, variance k theta^2
+export template <std::floating_point T = double, FullRangeGenerator G>
+T SampleGamma(G& generator, const T shape, const T scale = T(1))
+{
+    if (shape < T(1))
+    {
+        // Gamma(k) = Gamma(k + 1) U^(1 / k)
+        const double boost{std::pow(detail::UniformPositive(generator), 1.0 / static_cast<double>(shape))};
+        return static_cast<T>(static_cast<double>(SampleGamma<T>(generator, shape + T(1), scale)) * boost);
+    }
+
+    const double d{static_cast<double>(shape) - 1.0 / 3.0};
+    const double c{1.0 / std::sqrt(9.0 * d)};
+    for (;;)
+    {
+        double x;
+        double v;
+        do
+        {
+            x = SampleNormal(generator);
+            v = 1.0 + c * x;
+        } while (v <= 0.0);
+        v = v * v * v;
+        const double u{detail::UniformPositive(generator)};
+        const double x2{x * x};
+        if (u < 1.0 - 0.0331 * x2 * x2 || std::log(u) < 0.5 * x2 + d * (1.0 - v + std::log(v)))
+        {
+            return static_cast<T>(d * v) * scale;
+        }
+    }
+}
+
+export template <std::floating_point T = double, FullRangeGenerator G>
+T SampleBeta(G& generator, const T alpha, const T beta)
+{
+    const T x{SampleGamma<T>(generator, alpha)};
+    const T y{SampleGamma<T>(generator, beta)};
+    return x / (x + y);
+}
+
+// ---- discrete -------------------------------------------------------------
+
+// Walker's alias method with Vose's O(n) construction. Each column holds a 64-bit threshold
+// and its alias side by side in 16 bytes, so a sample touches one cache line however many
+// outcomes there are. One 64-bit draw picks the column (high half of draw * n) and flips the
+// coin (low half against the threshold). Batches pick a register of columns at a time and
+// gather their words.
+export class AliasTable
+{
+  public:
+    AliasTable() = default;
+
+    // Weights need not be normalised. Any weight that is negative or not finite, or a total that
+    // is zero or overflows, leaves the table empty, like a default-constructed one.
+    explicit AliasTable(const std::span<const double> weights)
+    {
+        const std::size_t n{weights.size()};
+        if (!std::ranges::all_of(weights, [](const double weight) { return simd::detail::is_finite(weight) && weight >= 0.0; }))
+        {
+            return;
+        }
+        const double total{std::accumulate(weights.begin(), weights.end(), 0.0)};
+        if (!(simd::detail::is_finite(total) && total > 0.0))
+        {
+            return;
+        }
+        m_columns.resize(column_words * n);
+
+        std::vector<double> scaled(n);
+        std::vector<std::uint32_t> small;
+        std::vector<std::uint32_t> large;
+        small.reserve(n);
+        large.reserve(n);
+        for (std::size_t i{}; i < n; ++i)
+        {
+            scaled[i] = weights[i] * static_cast<double>(n) / total;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+
+        while (!small.empty() && !large.empty())
+        {
+            const std::uint32_t less{small.back()};
+            small.pop_back();
+            const std::uint32_t more{large.back()};
+
+            SetColumn(less, ToThreshold(scaled[less]), more);
+            scaled[more]    = (scaled[more] + scaled[less]) - 1.0;
+            if (scaled[more] < 1.0)
+            {
+                large.pop_back();
+                small.push_back(more);
+            }
+        }
+        // leftovers are 1 up to rounding: always keep
+        for (const std::uint32_t i : large)
+        {
+            SetColumn(i, std::numeric_limits<std::uint64_t>::max(), i);
+        }
+        for (const std::uint32_t i : small)
+        {
+            SetColumn(i, std::numeric_limits<std::uint64_t>::max(), i);
+        }
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept
+    {
+        return m_columns.size() / column_words;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_columns.empty();
+    }
+
+    // the table must not be empty
+    template <FullRangeGenerator G>
+    std::uint32_t Sample(G& generator) const
+    {
+        BALBINO_ASSERT(!Empty(), "AliasTable has no outcomes to sample");
+        return Pick(UniformBits64(generator));
+    }
+
+    // the same outcomes as Sample in a loop; the draws are staged in bulk
+    template <FullRangeGenerator G>
+    void Sample(G& generator, const std::span<std::uint32_t> out) const
+    {
+        BALBINO_ASSERT(!Empty() || out.empty(), "AliasTable has no outcomes to sample");
+        std::array<std::uint32_t, detail::stage_words> bits;
+        for (std::size_t i{}; i < out.size(); i += detail::stage_words / 2)
+        {
+            const std::size_t count{std::min(detail::stage_words / 2, out.size() - i)};
+            detail::StageBits(generator, std::span{bits}.first(2 * count), true);
+            // the gather indexes words with int32, so huge tables stay on the scalar picks
+            const std::size_t picked{Size() <= max_gather_columns ? detail::AliasPickKernelFor()(m_columns.data(), static_cast<std::uint32_t>(Size()), bits.data(), out.data() + i, count) : 0};
+            for (std::size_t j{picked}; j < count; ++j)
+            {
+                out[i + j] = Pick((static_cast<std::uint64_t>(bits[2 * j]) << 32U) | bits[2 * j + 1]);
+            }
+        }
+    }
+
+  private:
+    // threshold low word, threshold high word, alias, padding
+    static constexpr std::size_t column_words{4};
+    static constexpr std::size_t max_gather_columns{std::size_t{1} << 29U};
+
+    std::vector<std::uint32_t> m_columns;
+
+    void SetColumn(const std::size_t index, const std::uint64_t threshold, const std::uint32_t alias) noexcept
+    {
+        std::uint32_t* entry{m_columns.data() + column_words * index};
+        entry[0] = static_cast<std::uint32_t>(threshold);
+        entry[1] = static_cast<std::uint32_t>(threshold >> 32U);
+        entry[2] = alias;
+    }
+
+    static std::uint64_t ToThreshold(const double probability) noexcept
+    {
+        return probability >= 1.0 ? std::numeric_limits<std::uint64_t>::max() : static_cast<std::uint64_t>(probability * 0x1.0p64);
+    }
+
+    [[nodiscard]] std::uint32_t Pick(const std::uint64_t bits) const noexcept
+    {
+        const detail::wide_product product{detail::MulWide(bits, Size())};
+        const std::uint32_t* entry{m_columns.data() + column_words * product.hi};
+        const std::uint64_t threshold{(static_cast<std::uint64_t>(entry[1]) << 32U) | entry[0]};
+        return product.lo < threshold ? static_cast<std::uint32_t>(product.hi) : entry[2];
+    }
+};
+} // namespace fawn_algebra
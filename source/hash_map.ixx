@@ -0,0 +1,731 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:HashMap;
+import :Hashing;
+import :SIMD;
+import std;
+
+// Flat open-addressing hash containers in the Swiss-table layout. Every slot has a control byte,
+// empty, deleted or the low 7 bits of its key's hash, and a lookup compares 16 control bytes at
+// once against those 7 bits with one u8x16 compare, so a probe rarely touches a key that does not
+// match. The elements sit in one array, without a node per element, and lookups stay short up to
+// the 7/8 maximum load.
+//
+//   FlatHashMap<Key, Value, Hash, Eq>   Key -> Value, elements are std::pair<Key, Value>
+//   FlatHashSet<Key, Hash, Eq>          Key
+//
+// The hash is mixed once more before use, so std::hash specialisations that are weak in some bits,
+// like the identity hash of integers or the Vec / Mat / Quat hashes, work as they are. With a Hash
+// and an Eq that both declare is_transparent, Find, Contains and Erase take any key type they
+// accept, for example std::string_view against std::string keys with StringHash.
+//
+// Inserting can rehash, which moves every element and invalidates iterators and references; erasing
+// invalidates only the erased element. Keys must not be changed through an iterator.
+namespace fawn_algebra
+{
+// transparent std::string / std::string_view / const char* hash, for heterogeneous lookup
+export struct StringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(const std::string_view text) const noexcept
+    {
+        return static_cast<std::size_t>(Hash64(text));
+    }
+};
+
+namespace detail
+{
+// control bytes: a full slot holds its 7 hash bits, 0 to 127
+inline constexpr std::uint8_t ctrl_empty{0x80};
+inline constexpr std::uint8_t ctrl_deleted{0xFE};
+inline constexpr std::size_t ctrl_group_width{16};
+
+// 16 control bytes from any slot on; bit i of a match is that slot + i
+struct ctrl_group
+{
+    simd::u8x16 ctrl;
+
+    BALBINO_FORCE_INLINE explicit ctrl_group(const std::uint8_t* at) noexcept
+        : ctrl{simd::u8x16::load(at)}
+    {
+    }
+
+    [[nodiscard]] BALBINO_FORCE_INLINE std::uint32_t Match(const std::uint8_t h2) const noexcept
+    {
+        return static_cast<std::uint32_t>(simd::movemask(ctrl == simd::u8x16::splat(h2)));
+    }
+
+    [[nodiscard]] BALBINO_FORCE_INLINE std::uint32_t MatchEmpty() const noexcept
+    {
+        return Match(ctrl_empty);
+    }
+
+    // empty or deleted, the slots an insert can take
+    [[nodiscard]] BALBINO_FORCE_INLINE std::uint32_t MatchFree() const noexcept
+    {
+        return static_cast<std::uint32_t>(simd::movemask(ctrl.r >= ctrl_empty));
+    }
+};
+
+template <typename Hash, typename Eq>
+concept transparent_hash_eq = requires {
+    typename Hash::is_transparent;
+    typename Eq::is_transparent;
+};
+
+// Element is what a slot holds: the Key itself for sets, std::pair<Key, Value> for maps
+template <typename Key, typename Element, typename Hash, typename Eq>
+class flat_table
+{
+  public:
+    using key_type   = Key;
+    using value_type = Element;
+    using size_type  = std::size_t;
+
+    template <bool Const>
+    class iterator_base
+    {
+      public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Element;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, const Element&, Element&>;
+        using pointer           = std::conditional_t<Const, const Element*, Element*>;
+
+        iterator_base() = default;
+
+        // iterator -> const_iterator
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        iterator_base(const iterator_base<OtherConst>& other) noexcept
+            : m_ctrl{other.m_ctrl}
+            , m_end{other.m_end}
+            , m_slot{other.m_slot}
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return *m_slot;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return m_slot;
+        }
+
+        iterator_base& operator++() noexcept
+        {
+            ++m_ctrl;
+            ++m_slot;
+            SkipFree();
+            return *this;
+        }
+
+        iterator_base operator++(int) noexcept
+        {
+            iterator_base old{*this};
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const iterator_base& a, const iterator_base& b) noexcept
+        {
+            return a.m_slot == b.m_slot;
+        }
+
+      private:
+        friend class flat_table;
+        friend class iterator_base<true>;
+
+        iterator_base(const std::uint8_t* ctrl, const std::uint8_t* end, pointer slot) noexcept
+            : m_ctrl{ctrl}
+            , m_end{end}
+            , m_slot{slot}
+        {
+        }
+
+        void SkipFree() noexcept
+        {
+            while (m_ctrl != m_end && *m_ctrl >= ctrl_empty)
+            {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+        const std::uint8_t* m_ctrl{};
+        const std::uint8_t* m_end{};
+        pointer m_slot{};
+    };
+
+    using iterator       = iterator_base<false>;
+    using const_iterator = iterator_base<true>;
+
+    flat_table() = default;
+
+    flat_table(const flat_table& other)
+        : m_hash{other.m_hash}
+        , m_eq{other.m_eq}
+    {
+        try
+        {
+            Reserve(other.m_size);
+            for (const Element& element : other)
+            {
+                const std::size_t hash{Mix(KeyOf(element))};
+                const std::size_t index{PrepareInsert(hash)};
+                std::construct_at(m_slots + index, element);
+                CommitInsert(index, hash);
+            }
+        }
+        catch (...)
+        {
+            // no destructor runs for a constructor that throws
+            Release();
+            throw;
+        }
+    }
+
+    flat_table(flat_table&& other) noexcept
+        : m_hash{std::move(other.m_hash)}
+        , m_eq{std::move(other.m_eq)}
+        , m_ctrl{std::exchange(other.m_ctrl, nullptr)}
+        , m_slots{std::exchange(other.m_slots, nullptr)}
+        , m_capacity{std::exchange(other.m_capacity, 0)}
+        , m_size{std::exchange(other.m_size, 0)}
+        , m_growthLeft{std::exchange(other.m_growthLeft, 0)}
+    {
+    }
+
+    flat_table& operator=(const flat_table& other)
+    {
+        if (this != &other)
+        {
+            flat_table copy{other};
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    flat_table& operator=(flat_table&& other) noexcept
+    {
+        flat_table moved{std::move(other)};
+        Swap(moved);
+        return *this;
+    }
+
+    ~flat_table()
+    {
+        Release();
+    }
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        iterator it{m_ctrl, m_ctrl + m_capacity, m_slots};
+        it.SkipFree();
+        return it;
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return {m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity};
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        const_iterator it{m_ctrl, m_ctrl + m_capacity, m_slots};
+        it.SkipFree();
+        return it;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return {m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity};
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    // slots; a power of two, at least 16 once anything was inserted
+    [[nodiscard]] std::size_t Capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    [[nodiscard]] float LoadFactor() const noexcept
+    {
+        return m_capacity == 0 ? 0.0F : static_cast<float>(m_size) / static_cast<float>(m_capacity);
+    }
+
+    // room for count elements without a rehash
+    void Reserve(const std::size_t count)
+    {
+        std::size_t capacity{ctrl_group_width};
+        while (MaxLoad(capacity) < count)
+        {
+            capacity *= 2;
+        }
+        if (capacity > m_capacity)
+        {
+            Rehash(capacity);
+        }
+    }
+
+    // keeps the capacity
+    void Clear() noexcept
+    {
+        if (m_capacity == 0)
+        {
+            return;
+        }
+        DestroyAll();
+        std::fill_n(m_ctrl, m_capacity + ctrl_group_width - 1, ctrl_empty);
+        m_size       = 0;
+        m_growthLeft = MaxLoad(m_capacity);
+    }
+
+    [[nodiscard]] iterator Find(const Key& key) noexcept
+    {
+        return At(FindIndex(key, Mix(key)));
+    }
+
+    [[nodiscard]] const_iterator Find(const Key& key) const noexcept
+    {
+        return At(FindIndex(key, Mix(key)));
+    }
+
+    template <typename K>
+        requires transparent_hash_eq<Hash, Eq> && (!std::same_as<K, Key>)
+    [[nodiscard]] iterator Find(const K& key) noexcept
+    {
+        return At(FindIndex(key, Mix(key)));
+    }
+
+    template <typename K>
+        requires transparent_hash_eq<Hash, Eq> && (!std::same_as<K, Key>)
+    [[nodiscard]] const_iterator Find(const K& key) const noexcept
+    {
+        return At(FindIndex(key, Mix(key)));
+    }
+
+    [[nodiscard]] bool Contains(const Key& key) const noexcept
+    {
+        return FindIndex(key, Mix(key)) != npos;
+    }
+
+    template <typename K>
+        requires transparent_hash_eq<Hash, Eq> && (!std::same_as<K, Key>)
+    [[nodiscard]] bool Contains(const K& key) const noexcept
+    {
+        return FindIndex(key, Mix(key)) != npos;
+    }
+
+    // elements erased, 0 or 1
+    std::size_t Erase(const Key& key) noexcept
+    {
+        return EraseKey(key);
+    }
+
+    template <typename K>
+        requires transparent_hash_eq<Hash, Eq> && (!std::same_as<K, Key>)
+    std::size_t Erase(const K& key) noexcept
+    {
+        return EraseKey(key);
+    }
+
+    // the element after it
+    iterator Erase(const const_iterator it) noexcept
+    {
+        const std::size_t index{static_cast<std::size_t>(it.m_slot - m_slots)};
+        EraseAt(index);
+        iterator next{m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+        next.SkipFree();
+        return next;
+    }
+
+    void Swap(flat_table& other) noexcept
+    {
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_eq, other.m_eq);
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+  protected:
+    static constexpr std::size_t npos{std::numeric_limits<std::size_t>::max()};
+
+    static const Key& KeyOf(const Element& element) noexcept
+    {
+        if constexpr (std::same_as<Element, Key>)
+        {
+            return element;
+        }
+        else
+        {
+            return element.first;
+        }
+    }
+
+    // the key's element and false, or a new element constructed from args and true; the slot is
+    // only marked full once the element is constructed, so a throwing constructor leaves the table
+    // as it was, apart from a rehash
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args)
+    {
+        const std::size_t hash{Mix(key)};
+        if (const std::size_t found{FindIndex(key, hash)}; found != npos)
+        {
+            return {At(found), false};
+        }
+        const std::size_t index{PrepareInsert(hash)};
+        std::construct_at(m_slots + index, std::forward<Args>(args)...);
+        CommitInsert(index, hash);
+        return {At(index), true};
+    }
+
+    iterator At(const std::size_t index) noexcept
+    {
+        return index == npos ? end() : iterator{m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+    }
+
+    const_iterator At(const std::size_t index) const noexcept
+    {
+        return index == npos ? end() : const_iterator{m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+    }
+
+  private:
+    // 7/8 of the slots; the rest stay empty so every probe ends
+    static constexpr std::size_t MaxLoad(const std::size_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    // std::hash is often the identity or weak in the low bits, which pick the group, and the high
+    // bits, which fill the control byte: fold a 64 x 64 -> 128 bit product over them
+    template <typename K>
+    std::size_t Mix(const K& key) const noexcept
+    {
+        return static_cast<std::size_t>(MulFold(static_cast<std::uint64_t>(m_hash(key)), 0x9E3779B97F4A7C15ULL));
+    }
+
+    static std::uint8_t H2(const std::size_t hash) noexcept
+    {
+        return static_cast<std::uint8_t>(hash & 0x7FU);
+    }
+
+    // Groups are probed from any slot on: the first 15 control bytes are repeated past the last
+    // slot, so a group never wraps. Group starts advance by 16, 32, 48, ... slots, which visits
+    // every slot of a power-of-two table.
+    template <typename K>
+    std::size_t FindIndex(const K& key, const std::size_t hash) const noexcept
+    {
+        if (m_capacity == 0)
+        {
+            return npos;
+        }
+        const std::size_t mask{m_capacity - 1};
+        const std::uint8_t h2{H2(hash)};
+        std::size_t offset{(hash >> 7U) & mask};
+        for (std::size_t step = ctrl_group_width;; step += ctrl_group_width)
+        {
+            const ctrl_group group{m_ctrl + offset};
+            for (std::uint32_t bits = group.Match(h2); bits != 0; bits &= bits - 1)
+            {
+                const std::size_t index{(offset + static_cast<std::size_t>(std::countr_zero(bits))) & mask};
+                if (m_eq(KeyOf(m_slots[index]), key)) [[likely]]
+                {
+                    return index;
+                }
+            }
+            if (group.MatchEmpty() != 0) [[likely]]
+            {
+                return npos;
+            }
+            offset = (offset + step) & mask;
+        }
+    }
+
+    std::size_t FindFree(const std::size_t hash) const noexcept
+    {
+        const std::size_t mask{m_capacity - 1};
+        std::size_t offset{(hash >> 7U) & mask};
+        for (std::size_t step = ctrl_group_width;; step += ctrl_group_width)
+        {
+            if (const std::uint32_t free{ctrl_group{m_ctrl + offset}.MatchFree()}; free != 0)
+            {
+                return (offset + static_cast<std::size_t>(std::countr_zero(free))) & mask;
+            }
+            offset = (offset + step) & mask;
+        }
+    }
+
+    void SetCtrl(const std::size_t index, const std::uint8_t ctrl) noexcept
+    {
+        m_ctrl[index] = ctrl;
+        if (index < ctrl_group_width - 1)
+        {
+            m_ctrl[m_capacity + index] = ctrl;
+        }
+    }
+
+    // a free slot for the hash, rehashing first when no empty slot is left; the slot stays free
+    // until CommitInsert
+    std::size_t PrepareInsert(const std::size_t hash)
+    {
+        if (m_growthLeft == 0)
+        {
+            // out of empty slots with the table at most 25/32 full: deleted slots took them, and
+            // rehashing in place drops those; otherwise grow
+            Rehash(m_capacity == 0 ? ctrl_group_width : m_size * 32 <= m_capacity * 25 ? m_capacity : 2 * m_capacity);
+        }
+        return FindFree(hash);
+    }
+
+    // marks the slot full once its element is constructed
+    void CommitInsert(const std::size_t index, const std::size_t hash) noexcept
+    {
+        m_growthLeft -= m_ctrl[index] == ctrl_empty ? 1 : 0;
+        SetCtrl(index, H2(hash));
+        ++m_size;
+    }
+
+    template <typename K>
+    std::size_t EraseKey(const K& key) noexcept
+    {
+        const std::size_t index{FindIndex(key, Mix(key))};
+        if (index == npos)
+        {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    // A slot can go back to empty when no probe can have passed it on a full group: the empty
+    // slots right before and after it leave less than a group of full slots around it.
+    void EraseAt(const std::size_t index) noexcept
+    {
+        std::destroy_at(m_slots + index);
+        --m_size;
+        const std::size_t mask{m_capacity - 1};
+        const std::uint32_t emptyBefore{ctrl_group{m_ctrl + ((index - ctrl_group_width) & mask)}.MatchEmpty()};
+        const std::uint32_t emptyAfter{ctrl_group{m_ctrl + index}.MatchEmpty()};
+        const int fullAround{std::countl_zero(static_cast<std::uint16_t>(emptyBefore)) + std::countr_zero(emptyAfter | 0x10000U)};
+        if (fullAround < static_cast<int>(ctrl_group_width))
+        {
+            SetCtrl(index, ctrl_empty);
+            ++m_growthLeft;
+        }
+        else
+        {
+            SetCtrl(index, ctrl_deleted);
+        }
+    }
+
+    // Elements are moved when that cannot throw and copied otherwise, and the old ones are only
+    // destroyed once every element is in the new table: if a copy throws, the new table is dropped
+    // and the old one is kept as it was.
+    void Rehash(const std::size_t capacity)
+    {
+        auto* const ctrl{new std::uint8_t[capacity + ctrl_group_width - 1]};
+        Element* slots{};
+        try
+        {
+            slots = std::allocator<Element>{}.allocate(capacity);
+        }
+        catch (...)
+        {
+            delete[] ctrl;
+            throw;
+        }
+
+        auto* const oldCtrl{std::exchange(m_ctrl, ctrl)};
+        Element* const oldSlots{std::exchange(m_slots, slots)};
+        const std::size_t oldCapacity{std::exchange(m_capacity, capacity)};
+        std::fill_n(m_ctrl, capacity + ctrl_group_width - 1, ctrl_empty);
+        try
+        {
+            for (std::size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] < ctrl_empty)
+                {
+                    const std::size_t index{FindFree(Mix(KeyOf(oldSlots[i])))};
+                    std::construct_at(m_slots + index, std::move_if_noexcept(oldSlots[i]));
+                    SetCtrl(index, oldCtrl[i]);
+                }
+            }
+        }
+        catch (...)
+        {
+            DestroyAll();
+            delete[] m_ctrl;
+            std::allocator<Element>{}.deallocate(m_slots, m_capacity);
+            m_ctrl     = oldCtrl;
+            m_slots    = oldSlots;
+            m_capacity = oldCapacity;
+            throw;
+        }
+
+        if constexpr (!std::is_trivially_destructible_v<Element>)
+        {
+            for (std::size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] < ctrl_empty)
+                {
+                    std::destroy_at(oldSlots + i);
+                }
+            }
+        }
+        m_growthLeft = MaxLoad(capacity) - m_size;
+        delete[] oldCtrl;
+        if (oldSlots != nullptr)
+        {
+            std::allocator<Element>{}.deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    void DestroyAll() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Element>)
+        {
+            for (std::size_t i = 0; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] < ctrl_empty)
+                {
+                    std::destroy_at(m_slots + i);
+                }
+            }
+        }
+    }
+
+    void Release() noexcept
+    {
+        if (m_capacity == 0)
+        {
+            return;
+        }
+        DestroyAll();
+        delete[] m_ctrl;
+        std::allocator<Element>{}.deallocate(m_slots, m_capacity);
+    }
+
+    [[no_unique_address]] Hash m_hash{};
+    [[no_unique_address]] Eq m_eq{};
+    std::uint8_t* m_ctrl{};
+    Element* m_slots{};
+    std::size_t m_capacity{};
+    std::size_t m_size{};
+    std::size_t m_growthLeft{};
+};
+} // namespace detail
+
+export template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class FlatHashMap : public detail::flat_table<Key, std::pair<Key, Value>, Hash, Eq>
+{
+    using base = detail::flat_table<Key, std::pair<Key, Value>, Hash, Eq>;
+
+  public:
+    using mapped_type = Value;
+    using typename base::iterator;
+
+    using base::base;
+
+    // the element for the key, constructed from args when the key is new
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args)
+    {
+        return Emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args)
+    {
+        return Emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> Insert(const std::pair<Key, Value>& element)
+    {
+        return Emplace(element.first, element.second);
+    }
+
+    std::pair<iterator, bool> Insert(std::pair<Key, Value>&& element)
+    {
+        return Emplace(std::move(element.first), std::move(element.second));
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> InsertOrAssign(const Key& key, V&& value)
+    {
+        auto result{Emplace(key, std::forward<V>(value))};
+        if (!result.second)
+        {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return Emplace(key).first->second;
+    }
+
+    Value& operator[](Key&& key)
+    {
+        return Emplace(std::move(key)).first->second;
+    }
+
+  private:
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> Emplace(K&& key, Args&&... args)
+    {
+        return this->EmplaceUnique(key, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+};
+
+export template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class FlatHashSet : public detail::flat_table<Key, Key, Hash, Eq>
+{
+    using base = detail::flat_table<Key, Key, Hash, Eq>;
+
+  public:
+    using typename base::iterator;
+
+    using base::base;
+
+    std::pair<iterator, bool> Insert(const Key& key)
+    {
+        return Emplace(key);
+    }
+
+    std::pair<iterator, bool> Insert(Key&& key)
+    {
+        return Emplace(std::move(key));
+    }
+
+  private:
+    template <typename K>
+    std::pair<iterator, bool> Emplace(K&& key)
+    {
+        return this->EmplaceUnique(key, std::forward<K>(key));
+    }
+};
+} // namespace fawn_algebra
@@ -4,8 +4,12 @@
 //
 
 module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
 
 export module FawnAlgebra:Hashing;
+import :CPU;
+import :SIMD;
 import std;
 
 namespace fawn_algebra
@@ -833,4 +837,1096 @@ export constexpr std::uint32_t HashBig(const void* key, std::size_t length, cons
     Final(a, b, c);
     return c;
 }
+
+// ---- XXH3 -------------------------------------------------------------------
+// XXH3 from xxHash 0.8 (Yann Collet, https://github.com/Cyan4973/xxHash), the 64 and 128-bit
+// variants with the default secret, bit for bit. Up to 240 bytes an input costs a handful of
+// 64 x 64 -> 128 bit multiply-folds and the whole hash is usable in constant expressions, so
+// string literals hash at compile time. Longer inputs run 64-byte stripes through eight 64-bit
+// accumulators, two, four or eight at a time on SSE2 / NEON, AVX2 and AVX-512.
+//
+//   Hash64(text, seed)     std::string_view, std::span<const std::byte> or pointer and length
+//   Hash128(text, seed)    the same inputs, to Hash128Value{low, high}
+//   Hasher                 the same hashes over input that arrives in pieces
+//   HashBatch(keys, out)   Hash64 of many fixed-size keys at once, a key per SIMD lane
+
+export struct Hash128Value
+{
+    std::uint64_t low;
+    std::uint64_t high;
+
+    constexpr bool operator==(const Hash128Value&) const = default;
+};
+
+namespace detail
+{
+struct wide_product
+{
+    std::uint64_t hi;
+    std::uint64_t lo;
+};
+
+// full 64 x 64 -> 128 bit product
+constexpr wide_product MulWide(const std::uint64_t a, const std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    const uint128 product{static_cast<uint128>(a) * b};
+    return {static_cast<std::uint64_t>(product >> 64U), static_cast<std::uint64_t>(product)};
+#else
+    const std::uint64_t aLo{a & 0xFFFFFFFFULL};
+    const std::uint64_t aHi{a >> 32U};
+    const std::uint64_t bLo{b & 0xFFFFFFFFULL};
+    const std::uint64_t bHi{b >> 32U};
+    const std::uint64_t ll{aLo * bLo};
+    const std::uint64_t lh{aLo * bHi};
+    const std::uint64_t hl{aHi * bLo};
+    const std::uint64_t hh{aHi * bHi};
+    const std::uint64_t mid{(ll >> 32U) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL)};
+    return {hh + (lh >> 32U) + (hl >> 32U) + (mid >> 32U), (mid << 32U) | (ll & 0xFFFFFFFFULL)};
+#endif
+}
+
+// both halves of the product folded into one word
+constexpr std::uint64_t MulFold(const std::uint64_t a, const std::uint64_t b) noexcept
+{
+    const wide_product product{MulWide(a, b)};
+    return product.hi ^ product.lo;
+}
+
+inline constexpr std::uint64_t xxh_prime32_1{0x9E3779B1U};
+inline constexpr std::uint64_t xxh_prime32_2{0x85EBCA77U};
+inline constexpr std::uint64_t xxh_prime32_3{0xC2B2AE3DU};
+inline constexpr std::uint64_t xxh_prime64_1{0x9E3779B185EBCA87ULL};
+inline constexpr std::uint64_t xxh_prime64_2{0xC2B2AE3D27D4EB4FULL};
+inline constexpr std::uint64_t xxh_prime64_3{0x165667B19E3779F9ULL};
+inline constexpr std::uint64_t xxh_prime64_4{0x85EBCA77C2B2AE63ULL};
+inline constexpr std::uint64_t xxh_prime64_5{0x27D4EB2F165667C5ULL};
+inline constexpr std::uint64_t xxh_prime_mx1{0x165667919E3779F9ULL};
+inline constexpr std::uint64_t xxh_prime_mx2{0x9FB21C651E98DF25ULL};
+
+inline constexpr std::size_t xxh3_stripe{64};
+inline constexpr std::size_t xxh3_secret_size{192};
+inline constexpr std::size_t xxh3_stripes_per_block{(xxh3_secret_size - xxh3_stripe) / 8};
+inline constexpr std::size_t xxh3_block{xxh3_stripe * xxh3_stripes_per_block};
+inline constexpr std::size_t xxh3_midsize_max{240};
+
+// secret offsets; the odd ones keep the secret words out of step with the accumulators
+inline constexpr std::size_t xxh3_last_stripe_secret{xxh3_secret_size - xxh3_stripe - 7};
+inline constexpr std::size_t xxh3_merge_secret{11};
+
+alignas(64) inline constexpr std::array<std::uint8_t, xxh3_secret_size> xxh3_secret{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e};
+
+using xxh3_secret_bytes  = std::array<std::uint8_t, xxh3_secret_size>;
+using xxh3_accumulators = std::array<std::uint64_t, 8>;
+
+inline constexpr xxh3_accumulators xxh3_initial_acc{xxh_prime32_3, xxh_prime64_1, xxh_prime64_2, xxh_prime64_3, xxh_prime64_4, xxh_prime32_2, xxh_prime64_5, xxh_prime32_1};
+
+// the byte types a key can be read through, also in constant expressions
+template <typename Byte>
+concept hash_byte = std::same_as<Byte, char> || std::same_as<Byte, unsigned char> || std::same_as<Byte, std::byte>;
+
+template <hash_byte Byte>
+constexpr std::uint64_t ReadLE64(const Byte* p) noexcept
+{
+    if consteval
+    {
+        std::uint64_t value{};
+        for (std::uint32_t i = 0; i < 8; ++i)
+        {
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(p[i])) << (8U * i);
+        }
+        return value;
+    }
+    else
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+}
+
+template <hash_byte Byte>
+constexpr std::uint32_t ReadLE32(const Byte* p) noexcept
+{
+    if consteval
+    {
+        std::uint32_t value{};
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(p[i])) << (8U * i);
+        }
+        return value;
+    }
+    else
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+}
+
+constexpr void WriteLE64(std::uint8_t* p, const std::uint64_t value) noexcept
+{
+    for (std::uint32_t i = 0; i < 8; ++i)
+    {
+        p[i] = static_cast<std::uint8_t>(value >> (8U * i));
+    }
+}
+
+template <hash_byte Byte>
+constexpr void CopyBytes(std::byte* to, const Byte* from, const std::size_t count) noexcept
+{
+    if consteval
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            to[i] = static_cast<std::byte>(static_cast<unsigned char>(from[i]));
+        }
+    }
+    else
+    {
+        if (count != 0)
+        {
+            std::memcpy(to, from, count);
+        }
+    }
+}
+
+constexpr std::uint64_t Xxh64Avalanche(std::uint64_t h) noexcept
+{
+    h ^= h >> 33U;
+    h *= xxh_prime64_2;
+    h ^= h >> 29U;
+    h *= xxh_prime64_3;
+    return h ^ (h >> 32U);
+}
+
+constexpr std::uint64_t Xxh3Avalanche(std::uint64_t h) noexcept
+{
+    h ^= h >> 37U;
+    h *= xxh_prime_mx1;
+    return h ^ (h >> 32U);
+}
+
+// Pelle Evensen's rrmxmx, for the 4 to 8 byte keys
+constexpr std::uint64_t Rrmxmx(std::uint64_t h, const std::uint64_t length) noexcept
+{
+    h ^= std::rotl(h, 49) ^ std::rotl(h, 24);
+    h *= xxh_prime_mx2;
+    h ^= (h >> 35U) + length;
+    h *= xxh_prime_mx2;
+    return h ^ (h >> 28U);
+}
+
+// first, middle and last byte and the length of a 1 to 3 byte key
+template <hash_byte Byte>
+constexpr std::uint32_t Combine1to3(const Byte* input, const std::size_t length) noexcept
+{
+    const auto byte{[input](const std::size_t i) { return static_cast<std::uint32_t>(static_cast<std::uint8_t>(input[i])); }};
+    return byte(0) << 16U | byte(length >> 1U) << 24U | byte(length - 1) | static_cast<std::uint32_t>(length) << 8U;
+}
+
+template <hash_byte Byte>
+constexpr std::uint64_t Mix16(const Byte* input, const std::uint8_t* secret, const std::uint64_t seed) noexcept
+{
+    return MulFold(ReadLE64(input) ^ (ReadLE64(secret) + seed), ReadLE64(input + 8) ^ (ReadLE64(secret + 8) - seed));
+}
+
+template <hash_byte Byte>
+constexpr Hash128Value Mix32(Hash128Value acc, const Byte* first, const Byte* second, const std::uint8_t* secret, const std::uint64_t seed) noexcept
+{
+    acc.low  += Mix16(first, secret, seed);
+    acc.low  ^= ReadLE64(second) + ReadLE64(second + 8);
+    acc.high += Mix16(second, secret + 16, seed);
+    acc.high ^= ReadLE64(first) + ReadLE64(first + 8);
+    return acc;
+}
+
+template <hash_byte Byte>
+constexpr std::uint64_t Xxh3Short64(const Byte* input, const std::size_t length, std::uint64_t seed) noexcept
+{
+    const std::uint8_t* secret{xxh3_secret.data()};
+    if (length > 8)
+    {
+        const std::uint64_t low{ReadLE64(input) ^ ((ReadLE64(secret + 24) ^ ReadLE64(secret + 32)) + seed)};
+        const std::uint64_t high{ReadLE64(input + length - 8) ^ ((ReadLE64(secret + 40) ^ ReadLE64(secret + 48)) - seed)};
+        return Xxh3Avalanche(length + std::byteswap(low) + high + MulFold(low, high));
+    }
+    if (length >= 4)
+    {
+        seed ^= static_cast<std::uint64_t>(std::byteswap(static_cast<std::uint32_t>(seed))) << 32U;
+        const std::uint64_t input64{ReadLE32(input + length - 4) + (static_cast<std::uint64_t>(ReadLE32(input)) << 32U)};
+        return Rrmxmx(input64 ^ ((ReadLE64(secret + 8) ^ ReadLE64(secret + 16)) - seed), length);
+    }
+    if (length > 0)
+    {
+        return Xxh64Avalanche(Combine1to3(input, length) ^ ((ReadLE32(secret) ^ ReadLE32(secret + 4)) + seed));
+    }
+    return Xxh64Avalanche(seed ^ ReadLE64(secret + 56) ^ ReadLE64(secret + 64));
+}
+
+// 17 to 240 bytes
+template <hash_byte Byte>
+constexpr std::uint64_t Xxh3Mid64(const Byte* input, const std::size_t length, const std::uint64_t seed) noexcept
+{
+    const std::uint8_t* secret{xxh3_secret.data()};
+    std::uint64_t acc{length * xxh_prime64_1};
+    if (length <= 128)
+    {
+        // 16-byte pairs from both ends inward, overlapping in the middle
+        for (std::size_t i = (length - 1) / 32 + 1; i-- > 0;)
+        {
+            acc += Mix16(input + 16 * i, secret + 32 * i, seed);
+            acc += Mix16(input + length - 16 * (i + 1), secret + 32 * i + 16, seed);
+        }
+        return Xxh3Avalanche(acc);
+    }
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        acc += Mix16(input + 16 * i, secret + 16 * i, seed);
+    }
+    std::uint64_t tail{Mix16(input + length - 16, secret + 136 - 17, seed)};
+    for (std::size_t i = 8; i < length / 16; ++i)
+    {
+        tail += Mix16(input + 16 * i, secret + 16 * (i - 8) + 3, seed);
+    }
+    return Xxh3Avalanche(Xxh3Avalanche(acc) + tail);
+}
+
+constexpr Hash128Value Xxh3Fold128(const Hash128Value acc, const std::size_t length, const std::uint64_t seed) noexcept
+{
+    const std::uint64_t high{acc.low * xxh_prime64_1 + acc.high * xxh_prime64_4 + (length - seed) * xxh_prime64_2};
+    return {Xxh3Avalanche(acc.low + acc.high), 0 - Xxh3Avalanche(high)};
+}
+
+template <hash_byte Byte>
+constexpr Hash128Value Xxh3Short128(const Byte* input, const std::size_t length, std::uint64_t seed) noexcept
+{
+    const std::uint8_t* secret{xxh3_secret.data()};
+    if (length > 8)
+    {
+        const std::uint64_t low{ReadLE64(input)};
+        std::uint64_t high{ReadLE64(input + length - 8)};
+        wide_product m{MulWide(low ^ high ^ ((ReadLE64(secret + 32) ^ ReadLE64(secret + 40)) - seed), xxh_prime64_1)};
+        m.lo += static_cast<std::uint64_t>(length - 1) << 54U;
+        high ^= (ReadLE64(secret + 48) ^ ReadLE64(secret + 56)) + seed;
+        m.hi += high + (high & 0xFFFFFFFFULL) * (xxh_prime32_2 - 1);
+        m.lo ^= std::byteswap(m.hi);
+        wide_product h{MulWide(m.lo, xxh_prime64_2)};
+        h.hi += m.hi * xxh_prime64_2;
+        return {Xxh3Avalanche(h.lo), Xxh3Avalanche(h.hi)};
+    }
+    if (length >= 4)
+    {
+        seed ^= static_cast<std::uint64_t>(std::byteswap(static_cast<std::uint32_t>(seed))) << 32U;
+        const std::uint64_t input64{ReadLE32(input) + (static_cast<std::uint64_t>(ReadLE32(input + length - 4)) << 32U)};
+        // the length shifted up keeps the multiplier odd
+        wide_product m{MulWide(input64 ^ ((ReadLE64(secret + 16) ^ ReadLE64(secret + 24)) + seed), xxh_prime64_1 + (length << 2U))};
+        m.hi += m.lo << 1U;
+        m.lo ^= m.hi >> 3U;
+        m.lo ^= m.lo >> 35U;
+        m.lo *= xxh_prime_mx2;
+        m.lo ^= m.lo >> 28U;
+        return {m.lo, Xxh3Avalanche(m.hi)};
+    }
+    if (length > 0)
+    {
+        const std::uint32_t low{Combine1to3(input, length)};
+        const std::uint32_t high{std::rotl(std::byteswap(low), 13)};
+        return {Xxh64Avalanche(low ^ ((ReadLE32(secret) ^ ReadLE32(secret + 4)) + seed)),
+                Xxh64Avalanche(high ^ ((ReadLE32(secret + 8) ^ ReadLE32(secret + 12)) - seed))};
+    }
+    return {Xxh64Avalanche(seed ^ ReadLE64(secret + 64) ^ ReadLE64(secret + 72)), Xxh64Avalanche(seed ^ ReadLE64(secret + 80) ^ ReadLE64(secret + 88))};
+}
+
+template <hash_byte Byte>
+constexpr Hash128Value Xxh3Mid128(const Byte* input, const std::size_t length, const std::uint64_t seed) noexcept
+{
+    const std::uint8_t* secret{xxh3_secret.data()};
+    Hash128Value acc{length * xxh_prime64_1, 0};
+    if (length <= 128)
+    {
+        for (std::size_t i = (length - 1) / 32 + 1; i-- > 0;)
+        {
+            acc = Mix32(acc, input + 16 * i, input + length - 16 * (i + 1), secret + 32 * i, seed);
+        }
+        return Xxh3Fold128(acc, length, seed);
+    }
+    for (std::size_t i = 32; i < 160; i += 32)
+    {
+        acc = Mix32(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+    }
+    acc = {Xxh3Avalanche(acc.low), Xxh3Avalanche(acc.high)};
+    for (std::size_t i = 160; i <= length; i += 32)
+    {
+        acc = Mix32(acc, input + i - 32, input + i - 16, secret + 3 + i - 160, seed);
+    }
+    acc = Mix32(acc, input + length - 16, input + length - 32, secret + 136 - 17 - 16, 0 - seed);
+    return Xxh3Fold128(acc, length, seed);
+}
+
+// the default secret with the seed added to and subtracted from alternate words
+constexpr xxh3_secret_bytes Xxh3SeededSecret(const std::uint64_t seed) noexcept
+{
+    xxh3_secret_bytes secret{};
+    for (std::size_t i = 0; i < xxh3_secret_size; i += 16)
+    {
+        WriteLE64(secret.data() + i, ReadLE64(xxh3_secret.data() + i) + seed);
+        WriteLE64(secret.data() + i + 8, ReadLE64(xxh3_secret.data() + i + 8) - seed);
+    }
+    return secret;
+}
+
+// Accumulator policies for Xxh3Consume. Each accumulator takes the product of the low and high
+// half of its keyed input word, plus the neighbouring input word unkeyed, so a zero product
+// cannot erase a lane.
+struct xxh3_scalar_lanes
+{
+    xxh3_accumulators acc{xxh3_initial_acc};
+
+    template <hash_byte Byte>
+    constexpr void Stripe(const Byte* input, const std::uint8_t* secret) noexcept
+    {
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            const std::uint64_t data{ReadLE64(input + 8 * i)};
+            const std::uint64_t key{data ^ ReadLE64(secret + 8 * i)};
+            acc[i ^ 1] += data;
+            acc[i]     += (key & 0xFFFFFFFFULL) * (key >> 32U);
+        }
+    }
+
+    constexpr void Scramble(const std::uint8_t* secret) noexcept
+    {
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            acc[i] = (acc[i] ^ (acc[i] >> 47U) ^ ReadLE64(secret + 8 * i)) * xxh_prime32_1;
+        }
+    }
+};
+
+// MulEven is simd::detail::mul_even in the form the kernel's ISA can inline
+template <int N, auto MulEven>
+struct xxh3_simd_lanes
+{
+    using lanes = simd::detail::raw<std::uint64_t, N>;
+
+    lanes acc[8 / N];
+
+    BALBINO_FORCE_INLINE explicit xxh3_simd_lanes(const xxh3_accumulators& from) noexcept
+    {
+        std::memcpy(acc, from.data(), sizeof(acc));
+    }
+
+    BALBINO_FORCE_INLINE void Store(xxh3_accumulators& to) const noexcept
+    {
+        std::memcpy(to.data(), acc, sizeof(acc));
+    }
+
+    template <hash_byte Byte>
+    BALBINO_FORCE_INLINE static lanes Load(const Byte* p) noexcept
+    {
+        lanes value;
+        std::memcpy(&value, p, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                value[i] = std::byteswap(value[i]);
+            }
+        }
+        return value;
+    }
+
+    template <int... Is>
+    BALBINO_FORCE_INLINE static lanes SwapPairs(const lanes value, std::integer_sequence<int, Is...>) noexcept
+    {
+        return __builtin_shufflevector(value, value, (Is ^ 1)...);
+    }
+
+    template <hash_byte Byte>
+    BALBINO_FORCE_INLINE void Stripe(const Byte* input, const std::uint8_t* secret) noexcept
+    {
+        for (int j = 0; j < 8 / N; ++j)
+        {
+            const lanes data{Load(input + 8 * N * j)};
+            const lanes key{data ^ Load(secret + 8 * N * j)};
+            acc[j] += SwapPairs(data, std::make_integer_sequence<int, N>{}) + MulEven(key, lanes(key >> 32U));
+        }
+    }
+
+    // 64 x 32 bit multiply out of two 32 x 32 -> 64 ones
+    BALBINO_FORCE_INLINE void Scramble(const std::uint8_t* secret) noexcept
+    {
+        lanes prime;
+        for (int i = 0; i < N; ++i)
+        {
+            prime[i] = xxh_prime32_1;
+        }
+        for (int j = 0; j < 8 / N; ++j)
+        {
+            const lanes mixed{acc[j] ^ (acc[j] >> 47U) ^ Load(secret + 8 * N * j)};
+            acc[j] = MulEven(mixed, prime) + (MulEven(lanes(mixed >> 32U), prime) << 32U);
+        }
+    }
+};
+
+// `stripes` stripes onto accumulators that are `stripesSoFar` stripes into their current block,
+// scrambling at every block boundary; returns the stripes into the block afterwards. A whole
+// input is (length - 1) / 64 stripes from zero, then its final 64 bytes again with a shifted
+// secret, as a one-stripe call.
+template <typename Lanes, hash_byte Byte>
+BALBINO_FORCE_INLINE constexpr std::size_t Xxh3ConsumeStripes(Lanes& lanes, std::size_t stripesSoFar, const Byte* input, std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    // finish the current block; whole blocks after it have a fixed stripe count, so they unroll
+    const std::size_t head{std::min(stripes, xxh3_stripes_per_block - stripesSoFar)};
+    for (std::size_t s = 0; s < head; ++s)
+    {
+        lanes.Stripe(input + s * xxh3_stripe, secret + 8 * (stripesSoFar + s));
+    }
+    stripesSoFar += head;
+    if (stripesSoFar < xxh3_stripes_per_block)
+    {
+        return stripesSoFar;
+    }
+    lanes.Scramble(secret + xxh3_secret_size - xxh3_stripe);
+    input   += head * xxh3_stripe;
+    stripes -= head;
+    for (; stripes >= xxh3_stripes_per_block; stripes -= xxh3_stripes_per_block, input += xxh3_block)
+    {
+        for (std::size_t s = 0; s < xxh3_stripes_per_block; ++s)
+        {
+            lanes.Stripe(input + s * xxh3_stripe, secret + 8 * s);
+        }
+        lanes.Scramble(secret + xxh3_secret_size - xxh3_stripe);
+    }
+    for (std::size_t s = 0; s < stripes; ++s)
+    {
+        lanes.Stripe(input + s * xxh3_stripe, secret + 8 * s);
+    }
+    return stripes;
+}
+
+using Xxh3StripesFn = std::size_t (*)(xxh3_accumulators&, std::size_t, const std::byte*, std::size_t, const std::uint8_t*) noexcept;
+
+template <int N, auto MulEven>
+BALBINO_FORCE_INLINE std::size_t Xxh3StripesKernel(xxh3_accumulators& acc, std::size_t stripesSoFar, const std::byte* input, const std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    xxh3_simd_lanes<N, MulEven> lanes{acc};
+    stripesSoFar = Xxh3ConsumeStripes(lanes, stripesSoFar, input, stripes, secret);
+    lanes.Store(acc);
+    return stripesSoFar;
+}
+
+inline std::size_t Xxh3StripesBaseline(xxh3_accumulators& acc, const std::size_t stripesSoFar, const std::byte* input, const std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    return Xxh3StripesKernel<2, simd::detail::mul_even<simd::detail::raw<std::uint64_t, 2>>>(acc, stripesSoFar, input, stripes, secret);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+BALBINO_TARGET_AVX2 inline std::size_t Xxh3StripesAvx2(xxh3_accumulators& acc, const std::size_t stripesSoFar, const std::byte* input, const std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    return Xxh3StripesKernel<4, simd::detail::mul_even_avx2>(acc, stripesSoFar, input, stripes, secret);
+}
+
+BALBINO_TARGET_AVX512 inline std::size_t Xxh3StripesAvx512(xxh3_accumulators& acc, const std::size_t stripesSoFar, const std::byte* input, const std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    return Xxh3StripesKernel<8, simd::detail::mul_even_avx512>(acc, stripesSoFar, input, stripes, secret);
+}
+#endif
+
+inline Xxh3StripesFn Xxh3StripesKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const Xxh3StripesFn kernel = DispatchTable<Xxh3StripesFn>{Xxh3StripesBaseline, nullptr, Xxh3StripesAvx2, Xxh3StripesAvx512}.Select(ActiveSimdLevel());
+#else
+    static const Xxh3StripesFn kernel = Xxh3StripesBaseline;
+#endif
+    return kernel;
+}
+
+template <hash_byte Byte>
+constexpr std::size_t Xxh3Stripes(xxh3_accumulators& acc, const std::size_t stripesSoFar, const Byte* input, const std::size_t stripes, const std::uint8_t* secret) noexcept
+{
+    if consteval
+    {
+        xxh3_scalar_lanes lanes{acc};
+        const std::size_t after{Xxh3ConsumeStripes(lanes, stripesSoFar, input, stripes, secret)};
+        acc = lanes.acc;
+        return after;
+    }
+    else
+    {
+        return Xxh3StripesKernelFor()(acc, stripesSoFar, reinterpret_cast<const std::byte*>(input), stripes, secret);
+    }
+}
+
+// length > 240
+template <hash_byte Byte>
+constexpr xxh3_accumulators Xxh3Accumulate(const Byte* input, const std::size_t length, const std::uint8_t* secret) noexcept
+{
+    xxh3_accumulators acc{xxh3_initial_acc};
+    Xxh3Stripes(acc, 0, input, (length - 1) / xxh3_stripe, secret);
+    Xxh3Stripes(acc, 0, input + length - xxh3_stripe, 1, secret + xxh3_last_stripe_secret);
+    return acc;
+}
+
+constexpr std::uint64_t Xxh3Merge(const xxh3_accumulators& acc, const std::uint8_t* secret, std::uint64_t start) noexcept
+{
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        start += MulFold(acc[2 * i] ^ ReadLE64(secret + 16 * i), acc[2 * i + 1] ^ ReadLE64(secret + 16 * i + 8));
+    }
+    return Xxh3Avalanche(start);
+}
+
+constexpr std::uint64_t Xxh3Final64(const xxh3_accumulators& acc, const std::uint8_t* secret, const std::uint64_t length) noexcept
+{
+    return Xxh3Merge(acc, secret + xxh3_merge_secret, length * xxh_prime64_1);
+}
+
+constexpr Hash128Value Xxh3Final128(const xxh3_accumulators& acc, const std::uint8_t* secret, const std::uint64_t length) noexcept
+{
+    return {Xxh3Merge(acc, secret + xxh3_merge_secret, length * xxh_prime64_1),
+            Xxh3Merge(acc, secret + xxh3_secret_size - sizeof(acc) - xxh3_merge_secret, ~(length * xxh_prime64_2))};
+}
+
+template <hash_byte Byte>
+constexpr std::uint64_t Xxh3Hash64(const Byte* input, const std::size_t length, const std::uint64_t seed) noexcept
+{
+    if (length <= 16)
+    {
+        return Xxh3Short64(input, length, seed);
+    }
+    if (length <= xxh3_midsize_max)
+    {
+        return Xxh3Mid64(input, length, seed);
+    }
+    if (seed == 0)
+    {
+        return Xxh3Final64(Xxh3Accumulate(input, length, xxh3_secret.data()), xxh3_secret.data(), length);
+    }
+    const xxh3_secret_bytes secret{Xxh3SeededSecret(seed)};
+    return Xxh3Final64(Xxh3Accumulate(input, length, secret.data()), secret.data(), length);
+}
+
+template <hash_byte Byte>
+constexpr Hash128Value Xxh3Hash128(const Byte* input, const std::size_t length, const std::uint64_t seed) noexcept
+{
+    if (length <= 16)
+    {
+        return Xxh3Short128(input, length, seed);
+    }
+    if (length <= xxh3_midsize_max)
+    {
+        return Xxh3Mid128(input, length, seed);
+    }
+    if (seed == 0)
+    {
+        return Xxh3Final128(Xxh3Accumulate(input, length, xxh3_secret.data()), xxh3_secret.data(), length);
+    }
+    const xxh3_secret_bytes secret{Xxh3SeededSecret(seed)};
+    return Xxh3Final128(Xxh3Accumulate(input, length, secret.data()), secret.data(), length);
+}
+} // namespace detail
+
+export constexpr std::uint64_t Hash64(const std::string_view text, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash64(text.data(), text.size(), seed);
+}
+
+export constexpr std::uint64_t Hash64(const std::span<const std::byte> data, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash64(data.data(), data.size(), seed);
+}
+
+export inline std::uint64_t Hash64(const void* key, const std::size_t length, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash64(static_cast<const std::byte*>(key), length, seed);
+}
+
+export constexpr Hash128Value Hash128(const std::string_view text, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash128(text.data(), text.size(), seed);
+}
+
+export constexpr Hash128Value Hash128(const std::span<const std::byte> data, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash128(data.data(), data.size(), seed);
+}
+
+export inline Hash128Value Hash128(const void* key, const std::size_t length, const std::uint64_t seed = 0) noexcept
+{
+    return detail::Xxh3Hash128(static_cast<const std::byte*>(key), length, seed);
+}
+
+// Streaming XXH3: Update with the input in pieces of any size, then Finalize gives what Hash64
+// (Finalize128: Hash128) gives for all of it at once with the same seed. Up to 256 bytes are
+// buffered to find the stripe boundaries and the final 64 bytes; longer pieces go through the
+// stripe kernel in place, so a file can be hashed as it is read. Finalizing leaves the state
+// alone and more input may follow.
+export class Hasher
+{
+  public:
+    constexpr explicit Hasher(const std::uint64_t seed = 0) noexcept
+        : m_secret{detail::Xxh3SeededSecret(seed)}
+        , m_seed{seed}
+    {
+    }
+
+    constexpr void Reset(const std::uint64_t seed = 0) noexcept
+    {
+        *this = Hasher{seed};
+    }
+
+    constexpr void Update(const std::span<const std::byte> data) noexcept
+    {
+        Append(data.data(), data.size());
+    }
+
+    constexpr void Update(const std::string_view text) noexcept
+    {
+        Append(text.data(), text.size());
+    }
+
+    void Update(const void* data, const std::size_t length) noexcept
+    {
+        Append(static_cast<const std::byte*>(data), length);
+    }
+
+    [[nodiscard]] constexpr std::uint64_t Length() const noexcept
+    {
+        return m_length;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t Finalize() const noexcept
+    {
+        if (m_length <= detail::xxh3_midsize_max)
+        {
+            return detail::Xxh3Hash64(m_buffer.data(), static_cast<std::size_t>(m_length), m_seed);
+        }
+        return detail::Xxh3Final64(Digest(), m_secret.data(), m_length);
+    }
+
+    [[nodiscard]] constexpr Hash128Value Finalize128() const noexcept
+    {
+        if (m_length <= detail::xxh3_midsize_max)
+        {
+            return detail::Xxh3Hash128(m_buffer.data(), static_cast<std::size_t>(m_length), m_seed);
+        }
+        return detail::Xxh3Final128(Digest(), m_secret.data(), m_length);
+    }
+
+  private:
+    static constexpr std::size_t buffer_size{4 * detail::xxh3_stripe};
+
+    template <detail::hash_byte Byte>
+    constexpr void Append(const Byte* input, std::size_t length) noexcept
+    {
+        m_length += length;
+        if (length <= buffer_size - m_buffered)
+        {
+            detail::CopyBytes(m_buffer.data() + m_buffered, input, length);
+            m_buffered += length;
+            return;
+        }
+
+        // the stripes of a full buffer are consumed only once more input follows them, since the
+        // last stripe of the whole input is hashed differently
+        if (m_buffered != 0)
+        {
+            const std::size_t fill{buffer_size - m_buffered};
+            detail::CopyBytes(m_buffer.data() + m_buffered, input, fill);
+            input  += fill;
+            length -= fill;
+            m_stripes = detail::Xxh3Stripes(m_acc, m_stripes, m_buffer.data(), buffer_size / detail::xxh3_stripe, m_secret.data());
+        }
+        if (length > buffer_size)
+        {
+            const std::size_t stripes{(length - 1) / detail::xxh3_stripe};
+            m_stripes = detail::Xxh3Stripes(m_acc, m_stripes, input, stripes, m_secret.data());
+            input  += stripes * detail::xxh3_stripe;
+            length -= stripes * detail::xxh3_stripe;
+            // the final 64 bytes may start in this piece
+            detail::CopyBytes(m_buffer.data() + buffer_size - detail::xxh3_stripe, input - detail::xxh3_stripe, detail::xxh3_stripe);
+        }
+        detail::CopyBytes(m_buffer.data(), input, length);
+        m_buffered = length;
+    }
+
+    // the accumulators once the buffered stripes and the final 64 bytes are in; m_length > 240
+    constexpr detail::xxh3_accumulators Digest() const noexcept
+    {
+        detail::xxh3_accumulators acc{m_acc};
+        if (m_buffered >= detail::xxh3_stripe)
+        {
+            detail::Xxh3Stripes(acc, m_stripes, m_buffer.data(), (m_buffered - 1) / detail::xxh3_stripe, m_secret.data());
+            detail::Xxh3Stripes(acc, 0, m_buffer.data() + m_buffered - detail::xxh3_stripe, 1, m_secret.data() + detail::xxh3_last_stripe_secret);
+        }
+        else
+        {
+            // the tail of the previous buffer, then the buffered bytes
+            std::array<std::byte, detail::xxh3_stripe> last{};
+            const std::size_t carried{detail::xxh3_stripe - m_buffered};
+            detail::CopyBytes(last.data(), m_buffer.data() + buffer_size - carried, carried);
+            detail::CopyBytes(last.data() + carried, m_buffer.data(), m_buffered);
+            detail::Xxh3Stripes(acc, 0, last.data(), 1, m_secret.data() + detail::xxh3_last_stripe_secret);
+        }
+        return acc;
+    }
+
+    detail::xxh3_accumulators m_acc{detail::xxh3_initial_acc};
+    detail::xxh3_secret_bytes m_secret;
+    std::array<std::byte, buffer_size> m_buffer{};
+    std::uint64_t m_seed;
+    std::uint64_t m_length{};
+    std::size_t m_buffered{};
+    std::size_t m_stripes{};
+};
+
+namespace detail
+{
+// Hash64 of N keys of Size bytes side by side, key i in lane i. Size is known at compile time,
+// so only its branch of the short and mid-size hashes is left, and the secret words with the
+// seed folded in are splatted once per batch. The 64 x 64 -> 128 bit products are put together
+// from four 32 x 32 -> 64 bit ones. Size <= 128.
+template <std::size_t Size, int N, auto MulEven>
+struct xxh3_batch_lanes
+{
+    using lanes = simd::detail::raw<std::uint64_t, N>;
+
+    // Mix16 calls, two keyed secret words each; the short keys use one or two words
+    static constexpr std::size_t mixes{Size <= 16 ? 1 : 2 * ((Size - 1) / 32 + 1)};
+
+    lanes key[2 * mixes];
+
+    BALBINO_FORCE_INLINE explicit xxh3_batch_lanes(std::uint64_t seed) noexcept
+    {
+        const std::uint8_t* secret{xxh3_secret.data()};
+        if constexpr (Size <= 3)
+        {
+            key[0] = Splat((ReadLE32(secret) ^ ReadLE32(secret + 4)) + seed);
+        }
+        else if constexpr (Size <= 8)
+        {
+            seed ^= static_cast<std::uint64_t>(std::byteswap(static_cast<std::uint32_t>(seed))) << 32U;
+            key[0] = Splat((ReadLE64(secret + 8) ^ ReadLE64(secret + 16)) - seed);
+        }
+        else if constexpr (Size <= 16)
+        {
+            key[0] = Splat((ReadLE64(secret + 24) ^ ReadLE64(secret + 32)) + seed);
+            key[1] = Splat((ReadLE64(secret + 40) ^ ReadLE64(secret + 48)) - seed);
+        }
+        else
+        {
+            for (std::size_t j = 0; j < mixes; ++j)
+            {
+                key[2 * j]     = Splat(ReadLE64(secret + 16 * j) + seed);
+                key[2 * j + 1] = Splat(ReadLE64(secret + 16 * j + 8) - seed);
+            }
+        }
+    }
+
+    BALBINO_FORCE_INLINE static lanes Splat(const std::uint64_t value) noexcept
+    {
+        lanes out;
+        for (int i = 0; i < N; ++i)
+        {
+            out[i] = value;
+        }
+        return out;
+    }
+
+    // Key words for the lanes, from keys that are not a power-of-two number of words: each lane
+    // read on its own, built up from pairs so it stays in registers
+    struct strided
+    {
+        const std::byte* keys;
+
+        template <int M, auto Read>
+        BALBINO_FORCE_INLINE static simd::detail::raw<std::uint64_t, M> Gather(const std::byte* from, const std::size_t offset) noexcept
+        {
+            if constexpr (M == 2)
+            {
+                return simd::detail::raw<std::uint64_t, 2>{Read(from + offset), Read(from + Size + offset)};
+            }
+            else
+            {
+                return Concat<M / 2>(Gather<M / 2, Read>(from, offset), Gather<M / 2, Read>(from + M / 2 * Size, offset), std::make_integer_sequence<int, M>{});
+            }
+        }
+
+        template <int M, int... Is>
+        BALBINO_FORCE_INLINE static simd::detail::raw<std::uint64_t, 2 * M> Concat(const simd::detail::raw<std::uint64_t, M> low, const simd::detail::raw<std::uint64_t, M> high,
+                                                                                    std::integer_sequence<int, Is...>) noexcept
+        {
+            return __builtin_shufflevector(low, high, Is...);
+        }
+
+        BALBINO_FORCE_INLINE lanes Load64(const std::size_t offset) const noexcept
+        {
+            return Gather<N, [](const std::byte* p) noexcept { return ReadLE64(p); }>(keys, offset);
+        }
+
+        BALBINO_FORCE_INLINE lanes Load32(const std::size_t offset) const noexcept
+        {
+            return Gather<N, [](const std::byte* p) noexcept { return static_cast<std::uint64_t>(ReadLE32(p)); }>(keys, offset);
+        }
+    };
+
+    // ... and from keys of 1, 2, 4, 8 or 16 words: whole vectors in, then rounds of even / odd
+    // splits until every vector holds one word of every key
+    static constexpr bool transposable{Size % 8 == 0 && std::has_single_bit(Size / 8)};
+
+    struct transposed
+    {
+        lanes word[Size / 8];
+
+        BALBINO_FORCE_INLINE explicit transposed(const std::byte* keys) noexcept
+        {
+            lanes rows[Size / 8];
+            for (std::size_t k = 0; k < Size / 8; ++k)
+            {
+                rows[k] = xxh3_simd_lanes<N, MulEven>::Load(keys + k * sizeof(lanes));
+            }
+            Split<Size / 8>(rows, word);
+        }
+
+        // in: the words of the keys one after another, W of them per key; out: W columns
+        template <std::size_t W>
+        BALBINO_FORCE_INLINE static void Split(const lanes* in, lanes* out) noexcept
+        {
+            if constexpr (W == 1)
+            {
+                out[0] = in[0];
+            }
+            else
+            {
+                lanes even[W / 2];
+                lanes odd[W / 2];
+                for (std::size_t j = 0; j < W / 2; ++j)
+                {
+                    even[j] = Pick<0>(in[2 * j], in[2 * j + 1], std::make_integer_sequence<int, N>{});
+                    odd[j]  = Pick<1>(in[2 * j], in[2 * j + 1], std::make_integer_sequence<int, N>{});
+                }
+                lanes evenWords[W / 2];
+                lanes oddWords[W / 2];
+                Split<W / 2>(even, evenWords);
+                Split<W / 2>(odd, oddWords);
+                for (std::size_t w = 0; w < W / 2; ++w)
+                {
+                    out[2 * w]     = evenWords[w];
+                    out[2 * w + 1] = oddWords[w];
+                }
+            }
+        }
+
+        template <int First, int... Is>
+        BALBINO_FORCE_INLINE static lanes Pick(const lanes low, const lanes high, std::integer_sequence<int, Is...>) noexcept
+        {
+            return __builtin_shufflevector(low, high, (2 * Is + First)...);
+        }
+
+        BALBINO_FORCE_INLINE lanes Load64(const std::size_t offset) const noexcept
+        {
+            return word[offset / 8];
+        }
+
+        // offset % 8 is 0 or 4
+        BALBINO_FORCE_INLINE lanes Load32(const std::size_t offset) const noexcept
+        {
+            return (word[offset / 8] >> (8U * (offset % 8))) & 0xFFFFFFFFULL;
+        }
+    };
+
+    template <int... Is>
+    BALBINO_FORCE_INLINE static lanes Byteswap(const lanes value, std::integer_sequence<int, Is...>) noexcept
+    {
+        using bytes = simd::detail::raw<std::uint8_t, 8 * N>;
+        const bytes b{std::bit_cast<bytes>(value)};
+        return std::bit_cast<lanes>(bytes(__builtin_shufflevector(b, b, (Is ^ 7)...)));
+    }
+
+    BALBINO_FORCE_INLINE static lanes MulFold(const lanes a, const lanes b) noexcept
+    {
+        const lanes aHigh{a >> 32U};
+        const lanes bHigh{b >> 32U};
+        const lanes ll{MulEven(a, b)};
+        const lanes lh{MulEven(a, bHigh)};
+        const lanes hl{MulEven(aHigh, b)};
+        const lanes hh{MulEven(aHigh, bHigh)};
+        const lanes cross{(ll >> 32U) + (lh & 0xFFFFFFFFULL) + hl};
+        return ((cross << 32U) | (ll & 0xFFFFFFFFULL)) ^ (hh + (lh >> 32U) + (cross >> 32U));
+    }
+
+    BALBINO_FORCE_INLINE static lanes Xxh64Avalanche(lanes h) noexcept
+    {
+        h ^= h >> 33U;
+        h *= Splat(xxh_prime64_2);
+        h ^= h >> 29U;
+        h *= Splat(xxh_prime64_3);
+        return h ^ (h >> 32U);
+    }
+
+    BALBINO_FORCE_INLINE static lanes Xxh3Avalanche(lanes h) noexcept
+    {
+        h ^= h >> 37U;
+        h *= Splat(xxh_prime_mx1);
+        return h ^ (h >> 32U);
+    }
+
+    BALBINO_FORCE_INLINE static lanes Rrmxmx(lanes h) noexcept
+    {
+        h ^= (h << 49U | h >> 15U) ^ (h << 24U | h >> 40U);
+        h *= Splat(xxh_prime_mx2);
+        h ^= (h >> 35U) + Size;
+        h *= Splat(xxh_prime_mx2);
+        return h ^ (h >> 28U);
+    }
+
+    template <typename Words>
+    BALBINO_FORCE_INLINE lanes Mix16(const Words& words, const std::size_t offset, const std::size_t mix) const noexcept
+    {
+        return MulFold(words.Load64(offset) ^ key[2 * mix], words.Load64(offset + 8) ^ key[2 * mix + 1]);
+    }
+
+    // Xxh3Short64 and Xxh3Mid64 for length == Size
+    BALBINO_FORCE_INLINE lanes Hash(const std::byte* keys) const noexcept
+    {
+        if constexpr (Size <= 3)
+        {
+            lanes combined;
+            for (int i = 0; i < N; ++i)
+            {
+                combined[i] = Combine1to3(keys + static_cast<std::size_t>(i) * Size, Size);
+            }
+            return Xxh64Avalanche(combined ^ key[0]);
+        }
+        else if constexpr (transposable)
+        {
+            return Hash(transposed{keys});
+        }
+        else
+        {
+            return Hash(strided{keys});
+        }
+    }
+
+    template <typename Words>
+    BALBINO_FORCE_INLINE lanes Hash(const Words& words) const noexcept
+    {
+        if constexpr (Size <= 8)
+        {
+            return Rrmxmx((words.Load32(Size - 4) + (words.Load32(0) << 32U)) ^ key[0]);
+        }
+        else if constexpr (Size <= 16)
+        {
+            const lanes low{words.Load64(0) ^ key[0]};
+            const lanes high{words.Load64(Size - 8) ^ key[1]};
+            return Xxh3Avalanche(Splat(Size) + Byteswap(low, std::make_integer_sequence<int, 8 * N>{}) + high + MulFold(low, high));
+        }
+        else
+        {
+            lanes acc{Splat(Size * xxh_prime64_1)};
+            for (std::size_t i = mixes / 2; i-- > 0;)
+            {
+                acc += Mix16(words, 16 * i, 2 * i);
+                acc += Mix16(words, Size - 16 * (i + 1), 2 * i + 1);
+            }
+            return Xxh3Avalanche(acc);
+        }
+    }
+};
+
+using Xxh3BatchFn = void (*)(const std::byte*, std::size_t, std::uint64_t*, std::uint64_t) noexcept;
+
+// two groups of N keys in flight, then the leftover keys one at a time
+template <std::size_t Size, int N, auto MulEven>
+BALBINO_FORCE_INLINE void Xxh3BatchKernel(const std::byte* keys, const std::size_t count, std::uint64_t* out, const std::uint64_t seed) noexcept
+{
+    using lanes = xxh3_batch_lanes<Size, N, MulEven>::lanes;
+    const xxh3_batch_lanes<Size, N, MulEven> batch{seed};
+    std::size_t i{};
+    for (; i + 2 * N <= count; i += 2 * N)
+    {
+        const lanes first{batch.Hash(keys + i * Size)};
+        const lanes second{batch.Hash(keys + (i + N) * Size)};
+        std::memcpy(out + i, &first, sizeof(first));
+        std::memcpy(out + i + N, &second, sizeof(second));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = Xxh3Hash64(keys + i * Size, Size, seed);
+    }
+}
+
+// two lanes lose to the scalar 64 x 64 -> 128 bit multiply, so SSE2 and NEON hash key by key
+template <std::size_t Size>
+void Xxh3BatchBaseline(const std::byte* keys, const std::size_t count, std::uint64_t* out, const std::uint64_t seed) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = Xxh3Hash64(keys + i * Size, Size, seed);
+    }
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+template <std::size_t Size>
+BALBINO_TARGET_AVX2 void Xxh3BatchAvx2(const std::byte* keys, const std::size_t count, std::uint64_t* out, const std::uint64_t seed) noexcept
+{
+    Xxh3BatchKernel<Size, 4, simd::detail::mul_even_avx2>(keys, count, out, seed);
+}
+
+template <std::size_t Size>
+BALBINO_TARGET_AVX512 void Xxh3BatchAvx512(const std::byte* keys, const std::size_t count, std::uint64_t* out, const std::uint64_t seed) noexcept
+{
+    Xxh3BatchKernel<Size, 8, simd::detail::mul_even_avx512>(keys, count, out, seed);
+}
+
+template <std::size_t Size>
+Xxh3BatchFn Xxh3BatchKernelFor() noexcept
+{
+    static const Xxh3BatchFn kernel = DispatchTable<Xxh3BatchFn>{Xxh3BatchBaseline<Size>, nullptr, Xxh3BatchAvx2<Size>, Xxh3BatchAvx512<Size>}.Select(ActiveSimdLevel());
+    return kernel;
+}
+#endif
+} // namespace detail
+
+// out[i] = Hash64 of the bytes of keys[i], for the first min(keys.size(), out.size()) keys of any
+// contiguous range: a span, const or not, a std::vector or a std::array. Keys
+// are hashed by their object representation, so padding bytes must be zeroed; keys up to 128
+// bytes go through the SIMD lanes, 8 / 16 at a time on AVX2 / AVX-512; longer keys, and all
+// keys on other targets, one by one.
+export template <std::ranges::contiguous_range Keys, typename Key = std::ranges::range_value_t<Keys>>
+    requires std::ranges::sized_range<Keys> && std::is_trivially_copyable_v<Key>
+void HashBatch(const Keys& keys, const std::span<std::uint64_t> out, const std::uint64_t seed = 0) noexcept
+{
+    const std::size_t count{std::min(static_cast<std::size_t>(std::ranges::size(keys)), out.size())};
+    const auto* bytes{reinterpret_cast<const std::byte*>(std::ranges::data(keys))};
+#if BALBINO_RUNTIME_DISPATCH
+    if constexpr (sizeof(Key) <= 128)
+    {
+        detail::Xxh3BatchKernelFor<sizeof(Key)>()(bytes, count, out.data(), seed);
+        return;
+    }
+#endif
+    detail::Xxh3BatchBaseline<sizeof(Key)>(bytes, count, out.data(), seed);
+}
 } // namespace fawn_algebra
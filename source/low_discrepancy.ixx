@@ -0,0 +1,848 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/assert.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:LowDiscrepancy;
+import :Arithmetics;
+import :Random;
+import :SIMD;
+import std;
+
+// Quasi-random point sets for integration and sampling. Every generator is stateless past
+// construction: point `index` of dimension `dimension` is computed directly, so threads,
+// pixels or passes can each take their own slice of a sequence without coordination.
+//
+//   Sobol       base-2 digital sequence, Joe & Kuo (2008) direction numbers for 256
+//               dimensions, optional hash-based Owen scrambling (Burley 2020)
+//   Halton      radical inverses in the first 256 prime bases, optional random digit
+//               permutations (0 kept fixed, so only the index's own digits are touched)
+//   Rd          additive recurrence on the generalised golden ratio (Roberts 2018); R2 is
+//               Rd(2)
+//   BlueNoise   64 x 64 void-and-cluster rank tile (Ulichney 1993) with per-dimension tile
+//               offsets and a golden-ratio step per index
+//
+// Fill writes count consecutive indices, several lanes at a time where the construction
+// allows it, and matches the Sample calls bit for bit. Sobol, Halton and Rd read per-dimension
+// tables: every dimension a call touches must be below max_dimensions, or Dimensions() of the
+// Halton and Rd object.
+namespace fawn_algebra
+{
+namespace detail
+{
+using ld_u32 = fill_raw;
+using ld_i32 = simd::detail::raw<std::int32_t, fill_lanes>;
+using ld_f32 = simd::detail::raw<float, fill_lanes>;
+
+// 32 fraction bits -> [0, 1) with the top 24
+constexpr float UnitFloat(const std::uint32_t bits) noexcept
+{
+    return static_cast<float>(bits >> 8U) * 0x1.0p-24F;
+}
+
+BALBINO_FORCE_INLINE ld_f32 UnitFloat(const ld_u32 bits) noexcept
+{
+    return __builtin_convertvector(std::bit_cast<ld_i32>(bits >> 8U), ld_f32) * 0x1.0p-24F;
+}
+
+// one 32-bit mixing step per (seed, dimension) pair
+constexpr std::uint32_t DimensionHash(const std::uint64_t seed, const std::uint32_t dimension) noexcept
+{
+    std::uint64_t z{seed + 0x9E3779B97F4A7C15ULL * (dimension + 1ULL)};
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return static_cast<std::uint32_t>(z ^ (z >> 31U));
+}
+
+// works on std::uint32_t and on ld_u32 lanes alike
+template <typename U>
+BALBINO_FORCE_INLINE constexpr U ReverseBits(U x) noexcept
+{
+    x = ((x >> 1U) & 0x55555555U) | ((x & 0x55555555U) << 1U);
+    x = ((x >> 2U) & 0x33333333U) | ((x & 0x33333333U) << 2U);
+    x = ((x >> 4U) & 0x0F0F0F0FU) | ((x & 0x0F0F0F0FU) << 4U);
+    x = ((x >> 8U) & 0x00FF00FFU) | ((x & 0x00FF00FFU) << 8U);
+    return (x >> 16U) | (x << 16U);
+}
+
+// Burley's Laine-Karras hash: each output bit depends only on the input bits below it, which
+// after the reversal on both sides is exactly a nested uniform (Owen) scramble
+template <typename U>
+BALBINO_FORCE_INLINE constexpr U OwenScramble(U x, const std::uint32_t seed) noexcept
+{
+    x = ReverseBits(x);
+    x ^= x * 0x3D20ADEAU;
+    x += seed;
+    x *= (seed >> 16U) | 1U;
+    x ^= x * 0x05526C56U;
+    x ^= x * 0x53A22864U;
+    return ReverseBits(x);
+}
+
+// ---- Sobol direction numbers ----------------------------------------------
+// new-joe-kuo-6.21201, dimensions 2 to 256. Polynomials carry both the leading and the
+// constant term (3 = x + 1); the initial direction numbers m_1 .. m_s of each polynomial of
+// degree s follow each other in sobol_initial.
+
+inline constexpr std::array<std::uint16_t, 255> sobol_polynomials{
+    3, 7, 11, 13, 19, 25, 37, 41, 47, 55, 59, 61, 67, 91, 97, 103,
+    109, 115, 131, 137, 143, 145, 157, 167, 171, 185, 191, 193, 203, 211, 213, 229,
+    239, 241, 247, 253, 285, 299, 301, 333, 351, 355, 357, 361, 369, 391, 397, 425,
+    451, 463, 487, 501, 529, 539, 545, 557, 563, 601, 607, 617, 623, 631, 637, 647,
+    661, 675, 677, 687, 695, 701, 719, 721, 731, 757, 761, 787, 789, 799, 803, 817,
+    827, 847, 859, 865, 875, 877, 883, 895, 901, 911, 949, 953, 967, 971, 973, 981,
+    985, 995, 1001, 1019, 1033, 1051, 1063, 1069, 1125, 1135, 1153, 1163, 1221, 1239, 1255, 1267,
+    1279, 1293, 1305, 1315, 1329, 1341, 1347, 1367, 1387, 1413, 1423, 1431, 1441, 1479, 1509, 1527,
+    1531, 1555, 1557, 1573, 1591, 1603, 1615, 1627, 1657, 1663, 1673, 1717, 1729, 1747, 1759, 1789,
+    1815, 1821, 1825, 1849, 1863, 1869, 1877, 1881, 1891, 1917, 1933, 1939, 1969, 2011, 2035, 2041,
+    2053, 2071, 2091, 2093, 2119, 2147, 2149, 2161, 2171, 2189, 2197, 2207, 2217, 2225, 2255, 2257,
+    2273, 2279, 2283, 2293, 2317, 2323, 2341, 2345, 2363, 2365, 2373, 2377, 2385, 2395, 2419, 2421,
+    2431, 2435, 2447, 2475, 2477, 2489, 2503, 2521, 2533, 2551, 2561, 2567, 2579, 2581, 2601, 2633,
+    2657, 2669, 2681, 2687, 2693, 2705, 2717, 2727, 2731, 2739, 2741, 2773, 2783, 2793, 2799, 2801,
+    2811, 2819, 2825, 2833, 2867, 2879, 2881, 2891, 2905, 2911, 2917, 2927, 2941, 2951, 2955, 2963,
+    2965, 2991, 2999, 3005, 3017, 3035, 3037, 3047, 3053, 3083, 3085, 3097, 3103, 3159, 3169};
+
+inline constexpr std::array<std::uint16_t, 2414> sobol_initial{
+    1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 3, 3, 1, 3, 5, 13, 1, 1, 5,
+    5, 17, 1, 1, 5, 5, 5, 1, 1, 7, 11, 19, 1, 1, 5, 1, 1, 1, 1, 1,
+    3, 11, 1, 3, 5, 5, 31, 1, 3, 3, 9, 7, 49, 1, 1, 1, 15, 21, 21, 1,
+    3, 1, 13, 27, 49, 1, 1, 1, 15, 7, 5, 1, 3, 1, 15, 13, 25, 1, 1, 5,
+    5, 19, 61, 1, 3, 7, 11, 23, 15, 103, 1, 3, 7, 13, 13, 15, 69, 1, 1, 3,
+    13, 7, 35, 63, 1, 3, 5, 9, 1, 25, 53, 1, 3, 1, 13, 9, 35, 107, 1, 3,
+    1, 5, 27, 61, 31, 1, 1, 5, 11, 19, 41, 61, 1, 3, 5, 3, 3, 13, 69, 1,
+    1, 7, 13, 1, 19, 1, 1, 3, 7, 5, 13, 19, 59, 1, 1, 3, 9, 25, 29, 41,
+    1, 3, 5, 13, 23, 1, 55, 1, 3, 7, 3, 13, 59, 17, 1, 3, 1, 3, 5, 53,
+    69, 1, 1, 5, 5, 23, 33, 13, 1, 1, 7, 7, 1, 61, 123, 1, 1, 7, 9, 13,
+    61, 49, 1, 3, 3, 5, 3, 55, 33, 1, 3, 1, 15, 31, 13, 49, 245, 1, 3, 5,
+    15, 31, 59, 63, 97, 1, 3, 1, 11, 11, 11, 77, 249, 1, 3, 1, 11, 27, 43, 71,
+    9, 1, 1, 7, 15, 21, 11, 81, 45, 1, 3, 7, 3, 25, 31, 65, 79, 1, 3, 1,
+    1, 19, 11, 3, 205, 1, 1, 5, 9, 19, 21, 29, 157, 1, 3, 7, 11, 1, 33, 89,
+    185, 1, 3, 3, 3, 15, 9, 79, 71, 1, 3, 7, 11, 15, 39, 119, 27, 1, 1, 3,
+    1, 11, 31, 97, 225, 1, 1, 1, 3, 23, 43, 57, 177, 1, 3, 7, 7, 17, 17, 37,
+    71, 1, 3, 1, 5, 27, 63, 123, 213, 1, 1, 3, 5, 11, 43, 53, 133, 1, 3, 5,
+    5, 29, 17, 47, 173, 479, 1, 3, 3, 11, 3, 1, 109, 9, 69, 1, 1, 1, 5, 17,
+    39, 23, 5, 343, 1, 3, 1, 5, 25, 15, 31, 103, 499, 1, 1, 1, 11, 11, 17, 63,
+    105, 183, 1, 1, 5, 11, 9, 29, 97, 231, 363, 1, 1, 5, 15, 19, 45, 41, 7, 383,
+    1, 3, 7, 7, 31, 19, 83, 137, 221, 1, 1, 1, 3, 23, 15, 111, 223, 83, 1, 1,
+    5, 13, 31, 15, 55, 25, 161, 1, 1, 3, 13, 25, 47, 39, 87, 257, 1, 1, 1, 11,
+    21, 53, 125, 249, 293, 1, 1, 7, 11, 11, 7, 57, 79, 323, 1, 1, 5, 5, 17, 13,
+    81, 3, 131, 1, 1, 7, 13, 23, 7, 65, 251, 475, 1, 3, 5, 1, 9, 43, 3, 149,
+    11, 1, 1, 3, 13, 31, 13, 13, 255, 487, 1, 3, 3, 1, 5, 63, 89, 91, 127, 1,
+    1, 3, 3, 1, 19, 123, 127, 237, 1, 1, 5, 7, 23, 31, 37, 243, 289, 1, 1, 5,
+    11, 17, 53, 117, 183, 491, 1, 1, 1, 5, 1, 13, 13, 209, 345, 1, 1, 3, 15, 1,
+    57, 115, 7, 33, 1, 3, 1, 11, 7, 43, 81, 207, 175, 1, 3, 1, 1, 15, 27, 63,
+    255, 49, 1, 3, 5, 3, 27, 61, 105, 171, 305, 1, 1, 5, 3, 1, 3, 57, 249, 149,
+    1, 1, 3, 5, 5, 57, 15, 13, 159, 1, 1, 1, 11, 7, 11, 105, 141, 225, 1, 3,
+    3, 5, 27, 59, 121, 101, 271, 1, 3, 5, 9, 11, 49, 51, 59, 115, 1, 1, 7, 1,
+    23, 45, 125, 71, 419, 1, 1, 3, 5, 23, 5, 105, 109, 75, 1, 1, 7, 15, 7, 11,
+    67, 121, 453, 1, 3, 7, 3, 9, 13, 31, 27, 449, 1, 3, 1, 15, 19, 39, 39, 89,
+    15, 1, 1, 1, 1, 1, 33, 73, 145, 379, 1, 3, 1, 15, 15, 43, 29, 13, 483, 1,
+    1, 7, 3, 19, 27, 85, 131, 431, 1, 3, 3, 3, 5, 35, 23, 195, 349, 1, 3, 3,
+    7, 9, 27, 39, 59, 297, 1, 1, 3, 9, 11, 17, 13, 241, 157, 1, 3, 7, 15, 25,
+    57, 33, 189, 213, 1, 1, 7, 1, 9, 55, 73, 83, 217, 1, 3, 3, 13, 19, 27, 23,
+    113, 249, 1, 3, 5, 3, 23, 43, 3, 253, 479, 1, 1, 5, 5, 11, 5, 45, 117, 217,
+    1, 3, 3, 7, 29, 37, 33, 123, 147, 1, 3, 1, 15, 5, 5, 37, 227, 223, 459, 1,
+    1, 7, 5, 5, 39, 63, 255, 135, 487, 1, 3, 1, 7, 9, 7, 87, 249, 217, 599, 1,
+    1, 3, 13, 9, 47, 7, 225, 363, 247, 1, 3, 7, 13, 19, 13, 9, 67, 9, 737, 1,
+    3, 5, 5, 19, 59, 7, 41, 319, 677, 1, 1, 5, 3, 31, 63, 15, 43, 207, 789, 1,
+    1, 7, 9, 13, 39, 3, 47, 497, 169, 1, 3, 1, 7, 21, 17, 97, 19, 415, 905, 1,
+    3, 7, 1, 3, 31, 71, 111, 165, 127, 1, 1, 5, 11, 1, 61, 83, 119, 203, 847, 1,
+    3, 3, 13, 9, 61, 19, 97, 47, 35, 1, 1, 7, 7, 15, 29, 63, 95, 417, 469, 1,
+    3, 1, 9, 25, 9, 71, 57, 213, 385, 1, 3, 5, 13, 31, 47, 101, 57, 39, 341, 1,
+    1, 3, 3, 31, 57, 125, 173, 365, 551, 1, 3, 7, 1, 13, 57, 67, 157, 451, 707, 1,
+    1, 1, 7, 21, 13, 105, 89, 429, 965, 1, 1, 5, 9, 17, 51, 45, 119, 157, 141, 1,
+    3, 7, 7, 13, 45, 91, 9, 129, 741, 1, 3, 7, 1, 23, 57, 67, 141, 151, 571, 1,
+    1, 3, 11, 17, 47, 93, 107, 375, 157, 1, 3, 3, 5, 11, 21, 43, 51, 169, 915, 1,
+    1, 5, 3, 15, 55, 101, 67, 455, 625, 1, 3, 5, 9, 1, 23, 29, 47, 345, 595, 1,
+    3, 7, 7, 5, 49, 29, 155, 323, 589, 1, 3, 3, 7, 5, 41, 127, 61, 261, 717, 1,
+    3, 7, 7, 17, 23, 117, 67, 129, 1009, 1, 1, 3, 13, 11, 39, 21, 207, 123, 305, 1,
+    1, 3, 9, 29, 3, 95, 47, 231, 73, 1, 3, 1, 9, 1, 29, 117, 21, 441, 259, 1,
+    3, 1, 13, 21, 39, 125, 211, 439, 723, 1, 1, 7, 3, 17, 63, 115, 89, 49, 773, 1,
+    3, 7, 13, 11, 33, 101, 107, 63, 73, 1, 1, 5, 5, 13, 57, 63, 135, 437, 177, 1,
+    1, 3, 7, 27, 63, 93, 47, 417, 483, 1, 1, 3, 1, 23, 29, 1, 191, 49, 23, 1,
+    1, 3, 15, 25, 55, 9, 101, 219, 607, 1, 3, 1, 7, 7, 19, 51, 251, 393, 307, 1,
+    3, 3, 3, 25, 55, 17, 75, 337, 3, 1, 1, 1, 13, 25, 17, 65, 45, 479, 413, 1,
+    1, 7, 7, 27, 49, 99, 161, 213, 727, 1, 3, 5, 1, 23, 5, 43, 41, 251, 857, 1,
+    3, 3, 7, 11, 61, 39, 87, 383, 835, 1, 1, 3, 15, 13, 7, 29, 7, 505, 923, 1,
+    3, 7, 1, 5, 31, 47, 157, 445, 501, 1, 1, 3, 7, 1, 43, 9, 147, 115, 605, 1,
+    3, 3, 13, 5, 1, 119, 211, 455, 1001, 1, 1, 3, 5, 13, 19, 3, 243, 75, 843, 1,
+    3, 7, 7, 1, 19, 91, 249, 357, 589, 1, 1, 1, 9, 1, 25, 109, 197, 279, 411, 1,
+    3, 1, 15, 23, 57, 59, 135, 191, 75, 1, 1, 5, 15, 29, 21, 39, 253, 383, 349, 1,
+    3, 3, 5, 19, 45, 61, 151, 199, 981, 1, 3, 5, 13, 9, 61, 107, 141, 141, 1, 1,
+    3, 1, 11, 27, 25, 85, 105, 309, 979, 1, 3, 3, 11, 19, 7, 115, 223, 349, 43, 1,
+    1, 7, 9, 21, 39, 123, 21, 275, 927, 1, 1, 7, 13, 15, 41, 47, 243, 303, 437, 1,
+    1, 1, 7, 7, 3, 15, 99, 409, 719, 1, 3, 3, 15, 27, 49, 113, 123, 113, 67, 469,
+    1, 3, 7, 11, 3, 23, 87, 169, 119, 483, 199, 1, 1, 5, 15, 7, 17, 109, 229, 179,
+    213, 741, 1, 1, 5, 13, 11, 17, 25, 135, 403, 557, 1433, 1, 3, 1, 1, 1, 61, 67,
+    215, 189, 945, 1243, 1, 1, 7, 13, 17, 33, 9, 221, 429, 217, 1679, 1, 1, 3, 11, 27,
+    3, 15, 93, 93, 865, 1049, 1, 3, 7, 7, 25, 41, 121, 35, 373, 379, 1547, 1, 3, 3,
+    9, 11, 35, 45, 205, 241, 9, 59, 1, 3, 1, 7, 3, 51, 7, 177, 53, 975, 89, 1,
+    1, 3, 5, 27, 1, 113, 231, 299, 759, 861, 1, 3, 3, 15, 25, 29, 5, 255, 139, 891,
+    2031, 1, 3, 1, 1, 13, 9, 109, 193, 419, 95, 17, 1, 1, 7, 9, 3, 7, 29, 41,
+    135, 839, 867, 1, 1, 7, 9, 25, 49, 123, 217, 113, 909, 215, 1, 1, 7, 3, 23, 15,
+    43, 133, 217, 327, 901, 1, 1, 3, 3, 13, 53, 63, 123, 477, 711, 1387, 1, 1, 3, 15,
+    7, 29, 75, 119, 181, 957, 247, 1, 1, 1, 11, 27, 25, 109, 151, 267, 99, 1461, 1, 3,
+    7, 15, 5, 5, 53, 145, 11, 725, 1501, 1, 3, 7, 1, 9, 43, 71, 229, 157, 607, 1835,
+    1, 3, 3, 13, 25, 1, 5, 27, 471, 349, 127, 1, 1, 1, 1, 23, 37, 9, 221, 269,
+    897, 1685, 1, 1, 3, 3, 31, 29, 51, 19, 311, 553, 1969, 1, 3, 7, 5, 5, 55, 17,
+    39, 475, 671, 1529, 1, 1, 7, 1, 1, 35, 47, 27, 437, 395, 1635, 1, 1, 7, 3, 13,
+    23, 43, 135, 327, 139, 389, 1, 3, 7, 3, 9, 25, 91, 25, 429, 219, 513, 1, 1, 3,
+    5, 13, 29, 119, 201, 277, 157, 2043, 1, 3, 5, 3, 29, 57, 13, 17, 167, 739, 1031, 1,
+    3, 3, 5, 29, 21, 95, 27, 255, 679, 1531, 1, 3, 7, 15, 9, 5, 21, 71, 61, 961,
+    1201, 1, 3, 5, 13, 15, 57, 33, 93, 459, 867, 223, 1, 1, 1, 15, 17, 43, 127, 191,
+    67, 177, 1073, 1, 1, 1, 15, 23, 7, 21, 199, 75, 293, 1611, 1, 3, 7, 13, 15, 39,
+    21, 149, 65, 741, 319, 1, 3, 7, 11, 23, 13, 101, 89, 277, 519, 711, 1, 3, 7, 15,
+    19, 27, 85, 203, 441, 97, 1895, 1, 3, 1, 3, 29, 25, 21, 155, 11, 191, 197, 1, 1,
+    7, 5, 27, 11, 81, 101, 457, 675, 1687, 1, 3, 1, 5, 25, 5, 65, 193, 41, 567, 781,
+    1, 3, 1, 5, 11, 15, 113, 77, 411, 695, 1111, 1, 1, 3, 9, 11, 53, 119, 171, 55,
+    297, 509, 1, 1, 1, 1, 11, 39, 113, 139, 165, 347, 595, 1, 3, 7, 11, 9, 17, 101,
+    13, 81, 325, 1733, 1, 3, 1, 1, 21, 43, 115, 9, 113, 907, 645, 1, 1, 7, 3, 9,
+    25, 117, 197, 159, 471, 475, 1, 3, 1, 9, 11, 21, 57, 207, 485, 613, 1661, 1, 1, 7,
+    7, 27, 55, 49, 223, 89, 85, 1523, 1, 1, 5, 3, 19, 41, 45, 51, 447, 299, 1355, 1,
+    3, 1, 13, 1, 33, 117, 143, 313, 187, 1073, 1, 1, 7, 7, 5, 11, 65, 97, 377, 377,
+    1501, 1, 3, 1, 1, 21, 35, 95, 65, 99, 23, 1239, 1, 1, 5, 9, 3, 37, 95, 167,
+    115, 425, 867, 1, 3, 3, 13, 1, 37, 27, 189, 81, 679, 773, 1, 1, 3, 11, 1, 61,
+    99, 233, 429, 969, 49, 1, 1, 1, 7, 25, 63, 99, 165, 245, 793, 1143, 1, 1, 5, 11,
+    11, 43, 55, 65, 71, 283, 273, 1, 1, 5, 5, 9, 3, 101, 251, 355, 379, 1611, 1, 1,
+    1, 15, 21, 63, 85, 99, 49, 749, 1335, 1, 1, 5, 13, 27, 9, 121, 43, 255, 715, 289,
+    1, 3, 1, 5, 27, 19, 17, 223, 77, 571, 1415, 1, 1, 5, 3, 13, 59, 125, 251, 195,
+    551, 1737, 1, 3, 3, 15, 13, 27, 49, 105, 389, 971, 755, 1, 3, 5, 15, 23, 43, 35,
+    107, 447, 763, 253, 1, 3, 5, 11, 21, 3, 17, 39, 497, 407, 611, 1, 1, 7, 13, 15,
+    31, 113, 17, 23, 507, 1995, 1, 1, 7, 15, 3, 15, 31, 153, 423, 79, 503, 1, 1, 7,
+    9, 19, 25, 23, 171, 505, 923, 1989, 1, 1, 5, 9, 21, 27, 121, 223, 133, 87, 697, 1,
+    1, 5, 5, 9, 19, 107, 99, 319, 765, 1461, 1, 1, 3, 3, 19, 25, 3, 101, 171, 729,
+    187, 1, 1, 3, 1, 13, 23, 85, 93, 291, 209, 37, 1, 1, 1, 15, 25, 25, 77, 253,
+    333, 947, 1073, 1, 1, 3, 9, 17, 29, 55, 47, 255, 305, 2037, 1, 3, 3, 9, 29, 63,
+    9, 103, 489, 939, 1523, 1, 3, 7, 15, 7, 31, 89, 175, 369, 339, 595, 1, 3, 7, 13,
+    25, 5, 71, 207, 251, 367, 665, 1, 3, 3, 3, 21, 25, 75, 35, 31, 321, 1603, 1, 1,
+    1, 9, 11, 1, 65, 5, 11, 329, 535, 1, 1, 5, 3, 19, 13, 17, 43, 379, 485, 383,
+    1, 3, 5, 13, 13, 9, 85, 147, 489, 787, 1133, 1, 3, 1, 1, 5, 51, 37, 129, 195,
+    297, 1783, 1, 1, 3, 15, 19, 57, 59, 181, 455, 697, 2033, 1, 3, 7, 1, 27, 9, 65,
+    145, 325, 189, 201, 1, 3, 1, 15, 31, 23, 19, 5, 485, 581, 539, 1, 1, 7, 13, 11,
+    15, 65, 83, 185, 847, 831, 1, 3, 5, 7, 7, 55, 73, 15, 303, 511, 1905, 1, 3, 5,
+    9, 7, 21, 45, 15, 397, 385, 597, 1, 3, 7, 3, 23, 13, 73, 221, 511, 883, 1265, 1,
+    1, 3, 11, 1, 51, 73, 185, 33, 975, 1441, 1, 3, 3, 9, 19, 59, 21, 39, 339, 37,
+    143, 1, 1, 7, 1, 31, 33, 19, 167, 117, 635, 639, 1, 1, 1, 3, 5, 13, 59, 83,
+    355, 349, 1967, 1, 1, 1, 5, 19, 3, 53, 133, 97, 863, 983};
+
+inline constexpr std::uint32_t sobol_dimensions{256};
+
+using sobol_matrix = std::array<std::uint32_t, 32>;
+
+consteval std::array<sobol_matrix, sobol_dimensions> MakeSobolMatrices()
+{
+    std::array<sobol_matrix, sobol_dimensions> matrices{};
+    for (std::uint32_t k = 0; k < 32; ++k)
+    {
+        matrices[0][k] = 1U << (31U - k);
+    }
+
+    std::size_t initial{};
+    for (std::uint32_t d = 1; d < sobol_dimensions; ++d)
+    {
+        const std::uint32_t polynomial{sobol_polynomials[d - 1]};
+        const auto degree{static_cast<std::uint32_t>(std::bit_width(polynomial)) - 1U};
+        sobol_matrix& v{matrices[d]};
+        for (std::uint32_t k = 0; k < degree; ++k)
+        {
+            v[k] = static_cast<std::uint32_t>(sobol_initial[initial++]) << (31U - k);
+        }
+        // v_k = c_1 v_(k-1) ^ ... ^ c_(s-1) v_(k-s+1) ^ v_(k-s) ^ (v_(k-s) >> s)
+        for (std::uint32_t k = degree; k < 32; ++k)
+        {
+            std::uint32_t value{v[k - degree] ^ (v[k - degree] >> degree)};
+            for (std::uint32_t j = 1; j < degree; ++j)
+            {
+                if ((polynomial >> (degree - j)) & 1U)
+                {
+                    value ^= v[k - j];
+                }
+            }
+            v[k] = value;
+        }
+    }
+    return matrices;
+}
+
+inline constexpr std::array<sobol_matrix, sobol_dimensions> sobol_matrices{MakeSobolMatrices()};
+
+// ---- Halton bases ---------------------------------------------------------
+
+inline constexpr std::uint32_t halton_dimensions{256};
+
+consteval std::array<std::uint32_t, halton_dimensions> MakePrimes()
+{
+    std::array<std::uint32_t, halton_dimensions> primes{};
+    std::uint32_t count{};
+    for (std::uint32_t candidate = 2; count < halton_dimensions; ++candidate)
+    {
+        bool prime{true};
+        for (std::uint32_t i = 0; i < count && primes[i] * primes[i] <= candidate; ++i)
+        {
+            prime = prime && candidate % primes[i] != 0;
+        }
+        if (prime)
+        {
+            primes[count++] = candidate;
+        }
+    }
+    return primes;
+}
+
+inline constexpr std::array<std::uint32_t, halton_dimensions> halton_bases{MakePrimes()};
+
+// ---- blue-noise tile ------------------------------------------------------
+
+inline constexpr std::uint32_t blue_noise_size{64};
+inline constexpr std::uint32_t blue_noise_pixels{blue_noise_size * blue_noise_size};
+
+// Void-and-cluster ranks. Energy is the toroidal Gaussian (sigma 1.5) of the placed pixels;
+// the minimum-energy empty pixel is both the largest void among the ones and the tightest
+// cluster among the zeros, so phases II and III share one loop.
+inline std::array<std::uint16_t, blue_noise_pixels> MakeBlueNoise()
+{
+    constexpr std::uint32_t size{blue_noise_size};
+    constexpr std::uint32_t pixels{blue_noise_pixels};
+    constexpr std::uint32_t initial{pixels / 10};
+
+    std::array<float, pixels> kernel;
+    for (std::uint32_t y = 0; y < size; ++y)
+    {
+        for (std::uint32_t x = 0; x < size; ++x)
+        {
+            const auto dx{static_cast<float>(std::min(x, size - x))};
+            const auto dy{static_cast<float>(std::min(y, size - y))};
+            kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0F * 1.5F * 1.5F));
+        }
+    }
+
+    std::array<bool, pixels> set{};
+    std::array<float, pixels> energy{};
+    const auto splat{[&](const std::uint32_t pixel, const float sign) {
+        const std::uint32_t px{pixel % size};
+        const std::uint32_t py{pixel / size};
+        for (std::uint32_t y = 0; y < size; ++y)
+        {
+            for (std::uint32_t x = 0; x < size; ++x)
+            {
+                energy[y * size + x] += sign * kernel[((y - py) % size) * size + (x - px) % size];
+            }
+        }
+    }};
+    const auto extreme{[&](const bool ones) {
+        std::uint32_t best{};
+        float bestEnergy{ones ? -1.0F : std::numeric_limits<float>::max()};
+        for (std::uint32_t i = 0; i < pixels; ++i)
+        {
+            if (set[i] == ones && (ones ? energy[i] > bestEnergy : energy[i] < bestEnergy))
+            {
+                best       = i;
+                bestEnergy = energy[i];
+            }
+        }
+        return best;
+    }};
+
+    // phase 0: a white-noise start, relaxed until the tightest cluster is the largest void
+    SplitMix64 rng{0};
+    for (std::uint32_t placed = 0; placed < initial;)
+    {
+        const auto pixel{static_cast<std::uint32_t>(UniformBounded(rng, pixels))};
+        if (!set[pixel])
+        {
+            set[pixel] = true;
+            splat(pixel, 1.0F);
+            ++placed;
+        }
+    }
+    for (;;)
+    {
+        const std::uint32_t cluster{extreme(true)};
+        set[cluster] = false;
+        splat(cluster, -1.0F);
+        const std::uint32_t hole{extreme(false)};
+        set[hole] = true;
+        splat(hole, 1.0F);
+        if (hole == cluster)
+        {
+            break;
+        }
+    }
+
+    std::array<std::uint16_t, pixels> ranks{};
+    const std::array<bool, pixels> start{set};
+    const std::array<float, pixels> startEnergy{energy};
+
+    // phase I: peel the start pattern from its tightest cluster down
+    for (std::uint32_t rank = initial; rank-- > 0;)
+    {
+        const std::uint32_t cluster{extreme(true)};
+        set[cluster] = false;
+        splat(cluster, -1.0F);
+        ranks[cluster] = static_cast<std::uint16_t>(rank);
+    }
+
+    // phases II and III: grow from the start pattern into the largest voids
+    set    = start;
+    energy = startEnergy;
+    for (std::uint32_t rank = initial; rank < pixels; ++rank)
+    {
+        const std::uint32_t hole{extreme(false)};
+        set[hole] = true;
+        splat(hole, 1.0F);
+        ranks[hole] = static_cast<std::uint16_t>(rank);
+    }
+    return ranks;
+}
+
+inline const std::array<std::uint16_t, blue_noise_pixels>& BlueNoiseTile()
+{
+    static const std::array<std::uint16_t, blue_noise_pixels> tile{MakeBlueNoise()};
+    return tile;
+}
+} // namespace detail
+
+// ---- Sobol ------------------------------------------------------------------
+
+export class Sobol
+{
+  public:
+    static constexpr std::uint32_t max_dimensions{detail::sobol_dimensions};
+
+    // the plain sequence; point 0 is the origin
+    constexpr Sobol() noexcept = default;
+
+    // Owen-scrambled: still a (0, 2)-sequence in dimensions 0 and 1 and stratified in every
+    // dimension, with the structure of the plain sequence randomised away
+    explicit constexpr Sobol(const std::uint64_t seed) noexcept
+        : m_seed{seed}
+        , m_scrambled{true}
+    {
+    }
+
+    [[nodiscard]] constexpr std::uint32_t SampleBits(const std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        BALBINO_ASSERT(dimension < max_dimensions, "Sobol has direction numbers for 256 dimensions");
+        const detail::sobol_matrix& v{detail::sobol_matrices[dimension]};
+        std::uint32_t bits{};
+        for (std::uint32_t i = index, k = 0; i != 0; i >>= 1U, ++k)
+        {
+            bits ^= (0U - (i & 1U)) & v[k];
+        }
+        return m_scrambled ? detail::OwenScramble(bits, detail::DimensionHash(m_seed, dimension)) : bits;
+    }
+
+    [[nodiscard]] constexpr float Sample(const std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        return detail::UnitFloat(SampleBits(index, dimension));
+    }
+
+    [[nodiscard]] constexpr float2 Sample2(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1)};
+    }
+
+    [[nodiscard]] constexpr float3 Sample3(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1), Sample(index, dimension + 2)};
+    }
+
+    // points first, first + 1, ... of one dimension, or of consecutive dimensions per point
+    void Fill(const std::uint32_t first, const std::span<float> out, const std::uint32_t dimension) const noexcept
+    {
+        FillDimensions<1>(first, out.data(), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float2> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<2>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float3> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<3>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+  private:
+    std::uint64_t m_seed{};
+    bool m_scrambled{};
+
+    // lanes hold consecutive indices; each lane XORs in the columns its index selects
+    template <int Dimensions>
+    void FillDimensions(const std::uint32_t first, float* out, const std::size_t count, const std::uint32_t dimension) const noexcept
+    {
+        constexpr int lanes{detail::fill_lanes};
+        constexpr detail::ld_u32 iota{detail::LaneIota(std::make_integer_sequence<int, lanes>{})};
+        BALBINO_ASSERT(dimension + std::size_t{Dimensions} <= max_dimensions, "Sobol has direction numbers for 256 dimensions");
+        if (count == 0)
+        {
+            return;
+        }
+        const auto columns{static_cast<int>(std::bit_width(first + static_cast<std::uint32_t>(count - 1)))};
+        for (std::size_t i{}; i < count; i += lanes)
+        {
+            const detail::ld_u32 index{iota + (first + static_cast<std::uint32_t>(i))};
+            const int active{static_cast<int>(std::min<std::size_t>(lanes, count - i))};
+            for (int d = 0; d < Dimensions; ++d)
+            {
+                const detail::sobol_matrix& v{detail::sobol_matrices[dimension + static_cast<std::uint32_t>(d)]};
+                detail::ld_u32 bits{};
+                for (int k = 0; k < columns; ++k)
+                {
+                    bits ^= (0U - ((index >> static_cast<std::uint32_t>(k)) & 1U)) & v[static_cast<std::size_t>(k)];
+                }
+                if (m_scrambled)
+                {
+                    bits = detail::OwenScramble(bits, detail::DimensionHash(m_seed, dimension + static_cast<std::uint32_t>(d)));
+                }
+                const detail::ld_f32 values{detail::UnitFloat(bits)};
+                for (int l = 0; l < active; ++l)
+                {
+                    out[(i + static_cast<std::size_t>(l)) * Dimensions + static_cast<std::size_t>(d)] = values[l];
+                }
+            }
+        }
+    }
+};
+
+// ---- Halton -----------------------------------------------------------------
+
+export class Halton
+{
+  public:
+    static constexpr std::uint32_t max_dimensions{detail::halton_dimensions};
+
+    // the plain radical inverses in dimensions 0 .. dimensions - 1
+    explicit Halton(const std::uint32_t dimensions = 16)
+        : m_offsets(dimensions + 1)
+    {
+        BALBINO_ASSERT(dimensions <= max_dimensions, "Halton has bases for 256 dimensions");
+        for (std::uint32_t d = 0; d < dimensions; ++d)
+        {
+            m_offsets[d + 1] = m_offsets[d] + detail::halton_bases[d];
+        }
+        m_permutations.resize(m_offsets.back());
+        for (std::uint32_t d = 0; d < dimensions; ++d)
+        {
+            std::iota(m_permutations.begin() + m_offsets[d], m_permutations.begin() + m_offsets[d + 1], std::uint16_t{});
+        }
+    }
+
+    // each dimension's nonzero digits go through their own random permutation, which breaks
+    // up the correlation between high, neighbouring bases
+    Halton(const std::uint32_t dimensions, const std::uint64_t seed)
+        : Halton(dimensions)
+    {
+        for (std::uint32_t d = 0; d < dimensions; ++d)
+        {
+            SplitMix64 rng{seed ^ detail::DimensionHash(seed, d)};
+            const auto digits{std::span{m_permutations}.subspan(m_offsets[d] + 1, detail::halton_bases[d] - 1)};
+            for (std::size_t i = digits.size(); i > 1; --i)
+            {
+                std::swap(digits[i - 1], digits[UniformBounded(rng, static_cast<std::uint64_t>(i))]);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint32_t Dimensions() const noexcept
+    {
+        return static_cast<std::uint32_t>(m_offsets.size() - 1);
+    }
+
+    [[nodiscard]] float Sample(std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        BALBINO_ASSERT(dimension < Dimensions(), "Halton dimension out of range");
+        const std::uint32_t base{detail::halton_bases[dimension]};
+        if (base == 2)
+        {
+            // the only permutation of {1} is the identity
+            return detail::UnitFloat(detail::ReverseBits(index));
+        }
+        const std::uint16_t* permutation{m_permutations.data() + m_offsets[dimension]};
+        const double inverseBase{1.0 / static_cast<double>(base)};
+        std::uint64_t reversed{};
+        double scale{1.0};
+        while (index != 0)
+        {
+            const std::uint32_t next{index / base};
+            reversed = reversed * base + permutation[index - next * base];
+            scale *= inverseBase;
+            index = next;
+        }
+        return std::min(static_cast<float>(static_cast<double>(reversed) * scale), 0x1.FFFFFEp-1F);
+    }
+
+    [[nodiscard]] float2 Sample2(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1)};
+    }
+
+    [[nodiscard]] float3 Sample3(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1), Sample(index, dimension + 2)};
+    }
+
+    // The digit loop has a data-dependent trip count and a division per digit, so batches
+    // stay scalar; base 2 is a bit reversal in lanes.
+    void Fill(const std::uint32_t first, const std::span<float> out, const std::uint32_t dimension) const noexcept
+    {
+        FillDimensions<1>(first, out.data(), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float2> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<2>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float3> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<3>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+  private:
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint16_t> m_permutations;
+
+    template <int Dimensions>
+    void FillDimensions(const std::uint32_t first, float* out, const std::size_t count, const std::uint32_t dimension) const noexcept
+    {
+        constexpr int lanes{detail::fill_lanes};
+        constexpr detail::ld_u32 iota{detail::LaneIota(std::make_integer_sequence<int, lanes>{})};
+        BALBINO_ASSERT(dimension + std::size_t{Dimensions} < m_offsets.size(), "Halton dimension out of range");
+        for (int d = 0; d < Dimensions; ++d)
+        {
+            const std::uint32_t current{dimension + static_cast<std::uint32_t>(d)};
+            if (detail::halton_bases[current] != 2)
+            {
+                for (std::size_t i{}; i < count; ++i)
+                {
+                    out[i * Dimensions + static_cast<std::size_t>(d)] = Sample(first + static_cast<std::uint32_t>(i), current);
+                }
+                continue;
+            }
+            for (std::size_t i{}; i < count; i += lanes)
+            {
+                const detail::ld_f32 values{detail::UnitFloat(detail::ReverseBits(detail::ld_u32{iota + (first + static_cast<std::uint32_t>(i))}))};
+                const int active{static_cast<int>(std::min<std::size_t>(lanes, count - i))};
+                for (int l = 0; l < active; ++l)
+                {
+                    out[(i + static_cast<std::size_t>(l)) * Dimensions + static_cast<std::size_t>(d)] = values[l];
+                }
+            }
+        }
+    }
+};
+
+// ---- Rd / R2 ----------------------------------------------------------------
+
+// x_n = offset + n * alpha (mod 1), alpha_j = phi_d^-(j + 1) with phi_d the positive root of
+// x^(d + 1) = x + 1. Kept in 0.64 fixed point, so point 2^32 - 1 is as exact as point 1.
+export class Rd
+{
+  public:
+    // seed 0 keeps Roberts' offset of 1/2 in every dimension; any other seed gives each
+    // dimension its own random offset (a Cranley-Patterson rotation)
+    explicit Rd(const std::uint32_t dimensions = 2, const std::uint64_t seed = 0)
+        : m_alpha(dimensions)
+        , m_offset(dimensions, 0x80000000U)
+    {
+        double phi{2.0};
+        for (int i = 0; i < 64; ++i)
+        {
+            phi = std::pow(1.0 + phi, 1.0 / static_cast<double>(dimensions + 1));
+        }
+        double alpha{1.0};
+        for (std::uint32_t d = 0; d < dimensions; ++d)
+        {
+            alpha /= phi;
+            m_alpha[d] = static_cast<std::uint64_t>(std::ldexp(alpha, 64));
+            if (seed != 0)
+            {
+                m_offset[d] = detail::DimensionHash(seed, d);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint32_t Dimensions() const noexcept
+    {
+        return static_cast<std::uint32_t>(m_alpha.size());
+    }
+
+    [[nodiscard]] std::uint32_t SampleBits(const std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        BALBINO_ASSERT(dimension < Dimensions(), "Rd dimension out of range");
+        return m_offset[dimension] + static_cast<std::uint32_t>((index * m_alpha[dimension]) >> 32U);
+    }
+
+    [[nodiscard]] float Sample(const std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        return detail::UnitFloat(SampleBits(index, dimension));
+    }
+
+    [[nodiscard]] float2 Sample2(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1)};
+    }
+
+    [[nodiscard]] float3 Sample3(const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(index, dimension), Sample(index, dimension + 1), Sample(index, dimension + 2)};
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float> out, const std::uint32_t dimension) const noexcept
+    {
+        FillDimensions<1>(first, out.data(), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float2> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<2>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t first, const std::span<float3> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<3>(first, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+  private:
+    std::vector<std::uint64_t> m_alpha;
+    std::vector<std::uint32_t> m_offset;
+
+    // the top 32 bits of n * alpha are n * alpha_hi + hi(n * alpha_lo), both 32-bit lane ops
+    template <int Dimensions>
+    void FillDimensions(const std::uint32_t first, float* out, const std::size_t count, const std::uint32_t dimension) const noexcept
+    {
+        constexpr int lanes{detail::fill_lanes};
+        constexpr detail::ld_u32 iota{detail::LaneIota(std::make_integer_sequence<int, lanes>{})};
+        BALBINO_ASSERT(dimension + std::size_t{Dimensions} <= m_alpha.size(), "Rd dimension out of range");
+        for (std::size_t i{}; i < count; i += lanes)
+        {
+            const detail::ld_u32 index{iota + (first + static_cast<std::uint32_t>(i))};
+            const int active{static_cast<int>(std::min<std::size_t>(lanes, count - i))};
+            for (int d = 0; d < Dimensions; ++d)
+            {
+                const std::uint32_t current{dimension + static_cast<std::uint32_t>(d)};
+                const auto low{static_cast<std::uint32_t>(m_alpha[current])};
+                const auto high{static_cast<std::uint32_t>(m_alpha[current] >> 32U)};
+                const auto product{simd::mul_wide(detail::fill_u32{index}, detail::fill_u32::splat(low))};
+                const detail::ld_f32 values{detail::UnitFloat(detail::ld_u32{m_offset[current] + index * high + product[0].r})};
+                for (int l = 0; l < active; ++l)
+                {
+                    out[(i + static_cast<std::size_t>(l)) * Dimensions + static_cast<std::size_t>(d)] = values[l];
+                }
+            }
+        }
+    }
+};
+
+export [[nodiscard]] inline Rd R2(const std::uint64_t seed = 0)
+{
+    return Rd{2, seed};
+}
+
+// ---- blue noise -------------------------------------------------------------
+
+// Pixel (x, y) of the wrapped 64 x 64 tile. Each dimension reads the tile at its own offset,
+// so dimensions stay blue individually but are decorrelated from each other; each index
+// adds the golden ratio, which keeps every pixel's sequence over time well spread as well.
+export class BlueNoise
+{
+  public:
+    static constexpr std::uint32_t tile_size{detail::blue_noise_size};
+
+    explicit BlueNoise(const std::uint64_t seed = 0)
+        : m_seed{seed}
+        , m_tile{&detail::BlueNoiseTile()}
+    {
+    }
+
+    // the ranks 0 .. 4095, row-major
+    [[nodiscard]] static std::span<const std::uint16_t, detail::blue_noise_pixels> Tile()
+    {
+        return detail::BlueNoiseTile();
+    }
+
+    [[nodiscard]] std::uint32_t SampleBits(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::uint32_t dimension) const noexcept
+    {
+        const std::uint32_t offset{dimension == 0 ? 0U : detail::DimensionHash(m_seed, dimension)};
+        const std::uint32_t px{(x + offset) % tile_size};
+        const std::uint32_t py{(y + (offset >> 16U)) % tile_size};
+        return Centre((*m_tile)[py * tile_size + px]) + index * 0x9E3779B9U;
+    }
+
+    [[nodiscard]] float Sample(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return detail::UnitFloat(SampleBits(x, y, index, dimension));
+    }
+
+    [[nodiscard]] float2 Sample2(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(x, y, index, dimension), Sample(x, y, index, dimension + 1)};
+    }
+
+    [[nodiscard]] float3 Sample3(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::uint32_t dimension = 0) const noexcept
+    {
+        return {Sample(x, y, index, dimension), Sample(x, y, index, dimension + 1), Sample(x, y, index, dimension + 2)};
+    }
+
+    // pixels (x, y) .. (x + count - 1, y) of one dimension, or of consecutive dimensions per pixel
+    void Fill(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::span<float> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<1>(x, y, index, out.data(), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::span<float2> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<2>(x, y, index, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+    void Fill(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, const std::span<float3> out, const std::uint32_t dimension = 0) const noexcept
+    {
+        FillDimensions<3>(x, y, index, reinterpret_cast<float*>(out.data()), out.size(), dimension);
+    }
+
+  private:
+    std::uint64_t m_seed;
+    const std::array<std::uint16_t, detail::blue_noise_pixels>* m_tile;
+
+    // rank r -> (r + 1/2) / 4096 in 0.32 fixed point
+    static constexpr std::uint32_t Centre(const std::uint16_t rank) noexcept
+    {
+        return (static_cast<std::uint32_t>(rank) << 20U) + 0x80000U;
+    }
+
+    // one tile row per dimension, read lanes pixels at a time
+    template <int Dimensions>
+    void FillDimensions(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index, float* out, const std::size_t count, const std::uint32_t dimension) const noexcept
+    {
+        constexpr int lanes{detail::fill_lanes};
+        const std::uint32_t step{index * 0x9E3779B9U};
+        for (int d = 0; d < Dimensions; ++d)
+        {
+            const std::uint32_t current{dimension + static_cast<std::uint32_t>(d)};
+            const std::uint32_t offset{current == 0 ? 0U : detail::DimensionHash(m_seed, current)};
+            const std::uint16_t* row{m_tile->data() + ((y + (offset >> 16U)) % tile_size) * tile_size};
+            std::uint32_t px{(x + offset) % tile_size};
+            for (std::size_t i{}; i < count; i += lanes)
+            {
+                detail::ld_u32 bits;
+                for (int l = 0; l < lanes; ++l)
+                {
+                    bits[l] = row[px];
+                    px      = (px + 1) % tile_size;
+                }
+                const detail::ld_f32 values{detail::UnitFloat(detail::ld_u32{(bits << 20U) + (0x80000U + step)})};
+                const int active{static_cast<int>(std::min<std::size_t>(lanes, count - i))};
+                for (int l = 0; l < active; ++l)
+                {
+                    out[(i + static_cast<std::size_t>(l)) * Dimensions + static_cast<std::size_t>(d)] = values[l];
+                }
+            }
+        }
+    }
+};
+} // namespace fawn_algebra
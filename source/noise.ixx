@@ -0,0 +1,880 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/architecture.hpp"
+#include "config/assert.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:Noise;
+import :Arithmetics;
+import :CPU;
+import :SIMD;
+import :SIMDMath;
+import std;
+
+// Gradient noise in SIMD lanes. Lattice corners are hashed from their coordinates and the
+// seed instead of looked up in a permutation table, so a call costs no gathers, the pattern
+// does not repeat every 256 or 65536 cells, and two seeds give unrelated fields.
+//
+//   Perlin(x, y[, z], seed)       improved Perlin noise (quintic fade), about [-1, 1]
+//   Simplex(x, y[, z[, w]], seed) simplex noise on hashed gradients, about [-1, 1]; d + 1
+//                                 corners per sample instead of Perlin's 2^d
+//   Worley(x, y[, z], seed)       cellular noise: distances to the nearest two feature points
+//   Noise(x, y[, z], settings)    one of the NoiseKind fractals over Perlin or simplex octaves
+//   FillGrid2D / FillGrid3D       a whole tile, row by row, dispatched on ActiveSimdLevel
+//
+// A period makes the Perlin and Worley lattices wrap, so a tile of period cells repeats
+// seamlessly. Simplex lattices are skewed and cannot repeat along the axes; a tileable
+// simplex texture samples Simplex(x, y, z, w) on a torus instead.
+//
+// Every function has a scalar form and a simd::vec<float, N> form; the scalar one runs the
+// 4-lane kernel on a splat, so both agree to the last bit in the same build.
+namespace fawn_algebra
+{
+export enum class NoiseKind : std::uint8_t
+{
+    Perlin,    // one octave
+    Fbm,       // sum of octaves, about [-1, 1]
+    Ridged,    // sum of (2 (1 - |n|)^2 - 1): sharp crests along the zero set, about [-1, 1]
+    Turbulence // sum of |n|, [0, 1]
+};
+
+export enum class NoiseBasis : std::uint8_t
+{
+    Perlin,
+    Simplex
+};
+
+export struct NoiseSettings
+{
+    NoiseKind kind{NoiseKind::Fbm};
+    NoiseBasis basis{NoiseBasis::Perlin};
+    std::uint32_t seed{};
+    float frequency{1.0F};
+    int octaves{6};
+    float lacunarity{2.0F};
+    float gain{0.5F};
+    // 0, or the number of lattice cells after which the Perlin basis repeats at the first
+    // octave; octave i repeats after period * lacunarity^i cells, rounded, so the fractal
+    // tiles exactly when the lacunarity is a whole number. Ignored by the simplex basis.
+    std::uint32_t period{};
+};
+
+// F1 and F2 of cellular noise, in lattice cells
+export template <typename T>
+struct WorleyDistances
+{
+    T f1;
+    T f2;
+};
+
+namespace detail
+{
+template <int N>
+using noise_u32 = simd::detail::raw<std::uint32_t, N>;
+template <int N>
+using noise_i32 = simd::detail::raw<std::int32_t, N>;
+
+inline constexpr std::uint32_t noise_prime_x{501125321U};
+inline constexpr std::uint32_t noise_prime_y{1136930381U};
+inline constexpr std::uint32_t noise_prime_z{1720413743U};
+inline constexpr std::uint32_t noise_prime_w{1066037191U};
+
+// bring the simplex peaks (0.0142556, 0.0130072 and 0.0159292, found by local search from
+// random starts) to about 0.995
+inline constexpr float simplex_scale_2d{69.8F};
+inline constexpr float simplex_scale_3d{76.4F};
+inline constexpr float simplex_scale_4d{62.4F};
+
+template <int N>
+BALBINO_FORCE_INLINE noise_u32<N> LatticeHash(const noise_u32<N> hash) noexcept
+{
+    const noise_u32<N> h{hash * 0x27D4EB2DU};
+    return h ^ (h >> 15U);
+}
+
+// Selects are bitwise blends rather than vector ?: (simd::select, simd::detail::pick): these
+// helpers are lowered for the baseline ISA before they are inlined into the AVX2 / AVX-512
+// kernels, and a lowered ?: stays one lane at a time, while & | ^ stay whole vectors.
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Blend(const noise_i32<N> mask, const simd::vec<float, N> a, const simd::vec<float, N> b) noexcept
+{
+    const noise_i32<N> bits{(std::bit_cast<noise_i32<N>>(a.r) & mask) | (std::bit_cast<noise_i32<N>>(b.r) & ~mask)};
+    return simd::vec<float, N>{std::bit_cast<simd::detail::raw<float, N>>(bits)};
+}
+
+// flips the sign of the lanes whose `bit` is set in h
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> FlipSign(const simd::vec<float, N> value, const noise_u32<N> h, const std::uint32_t bit) noexcept
+{
+    const noise_u32<N> sign{(h & bit) << static_cast<std::uint32_t>(31 - std::countr_zero(bit))};
+    return simd::vec<float, N>{std::bit_cast<simd::detail::raw<float, N>>(std::bit_cast<noise_u32<N>>(value.r) ^ sign)};
+}
+
+// 8 directions: the 4 diagonals and the 4 axes scaled to the same length sqrt(2)
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Gradient(const noise_u32<N> hash, const simd::vec<float, N> x, const simd::vec<float, N> y) noexcept
+{
+    const noise_i32<N> h{std::bit_cast<noise_i32<N>>(hash)};
+    const simd::vec<float, N> diagonal{FlipSign(x, hash, 1U) + FlipSign(y, hash, 2U)};
+    const simd::vec<float, N> axis{FlipSign(Blend<N>((h & 1) != 0, y, x), hash, 2U) * 1.41421356237309504880F};
+    return Blend<N>((h & 4) != 0, axis, diagonal);
+}
+
+// Perlin's 12 cube edges, 16 entries with 4 repeated, as in Grad; (h & 13) == 12 is h == 12 or 14
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Gradient(const noise_u32<N> hash, const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z) noexcept
+{
+    const noise_i32<N> h{std::bit_cast<noise_i32<N>>(hash & 15U)};
+    const simd::vec<float, N> u{Blend<N>(h < 8, x, y)};
+    const simd::vec<float, N> v{Blend<N>(h < 4, y, Blend<N>((h & 13) == 12, x, z))};
+    return FlipSign(u, hash, 1U) + FlipSign(v, hash, 2U);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Quintic(const simd::vec<float, N> t) noexcept
+{
+    return t * t * t * (t * (t * 6.0F - 15.0F) + 10.0F);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Mix(const simd::vec<float, N> a, const simd::vec<float, N> b, const simd::vec<float, N> t) noexcept
+{
+    return a + (b - a) * t;
+}
+
+// floor through truncation, minus one where truncation rounded up
+template <int N>
+BALBINO_FORCE_INLINE noise_i32<N> FloorInt(const simd::detail::raw<float, N> x) noexcept
+{
+    const noise_i32<N> truncated{__builtin_convertvector(x, noise_i32<N>)};
+    return truncated + (__builtin_convertvector(truncated, simd::detail::raw<float, N>) > x);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> ToFloat(const noise_i32<N> x) noexcept
+{
+    return simd::vec<float, N>{__builtin_convertvector(x, simd::detail::raw<float, N>)};
+}
+
+// lanes below zero or at the period come back into [0, period)
+template <int N>
+BALBINO_FORCE_INLINE noise_i32<N> WrapNear(const noise_i32<N> cell, const noise_i32<N> period) noexcept
+{
+    return cell + (period & (cell < 0)) - (period & (cell >= period));
+}
+
+template <int N>
+BALBINO_FORCE_INLINE noise_i32<N> Wrap(const noise_i32<N> cell, const noise_i32<N> period) noexcept
+{
+    const simd::detail::raw<float, N> quotient{ToFloat<N>(cell).r / ToFloat<N>(period).r};
+    // the quotient may round across a multiple of the period
+    return WrapNear<N>(cell - FloorInt<N>(quotient) * period, period);
+}
+
+// the hashed cells on both sides of x (times the axis prime) and the offset from the lower one
+template <int N, bool Periodic>
+BALBINO_FORCE_INLINE void Corners(const simd::vec<float, N> x, const std::uint32_t prime, const noise_i32<N> period, noise_u32<N>& lower, noise_u32<N>& upper,
+                                  simd::vec<float, N>& offset) noexcept
+{
+    noise_i32<N> cell{FloorInt<N>(x.r)};
+    offset = x - ToFloat<N>(cell);
+    if constexpr (Periodic)
+    {
+        cell = Wrap<N>(cell, period);
+        lower = std::bit_cast<noise_u32<N>>(cell) * prime;
+        upper = std::bit_cast<noise_u32<N>>(WrapNear<N>(cell + 1, period)) * prime;
+    }
+    else
+    {
+        lower = std::bit_cast<noise_u32<N>>(cell) * prime;
+        upper = lower + prime;
+    }
+}
+
+template <int N, bool Periodic = false>
+BALBINO_FORCE_INLINE simd::vec<float, N> Perlin2(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed, const noise_i32<N> period = noise_i32<N>{}) noexcept
+{
+    using V = simd::vec<float, N>;
+    V x0;
+    V y0;
+    noise_u32<N> px0;
+    noise_u32<N> px1;
+    noise_u32<N> py0;
+    noise_u32<N> py1;
+    Corners<N, Periodic>(x, noise_prime_x, period, px0, px1, x0);
+    Corners<N, Periodic>(y, noise_prime_y, period, py0, py1, y0);
+    const V x1{x0 - 1.0F};
+    const V y1{y0 - 1.0F};
+
+    const V n00{Gradient<N>(LatticeHash<N>(px0 ^ py0 ^ seed), x0, y0)};
+    const V n10{Gradient<N>(LatticeHash<N>(px1 ^ py0 ^ seed), x1, y0)};
+    const V n01{Gradient<N>(LatticeHash<N>(px0 ^ py1 ^ seed), x0, y1)};
+    const V n11{Gradient<N>(LatticeHash<N>(px1 ^ py1 ^ seed), x1, y1)};
+
+    const V u{Quintic(x0)};
+    return Mix(Mix(n00, n10, u), Mix(n01, n11, u), Quintic(y0));
+}
+
+template <int N, bool Periodic = false>
+BALBINO_FORCE_INLINE simd::vec<float, N> Perlin3(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const std::uint32_t seed,
+                                                 const noise_i32<N> period = noise_i32<N>{}) noexcept
+{
+    using V = simd::vec<float, N>;
+    V x0;
+    V y0;
+    V z0;
+    noise_u32<N> px0;
+    noise_u32<N> px1;
+    noise_u32<N> py0;
+    noise_u32<N> py1;
+    noise_u32<N> pz0;
+    noise_u32<N> pz1;
+    Corners<N, Periodic>(x, noise_prime_x, period, px0, px1, x0);
+    Corners<N, Periodic>(y, noise_prime_y, period, py0, py1, y0);
+    Corners<N, Periodic>(z, noise_prime_z, period, pz0, pz1, z0);
+    const V x1{x0 - 1.0F};
+    const V y1{y0 - 1.0F};
+    const V z1{z0 - 1.0F};
+
+    const V n000{Gradient<N>(LatticeHash<N>(px0 ^ py0 ^ pz0 ^ seed), x0, y0, z0)};
+    const V n100{Gradient<N>(LatticeHash<N>(px1 ^ py0 ^ pz0 ^ seed), x1, y0, z0)};
+    const V n010{Gradient<N>(LatticeHash<N>(px0 ^ py1 ^ pz0 ^ seed), x0, y1, z0)};
+    const V n110{Gradient<N>(LatticeHash<N>(px1 ^ py1 ^ pz0 ^ seed), x1, y1, z0)};
+    const V n001{Gradient<N>(LatticeHash<N>(px0 ^ py0 ^ pz1 ^ seed), x0, y0, z1)};
+    const V n101{Gradient<N>(LatticeHash<N>(px1 ^ py0 ^ pz1 ^ seed), x1, y0, z1)};
+    const V n011{Gradient<N>(LatticeHash<N>(px0 ^ py1 ^ pz1 ^ seed), x0, y1, z1)};
+    const V n111{Gradient<N>(LatticeHash<N>(px1 ^ py1 ^ pz1 ^ seed), x1, y1, z1)};
+
+    const V u{Quintic(x0)};
+    const V v{Quintic(y0)};
+    const V front{Mix(Mix(n000, n100, u), Mix(n010, n110, u), v)};
+    const V back{Mix(Mix(n001, n101, u), Mix(n011, n111, u), v)};
+    // the edge gradients peak at about 1.036 rather than 1
+    return Mix(front, back, Quintic(z0)) * 0.964921414852142333984375F;
+}
+
+// 32 tesseract edges: one coordinate dropped, the other three with hashed signs
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Gradient(const noise_u32<N> hash, const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z,
+                                                  const simd::vec<float, N> w) noexcept
+{
+    const noise_i32<N> dropped{std::bit_cast<noise_i32<N>>((hash >> 3U) & 3U)};
+    const simd::vec<float, N> a{Blend<N>(dropped == 0, y, x)};
+    const simd::vec<float, N> b{Blend<N>(dropped <= 1, z, y)};
+    const simd::vec<float, N> c{Blend<N>(dropped <= 2, w, z)};
+    return FlipSign(a, hash, 1U) + FlipSign(b, hash, 2U) + FlipSign(c, hash, 4U);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Lane(const noise_i32<N> mask) noexcept
+{
+    return ToFloat<N>(-mask);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE noise_u32<N> Step(const noise_i32<N> mask, const std::uint32_t prime) noexcept
+{
+    return std::bit_cast<noise_u32<N>>(mask) & prime;
+}
+
+// the radial kernel (0.5 - |d|^2)^4 of a simplex corner; 0.5 is the squared distance from a
+// corner to the opposite face, so the field stays continuous (Gustavson's 0.6 does not)
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Falloff(const simd::vec<float, N> distance2) noexcept
+{
+    const simd::vec<float, N> t{simd::vec<float, N>::splat(0.5F) - distance2};
+    const simd::vec<float, N> inside{Blend<N>(t.r > 0.0F, t, simd::vec<float, N>{})};
+    const simd::vec<float, N> t2{inside * inside};
+    return t2 * t2;
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex2(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed) noexcept
+{
+    using V = simd::vec<float, N>;
+    constexpr float skew{0.366025403784438646763723170752936183F};   // (sqrt(3) - 1) / 2
+    constexpr float unskew{0.211324865405187117745425609748853894F}; // (3 - sqrt(3)) / 6
+
+    const V s{(x + y) * skew};
+    const noise_i32<N> i{FloorInt<N>((x + s).r)};
+    const noise_i32<N> j{FloorInt<N>((y + s).r)};
+    const V t{ToFloat<N>(i + j) * unskew};
+    const V x0{x - ToFloat<N>(i) + t};
+    const V y0{y - ToFloat<N>(j) + t};
+
+    // the lower triangle steps along x first, the upper one along y
+    const noise_i32<N> lower{x0.r > y0.r};
+    const V x1{x0 - Lane<N>(lower) + unskew};
+    const V y1{y0 - Lane<N>(~lower) + unskew};
+    const V x2{x0 + (2.0F * unskew - 1.0F)};
+    const V y2{y0 + (2.0F * unskew - 1.0F)};
+
+    const noise_u32<N> pi{std::bit_cast<noise_u32<N>>(i) * noise_prime_x};
+    const noise_u32<N> pj{std::bit_cast<noise_u32<N>>(j) * noise_prime_y};
+    const noise_u32<N> h0{LatticeHash<N>(pi ^ pj ^ seed)};
+    const noise_u32<N> h1{LatticeHash<N>((pi + Step<N>(lower, noise_prime_x)) ^ (pj + Step<N>(~lower, noise_prime_y)) ^ seed)};
+    const noise_u32<N> h2{LatticeHash<N>((pi + noise_prime_x) ^ (pj + noise_prime_y) ^ seed)};
+
+    const V n{Falloff(x0 * x0 + y0 * y0) * Gradient<N>(h0, x0, y0) + Falloff(x1 * x1 + y1 * y1) * Gradient<N>(h1, x1, y1) +
+              Falloff(x2 * x2 + y2 * y2) * Gradient<N>(h2, x2, y2)};
+    return n * simplex_scale_2d;
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex3(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const std::uint32_t seed) noexcept
+{
+    using V = simd::vec<float, N>;
+    constexpr float skew{1.0F / 3.0F};
+    constexpr float unskew{1.0F / 6.0F};
+
+    const V s{(x + y + z) * skew};
+    const noise_i32<N> i{FloorInt<N>((x + s).r)};
+    const noise_i32<N> j{FloorInt<N>((y + s).r)};
+    const noise_i32<N> k{FloorInt<N>((z + s).r)};
+    const V t{ToFloat<N>(i + j + k) * unskew};
+    const V x0{x - ToFloat<N>(i) + t};
+    const V y0{y - ToFloat<N>(j) + t};
+    const V z0{z - ToFloat<N>(k) + t};
+
+    // the walk from corner 0 to corner 3 steps along the largest offset first
+    const noise_i32<N> xy{x0.r >= y0.r};
+    const noise_i32<N> yz{y0.r >= z0.r};
+    const noise_i32<N> xz{x0.r >= z0.r};
+    const noise_i32<N> i1{xy & xz};
+    const noise_i32<N> j1{~xy & yz};
+    const noise_i32<N> k1{~xz & ~yz};
+    const noise_i32<N> i2{xy | xz};
+    const noise_i32<N> j2{~xy | yz};
+    const noise_i32<N> k2{~xz | ~yz};
+
+    const V x1{x0 - Lane<N>(i1) + unskew};
+    const V y1{y0 - Lane<N>(j1) + unskew};
+    const V z1{z0 - Lane<N>(k1) + unskew};
+    const V x2{x0 - Lane<N>(i2) + 2.0F * unskew};
+    const V y2{y0 - Lane<N>(j2) + 2.0F * unskew};
+    const V z2{z0 - Lane<N>(k2) + 2.0F * unskew};
+    const V x3{x0 + (3.0F * unskew - 1.0F)};
+    const V y3{y0 + (3.0F * unskew - 1.0F)};
+    const V z3{z0 + (3.0F * unskew - 1.0F)};
+
+    const noise_u32<N> pi{std::bit_cast<noise_u32<N>>(i) * noise_prime_x};
+    const noise_u32<N> pj{std::bit_cast<noise_u32<N>>(j) * noise_prime_y};
+    const noise_u32<N> pk{std::bit_cast<noise_u32<N>>(k) * noise_prime_z};
+    const noise_u32<N> h0{LatticeHash<N>(pi ^ pj ^ pk ^ seed)};
+    const noise_u32<N> h1{LatticeHash<N>((pi + Step<N>(i1, noise_prime_x)) ^ (pj + Step<N>(j1, noise_prime_y)) ^ (pk + Step<N>(k1, noise_prime_z)) ^ seed)};
+    const noise_u32<N> h2{LatticeHash<N>((pi + Step<N>(i2, noise_prime_x)) ^ (pj + Step<N>(j2, noise_prime_y)) ^ (pk + Step<N>(k2, noise_prime_z)) ^ seed)};
+    const noise_u32<N> h3{LatticeHash<N>((pi + noise_prime_x) ^ (pj + noise_prime_y) ^ (pk + noise_prime_z) ^ seed)};
+
+    const V n{Falloff(x0 * x0 + y0 * y0 + z0 * z0) * Gradient<N>(h0, x0, y0, z0) + Falloff(x1 * x1 + y1 * y1 + z1 * z1) * Gradient<N>(h1, x1, y1, z1) +
+              Falloff(x2 * x2 + y2 * y2 + z2 * z2) * Gradient<N>(h2, x2, y2, z2) + Falloff(x3 * x3 + y3 * y3 + z3 * z3) * Gradient<N>(h3, x3, y3, z3)};
+    return n * simplex_scale_3d;
+}
+
+// counts a > b towards the rank of a, otherwise towards the rank of b
+template <int N>
+BALBINO_FORCE_INLINE void Order(noise_i32<N>& rankA, noise_i32<N>& rankB, const simd::vec<float, N> a, const simd::vec<float, N> b) noexcept
+{
+    const noise_i32<N> greater{(a.r > b.r) & 1};
+    rankA += greater;
+    rankB += 1 - greater;
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex4(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const simd::vec<float, N> w,
+                                                  const std::uint32_t seed) noexcept
+{
+    using V = simd::vec<float, N>;
+    constexpr float skew{0.309016994374947424102293417182819059F};   // (sqrt(5) - 1) / 4
+    constexpr float unskew{0.138196601125010515179541316563436189F}; // (5 - sqrt(5)) / 20
+
+    const V s{(x + y + z + w) * skew};
+    const noise_i32<N> i{FloorInt<N>((x + s).r)};
+    const noise_i32<N> j{FloorInt<N>((y + s).r)};
+    const noise_i32<N> k{FloorInt<N>((z + s).r)};
+    const noise_i32<N> l{FloorInt<N>((w + s).r)};
+    const V t{ToFloat<N>(i + j + k + l) * unskew};
+    const V x0{x - ToFloat<N>(i) + t};
+    const V y0{y - ToFloat<N>(j) + t};
+    const V z0{z - ToFloat<N>(k) + t};
+    const V w0{w - ToFloat<N>(l) + t};
+
+    // rank of every offset among the four: the walk steps along rank 3 first, rank 0 last
+    noise_i32<N> rx{};
+    noise_i32<N> ry{};
+    noise_i32<N> rz{};
+    noise_i32<N> rw{};
+    Order(rx, ry, x0, y0);
+    Order(rx, rz, x0, z0);
+    Order(rx, rw, x0, w0);
+    Order(ry, rz, y0, z0);
+    Order(ry, rw, y0, w0);
+    Order(rz, rw, z0, w0);
+
+    const V x1{x0 - Lane<N>(rx >= 3) + unskew};
+    const V y1{y0 - Lane<N>(ry >= 3) + unskew};
+    const V z1{z0 - Lane<N>(rz >= 3) + unskew};
+    const V w1{w0 - Lane<N>(rw >= 3) + unskew};
+    const V x2{x0 - Lane<N>(rx >= 2) + 2.0F * unskew};
+    const V y2{y0 - Lane<N>(ry >= 2) + 2.0F * unskew};
+    const V z2{z0 - Lane<N>(rz >= 2) + 2.0F * unskew};
+    const V w2{w0 - Lane<N>(rw >= 2) + 2.0F * unskew};
+    const V x3{x0 - Lane<N>(rx >= 1) + 3.0F * unskew};
+    const V y3{y0 - Lane<N>(ry >= 1) + 3.0F * unskew};
+    const V z3{z0 - Lane<N>(rz >= 1) + 3.0F * unskew};
+    const V w3{w0 - Lane<N>(rw >= 1) + 3.0F * unskew};
+    const V x4{x0 + (4.0F * unskew - 1.0F)};
+    const V y4{y0 + (4.0F * unskew - 1.0F)};
+    const V z4{z0 + (4.0F * unskew - 1.0F)};
+    const V w4{w0 + (4.0F * unskew - 1.0F)};
+
+    const noise_u32<N> pi{std::bit_cast<noise_u32<N>>(i) * noise_prime_x};
+    const noise_u32<N> pj{std::bit_cast<noise_u32<N>>(j) * noise_prime_y};
+    const noise_u32<N> pk{std::bit_cast<noise_u32<N>>(k) * noise_prime_z};
+    const noise_u32<N> pl{std::bit_cast<noise_u32<N>>(l) * noise_prime_w};
+    const noise_u32<N> h0{LatticeHash<N>(pi ^ pj ^ pk ^ pl ^ seed)};
+    const noise_u32<N> h1{LatticeHash<N>((pi + Step<N>(rx >= 3, noise_prime_x)) ^ (pj + Step<N>(ry >= 3, noise_prime_y)) ^ (pk + Step<N>(rz >= 3, noise_prime_z)) ^
+                                         (pl + Step<N>(rw >= 3, noise_prime_w)) ^ seed)};
+    const noise_u32<N> h2{LatticeHash<N>((pi + Step<N>(rx >= 2, noise_prime_x)) ^ (pj + Step<N>(ry >= 2, noise_prime_y)) ^ (pk + Step<N>(rz >= 2, noise_prime_z)) ^
+                                         (pl + Step<N>(rw >= 2, noise_prime_w)) ^ seed)};
+    const noise_u32<N> h3{LatticeHash<N>((pi + Step<N>(rx >= 1, noise_prime_x)) ^ (pj + Step<N>(ry >= 1, noise_prime_y)) ^ (pk + Step<N>(rz >= 1, noise_prime_z)) ^
+                                         (pl + Step<N>(rw >= 1, noise_prime_w)) ^ seed)};
+    const noise_u32<N> h4{LatticeHash<N>((pi + noise_prime_x) ^ (pj + noise_prime_y) ^ (pk + noise_prime_z) ^ (pl + noise_prime_w) ^ seed)};
+
+    const V n{Falloff(x0 * x0 + y0 * y0 + z0 * z0 + w0 * w0) * Gradient<N>(h0, x0, y0, z0, w0) +
+              Falloff(x1 * x1 + y1 * y1 + z1 * z1 + w1 * w1) * Gradient<N>(h1, x1, y1, z1, w1) +
+              Falloff(x2 * x2 + y2 * y2 + z2 * z2 + w2 * w2) * Gradient<N>(h2, x2, y2, z2, w2) +
+              Falloff(x3 * x3 + y3 * y3 + z3 * z3 + w3 * w3) * Gradient<N>(h3, x3, y3, z3, w3) +
+              Falloff(x4 * x4 + y4 * y4 + z4 * z4 + w4 * w4) * Gradient<N>(h4, x4, y4, z4, w4)};
+    return n * simplex_scale_4d;
+}
+
+// feature points sit in the middle worley_jitter of their cell. Against a 5x5(x5) search the
+// 3x3(x3) neighbourhood missed no F1 or F2 over a million samples; at full jitter it misses
+// about one F2 in ten thousand.
+inline constexpr float worley_jitter{0.75F};
+
+template <int N>
+BALBINO_FORCE_INLINE void Nearest(const simd::vec<float, N> distance2, simd::vec<float, N>& f1, simd::vec<float, N>& f2) noexcept
+{
+    const noise_i32<N> closer{distance2.r < f1.r};
+    f2 = Blend<N>(closer, f1, Blend<N>(distance2.r < f2.r, distance2, f2));
+    f1 = Blend<N>(closer, distance2, f1);
+}
+
+template <int N, bool Periodic>
+BALBINO_FORCE_INLINE WorleyDistances<simd::vec<float, N>> Worley2(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed,
+                                                                  const noise_i32<N> period) noexcept
+{
+    using V = simd::vec<float, N>;
+    noise_i32<N> cx{FloorInt<N>(x.r)};
+    noise_i32<N> cy{FloorInt<N>(y.r)};
+    const V fx{x - ToFloat<N>(cx)};
+    const V fy{y - ToFloat<N>(cy)};
+    if constexpr (Periodic)
+    {
+        cx = Wrap<N>(cx, period);
+        cy = Wrap<N>(cy, period);
+    }
+
+    constexpr float scale{worley_jitter / 65536.0F};
+    constexpr float margin{0.5F * (1.0F - worley_jitter)};
+    V f1{V::splat(8.0F)};
+    V f2{V::splat(8.0F)};
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+        noise_i32<N> ny{cy + dy};
+        if constexpr (Periodic)
+        {
+            ny = WrapNear<N>(ny, period);
+        }
+        const noise_u32<N> hy{std::bit_cast<noise_u32<N>>(ny) * noise_prime_y ^ seed};
+        const V oy{fy - (static_cast<float>(dy) + margin)};
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            noise_i32<N> nx{cx + dx};
+            if constexpr (Periodic)
+            {
+                nx = WrapNear<N>(nx, period);
+            }
+            const noise_i32<N> h{std::bit_cast<noise_i32<N>>(LatticeHash<N>(std::bit_cast<noise_u32<N>>(nx) * noise_prime_x ^ hy))};
+            const V px{ToFloat<N>(h & 0xFFFF) * scale - (fx - (static_cast<float>(dx) + margin))};
+            const V py{ToFloat<N>((h >> 16) & 0xFFFF) * scale - oy};
+            Nearest(px * px + py * py, f1, f2);
+        }
+    }
+    return {simd::sqrt(f1), simd::sqrt(f2)};
+}
+
+template <int N, bool Periodic>
+BALBINO_FORCE_INLINE WorleyDistances<simd::vec<float, N>> Worley3(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z,
+                                                                  const std::uint32_t seed, const noise_i32<N> period) noexcept
+{
+    using V = simd::vec<float, N>;
+    noise_i32<N> cx{FloorInt<N>(x.r)};
+    noise_i32<N> cy{FloorInt<N>(y.r)};
+    noise_i32<N> cz{FloorInt<N>(z.r)};
+    const V fx{x - ToFloat<N>(cx)};
+    const V fy{y - ToFloat<N>(cy)};
+    const V fz{z - ToFloat<N>(cz)};
+    if constexpr (Periodic)
+    {
+        cx = Wrap<N>(cx, period);
+        cy = Wrap<N>(cy, period);
+        cz = Wrap<N>(cz, period);
+    }
+
+    constexpr float scale{worley_jitter / 1024.0F};
+    constexpr float margin{0.5F * (1.0F - worley_jitter)};
+    V f1{V::splat(8.0F)};
+    V f2{V::splat(8.0F)};
+    for (int dz = -1; dz <= 1; ++dz)
+    {
+        noise_i32<N> nz{cz + dz};
+        if constexpr (Periodic)
+        {
+            nz = WrapNear<N>(nz, period);
+        }
+        const noise_u32<N> hz{std::bit_cast<noise_u32<N>>(nz) * noise_prime_z ^ seed};
+        const V oz{fz - (static_cast<float>(dz) + margin)};
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            noise_i32<N> ny{cy + dy};
+            if constexpr (Periodic)
+            {
+                ny = WrapNear<N>(ny, period);
+            }
+            const noise_u32<N> hy{std::bit_cast<noise_u32<N>>(ny) * noise_prime_y ^ hz};
+            const V oy{fy - (static_cast<float>(dy) + margin)};
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                noise_i32<N> nx{cx + dx};
+                if constexpr (Periodic)
+                {
+                    nx = WrapNear<N>(nx, period);
+                }
+                const noise_i32<N> h{std::bit_cast<noise_i32<N>>(LatticeHash<N>(std::bit_cast<noise_u32<N>>(nx) * noise_prime_x ^ hy))};
+                const V px{ToFloat<N>(h & 0x3FF) * scale - (fx - (static_cast<float>(dx) + margin))};
+                const V py{ToFloat<N>((h >> 10) & 0x3FF) * scale - oy};
+                const V pz{ToFloat<N>((h >> 20) & 0x3FF) * scale - oz};
+                Nearest(px * px + py * py + pz * pz, f1, f2);
+            }
+        }
+    }
+    return {simd::sqrt(f1), simd::sqrt(f2)};
+}
+
+template <int N, bool Volume>
+BALBINO_FORCE_INLINE simd::vec<float, N> Octave(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const simd::vec<float, N> frequency,
+                                                const std::uint32_t seed, const NoiseSettings& settings, const simd::vec<float, N> period) noexcept
+{
+    const simd::vec<float, N> fx{x * frequency};
+    const simd::vec<float, N> fy{y * frequency};
+    const simd::vec<float, N> fz{z * frequency};
+    if (settings.basis == NoiseBasis::Simplex)
+    {
+        if constexpr (Volume)
+        {
+            return Simplex3<N>(fx, fy, fz, seed);
+        }
+        else
+        {
+            return Simplex2<N>(fx, fy, seed);
+        }
+    }
+    if (settings.period != 0)
+    {
+        const noise_i32<N> cells{FloorInt<N>((period + 0.5F).r)};
+        if constexpr (Volume)
+        {
+            return Perlin3<N, true>(fx, fy, fz, seed, cells);
+        }
+        else
+        {
+            return Perlin2<N, true>(fx, fy, seed, cells);
+        }
+    }
+    if constexpr (Volume)
+    {
+        return Perlin3<N>(fx, fy, fz, seed);
+    }
+    else
+    {
+        return Perlin2<N>(fx, fy, seed);
+    }
+}
+
+// octave i samples at frequency * lacunarity^i with seed + i, weighted gain^i; the sum is
+// divided by the total weight so every kind keeps its range for any octave count
+template <int N, bool Volume>
+BALBINO_FORCE_INLINE simd::vec<float, N> Fractal(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const NoiseSettings& settings) noexcept
+{
+    using V = simd::vec<float, N>;
+    if (settings.kind == NoiseKind::Perlin)
+    {
+        const V period{settings.period != 0 ? V::splat(static_cast<float>(settings.period)) : V{}};
+        return Octave<N, Volume>(x, y, z, V::splat(settings.frequency), settings.seed, settings, period);
+    }
+
+    // frequency and amplitude stay in lanes: splatting them per octave costs more than the
+    // vector multiply that advances them
+    const V lacunarity{V::splat(settings.lacunarity)};
+    const V gain{V::splat(settings.gain)};
+    V frequency{V::splat(settings.frequency)};
+    V period{V::splat(static_cast<float>(settings.period))};
+    V amplitude{V::splat(1.0F)};
+    V sum{};
+    float weight{1.0F};
+    float total{};
+    for (int i = 0; i < settings.octaves; ++i)
+    {
+        const V n{Octave<N, Volume>(x, y, z, frequency, settings.seed + static_cast<std::uint32_t>(i), settings, period)};
+        switch (settings.kind)
+        {
+        case NoiseKind::Ridged:
+        {
+            const V crest{V::splat(1.0F) - simd::abs(n)};
+            sum += (crest * crest * 2.0F - 1.0F) * amplitude;
+            break;
+        }
+        case NoiseKind::Turbulence:
+            sum += simd::abs(n) * amplitude;
+            break;
+        default:
+            sum += n * amplitude;
+            break;
+        }
+        total += weight;
+        weight *= settings.gain;
+        frequency *= lacunarity;
+        period *= lacunarity;
+        amplitude *= gain;
+    }
+    return total > 0.0F ? sum * (1.0F / total) : sum;
+}
+
+template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> LaneOffsets() noexcept
+{
+    constexpr std::array<float, 16> offsets{0.0F, 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F, 10.0F, 11.0F, 12.0F, 13.0F, 14.0F, 15.0F};
+    return simd::vec<float, N>::load(offsets.data());
+}
+
+struct noise_grid
+{
+    float* out;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t depth;
+    float3 origin;
+    float3 step;
+};
+
+// x runs across the lanes; one row of the tile at a time
+template <int N, bool Volume>
+BALBINO_FORCE_INLINE void FillGridKernel(const noise_grid& grid, const NoiseSettings& settings) noexcept
+{
+    using V = simd::vec<float, N>;
+    // column indices stay whole floats, so x matches the scalar origin + i * step exactly
+    const V lanes{LaneOffsets<N>()};
+    const V width{V::splat(static_cast<float>(N))};
+    const V stepX{V::splat(grid.step.x)};
+    const V originX{V::splat(grid.origin.x)};
+    float* out{grid.out};
+    for (std::uint32_t k = 0; k < grid.depth; ++k)
+    {
+        const V z{V::splat(grid.origin.z + static_cast<float>(k) * grid.step.z)};
+        for (std::uint32_t j = 0; j < grid.height; ++j)
+        {
+            const V y{V::splat(grid.origin.y + static_cast<float>(j) * grid.step.y)};
+            V column{lanes};
+            for (std::uint32_t i = 0; i < grid.width; i += N, column += width)
+            {
+                const V x{column * stepX + originX};
+                const V value{Fractal<N, Volume>(x, y, z, settings)};
+                const int active{static_cast<int>(std::min<std::uint32_t>(N, grid.width - i))};
+                if (active == N)
+                {
+                    value.store(out + i);
+                }
+                else
+                {
+                    value.store_partial(out + i, active);
+                }
+            }
+            out += grid.width;
+        }
+    }
+}
+
+using FillGridFn = void (*)(const noise_grid&, const NoiseSettings&) noexcept;
+
+template <bool Volume>
+void FillGridBaseline(const noise_grid& grid, const NoiseSettings& settings) noexcept
+{
+    FillGridKernel<8, Volume>(grid, settings);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+template <bool Volume>
+BALBINO_TARGET_AVX2 void FillGridAvx2(const noise_grid& grid, const NoiseSettings& settings) noexcept
+{
+    FillGridKernel<8, Volume>(grid, settings);
+}
+
+template <bool Volume>
+BALBINO_TARGET_AVX512 void FillGridAvx512(const noise_grid& grid, const NoiseSettings& settings) noexcept
+{
+    FillGridKernel<16, Volume>(grid, settings);
+}
+#endif
+
+template <bool Volume>
+void FillGrid(const noise_grid& grid, const NoiseSettings& settings) noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const FillGridFn kernel =
+        DispatchTable<FillGridFn>{FillGridBaseline<Volume>, nullptr, FillGridAvx2<Volume>, FillGridAvx512<Volume>}.Select(ActiveSimdLevel());
+#else
+    static const FillGridFn kernel = FillGridBaseline<Volume>;
+#endif
+    kernel(grid, settings);
+}
+} // namespace detail
+
+// ---- per point ----------------------------------------------------------
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Perlin(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Perlin2<N>(x, y, seed);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Perlin(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Perlin3<N>(x, y, z, seed);
+}
+
+export inline float Perlin(const float x, const float y, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Perlin2<4>(simd::f32x4::splat(x), simd::f32x4::splat(y), seed)[0];
+}
+
+export inline float Perlin(const float x, const float y, const float z, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Perlin3<4>(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4::splat(z), seed)[0];
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex2<N>(x, y, seed);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex3<N>(x, y, z, seed);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Simplex(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const simd::vec<float, N> w,
+                                                 const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex4<N>(x, y, z, w, seed);
+}
+
+export inline float Simplex(const float x, const float y, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex2<4>(simd::f32x4::splat(x), simd::f32x4::splat(y), seed)[0];
+}
+
+export inline float Simplex(const float x, const float y, const float z, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex3<4>(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4::splat(z), seed)[0];
+}
+
+export inline float Simplex(const float x, const float y, const float z, const float w, const std::uint32_t seed = 0) noexcept
+{
+    return detail::Simplex4<4>(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4::splat(z), simd::f32x4::splat(w), seed)[0];
+}
+
+// with a period > 0 the feature points repeat every `period` cells along each axis
+export template <int N>
+BALBINO_FORCE_INLINE WorleyDistances<simd::vec<float, N>> Worley(const simd::vec<float, N> x, const simd::vec<float, N> y, const std::uint32_t seed = 0,
+                                                                 const std::uint32_t period = 0) noexcept
+{
+    if (period != 0)
+    {
+        return detail::Worley2<N, true>(x, y, seed, detail::noise_i32<N>{} + static_cast<std::int32_t>(period));
+    }
+    return detail::Worley2<N, false>(x, y, seed, detail::noise_i32<N>{});
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE WorleyDistances<simd::vec<float, N>> Worley(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z,
+                                                                 const std::uint32_t seed = 0, const std::uint32_t period = 0) noexcept
+{
+    if (period != 0)
+    {
+        return detail::Worley3<N, true>(x, y, z, seed, detail::noise_i32<N>{} + static_cast<std::int32_t>(period));
+    }
+    return detail::Worley3<N, false>(x, y, z, seed, detail::noise_i32<N>{});
+}
+
+export inline WorleyDistances<float> Worley(const float x, const float y, const std::uint32_t seed = 0, const std::uint32_t period = 0) noexcept
+{
+    const WorleyDistances<simd::f32x4> d{Worley(simd::f32x4::splat(x), simd::f32x4::splat(y), seed, period)};
+    return {d.f1[0], d.f2[0]};
+}
+
+export inline WorleyDistances<float> Worley(const float x, const float y, const float z, const std::uint32_t seed = 0, const std::uint32_t period = 0) noexcept
+{
+    const WorleyDistances<simd::f32x4> d{Worley(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4::splat(z), seed, period)};
+    return {d.f1[0], d.f2[0]};
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Noise(const simd::vec<float, N> x, const simd::vec<float, N> y, const NoiseSettings& settings = {}) noexcept
+{
+    return detail::Fractal<N, false>(x, y, simd::vec<float, N>{}, settings);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE simd::vec<float, N> Noise(const simd::vec<float, N> x, const simd::vec<float, N> y, const simd::vec<float, N> z, const NoiseSettings& settings = {}) noexcept
+{
+    return detail::Fractal<N, true>(x, y, z, settings);
+}
+
+export inline float Noise(const float x, const float y, const NoiseSettings& settings = {}) noexcept
+{
+    return detail::Fractal<4, false>(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4{}, settings)[0];
+}
+
+export inline float Noise(const float x, const float y, const float z, const NoiseSettings& settings = {}) noexcept
+{
+    return detail::Fractal<4, true>(simd::f32x4::splat(x), simd::f32x4::splat(y), simd::f32x4::splat(z), settings)[0];
+}
+
+// ---- grids ----------------------------------------------------------------
+
+// out[j * width + i] = Noise(origin + (i, j) * step); out must hold width * height values
+export inline void FillGrid2D(const std::span<float> out, const std::uint32_t width, const std::uint32_t height, const float2 origin, const float2 step,
+                              const NoiseSettings& settings = {}) noexcept
+{
+    BALBINO_ASSERT(out.size() >= std::size_t{width} * height, "FillGrid2D output holds fewer than width * height values");
+    detail::FillGrid<false>({out.data(), width, height, 1, float3{origin.x, origin.y, 0.0F}, float3{step.x, step.y, 0.0F}}, settings);
+}
+
+// out[(k * height + j) * width + i] = Noise(origin + (i, j, k) * step); out must hold width * height * depth values
+export inline void FillGrid3D(const std::span<float> out, const std::uint32_t width, const std::uint32_t height, const std::uint32_t depth, const float3 origin,
+                              const float3 step, const NoiseSettings& settings = {}) noexcept
+{
+    BALBINO_ASSERT(out.size() >= std::size_t{width} * height * depth, "FillGrid3D output holds fewer than width * height * depth values");
+    detail::FillGrid<true>({out.data(), width, height, depth, origin, step}, settings);
+}
+} // namespace fawn_algebra
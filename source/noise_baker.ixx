@@ -0,0 +1,384 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/assert.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:NoiseBaker;
+import :Arithmetics;
+import :Hashing;
+import :Noise;
+import std;
+
+// Chunked noise baking for world streaming. A NoiseBaker owns a small worker pool and an LRU
+// cache of finished chunks keyed by the noise settings and the chunk coordinate, so streaming
+// the same region again is served from memory instead of recomputed.
+//
+//   Chunk(coord, settings)              one chunk, from the cache or baked on the calling thread
+//   Bake(first, count, settings, fn)    chunks baked on the pool; fn sees each one as it is done
+//   Bake(first, count, settings, out)   the region assembled into one caller-owned array, for
+//                                       example a memory-mapped file
+//
+// Chunk c covers texels c * chunkSize onward and texel t samples the noise at t * texelSize,
+// so neighbouring chunks continue each other. Two requests for the same chunk at the same time
+// bake it once: the second waits for the first. A chunk whose baking throws is not cached; the
+// exception reaches every request waiting for it, and the next request bakes it again.
+namespace fawn_algebra
+{
+export struct NoiseBakerSettings
+{
+    uint3 chunkSize{64, 64, 1};
+    float3 texelSize{1.0F, 1.0F, 1.0F};
+    bool volume{};                // 3D noise; otherwise chunks are chunkSize.x by chunkSize.y
+    std::size_t cacheChunks{256}; // finished chunks kept, least recently used evicted first
+    std::uint32_t threads{};      // 0: one per hardware thread
+};
+
+export struct NoiseChunk
+{
+    int3 coord;
+    std::vector<float> texels; // x fastest, then y, then z
+};
+
+namespace detail
+{
+struct baked_chunk
+{
+    NoiseChunk chunk;
+    std::exception_ptr error; // set before ready when baking threw
+    std::atomic<bool> ready;
+};
+
+// chunks left and the first exception of one NoiseBaker::Bake call
+struct bake_state
+{
+    std::atomic<std::uint32_t> remaining;
+    std::mutex mutex;
+    std::exception_ptr error;
+
+    explicit bake_state(const std::uint32_t chunks) noexcept
+        : remaining{chunks}
+    {
+    }
+};
+
+// every NoiseSettings field and the chunk coordinate, without the struct padding
+struct chunk_key
+{
+    std::array<std::uint32_t, 10> words;
+
+    bool operator==(const chunk_key&) const = default;
+};
+
+struct chunk_key_hash
+{
+    std::size_t operator()(const chunk_key& key) const noexcept
+    {
+        const std::uint32_t* words{key.words.data()};
+        return HashWord(words, static_cast<std::uint32_t>(key.words.size()), 0U);
+    }
+};
+
+inline chunk_key MakeChunkKey(const int3 coord, const NoiseSettings& settings) noexcept
+{
+    return {{static_cast<std::uint32_t>(settings.kind) | static_cast<std::uint32_t>(settings.basis) << 8U, settings.seed, std::bit_cast<std::uint32_t>(settings.frequency),
+             static_cast<std::uint32_t>(settings.octaves), std::bit_cast<std::uint32_t>(settings.lacunarity), std::bit_cast<std::uint32_t>(settings.gain), settings.period,
+             static_cast<std::uint32_t>(coord.x), static_cast<std::uint32_t>(coord.y), static_cast<std::uint32_t>(coord.z)}};
+}
+} // namespace detail
+
+// Handle to the chunks of one NoiseBaker::Bake call
+export class NoiseBakeJob
+{
+  public:
+    NoiseBakeJob() = default;
+
+    explicit NoiseBakeJob(const std::uint32_t chunks)
+        : m_state{std::make_shared<detail::bake_state>(chunks)}
+    {
+    }
+
+    [[nodiscard]] bool Done() const noexcept
+    {
+        return !m_state || m_state->remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    // rethrows the first exception a chunk or its callback threw, once every chunk is done
+    void Wait() const
+    {
+        if (!m_state)
+        {
+            return;
+        }
+        for (std::uint32_t left{m_state->remaining.load(std::memory_order_acquire)}; left != 0; left = m_state->remaining.load(std::memory_order_acquire))
+        {
+            m_state->remaining.wait(left, std::memory_order_acquire);
+        }
+        if (m_state->error)
+        {
+            std::rethrow_exception(m_state->error);
+        }
+    }
+
+  private:
+    friend class NoiseBaker;
+
+    void Fail(std::exception_ptr error) const noexcept
+    {
+        const std::scoped_lock lock{m_state->mutex};
+        if (!m_state->error)
+        {
+            m_state->error = std::move(error);
+        }
+    }
+
+    void Finish() const noexcept
+    {
+        if (m_state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_state->remaining.notify_all();
+        }
+    }
+
+    std::shared_ptr<detail::bake_state> m_state;
+};
+
+// Destroying the baker finishes the chunks already queued, then joins the workers.
+export class NoiseBaker
+{
+  public:
+    explicit NoiseBaker(const NoiseBakerSettings& settings = {})
+        : m_settings{settings}
+    {
+        if (!m_settings.volume)
+        {
+            m_settings.chunkSize.z = 1;
+        }
+        const std::uint32_t threads{m_settings.threads != 0 ? m_settings.threads : std::max(1U, std::thread::hardware_concurrency())};
+        m_workers.reserve(threads);
+        for (std::uint32_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back([this](const std::stop_token stop) { Work(stop); });
+        }
+    }
+
+    NoiseBaker(const NoiseBaker&)            = delete;
+    NoiseBaker& operator=(const NoiseBaker&) = delete;
+
+    [[nodiscard]] const NoiseBakerSettings& Settings() const noexcept
+    {
+        return m_settings;
+    }
+
+    // texels in one chunk
+    [[nodiscard]] std::size_t ChunkTexels() const noexcept
+    {
+        return static_cast<std::size_t>(m_settings.chunkSize.x) * m_settings.chunkSize.y * m_settings.chunkSize.z;
+    }
+
+    [[nodiscard]] std::uint64_t CacheHits() const noexcept
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t CacheMisses() const noexcept
+    {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+
+    // the chunk stays valid after it is evicted from the cache
+    [[nodiscard]] std::shared_ptr<const NoiseChunk> Chunk(const int3 coord, const NoiseSettings& settings)
+    {
+        const auto [entry, owner]{Acquire(coord, settings)};
+        if (owner)
+        {
+            try
+            {
+                Compute(entry->chunk, settings);
+            }
+            catch (...)
+            {
+                entry->error = std::current_exception();
+                entry->ready.store(true, std::memory_order_release);
+                entry->ready.notify_all();
+                Evict(coord, settings, entry);
+                throw;
+            }
+            entry->ready.store(true, std::memory_order_release);
+            entry->ready.notify_all();
+        }
+        else
+        {
+            entry->ready.wait(false, std::memory_order_acquire);
+            if (entry->error)
+            {
+                std::rethrow_exception(entry->error);
+            }
+        }
+        return {entry, &entry->chunk};
+    }
+
+    // onChunk runs on the worker threads, once per chunk, in no particular order; 2D bakers
+    // take count.z = 1. A chunk that throws, in baking or in onChunk, still counts as done, and
+    // the job's Wait() rethrows the first exception.
+    NoiseBakeJob Bake(const int3 first, const uint3 count, const NoiseSettings& settings, std::function<void(const NoiseChunk&)> onChunk)
+    {
+        // the chunk count in 64 bits: the product of three uint32 counts wraps in 32
+        const std::uint64_t plane{std::uint64_t{count.x} * count.y};
+        BALBINO_ASSERT(count.z == 0 || plane <= std::numeric_limits<std::uint32_t>::max() / count.z, "Bake region holds more chunks than a job can count");
+        const NoiseBakeJob job{static_cast<std::uint32_t>(plane * count.z)};
+        if (job.Done())
+        {
+            return job;
+        }
+        const auto callback{std::make_shared<const std::function<void(const NoiseChunk&)>>(std::move(onChunk))};
+        {
+            const std::scoped_lock lock{m_queueMutex};
+            for (std::uint32_t k = 0; k < count.z; ++k)
+            {
+                for (std::uint32_t j = 0; j < count.y; ++j)
+                {
+                    for (std::uint32_t i = 0; i < count.x; ++i)
+                    {
+                        const int3 coord{first.x + static_cast<std::int32_t>(i), first.y + static_cast<std::int32_t>(j), first.z + static_cast<std::int32_t>(k)};
+                        m_queue.emplace_back([this, coord, settings, callback, job] {
+                            try
+                            {
+                                (*callback)(*Chunk(coord, settings));
+                            }
+                            catch (...)
+                            {
+                                job.Fail(std::current_exception());
+                            }
+                            job.Finish();
+                        });
+                    }
+                }
+            }
+        }
+        m_wake.notify_all();
+        return job;
+    }
+
+    // out holds the count * chunkSize region, x fastest, and must outlive the job; every chunk
+    // copies its rows in place
+    NoiseBakeJob Bake(const int3 first, const uint3 count, const NoiseSettings& settings, const std::span<float> out)
+    {
+        const uint3 size{m_settings.chunkSize};
+        const std::size_t width{static_cast<std::size_t>(count.x) * size.x};
+        const std::size_t height{static_cast<std::size_t>(count.y) * size.y};
+        BALBINO_ASSERT(out.size() >= width * height * (static_cast<std::size_t>(count.z) * size.z), "Bake output holds fewer values than the region");
+        return Bake(first, count, settings, [out, first, size, width, height](const NoiseChunk& chunk) {
+            const std::size_t x{static_cast<std::size_t>(chunk.coord.x - first.x) * size.x};
+            const std::size_t y{static_cast<std::size_t>(chunk.coord.y - first.y) * size.y};
+            const std::size_t z{static_cast<std::size_t>(chunk.coord.z - first.z) * size.z};
+            for (std::uint32_t k = 0; k < size.z; ++k)
+            {
+                for (std::uint32_t j = 0; j < size.y; ++j)
+                {
+                    const auto row{chunk.texels.begin() + (static_cast<std::ptrdiff_t>(k) * size.y + j) * size.x};
+                    std::copy_n(row, size.x, out.begin() + static_cast<std::ptrdiff_t>(((z + k) * height + y + j) * width + x));
+                }
+            }
+        });
+    }
+
+  private:
+    using lru_list = std::list<std::pair<detail::chunk_key, std::shared_ptr<detail::baked_chunk>>>;
+
+    // the cached entry for the chunk, and whether the caller has to bake it
+    std::pair<std::shared_ptr<detail::baked_chunk>, bool> Acquire(const int3 coord, const NoiseSettings& settings)
+    {
+        const detail::chunk_key key{detail::MakeChunkKey(coord, settings)};
+        const std::scoped_lock lock{m_cacheMutex};
+        if (const auto found{m_index.find(key)}; found != m_index.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, found->second);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return {found->second->second, false};
+        }
+
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        auto entry{std::make_shared<detail::baked_chunk>()};
+        entry->chunk.coord = coord;
+        if (m_settings.cacheChunks == 0)
+        {
+            return {entry, true};
+        }
+        m_lru.emplace_front(key, entry);
+        m_index.emplace(key, m_lru.begin());
+        if (m_lru.size() > m_settings.cacheChunks)
+        {
+            m_index.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+        return {entry, true};
+    }
+
+    // drops a chunk that failed to bake, unless it was evicted and requested again meanwhile
+    void Evict(const int3 coord, const NoiseSettings& settings, const std::shared_ptr<detail::baked_chunk>& entry)
+    {
+        const std::scoped_lock lock{m_cacheMutex};
+        if (const auto found{m_index.find(detail::MakeChunkKey(coord, settings))}; found != m_index.end() && found->second->second == entry)
+        {
+            m_lru.erase(found->second);
+            m_index.erase(found);
+        }
+    }
+
+    void Compute(NoiseChunk& chunk, const NoiseSettings& settings) const
+    {
+        const uint3 size{m_settings.chunkSize};
+        const float3 texel{m_settings.texelSize};
+        const float3 origin{static_cast<float>(static_cast<std::int64_t>(chunk.coord.x) * size.x) * texel.x,
+                            static_cast<float>(static_cast<std::int64_t>(chunk.coord.y) * size.y) * texel.y,
+                            static_cast<float>(static_cast<std::int64_t>(chunk.coord.z) * size.z) * texel.z};
+        chunk.texels.resize(ChunkTexels());
+        if (m_settings.volume)
+        {
+            FillGrid3D(std::span{chunk.texels}, size.x, size.y, size.z, origin, texel, settings);
+        }
+        else
+        {
+            FillGrid2D(std::span{chunk.texels}, size.x, size.y, float2{origin.x, origin.y}, float2{texel.x, texel.y}, settings);
+        }
+    }
+
+    void Work(const std::stop_token& stop)
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock{m_queueMutex};
+                // past a stop request the queue still drains
+                if (!m_wake.wait(lock, stop, [this] { return !m_queue.empty(); }))
+                {
+                    return;
+                }
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            task();
+        }
+    }
+
+    NoiseBakerSettings m_settings;
+
+    std::mutex m_cacheMutex;
+    lru_list m_lru;
+    std::unordered_map<detail::chunk_key, lru_list::iterator, detail::chunk_key_hash> m_index;
+    std::atomic<std::uint64_t> m_hits{};
+    std::atomic<std::uint64_t> m_misses{};
+
+    std::mutex m_queueMutex;
+    std::condition_variable_any m_wake;
+    std::deque<std::function<void()>> m_queue;
+
+    // last, so the workers are joined before anything they use goes away
+    std::vector<std::jthread> m_workers;
+};
+} // namespace fawn_algebra
@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:PerfectHash;
+import :Hashing;
+import std;
+
+// Minimal perfect hash tables built at compile time from a fixed list of strings: attribute names,
+// shader parameters, enum names. Construction is consteval and uses hash and displace (CHD): keys are
+// hashed with Hash64 and spread over buckets of about two keys, and buckets are placed largest first,
+// each trying displacements until all its keys land on free slots. N keys fill exactly N slots.
+//
+//   constexpr std::string_view names[]{"position", "normal", "uv"};
+//   constexpr PerfectHash table{names};
+//   table.Index("normal") == 1
+//
+// A lookup is one Hash64, a read of the key's bucket displacement and a read of its slot. The slot
+// holds the key's full 64-bit hash instead of the string, so a string that is not in the table is
+// told apart without comparing characters, and is only mistaken for a key when all 64 bits match.
+//
+// A key listed twice does not compile (PerfectHashDuplicateKey). Keys whose hashes collide, or that
+// cannot be placed, are retried under other seeds; a set that fails every seed does not compile
+// (PerfectHashNoSeedFound), which takes far more than the few thousand keys these tables are for.
+namespace fawn_algebra
+{
+namespace detail
+{
+// not constexpr: reaching either during construction stops compilation with its name
+inline void PerfectHashDuplicateKey() noexcept
+{
+}
+
+inline void PerfectHashNoSeedFound() noexcept
+{
+}
+
+// displacements are stored in 16 bits
+inline constexpr std::uint32_t perfect_hash_max_displacement{1U << 16U};
+inline constexpr std::uint64_t perfect_hash_max_seed{64};
+
+constexpr std::size_t PerfectHashBuckets(const std::size_t keys) noexcept
+{
+    return (keys + 1) / 2;
+}
+
+// (x * range) / 2^32, a range reduction without a modulo
+constexpr std::size_t PerfectHashReduce(const std::uint32_t x, const std::size_t range) noexcept
+{
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(x) * range) >> 32U);
+}
+
+constexpr std::size_t PerfectHashBucket(const std::uint64_t hash, const std::size_t buckets) noexcept
+{
+    return PerfectHashReduce(static_cast<std::uint32_t>(hash), buckets);
+}
+
+constexpr std::size_t PerfectHashSlot(const std::uint64_t hash, const std::uint32_t displacement, const std::size_t slots) noexcept
+{
+    return PerfectHashReduce(static_cast<std::uint32_t>(MulFold(hash ^ displacement, 0x9E3779B97F4A7C15ULL) >> 32U), slots);
+}
+
+struct perfect_hash_slot
+{
+    std::uint64_t hash;
+    std::uint32_t index;
+};
+} // namespace detail
+
+export template <std::size_t N>
+    requires(N > 0)
+class PerfectHash
+{
+  public:
+    static constexpr std::size_t npos{std::numeric_limits<std::size_t>::max()};
+
+    consteval explicit PerfectHash(const std::string_view (&keys)[N])
+    {
+        Build(std::span<const std::string_view, N>{keys});
+    }
+
+    consteval explicit PerfectHash(const std::array<std::string_view, N>& keys)
+    {
+        Build(std::span<const std::string_view, N>{keys});
+    }
+
+    // the key's position in the list the table was built from, npos when it isn't one of them
+    [[nodiscard]] constexpr std::size_t Index(const std::string_view key) const noexcept
+    {
+        const std::uint64_t hash{Hash64(key, m_seed)};
+        const detail::perfect_hash_slot& slot{m_slots[detail::PerfectHashSlot(hash, m_displacements[detail::PerfectHashBucket(hash, buckets)], N)]};
+        return slot.hash == hash ? slot.index : npos;
+    }
+
+    [[nodiscard]] constexpr bool Contains(const std::string_view key) const noexcept
+    {
+        return Index(key) != npos;
+    }
+
+    [[nodiscard]] static constexpr std::size_t Size() noexcept
+    {
+        return N;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t Seed() const noexcept
+    {
+        return m_seed;
+    }
+
+  private:
+    static constexpr std::size_t buckets{detail::PerfectHashBuckets(N)};
+
+    consteval void Build(const std::span<const std::string_view, N> keys)
+    {
+        for (std::uint64_t seed = 0; seed < detail::perfect_hash_max_seed; ++seed)
+        {
+            if (TryBuild(keys, seed))
+            {
+                return;
+            }
+        }
+        detail::PerfectHashNoSeedFound();
+    }
+
+    consteval bool TryBuild(const std::span<const std::string_view, N> keys, const std::uint64_t seed)
+    {
+        m_seed          = seed;
+        m_displacements = {};
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::uint32_t, N> byHash{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = Hash64(keys[i], seed);
+            byHash[i] = static_cast<std::uint32_t>(i);
+        }
+        // equal hashes are the same key twice, or a collision another seed avoids
+        std::ranges::sort(byHash, {}, [&](const std::uint32_t i) { return hashes[i]; });
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            if (hashes[byHash[i - 1]] == hashes[byHash[i]])
+            {
+                if (keys[byHash[i - 1]] == keys[byHash[i]])
+                {
+                    detail::PerfectHashDuplicateKey();
+                }
+                return false;
+            }
+        }
+
+        // keys grouped by bucket, then buckets ordered largest first
+        std::array<std::size_t, buckets + 1> offsets{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            ++offsets[detail::PerfectHashBucket(hashes[i], buckets) + 1];
+        }
+        for (std::size_t b = 0; b < buckets; ++b)
+        {
+            offsets[b + 1] += offsets[b];
+        }
+        std::array<std::uint32_t, N> members{};
+        std::array<std::size_t, buckets> filled{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const std::size_t b{detail::PerfectHashBucket(hashes[i], buckets)};
+            members[offsets[b] + filled[b]++] = static_cast<std::uint32_t>(i);
+        }
+        std::array<std::size_t, buckets> order{};
+        for (std::size_t b = 0; b < buckets; ++b)
+        {
+            order[b] = b;
+        }
+        std::ranges::sort(order, [&](const std::size_t a, const std::size_t b) {
+            const std::size_t sizeA{offsets[a + 1] - offsets[a]};
+            const std::size_t sizeB{offsets[b + 1] - offsets[b]};
+            return sizeA != sizeB ? sizeA > sizeB : a < b;
+        });
+
+        std::array<bool, N> taken{};
+        std::array<std::size_t, N> placed{};
+        for (const std::size_t b : order)
+        {
+            const std::size_t first{offsets[b]};
+            const std::size_t count{offsets[b + 1] - first};
+            if (count == 0)
+            {
+                break;
+            }
+            std::uint32_t displacement{};
+            for (;; ++displacement)
+            {
+                if (displacement == detail::perfect_hash_max_displacement)
+                {
+                    return false;
+                }
+                bool fits{true};
+                for (std::size_t k = 0; k < count && fits; ++k)
+                {
+                    placed[k] = detail::PerfectHashSlot(hashes[members[first + k]], displacement, N);
+                    fits      = !taken[placed[k]];
+                    for (std::size_t other = 0; other < k && fits; ++other)
+                    {
+                        fits = placed[other] != placed[k];
+                    }
+                }
+                if (fits)
+                {
+                    break;
+                }
+            }
+            m_displacements[b] = static_cast<std::uint16_t>(displacement);
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                taken[placed[k]]   = true;
+                m_slots[placed[k]] = {hashes[members[first + k]], members[first + k]};
+            }
+        }
+        return true;
+    }
+
+    std::array<std::uint16_t, buckets> m_displacements{};
+    std::array<detail::perfect_hash_slot, N> m_slots{};
+    std::uint64_t m_seed{};
+};
+
+template <std::size_t N>
+PerfectHash(const std::string_view (&)[N]) -> PerfectHash<N>;
+
+template <std::size_t N>
+PerfectHash(const std::array<std::string_view, N>&) -> PerfectHash<N>;
+
+// string -> Value over a fixed set of strings, built at compile time
+//
+//   constexpr std::pair<std::string_view, Format> formats[]{{"rgba8", Format::Rgba8}, {"r32f", Format::R32F}};
+//   constexpr PerfectHashMap formatByName{formats};
+//   formatByName.Find("r32f") -> pointer to Format::R32F, nullptr for unknown names
+export template <typename Value, std::size_t N>
+    requires(N > 0)
+class PerfectHashMap
+{
+  public:
+    consteval explicit PerfectHashMap(const std::pair<std::string_view, Value> (&entries)[N])
+        : m_table{Keys(entries, std::make_index_sequence<N>{})}
+        , m_values{Values(entries, std::make_index_sequence<N>{})}
+    {
+    }
+
+    [[nodiscard]] constexpr const Value* Find(const std::string_view key) const noexcept
+    {
+        const std::size_t index{m_table.Index(key)};
+        return index == PerfectHash<N>::npos ? nullptr : &m_values[index];
+    }
+
+    [[nodiscard]] constexpr bool Contains(const std::string_view key) const noexcept
+    {
+        return m_table.Contains(key);
+    }
+
+    // the value for key, fallback when key isn't one of the entries
+    [[nodiscard]] constexpr Value ValueOr(const std::string_view key, const Value& fallback) const noexcept
+    {
+        const Value* value{Find(key)};
+        return value != nullptr ? *value : fallback;
+    }
+
+    [[nodiscard]] static constexpr std::size_t Size() noexcept
+    {
+        return N;
+    }
+
+  private:
+    template <std::size_t... Is>
+    static consteval std::array<std::string_view, N> Keys(const std::pair<std::string_view, Value> (&entries)[N], std::index_sequence<Is...>)
+    {
+        return {entries[Is].first...};
+    }
+
+    template <std::size_t... Is>
+    static consteval std::array<Value, N> Values(const std::pair<std::string_view, Value> (&entries)[N], std::index_sequence<Is...>)
+    {
+        return {entries[Is].second...};
+    }
+
+    PerfectHash<N> m_table;
+    std::array<Value, N> m_values;
+};
+
+template <typename Value, std::size_t N>
+PerfectHashMap(const std::pair<std::string_view, Value> (&)[N]) -> PerfectHashMap<Value, N>;
+} // namespace fawn_algebra
@@ -4,9 +4,15 @@
 //
 
 module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
 
 export module FawnAlgebra:Random;
+import :CPU;
+import :Hashing;
 import :Interpolation;
+import :SIMD;
+import :SIMDMath;
 import std;
 
 namespace fawn_algebra
@@ -2639,6 +2645,8 @@ inline constexpr std::uint32_t permutation[]{
 // Random number generator is deterministic \o/
 // Queue complaints of "random isn't random enough"
 // I have hash functions if you want something quick and "random"
+// Period 65536 and a biased Next(min, max): fine for shuffling a deck, not for Monte Carlo.
+// Use one of the engines below with UniformRange / UniformFloat for anything statistical.
 export class Random
 {
   public:
@@ -2768,4 +2776,993 @@ export class Random
   private:
     std::uint32_t m_index;
 };
+
+// ---- engines ------------------------------------------------------------
+// All engines model std::uniform_random_bit_generator over their full result_type, so they
+// plug into <random> as well as into the Uniform* helpers further down. State is a few
+// words in registers; nothing touches memory between draws.
+
+// Steele, Lea & Flood, "Fast splittable pseudorandom number generators" (2014)
+// 64 bits of state, period 2^64. Mostly here to expand one seed into the state of the others.
+export class SplitMix64
+{
+  public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit SplitMix64(const std::uint64_t seed = 0) noexcept
+        : m_state{seed}
+    {
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        std::uint64_t z{m_state += 0x9E3779B97F4A7C15ULL};
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31U);
+    }
+
+    constexpr void Discard(const std::uint64_t count) noexcept
+    {
+        m_state += count * 0x9E3779B97F4A7C15ULL;
+    }
+
+    constexpr bool operator==(const SplitMix64&) const noexcept = default;
+
+  private:
+    std::uint64_t m_state;
+};
+
+namespace detail
+{
+// Seed of substream index of an engine whose whole state is words: the words and then the index
+// go through the SplitMix64 output mix one after another. Every child, and every child of a
+// child, gets its own seed, unrelated to the parent's and its siblings' ones, rather than a
+// position in the parent's sequence.
+template <std::size_t N>
+constexpr std::uint64_t SplitSeed(const std::array<std::uint64_t, N>& words, const std::uint64_t index) noexcept
+{
+    constexpr auto mix{[](std::uint64_t z) noexcept
+                       {
+                           z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                           z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+                           return z ^ (z >> 31U);
+                       }};
+    std::uint64_t hash{0x6A09E667F3BCC909ULL};
+    for (const std::uint64_t word : words)
+    {
+        hash = mix((hash + 0x9E3779B97F4A7C15ULL) ^ word);
+    }
+    return mix((hash + 0x9E3779B97F4A7C15ULL) ^ index);
+}
+} // namespace detail
+
+// O'Neill, "PCG: A Family of Simple Fast Space-Efficient Statistically Good Algorithms" (2014)
+// pcg32 (XSH RR 64/32): 64-bit LCG state, 2^63 selectable streams, period 2^64 per stream.
+export class PCG32
+{
+  public:
+    using result_type = std::uint32_t;
+
+    constexpr explicit PCG32(const std::uint64_t seed = 0x853C49E6748FEA9BULL, const std::uint64_t stream = 0xDA3E39CB94B95BDBULL) noexcept
+        : m_state{0}
+        , m_increment{(stream << 1U) | 1U}
+    {
+        Step();
+        m_state += seed;
+        Step();
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        const std::uint64_t old{m_state};
+        Step();
+        const auto xorShifted{static_cast<std::uint32_t>(((old >> 18U) ^ old) >> 27U)};
+        const auto rotation{static_cast<int>(old >> 59U)};
+        return std::rotr(xorShifted, rotation);
+    }
+
+    // Brown, "Random Number Generation with Arbitrary Strides" (1994): O(log count) LCG jump
+    constexpr void Discard(std::uint64_t count) noexcept
+    {
+        std::uint64_t accumulatedMultiplier{1};
+        std::uint64_t accumulatedIncrement{0};
+        std::uint64_t multiplier{pcg_multiplier};
+        std::uint64_t increment{m_increment};
+        while (count > 0)
+        {
+            if ((count & 1U) != 0)
+            {
+                accumulatedMultiplier *= multiplier;
+                accumulatedIncrement = accumulatedIncrement * multiplier + increment;
+            }
+            increment = (multiplier + 1U) * increment;
+            multiplier *= multiplier;
+            count >>= 1U;
+        }
+        m_state = accumulatedMultiplier * m_state + accumulatedIncrement;
+    }
+
+    // a seed and increment hashed from this state and index; streams are distinct sequences,
+    // not provably uncorrelated ones, so prefer Philox4x32 when that matters
+    [[nodiscard]] constexpr PCG32 Split(const std::uint64_t index) const noexcept
+    {
+        SplitMix64 expand{detail::SplitSeed(std::array{m_state, m_increment}, index)};
+        const std::uint64_t seed{expand()};
+        return PCG32{seed, expand()};
+    }
+
+    constexpr bool operator==(const PCG32&) const noexcept = default;
+
+  private:
+    static constexpr std::uint64_t pcg_multiplier{6364136223846793005ULL};
+
+    std::uint64_t m_state;
+    std::uint64_t m_increment;
+
+    constexpr void Step() noexcept
+    {
+        m_state = m_state * pcg_multiplier + m_increment;
+    }
+};
+
+// Blackman & Vigna, "Scrambled Linear Pseudorandom Number Generators" (2018)
+// xoshiro256**: 256 bits of state, period 2^256 - 1. The general purpose 64-bit engine.
+export class Xoshiro256StarStar
+{
+  public:
+    using result_type = std::uint64_t;
+
+    // the state is expanded with SplitMix64, as the authors recommend; it is never all zero
+    constexpr explicit Xoshiro256StarStar(const std::uint64_t seed = 0) noexcept
+    {
+        SplitMix64 expand{seed};
+        for (std::uint64_t& word : m_state)
+        {
+            word = expand();
+        }
+    }
+
+    // the raw state; must not be all zero
+    constexpr explicit Xoshiro256StarStar(const std::array<std::uint64_t, 4>& state) noexcept
+        : m_state{state}
+    {
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        const std::uint64_t result{std::rotl(m_state[1] * 5U, 7) * 9U};
+        const std::uint64_t t{m_state[1] << 17U};
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = std::rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    // Equivalent to 2^128 calls: 2^128 non-overlapping subsequences, one per thread.
+    constexpr void Jump() noexcept
+    {
+        JumpBy({0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL});
+    }
+
+    // Equivalent to 2^192 calls: 2^64 starting points, each of which Jump() splits further.
+    constexpr void LongJump() noexcept
+    {
+        JumpBy({0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL});
+    }
+
+    // substream index: seeded from a hash of this state and index, O(1). Substreams start at
+    // unrelated points of the 2^256 - 1 period; use Jump() for sequences that provably do not
+    // overlap.
+    [[nodiscard]] constexpr Xoshiro256StarStar Split(const std::uint64_t index) const noexcept
+    {
+        return Xoshiro256StarStar{detail::SplitSeed(m_state, index)};
+    }
+
+    constexpr bool operator==(const Xoshiro256StarStar&) const noexcept = default;
+
+  private:
+    std::array<std::uint64_t, 4> m_state{};
+
+    // multiply the state by the jump polynomial, one bit of it per step
+    constexpr void JumpBy(const std::array<std::uint64_t, 4>& polynomial) noexcept
+    {
+        std::array<std::uint64_t, 4> jumped{};
+        for (const std::uint64_t word : polynomial)
+        {
+            for (std::uint32_t bit = 0; bit < 64; ++bit)
+            {
+                if ((word & (1ULL << bit)) != 0)
+                {
+                    for (std::size_t i = 0; i < 4; ++i)
+                    {
+                        jumped[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        m_state = jumped;
+    }
+};
+
+namespace detail
+{
+// 32-bit lanes of the widest integer register the build targets: 16 with AVX-512, 8 with AVX2,
+// 4 otherwise. The baseline Philox kernels run at this width; Fill and FillNormal pick the
+// AVX2 / AVX-512 kernels at run time on top of it. Each output depends on its counter only,
+// so the width never shows in the stream.
+#if defined(__AVX512F__)
+inline constexpr int fill_lanes{16};
+#elif defined(__AVX2__)
+inline constexpr int fill_lanes{8};
+#else
+inline constexpr int fill_lanes{4};
+#endif
+
+using fill_u32 = simd::vec<std::uint32_t, fill_lanes>;
+using fill_raw = fill_u32::raw_type;
+
+template <int... Is>
+constexpr simd::detail::raw<std::uint32_t, sizeof...(Is)> LaneIota(std::integer_sequence<int, Is...>) noexcept
+{
+    return simd::detail::raw<std::uint32_t, sizeof...(Is)>{static_cast<std::uint32_t>(Is)...};
+}
+
+// counter + count, carried through all 128 bits
+constexpr void AdvanceCounter(std::array<std::uint32_t, 4>& counter, const std::uint64_t count) noexcept
+{
+    std::uint64_t carry{count};
+    for (std::uint32_t& word : counter)
+    {
+        const std::uint64_t sum{word + (carry & 0xFFFFFFFFULL)};
+        word  = static_cast<std::uint32_t>(sum);
+        carry = (carry >> 32U) + (sum >> 32U);
+        if (carry == 0)
+        {
+            break;
+        }
+    }
+}
+
+// Philox4x32-10 over N consecutive counters, written to out in stream order
+template <int N, auto MulEven>
+BALBINO_FORCE_INLINE void PhiloxBlocks(const std::array<std::uint32_t, 4>& counter, std::array<std::uint32_t, 2> key, std::uint32_t* out) noexcept
+{
+    using u32  = simd::vec<std::uint32_t, N>;
+    using lane = u32::raw_type;
+    constexpr lane iota{LaneIota(std::make_integer_sequence<int, N>{})};
+
+    // per-lane counter + lane, carried through all 128 bits
+    lane c0{iota + counter[0]};
+    lane carry{std::bit_cast<lane>(c0 < counter[0])};
+    lane c1{counter[1] - carry};
+    carry &= std::bit_cast<lane>(c1 == 0U);
+    lane c2{counter[2] - carry};
+    carry &= std::bit_cast<lane>(c2 == 0U);
+    lane c3{counter[3] - carry};
+
+    const u32 multiplier0{u32::splat(0xD2511F53U)};
+    const u32 multiplier1{u32::splat(0xCD9E8D57U)};
+    for (int round = 0; round < 10; ++round)
+    {
+        const auto [high0, low0]{simd::mul_wide<N, MulEven>(u32{c0}, multiplier0)};
+        const auto [high1, low1]{simd::mul_wide<N, MulEven>(u32{c2}, multiplier1)};
+        c0 = high1.r ^ c1 ^ key[0];
+        c1 = low1.r;
+        c2 = high0.r ^ c3 ^ key[1];
+        c3 = low0.r;
+        key[0] += 0x9E3779B9U;
+        key[1] += 0xBB67AE85U;
+    }
+
+    // lanes hold blocks, memory wants words: a 4 x N transpose
+    const auto even{simd::interleave(u32{c0}, u32{c2})};
+    const auto odd{simd::interleave(u32{c1}, u32{c3})};
+    const auto low{simd::interleave(even[0], odd[0])};
+    const auto high{simd::interleave(even[1], odd[1])};
+    std::memcpy(out, &low[0].r, sizeof(lane));
+    std::memcpy(out + N, &low[1].r, sizeof(lane));
+    std::memcpy(out + 2 * N, &high[0].r, sizeof(lane));
+    std::memcpy(out + 3 * N, &high[1].r, sizeof(lane));
+}
+
+// The whole multiples of N among `blocks` Philox blocks from counter on, to out; returns how
+// many blocks that was
+using PhiloxFillFn = std::size_t (*)(std::array<std::uint32_t, 4>, std::array<std::uint32_t, 2>, std::uint32_t*, std::size_t) noexcept;
+
+template <int N, auto MulEven>
+BALBINO_FORCE_INLINE std::size_t PhiloxFillKernel(std::array<std::uint32_t, 4> counter, const std::array<std::uint32_t, 2> key, std::uint32_t* out, const std::size_t blocks) noexcept
+{
+    const std::size_t steps{blocks / N};
+    for (std::size_t s = 0; s < steps; ++s)
+    {
+        PhiloxBlocks<N, MulEven>(counter, key, out + 4 * N * s);
+        AdvanceCounter(counter, N);
+    }
+    return steps * N;
+}
+
+inline std::size_t PhiloxFillBaseline(const std::array<std::uint32_t, 4> counter, const std::array<std::uint32_t, 2> key, std::uint32_t* out, const std::size_t blocks) noexcept
+{
+    return PhiloxFillKernel<fill_lanes, simd::detail::mul_even<simd::detail::raw<std::uint64_t, fill_lanes / 2>>>(counter, key, out, blocks);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+BALBINO_TARGET_AVX2 inline std::size_t PhiloxFillAvx2(const std::array<std::uint32_t, 4> counter, const std::array<std::uint32_t, 2> key, std::uint32_t* out, const std::size_t blocks) noexcept
+{
+    return PhiloxFillKernel<8, simd::detail::mul_even_avx2>(counter, key, out, blocks);
+}
+
+BALBINO_TARGET_AVX512 inline std::size_t PhiloxFillAvx512(const std::array<std::uint32_t, 4> counter, const std::array<std::uint32_t, 2> key, std::uint32_t* out, const std::size_t blocks) noexcept
+{
+    return PhiloxFillKernel<16, simd::detail::mul_even_avx512>(counter, key, out, blocks);
+}
+#endif
+
+inline PhiloxFillFn PhiloxFillKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const PhiloxFillFn kernel = DispatchTable<PhiloxFillFn>{PhiloxFillBaseline, nullptr, PhiloxFillAvx2, PhiloxFillAvx512}.Select(ActiveSimdLevel());
+#else
+    static const PhiloxFillFn kernel = PhiloxFillBaseline;
+#endif
+    return kernel;
+}
+
+// Box-Muller on pairs of uniforms, u1 in (0, 1] and u2 in [0, 1)
+template <typename T, int N>
+BALBINO_FORCE_INLINE std::array<simd::vec<T, N>, 2> BoxMuller(const simd::vec<T, N> u1, const simd::vec<T, N> u2) noexcept
+{
+    const simd::vec<T, N> radius{simd::detail::lane_sqrt(simd::log(u1) * T(-2))};
+    const auto [sine, cosine]{simd::sincos(u2 * T(6.28318530717958647692))};
+    return {radius * cosine, radius * sine};
+}
+
+// N pairs of 32-bit draws {u1, u2, u1, u2, ...} in two registers to N pairs of normals {cos, sin, ...}
+template <int N>
+BALBINO_FORCE_INLINE std::array<simd::vec<float, N>, 2> NormalPairsStep(const simd::vec<std::uint32_t, N> first, const simd::vec<std::uint32_t, N> second) noexcept
+{
+    using V = simd::vec<float, N>;
+    using I = simd::vec<std::int32_t, N>::raw_type;
+    const auto [u1bits, u2bits]{simd::deinterleave(first, second)};
+    // the shifted draws fit 24 bits, so the signed convert is exact
+    const V u1{V{__builtin_convertvector(std::bit_cast<I>(u1bits.r >> 8U) + 1, typename V::raw_type)} * 0x1.0p-24F};
+    const V u2{V{__builtin_convertvector(std::bit_cast<I>(u2bits.r >> 8U), typename V::raw_type)} * 0x1.0p-24F};
+    const auto [z0, z1]{BoxMuller(u1, u2)};
+    return simd::interleave(z0, z1);
+}
+
+// n pairs of 32-bit draws to n pairs of normals, N pairs per step
+template <int N>
+BALBINO_FORCE_INLINE void NormalPairsKernel(const std::uint32_t* bits, float* out, const std::size_t pairs) noexcept
+{
+    using U = simd::vec<std::uint32_t, N>;
+
+    // whole steps with plain loads and stores: the partial forms are per-lane code where the
+    // build's ISA has no masked moves, as in the dispatched kernels
+    std::size_t i{};
+    for (; pairs - i >= N; i += N)
+    {
+        const auto zipped{NormalPairsStep<N>(U::load(bits + 2 * i), U::load(bits + 2 * i + N))};
+        zipped[0].store(out + 2 * i);
+        zipped[1].store(out + 2 * i + N);
+    }
+    if (i < pairs)
+    {
+        const int count{static_cast<int>(pairs - i)};
+        const auto zipped{NormalPairsStep<N>(U::load_partial(bits + 2 * i, std::min(2 * count, N)), U::load_partial(bits + 2 * i + N, std::max(2 * count - N, 0)))};
+        zipped[0].store_partial(out + 2 * i, std::min(2 * count, N));
+        zipped[1].store_partial(out + 2 * i + N, std::max(2 * count - N, 0));
+    }
+}
+
+// upper * 2^31 + lower over the N / 2 lanes from Offset, exact for upper < 2^22
+template <int Offset, typename R, int... Is>
+BALBINO_FORCE_INLINE simd::vec<double, sizeof...(Is)> JoinHalf(const R upper, const R lower, std::integer_sequence<int, Is...>) noexcept
+{
+    using D = simd::vec<double, sizeof...(Is)>::raw_type;
+    return simd::vec<double, sizeof...(Is)>{__builtin_convertvector(__builtin_shufflevector(upper, upper, (Offset + Is)...), D) * 0x1.0p31
+                                            + __builtin_convertvector(__builtin_shufflevector(lower, lower, (Offset + Is)...), D)};
+}
+
+// x >> 11 of N 64-bit draws given as their high and low words, as two halves of doubles. The 53
+// bits go through two int32 converts (22 + 31 bits), which every level has in SIMD form, instead
+// of the 64-bit convert that needs AVX-512DQ.
+template <int N>
+BALBINO_FORCE_INLINE std::array<simd::vec<double, N / 2>, 2> Top53(const simd::vec<std::uint32_t, N> high, const simd::vec<std::uint32_t, N> low) noexcept
+{
+    using I = simd::vec<std::int32_t, N>::raw_type;
+    constexpr auto half = std::make_integer_sequence<int, N / 2>{};
+    const I upper{std::bit_cast<I>(high.r >> 10U)};
+    const I lower{std::bit_cast<I>(((high.r << 21U) | (low.r >> 11U)) & 0x7FFFFFFFU)};
+    return {JoinHalf<0>(upper, lower, half), JoinHalf<N / 2>(upper, lower, half)};
+}
+
+// n pairs of 64-bit draws, each two 32-bit words high first, to n pairs of normals, N pairs per step
+template <int N>
+BALBINO_FORCE_INLINE void NormalPairsKernel(const std::uint32_t* bits, double* out, const std::size_t pairs) noexcept
+{
+    constexpr int lanes{N / 2};
+    using U = simd::vec<std::uint32_t, N>;
+    using V = simd::vec<double, lanes>;
+
+    std::size_t i{};
+    for (; pairs - i >= N; i += N)
+    {
+        // {u1 high, u1 low, u2 high, u2 low} per pair in four registers, unzipped twice
+        const auto [even0, odd0]{simd::deinterleave(U::load(bits + 4 * i), U::load(bits + 4 * i + N))};
+        const auto [even1, odd1]{simd::deinterleave(U::load(bits + 4 * i + 2 * N), U::load(bits + 4 * i + 3 * N))};
+        const auto [u1High, u2High]{simd::deinterleave(even0, even1)};
+        const auto [u1Low, u2Low]{simd::deinterleave(odd0, odd1)};
+        const auto u1{Top53(u1High, u1Low)};
+        const auto u2{Top53(u2High, u2Low)};
+        for (int h = 0; h < 2; ++h)
+        {
+            const auto [z0, z1]{BoxMuller((u1[h] + 1.0) * 0x1.0p-53, u2[h] * 0x1.0p-53)};
+            const auto zipped{simd::interleave(z0, z1)};
+            zipped[0].store(out + 2 * i + h * N);
+            zipped[1].store(out + 2 * i + h * N + lanes);
+        }
+    }
+    for (; i < pairs; i += lanes)
+    {
+        const int count{static_cast<int>(std::min<std::size_t>(lanes, pairs - i))};
+        V u1;
+        V u2;
+        for (int l = 0; l < lanes; ++l)
+        {
+            const std::uint32_t* pair{bits + 4 * (i + static_cast<std::size_t>(std::min(l, count - 1)))};
+            u1[l] = static_cast<double>((((static_cast<std::uint64_t>(pair[0]) << 32U) | pair[1]) >> 11U) + 1U) * 0x1.0p-53;
+            u2[l] = static_cast<double>(((static_cast<std::uint64_t>(pair[2]) << 32U) | pair[3]) >> 11U) * 0x1.0p-53;
+        }
+        const auto [z0, z1]{BoxMuller(u1, u2)};
+        const auto zipped{simd::interleave(z0, z1)};
+        zipped[0].store_partial(out + 2 * i, std::min(2 * count, lanes));
+        zipped[1].store_partial(out + 2 * i + lanes, std::max(2 * count - lanes, 0));
+    }
+}
+
+template <typename T>
+using NormalPairsFn = void (*)(const std::uint32_t*, T*, std::size_t) noexcept;
+
+template <typename T>
+void NormalPairsBaseline(const std::uint32_t* bits, T* out, const std::size_t pairs) noexcept
+{
+    NormalPairsKernel<fill_lanes>(bits, out, pairs);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+template <typename T>
+BALBINO_TARGET_AVX2 void NormalPairsAvx2(const std::uint32_t* bits, T* out, const std::size_t pairs) noexcept
+{
+    NormalPairsKernel<8>(bits, out, pairs);
+}
+
+template <typename T>
+BALBINO_TARGET_AVX512 void NormalPairsAvx512(const std::uint32_t* bits, T* out, const std::size_t pairs) noexcept
+{
+    NormalPairsKernel<16>(bits, out, pairs);
+}
+#endif
+
+template <typename T>
+void NormalPairs(const std::uint32_t* bits, T* out, const std::size_t pairs) noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const NormalPairsFn<T> kernel = DispatchTable<NormalPairsFn<T>>{NormalPairsBaseline<T>, nullptr, NormalPairsAvx2<T>, NormalPairsAvx512<T>}.Select(ActiveSimdLevel());
+#else
+    static const NormalPairsFn<T> kernel = NormalPairsBaseline<T>;
+#endif
+    kernel(bits, out, pairs);
+}
+} // namespace detail
+
+// Salmon, Moraes, Dror & Shaw, "Parallel Random Numbers: As Easy as 1, 2, 3" (SC 2011)
+// Counter-based: output block i is a keyed bijection of i, so any block can be computed
+// directly, in any order and on any thread. Philox4x32-10 is the variant Random123, cuRAND
+// and C++26 std::philox4x32 use.
+export class Philox4x32
+{
+  public:
+    using result_type  = std::uint32_t;
+    using counter_type = std::array<std::uint32_t, 4>;
+    using key_type     = std::array<std::uint32_t, 2>;
+
+    static constexpr std::uint32_t multiplier0{0xD2511F53U};
+    static constexpr std::uint32_t multiplier1{0xCD9E8D57U};
+    static constexpr std::uint32_t weyl0{0x9E3779B9U};
+    static constexpr std::uint32_t weyl1{0xBB67AE85U};
+    static constexpr int rounds{10};
+
+    // seed is the key, stream the high half of the counter
+    constexpr explicit Philox4x32(const std::uint64_t seed = 0, const std::uint64_t stream = 0) noexcept
+        : m_key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32U)}
+        , m_counter{0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32U)}
+    {
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    // the stateless bijection: four outputs for one counter under one key
+    static constexpr counter_type Block(counter_type counter, key_type key) noexcept
+    {
+        for (int round = 0; round < rounds; ++round)
+        {
+            const std::uint64_t product0{static_cast<std::uint64_t>(multiplier0) * counter[0]};
+            const std::uint64_t product1{static_cast<std::uint64_t>(multiplier1) * counter[2]};
+            counter = {static_cast<std::uint32_t>(product1 >> 32U) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+                       static_cast<std::uint32_t>(product0 >> 32U) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0)};
+            key[0] += weyl0;
+            key[1] += weyl1;
+        }
+        return counter;
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        if (m_index == 4)
+        {
+            m_block = Block(m_counter, m_key);
+            Increment();
+            m_index = 0;
+        }
+        return m_block[m_index++];
+    }
+
+    // Bulk output, many blocks per step in the SIMD lanes of the widest kernel ActiveSimdLevel
+    // allows. Each overload writes exactly what the matching scalar loop would and leaves the
+    // engine where that loop would have:
+    //   uint32_t: (*this)()              uint64_t: UniformBits64(*this)
+    //   float:    UniformFloat(*this)    double:   UniformDouble(*this)
+    // so results never depend on the vector width, the ISA or how a request is split.
+    void Fill(const std::span<std::uint32_t> out) noexcept
+    {
+        std::size_t i{};
+        while (i < out.size() && m_index != 4)
+        {
+            out[i++] = m_block[m_index++];
+        }
+        const std::size_t blocks{detail::PhiloxFillKernelFor()(m_counter, m_key, out.data() + i, (out.size() - i) / 4)};
+        Increment(blocks);
+        i += 4 * blocks;
+        while (i < out.size())
+        {
+            out[i++] = (*this)();
+        }
+    }
+
+    void Fill(const std::span<std::uint64_t> out) noexcept
+    {
+        std::array<std::uint32_t, fill_chunk> bits;
+        for (std::size_t i{}; i < out.size(); i += fill_chunk / 2)
+        {
+            const std::size_t count{std::min(fill_chunk / 2, out.size() - i)};
+            Fill(std::span{bits}.first(2 * count));
+            for (std::size_t j{}; j < count; ++j)
+            {
+                out[i + j] = (static_cast<std::uint64_t>(bits[2 * j]) << 32U) | bits[2 * j + 1];
+            }
+        }
+    }
+
+    void Fill(const std::span<float> out) noexcept
+    {
+        std::array<std::uint32_t, fill_chunk> bits;
+        for (std::size_t i{}; i < out.size(); i += fill_chunk)
+        {
+            const std::size_t count{std::min(fill_chunk, out.size() - i)};
+            Fill(std::span{bits}.first(count));
+            for (std::size_t j{}; j < count; ++j)
+            {
+                out[i + j] = static_cast<float>(bits[j] >> 8U) * 0x1.0p-24F;
+            }
+        }
+    }
+
+    void Fill(const std::span<double> out) noexcept
+    {
+        std::array<std::uint32_t, fill_chunk> bits;
+        for (std::size_t i{}; i < out.size(); i += fill_chunk / 2)
+        {
+            const std::size_t count{std::min(fill_chunk / 2, out.size() - i)};
+            Fill(std::span{bits}.first(2 * count));
+            for (std::size_t j{}; j < count; ++j)
+            {
+                out[i + j] = static_cast<double>(((static_cast<std::uint64_t>(bits[2 * j]) << 32U) | bits[2 * j + 1]) >> 11U) * 0x1.0p-53;
+            }
+        }
+    }
+
+    // Standard normals by Box-Muller, two per pair of uniforms (UniformFloat / UniformDouble,
+    // the first nudged off zero): out[2k] = r cos(theta), out[2k + 1] = r sin(theta). An odd
+    // count still consumes the whole last pair. Bit-identical across widths and ISAs as long
+    // as the build contracts a * b + c the same way (ISO mode, -ffp-contract=off, does not).
+    void FillNormal(const std::span<float> out) noexcept
+    {
+        std::array<std::uint32_t, fill_chunk> bits;
+        const std::size_t pairs{(out.size() + 1) / 2};
+        for (std::size_t i{}; i < pairs; i += fill_chunk / 2)
+        {
+            const std::size_t count{std::min(fill_chunk / 2, pairs - i)};
+            Fill(std::span{bits}.first(2 * count));
+            if (2 * (i + count) <= out.size())
+            {
+                detail::NormalPairs(bits.data(), out.data() + 2 * i, count);
+            }
+            else
+            {
+                detail::NormalPairs(bits.data(), out.data() + 2 * i, count - 1);
+                float last[2];
+                detail::NormalPairs(bits.data() + 2 * (count - 1), last, 1);
+                out.back() = last[0];
+            }
+        }
+    }
+
+    void FillNormal(const std::span<double> out) noexcept
+    {
+        std::array<std::uint32_t, fill_chunk> bits;
+        const std::size_t pairs{(out.size() + 1) / 2};
+        for (std::size_t i{}; i < pairs; i += fill_chunk / 4)
+        {
+            const std::size_t count{std::min(fill_chunk / 4, pairs - i)};
+            Fill(std::span{bits}.first(4 * count));
+            if (2 * (i + count) <= out.size())
+            {
+                detail::NormalPairs(bits.data(), out.data() + 2 * i, count);
+            }
+            else
+            {
+                detail::NormalPairs(bits.data(), out.data() + 2 * i, count - 1);
+                double last[2];
+                detail::NormalPairs(bits.data() + 4 * (count - 1), last, 1);
+                out.back() = last[0];
+            }
+        }
+    }
+
+    // skips count outputs in O(1), landing mid-block when count is not a multiple of four
+    constexpr void Discard(std::uint64_t count) noexcept
+    {
+        const std::uint64_t buffered{4U - m_index};
+        if (count <= buffered)
+        {
+            m_index += static_cast<std::uint32_t>(count);
+            return;
+        }
+        count -= buffered;
+        Increment(count / 4U);
+        m_index = 4;
+        if (count % 4U != 0)
+        {
+            m_block = Block(m_counter, m_key);
+            Increment();
+            m_index = static_cast<std::uint32_t>(count % 4U);
+        }
+    }
+
+    // Key split: substream index is Philox4x32(seed, stream) with both hashed from this key,
+    // counter and index, 2^66 outputs long. O(1) for any index.
+    [[nodiscard]] constexpr Philox4x32 Split(const std::uint64_t index) const noexcept
+    {
+        const std::array<std::uint64_t, 3> words{m_key[0] | static_cast<std::uint64_t>(m_key[1]) << 32U, m_counter[0] | static_cast<std::uint64_t>(m_counter[1]) << 32U,
+                                                 m_counter[2] | static_cast<std::uint64_t>(m_counter[3]) << 32U};
+        SplitMix64 expand{detail::SplitSeed(words, index)};
+        const std::uint64_t seed{expand()};
+        return Philox4x32{seed, expand()};
+    }
+
+    // words already handed out do not take part, Fill leaves them stale
+    constexpr bool operator==(const Philox4x32& other) const noexcept
+    {
+        return m_key == other.m_key && m_counter == other.m_counter && m_index == other.m_index &&
+               std::equal(m_block.begin() + m_index, m_block.end(), other.m_block.begin() + m_index);
+    }
+
+  private:
+    // draws staged per Fill round trip: 4 KiB, stays in L1 between generation and conversion
+    static constexpr std::size_t fill_chunk{1024};
+
+    key_type m_key;
+    counter_type m_counter;
+    counter_type m_block{};
+    std::uint32_t m_index{4};
+
+    constexpr void Increment(const std::uint64_t count = 1) noexcept
+    {
+        detail::AdvanceCounter(m_counter, count);
+    }
+};
+
+// Same paper: Threefry2x64-20, the Threefish block cipher with the key schedule kept and the
+// tweak dropped. Only adds, rotates and xors, so it is the counter-based engine to pick where
+// 32 x 32 -> 64 multiplies are slow.
+export class Threefry2x64
+{
+  public:
+    using result_type  = std::uint64_t;
+    using counter_type = std::array<std::uint64_t, 2>;
+    using key_type     = std::array<std::uint64_t, 2>;
+
+    static constexpr std::uint64_t parity{0x1BD11BDAA9FC1A22ULL};
+    static constexpr int rounds{20};
+
+    // seed is the key, stream the high word of the counter
+    constexpr explicit Threefry2x64(const std::uint64_t seed = 0, const std::uint64_t stream = 0) noexcept
+        : m_key{seed, 0}
+        , m_counter{0, stream}
+    {
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    static constexpr counter_type Block(const counter_type& counter, const key_type& key) noexcept
+    {
+        constexpr int rotation[8]{16, 42, 12, 31, 16, 32, 24, 21};
+        const std::uint64_t schedule[3]{key[0], key[1], parity ^ key[0] ^ key[1]};
+
+        std::uint64_t x0{counter[0] + schedule[0]};
+        std::uint64_t x1{counter[1] + schedule[1]};
+        for (int round = 0; round < rounds; ++round)
+        {
+            x0 += x1;
+            x1 = std::rotl(x1, rotation[round % 8]);
+            x1 ^= x0;
+
+            // key injection after every fourth round
+            if (round % 4 == 3)
+            {
+                const int injection{round / 4 + 1};
+                x0 += schedule[injection % 3];
+                x1 += schedule[(injection + 1) % 3] + static_cast<std::uint64_t>(injection);
+            }
+        }
+        return {x0, x1};
+    }
+
+    constexpr result_type operator()() noexcept
+    {
+        if (m_index == 2)
+        {
+            m_block = Block(m_counter, m_key);
+            Increment(1);
+            m_index = 0;
+        }
+        return m_block[m_index++];
+    }
+
+    constexpr void Discard(std::uint64_t count) noexcept
+    {
+        const std::uint64_t buffered{2U - m_index};
+        if (count <= buffered)
+        {
+            m_index += static_cast<std::uint32_t>(count);
+            return;
+        }
+        count -= buffered;
+        Increment(count / 2U);
+        m_index = 2;
+        if (count % 2U != 0)
+        {
+            m_block = Block(m_counter, m_key);
+            Increment(1);
+            m_index = 1;
+        }
+    }
+
+    // Key split: substream index has a 128-bit key hashed from this key, counter and index,
+    // and starts at counter zero. O(1) for any index.
+    [[nodiscard]] constexpr Threefry2x64 Split(const std::uint64_t index) const noexcept
+    {
+        SplitMix64 expand{detail::SplitSeed(std::array{m_key[0], m_key[1], m_counter[0], m_counter[1]}, index)};
+        Threefry2x64 child{};
+        child.m_key[0] = expand();
+        child.m_key[1] = expand();
+        return child;
+    }
+
+    constexpr bool operator==(const Threefry2x64&) const noexcept = default;
+
+  private:
+    key_type m_key;
+    counter_type m_counter;
+    counter_type m_block{};
+    std::uint32_t m_index{2};
+
+    constexpr void Increment(const std::uint64_t count) noexcept
+    {
+        m_counter[0] += count;
+        m_counter[1] += m_counter[0] < count ? 1U : 0U;
+    }
+};
+
+// ---- parallel streams ---------------------------------------------------
+export template <typename E>
+concept SplittableEngine = std::uniform_random_bit_generator<E> && requires(const E engine, const std::uint64_t index) {
+    { engine.Split(index) } -> std::same_as<E>;
+};
+
+// Deterministic per-task generators: Stream(task) depends on the seed and the task index
+// only, never on which thread asks or in what order, so a parallel run reproduces a serial
+// one bit for bit. Give every unit of work its own index (a tile, a path, a particle batch),
+// not every thread. Any 64-bit task index is O(1), and a stream can be split again for
+// subtasks without meeting another task's stream.
+export template <SplittableEngine Engine = Philox4x32>
+class RandomStreamPool
+{
+  public:
+    using engine_type = Engine;
+
+    constexpr explicit RandomStreamPool(const std::uint64_t seed = 0) noexcept
+        : m_root{seed}
+    {
+    }
+
+    [[nodiscard]] constexpr Engine Stream(const std::uint64_t task) const noexcept
+    {
+        return m_root.Split(task);
+    }
+
+  private:
+    Engine m_root;
+};
+
+// ---- ranges and floats --------------------------------------------------
+// Generators whose output is 32 or 64 uniform bits: min() == 0 and max() == 2^32 - 1 or
+// 2^64 - 1. All engines above qualify, as do std::mt19937 and std::mt19937_64.
+export template <typename G>
+concept FullRangeGenerator = std::uniform_random_bit_generator<G> && G::min() == 0 &&
+                             (G::max() == std::numeric_limits<std::uint32_t>::max() || G::max() == std::numeric_limits<std::uint64_t>::max());
+
+// the high half of a 64-bit draw, where the scrambled engines are strongest
+export template <FullRangeGenerator G>
+constexpr std::uint32_t UniformBits32(G& generator) noexcept(noexcept(generator()))
+{
+    if constexpr (G::max() == std::numeric_limits<std::uint32_t>::max())
+    {
+        return static_cast<std::uint32_t>(generator());
+    }
+    else
+    {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(generator()) >> 32U);
+    }
+}
+
+export template <FullRangeGenerator G>
+constexpr std::uint64_t UniformBits64(G& generator) noexcept(noexcept(generator()))
+{
+    if constexpr (G::max() == std::numeric_limits<std::uint64_t>::max())
+    {
+        return static_cast<std::uint64_t>(generator());
+    }
+    else
+    {
+        const auto hi{static_cast<std::uint64_t>(generator())};
+        return (hi << 32U) | static_cast<std::uint64_t>(generator());
+    }
+}
+
+// Lemire, "Fast Random Integer Generation in an Interval" (2019): uniform in [0, range), no
+// modulo bias and, except for the rare rejection, no division. range must be > 0.
+export template <FullRangeGenerator G>
+constexpr std::uint32_t UniformBounded(G& generator, const std::uint32_t range) noexcept(noexcept(generator()))
+{
+    std::uint64_t product{static_cast<std::uint64_t>(UniformBits32(generator)) * range};
+    auto low{static_cast<std::uint32_t>(product)};
+    if (low < range)
+    {
+        const std::uint32_t threshold{(0U - range) % range};
+        while (low < threshold)
+        {
+            product = static_cast<std::uint64_t>(UniformBits32(generator)) * range;
+            low     = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32U);
+}
+
+export template <FullRangeGenerator G>
+constexpr std::uint64_t UniformBounded(G& generator, const std::uint64_t range) noexcept(noexcept(generator()))
+{
+    detail::wide_product product{detail::MulWide(UniformBits64(generator), range)};
+    if (product.lo < range)
+    {
+        const std::uint64_t threshold{(0ULL - range) % range};
+        while (product.lo < threshold)
+        {
+            product = detail::MulWide(UniformBits64(generator), range);
+        }
+    }
+    return product.hi;
+}
+
+// uniform in [min, max), the same half-open convention as Random::Next; max must be > min
+export template <FullRangeGenerator G, std::integral T>
+constexpr T UniformRange(G& generator, const T min, const T max) noexcept(noexcept(generator()))
+{
+    using U = std::make_unsigned_t<T>;
+    using R = std::conditional_t<(sizeof(T) > 4), std::uint64_t, std::uint32_t>;
+    const auto range{static_cast<R>(static_cast<U>(max) - static_cast<U>(min))};
+    return static_cast<T>(static_cast<U>(min) + static_cast<U>(UniformBounded(generator, range)));
+}
+
+// Uniform in [0, 1) on the grid k * 2^-24 (float) or k * 2^-53 (double). Every value is exactly
+// representable, so no rounding can bias the result or produce 1.0.
+export template <FullRangeGenerator G>
+constexpr float UniformFloat(G& generator) noexcept(noexcept(generator()))
+{
+    return static_cast<float>(UniformBits32(generator) >> 8U) * 0x1.0p-24F;
+}
+
+export template <FullRangeGenerator G>
+constexpr double UniformDouble(G& generator) noexcept(noexcept(generator()))
+{
+    return static_cast<double>(UniformBits64(generator) >> 11U) * 0x1.0p-53;
+}
+
+// uniform in [min, max); the product is rounded, so max itself can come out when |max| >> |max - min|
+export template <FullRangeGenerator G, std::floating_point T>
+constexpr T UniformReal(G& generator, const T min, const T max) noexcept(noexcept(generator()))
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return min + (max - min) * UniformFloat(generator);
+    }
+    else
+    {
+        return min + (max - min) * static_cast<T>(UniformDouble(generator));
+    }
+}
 } // namespace fawn_algebra
@@ -4,6 +4,11 @@
 //
 
 module;
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+#    include <immintrin.h>
+#endif
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
 
 export module FawnAlgebra:SIMD;
 import std;
@@ -216,6 +221,7 @@ SIMD_DEFINE_RAW(double, 8)
 
 SIMD_DEFINE_RAW(std::int8_t, 16)
 SIMD_DEFINE_RAW(std::int8_t, 32)
+SIMD_DEFINE_RAW(std::int8_t, 64)
 SIMD_DEFINE_RAW(std::int16_t, 8)
 SIMD_DEFINE_RAW(std::int16_t, 16)
 SIMD_DEFINE_RAW(std::int32_t, 4)
@@ -223,15 +229,19 @@ SIMD_DEFINE_RAW(std::int32_t, 8)
 SIMD_DEFINE_RAW(std::int32_t, 16)
 SIMD_DEFINE_RAW(std::int64_t, 2)
 SIMD_DEFINE_RAW(std::int64_t, 4)
+SIMD_DEFINE_RAW(std::int64_t, 8)
 
 SIMD_DEFINE_RAW(std::uint8_t, 16)
 SIMD_DEFINE_RAW(std::uint8_t, 32)
+SIMD_DEFINE_RAW(std::uint8_t, 64)
 SIMD_DEFINE_RAW(std::uint16_t, 8)
 SIMD_DEFINE_RAW(std::uint16_t, 16)
 SIMD_DEFINE_RAW(std::uint32_t, 4)
 SIMD_DEFINE_RAW(std::uint32_t, 8)
+SIMD_DEFINE_RAW(std::uint32_t, 16)
 SIMD_DEFINE_RAW(std::uint64_t, 2)
 SIMD_DEFINE_RAW(std::uint64_t, 4)
+SIMD_DEFINE_RAW(std::uint64_t, 8)
 
 #undef SIMD_DEFINE_RAW
 
@@ -243,15 +253,21 @@ using raw = raw_traits<Scalar, Lanes>::type;
 namespace fawn_algebra::simd
 {
 
+export template <int N>
+struct mask;
+
 // ---- raw vector type aliases -------------------------------------------
 
-export using raw_f32x4 = detail::raw<float, 4>;
-export using raw_f32x8 = detail::raw<float, 8>;
-export using raw_f64x2 = detail::raw<double, 2>;
-export using raw_f64x4 = detail::raw<double, 4>;
+export using raw_f32x4  = detail::raw<float, 4>;
+export using raw_f32x8  = detail::raw<float, 8>;
+export using raw_f32x16 = detail::raw<float, 16>;
+export using raw_f64x2  = detail::raw<double, 2>;
+export using raw_f64x4  = detail::raw<double, 4>;
+export using raw_f64x8  = detail::raw<double, 8>;
 
-export using raw_i32x4 = detail::raw<std::int32_t, 4>;
-export using raw_i32x8 = detail::raw<std::int32_t, 8>;
+export using raw_i32x4  = detail::raw<std::int32_t, 4>;
+export using raw_i32x8  = detail::raw<std::int32_t, 8>;
+export using raw_i32x16 = detail::raw<std::int32_t, 16>;
 export using raw_i64x2 = detail::raw<std::int64_t, 2>;
 export using raw_i64x4 = detail::raw<std::int64_t, 4>;
 export using raw_i16x8 = detail::raw<std::int16_t, 8>;
@@ -284,8 +300,12 @@ struct vec
     // NOTE: a loop doing out.r[i] = value is NOT usable in constexpr --
     // GCC vector_size types don't permit per-lane lvalue mutation in a
     // constant expression (read-by-index is fine, write-by-index isn't).
-    // Build a fresh raw_type via the index_sequence trick instead, which
-    // is pure construction, no mutation.
+    // Constant evaluation builds a fresh raw_type via the index_sequence
+    // trick instead, which is pure construction, no mutation. At runtime
+    // the loop is the better form: GCC folds the N-element initializer
+    // early, and once that lands in a baseline-ISA caller (splat called
+    // through operator*(vec, T) and the like) it reaches AVX2 / AVX-512
+    // dispatch kernels as N masked inserts. The loop stays one broadcast.
     static constexpr vec splat(T value)
     {
         return splat_impl(value, std::make_integer_sequence<int, N>{});
@@ -295,7 +315,19 @@ struct vec
     template <int... Is>
     static constexpr vec splat_impl(T value, std::integer_sequence<int, Is...>)
     {
-        return vec{raw_type{(static_cast<void>(Is), value)...}};
+        if consteval
+        {
+            return vec{raw_type{(static_cast<void>(Is), value)...}};
+        }
+        else
+        {
+            raw_type out{};
+            for (int i = 0; i < N; ++i)
+            {
+                out[i] = value;
+            }
+            return vec{out};
+        }
     }
 
   public:
@@ -337,6 +369,19 @@ struct vec
             p[i] = r[i];
     }
 
+    // loop tails: only the first `count` elements are read or written, so
+    // p may point at the last few elements of a buffer. Lanes past `count`
+    // are `fill` on load. Goes through load_masked/store_masked below.
+    static constexpr vec load_partial(const T* p, int count, T fill = T{})
+    {
+        return load_masked(p, mask<N>::first(count), splat(fill));
+    }
+
+    constexpr void store_partial(T* p, int count) const
+    {
+        store_masked(p, mask<N>::first(count), *this);
+    }
+
     // -- arithmetic -------------------------------------------------------
     // Every operator just forwards to the builtin vector op: the compiler
     // (not us) is responsible for recognizing add/sub/mul/div and emitting
@@ -444,15 +489,25 @@ struct vec
 
 // ---- readable type aliases (struct wrapper, not raw) -------------------
 
-export using f32x4 = vec<float, 4>;
-export using f32x8 = vec<float, 8>;
-export using f64x2 = vec<double, 2>;
-export using f64x4 = vec<double, 4>;
+export using f32x4  = vec<float, 4>;
+export using f32x8  = vec<float, 8>;
+export using f32x16 = vec<float, 16>;
+export using f64x2  = vec<double, 2>;
+export using f64x4  = vec<double, 4>;
+export using f64x8  = vec<double, 8>;
+
+export using i32x4  = vec<std::int32_t, 4>;
+export using i32x8  = vec<std::int32_t, 8>;
+export using i32x16 = vec<std::int32_t, 16>;
+export using u8x16  = vec<std::uint8_t, 16>;
+export using i16x8  = vec<std::int16_t, 8>;
 
-export using i32x4 = vec<std::int32_t, 4>;
-export using i32x8 = vec<std::int32_t, 8>;
-export using u8x16 = vec<std::uint8_t, 16>;
-export using i16x8 = vec<std::int16_t, 8>;
+export using u32x4  = vec<std::uint32_t, 4>;
+export using u32x8  = vec<std::uint32_t, 8>;
+export using u32x16 = vec<std::uint32_t, 16>;
+export using u64x2  = vec<std::uint64_t, 2>;
+export using u64x4  = vec<std::uint64_t, 4>;
+export using u64x8  = vec<std::uint64_t, 8>;
 
 // ---- min / max / clamp --------------------------------------------------
 // a < b ? a : b  compiles to a single minps/vminps -- GCC vector-extension
@@ -512,6 +567,14 @@ export constexpr f32x8 abs(f32x8 a)
     return f32x8{f32x8::raw_type(u32_raw(a.r) & sign_mask)};
 }
 
+export constexpr f32x16 abs(f32x16 a)
+{
+    using u32_raw = detail::raw<std::uint32_t, 16>;
+    constexpr u32_raw sign_mask{0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu,
+                                0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu, 0x7fffffffu};
+    return f32x16{f32x16::raw_type(u32_raw(a.r) & sign_mask)};
+}
+
 // ---- sqrt / rsqrt -------------------------------------------------------
 // Dispatch to the best available instruction set at compile time based on
 // macros GCC/Clang define automatically from -march/-msse/-mavx flags.
@@ -583,6 +646,24 @@ export inline f32x8 rsqrt(f32x8 a)
 }
 #endif
 
+// f32x16: GCC and Clang disagree on the signatures of the 512-bit sqrt
+// builtins, so this stays a per-lane loop. With -mavx512f and the release
+// -ffast-math flags it still folds into a single vsqrtps zmm.
+export inline f32x16 sqrt(f32x16 a)
+{
+    f32x16 out;
+    for (int i = 0; i < 16; ++i)
+        out[i] = std::sqrt(a[i]);
+    return out;
+}
+export inline f32x16 rsqrt(f32x16 a)
+{
+    f32x16 out;
+    for (int i = 0; i < 16; ++i)
+        out[i] = 1.f / std::sqrt(a[i]);
+    return out;
+}
+
 // One Newton-Raphson refinement step for rsqrt: turns the ~12-bit
 // approximation into ~23-bit (near full float precision), still far
 // cheaper than a real divide + sqrt. y_{n+1} = y_n * (1.5 - 0.5*x*y_n^2)
@@ -633,4 +714,738 @@ constexpr vec<T, N> select(decltype(std::declval<vec<T, N>>().r < std::declval<v
 {
     return vec<T, N>{typename vec<T, N>::raw_type(mask ? a.r : b.r)};
 }
+
+// ---- mask<N>: one bit per lane ---------------------------------------
+// The AVX-512 way of predicating: a plain N-bit integer (__mmask16 for 16
+// float lanes) instead of a full-width all-1s/all-0s vector. Bit i belongs
+// to lane i. Build one from a compare with to_mask(a < b); every consumer
+// below works at any width, and lowers to the k-register forms
+// (vblendmps, masked vmovups, vcompressps) when __AVX512F__ is set.
+
+export template <int N>
+struct mask
+{
+    static_assert(N > 0 && N <= 64, "mask<N> holds at most 64 lanes");
+    using bits_type = std::conditional_t<(N <= 8), std::uint8_t, std::conditional_t<(N <= 16), std::uint16_t, std::conditional_t<(N <= 32), std::uint32_t, std::uint64_t>>>;
+
+    static constexpr int lanes         = N;
+    static constexpr bits_type all_set = static_cast<bits_type>(N == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << N) - 1);
+
+    bits_type bits{};
+
+    static constexpr mask from_bits(std::uint64_t value)
+    {
+        return mask{static_cast<bits_type>(value & all_set)};
+    }
+
+    // first `count` lanes set: the tail mask for a loop remainder
+    static constexpr mask first(int count)
+    {
+        return count <= 0 ? mask{} : count >= N ? mask{all_set} : from_bits((std::uint64_t{1} << count) - 1);
+    }
+
+    constexpr bool operator[](int i) const
+    {
+        return ((bits >> i) & 1u) != 0;
+    }
+
+    constexpr bool any() const
+    {
+        return bits != 0;
+    }
+    constexpr bool all() const
+    {
+        return bits == all_set;
+    }
+    constexpr bool none() const
+    {
+        return bits == 0;
+    }
+    constexpr int count() const
+    {
+        return std::popcount(bits);
+    }
+
+    friend constexpr mask operator&(mask a, mask b)
+    {
+        return mask{static_cast<bits_type>(a.bits & b.bits)};
+    }
+    friend constexpr mask operator|(mask a, mask b)
+    {
+        return mask{static_cast<bits_type>(a.bits | b.bits)};
+    }
+    friend constexpr mask operator^(mask a, mask b)
+    {
+        return mask{static_cast<bits_type>(a.bits ^ b.bits)};
+    }
+    friend constexpr mask operator~(mask a)
+    {
+        return mask{static_cast<bits_type>(~a.bits & all_set)};
+    }
+    friend constexpr bool operator==(mask a, mask b) = default;
+};
+
+export using mask4  = mask<4>;
+export using mask8  = mask<8>;
+export using mask16 = mask<16>;
+
+// ---- compare results -----------------------------------------------
+// Queries straight on the all-1s/all-0s vector a vec compare returns, for
+// kernels that only need to branch on it: if (any(d < zero)) ...
+// movemask is one movmskps/movmskpd/pmovmskb (or vptestm under AVX-512)
+// for the 16/32/64-byte forms; lane i lands in bit i.
+
+namespace detail
+{
+// a raw compare-result vector: integral lanes, not a vec wrapper
+template <typename Cmp>
+concept compare_result = std::is_integral_v<std::remove_cvref_t<decltype(std::declval<Cmp>()[0])>> && !requires { Cmp::lanes; };
+
+template <typename Cmp>
+constexpr int compare_lanes = static_cast<int>(sizeof(Cmp) / sizeof(std::declval<Cmp>()[0]));
+} // namespace detail
+
+export template <detail::compare_result Cmp>
+constexpr std::uint64_t movemask(Cmp cmp)
+{
+    constexpr std::size_t bytes = sizeof(Cmp);
+    constexpr std::size_t lane  = sizeof(cmp[0]);
+#if defined(__SSE2__)
+    if !consteval
+    {
+        if constexpr (bytes == 16 && lane == 4)
+            return static_cast<std::uint32_t>(_mm_movemask_ps(std::bit_cast<__m128>(cmp)));
+        else if constexpr (bytes == 16 && lane == 8)
+            return static_cast<std::uint32_t>(_mm_movemask_pd(std::bit_cast<__m128d>(cmp)));
+        else if constexpr (bytes == 16 && lane == 1)
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(std::bit_cast<__m128i>(cmp)));
+#    if defined(__AVX__)
+        else if constexpr (bytes == 32 && lane == 4)
+            return static_cast<std::uint32_t>(_mm256_movemask_ps(std::bit_cast<__m256>(cmp)));
+        else if constexpr (bytes == 32 && lane == 8)
+            return static_cast<std::uint32_t>(_mm256_movemask_pd(std::bit_cast<__m256d>(cmp)));
+#    endif
+#    if defined(__AVX512F__)
+        else if constexpr (bytes == 64 && lane == 4)
+            return _mm512_test_epi32_mask(std::bit_cast<__m512i>(cmp), std::bit_cast<__m512i>(cmp));
+        else if constexpr (bytes == 64 && lane == 8)
+            return _mm512_test_epi64_mask(std::bit_cast<__m512i>(cmp), std::bit_cast<__m512i>(cmp));
+#    endif
+    }
+#endif
+    std::uint64_t bits{};
+    for (int i = 0; i < detail::compare_lanes<Cmp>; ++i)
+        bits |= static_cast<std::uint64_t>(cmp[i] != 0) << i;
+    return bits;
+}
+
+export template <detail::compare_result Cmp>
+constexpr bool any(Cmp cmp)
+{
+    return movemask(cmp) != 0;
+}
+
+export template <detail::compare_result Cmp>
+constexpr bool all(Cmp cmp)
+{
+    return movemask(cmp) == mask<detail::compare_lanes<Cmp>>::all_set;
+}
+
+export template <detail::compare_result Cmp>
+constexpr int popcount(Cmp cmp)
+{
+    return std::popcount(movemask(cmp));
+}
+
+// Compress a compare result (all-1s/all-0s lanes) into one bit per lane.
+export template <detail::compare_result Cmp>
+constexpr auto to_mask(Cmp cmp)
+{
+    return mask<detail::compare_lanes<Cmp>>::from_bits(movemask(cmp));
+}
+
+namespace detail
+{
+template <typename T>
+using lane_int_t = std::conditional_t<sizeof(T) == 8, std::int64_t, std::conditional_t<sizeof(T) == 4, std::int32_t, std::conditional_t<sizeof(T) == 2, std::int16_t, std::int8_t>>>;
+
+// Expand a bitmask back into the compare-result vector the ternary select
+// understands: lane i tests bit i of a broadcast copy of the mask.
+template <typename T, int N, int... Is>
+constexpr auto expand_mask(mask<N> m, std::integer_sequence<int, Is...>)
+{
+    using raw_int = raw<lane_int_t<T>, N>;
+    return (raw_int{(static_cast<void>(Is), static_cast<lane_int_t<T>>(m.bits))...} & raw_int{static_cast<lane_int_t<T>>(std::uint64_t{1} << Is)...}) != 0;
+}
+
+// Per-lane fallback for lanes too narrow to hold a bit index (u8x16).
+// Pure construction, no lane writes, so it stays usable in constexpr.
+template <typename T, int N, int... Is>
+constexpr vec<T, N> select_lanes(mask<N> m, vec<T, N> a, vec<T, N> b, std::integer_sequence<int, Is...>)
+{
+    return vec<T, N>{typename vec<T, N>::raw_type{(m[Is] ? a[Is] : b[Is])...}};
+}
+
+#if defined(__AVX512F__)
+using v16sf = float __attribute__((__vector_size__(64)));
+using v16si = int __attribute__((__vector_size__(64)));
+#endif
+} // namespace detail
+
+export template <typename T, int N>
+constexpr vec<T, N> select(mask<N> m, vec<T, N> a, vec<T, N> b)
+{
+    if constexpr (sizeof(T) * 8 >= N)
+    {
+        return vec<T, N>{typename vec<T, N>::raw_type(detail::expand_mask<T>(m, std::make_integer_sequence<int, N>{}) ? a.r : b.r)};
+    }
+    else
+    {
+        return detail::select_lanes(m, a, b, std::make_integer_sequence<int, N>{});
+    }
+}
+
+// ---- masked memory access -------------------------------------------
+// Lanes outside the mask are neither read nor written, so these are safe
+// on the ragged end of a buffer. Under __AVX512F__ the 16 x 32-bit forms
+// are single masked vmovups / vmovdqu32 / vcompressps / vpcompressd
+// instructions; everything else is a per-lane loop.
+
+// Lanes outside `m` keep the value from `fallback`.
+export template <typename T, int N>
+constexpr vec<T, N> load_masked(const T* p, mask<N> m, vec<T, N> fallback = {})
+{
+#if defined(__AVX512F__)
+    if !consteval
+    {
+        if constexpr (N == 16 && std::is_same_v<T, float>)
+            return vec<T, N>{__builtin_ia32_loadups512_mask(p, fallback.r, m.bits)};
+        else if constexpr (N == 16 && std::is_same_v<T, std::int32_t>)
+            return vec<T, N>{__builtin_ia32_loaddqusi512_mask(p, fallback.r, m.bits)};
+    }
+#endif
+    vec<T, N> out = fallback;
+    for (int i = 0; i < N; ++i)
+        if (m[i])
+            out[i] = p[i];
+    return out;
+}
+
+export template <typename T, int N>
+constexpr void store_masked(T* p, mask<N> m, vec<T, N> v)
+{
+#if defined(__AVX512F__)
+    if !consteval
+    {
+        if constexpr (N == 16 && std::is_same_v<T, float>)
+            return __builtin_ia32_storeups512_mask(p, v.r, m.bits);
+        else if constexpr (N == 16 && std::is_same_v<T, std::int32_t>)
+            return __builtin_ia32_storedqusi512_mask(p, v.r, m.bits);
+    }
+#endif
+    for (int i = 0; i < N; ++i)
+        if (m[i])
+            p[i] = v[i];
+}
+
+// Writes the selected lanes contiguously to p (in lane order) and returns
+// how many were written; p needs room for m.count() elements only. This is
+// the building block for culling/filtering kernels that emit a compacted
+// stream:  out += compress_store(out, to_mask(d > 0), ids);
+export template <typename T, int N>
+constexpr int compress_store(T* p, mask<N> m, vec<T, N> v)
+{
+#if defined(__AVX512F__)
+    if !consteval
+    {
+        if constexpr (N == 16 && std::is_same_v<T, float>)
+        {
+            __builtin_ia32_compressstoresf512_mask(reinterpret_cast<detail::v16sf*>(p), v.r, m.bits);
+            return m.count();
+        }
+        else if constexpr (N == 16 && std::is_same_v<T, std::int32_t>)
+        {
+            __builtin_ia32_compressstoresi512_mask(reinterpret_cast<detail::v16si*>(p), v.r, m.bits);
+            return m.count();
+        }
+    }
+#endif
+    int written = 0;
+    for (int i = 0; i < N; ++i)
+        if (m[i])
+            p[written++] = v[i];
+    return written;
+}
+
+// ---- gather / scatter -----------------------------------------------
+// Per lane base[indices[i]], for index buffers and BVH node fetches.
+// Indices are element offsets, not byte offsets. AVX2 gathers 4 and 8
+// lanes through 32-bit indices (vgatherdps / vpgatherdd, and f64x4 from
+// an i32x4); AVX-512F adds the 16 x 32-bit and 8 x 64-bit forms plus
+// scatters. Anything else is a per-lane loop. Overlapping scatter indices
+// resolve like the loop: the highest lane wins.
+
+namespace detail
+{
+template <typename T, int N, int... Is>
+constexpr vec<T, N> gather_lanes(const T* base, vec<std::int32_t, N> indices, std::integer_sequence<int, Is...>)
+{
+    return vec<T, N>{typename vec<T, N>::raw_type{base[indices[Is]]...}};
+}
+} // namespace detail
+
+export template <typename T, int N>
+constexpr vec<T, N> gather(const T* base, vec<std::int32_t, N> indices)
+{
+#if defined(__AVX2__)
+    using raw_type = vec<T, N>::raw_type;
+    // the masked forms with a zero source: GCC's unmasked gathers trip -Wmaybe-uninitialized on
+    // their undefined source
+    if !consteval
+    {
+        const __m256i all{_mm256_set1_epi32(-1)};
+        if constexpr (std::is_same_v<T, float> && N == 4)
+            return vec<T, N>{std::bit_cast<raw_type>(
+                _mm_mask_i32gather_ps(_mm_setzero_ps(), base, std::bit_cast<__m128i>(indices.r), _mm_castsi128_ps(_mm256_castsi256_si128(all)), 4))};
+        else if constexpr (std::is_same_v<T, float> && N == 8)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, std::bit_cast<__m256i>(indices.r), _mm256_castsi256_ps(all), 4))};
+        else if constexpr (std::is_same_v<T, std::int32_t> && N == 4)
+            return vec<T, N>{std::bit_cast<raw_type>(
+                _mm_mask_i32gather_epi32(_mm_setzero_si128(), base, std::bit_cast<__m128i>(indices.r), _mm256_castsi256_si128(all), 4))};
+        else if constexpr (std::is_same_v<T, std::int32_t> && N == 8)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, std::bit_cast<__m256i>(indices.r), all, 4))};
+        else if constexpr (std::is_same_v<T, double> && N == 4)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, std::bit_cast<__m128i>(indices.r), _mm256_castsi256_pd(all), 8))};
+#    if defined(__AVX512F__)
+        else if constexpr (std::is_same_v<T, float> && N == 16)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, std::bit_cast<__m512i>(indices.r), base, 4))};
+        else if constexpr (std::is_same_v<T, std::int32_t> && N == 16)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, std::bit_cast<__m512i>(indices.r), base, 4))};
+        else if constexpr (std::is_same_v<T, double> && N == 8)
+            return vec<T, N>{std::bit_cast<raw_type>(_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, std::bit_cast<__m256i>(indices.r), base, 8))};
+#    endif
+    }
+#endif
+    return detail::gather_lanes(base, indices, std::make_integer_sequence<int, N>{});
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+namespace detail
+{
+// The runtime dispatched kernels see neither __AVX2__ nor __AVX512F__, so gather would take
+// the per-lane loop there; like mul_even_avx2 below these carry the target themselves, and
+// those kernels pass them in place of gather.
+inline BALBINO_TARGET_AVX2 vec<std::int32_t, 8> gather_avx2(const std::int32_t* base, const vec<std::int32_t, 8> indices) noexcept
+{
+    return vec<std::int32_t, 8>{std::bit_cast<raw<std::int32_t, 8>>(
+        _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, std::bit_cast<__m256i>(indices.r), _mm256_set1_epi32(-1), 4))};
+}
+
+inline BALBINO_TARGET_AVX512 vec<std::int32_t, 16> gather_avx512(const std::int32_t* base, const vec<std::int32_t, 16> indices) noexcept
+{
+    return vec<std::int32_t, 16>{std::bit_cast<raw<std::int32_t, 16>>(_mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, std::bit_cast<__m512i>(indices.r), base, 4))};
+}
+} // namespace detail
+#endif
+
+export template <typename T, int N>
+constexpr void scatter(T* base, vec<std::int32_t, N> indices, vec<T, N> v)
+{
+#if defined(__AVX512F__)
+    if !consteval
+    {
+        if constexpr (std::is_same_v<T, float> && N == 16)
+            return _mm512_i32scatter_ps(base, std::bit_cast<__m512i>(indices.r), std::bit_cast<__m512>(v.r), 4);
+        else if constexpr (std::is_same_v<T, std::int32_t> && N == 16)
+            return _mm512_i32scatter_epi32(base, std::bit_cast<__m512i>(indices.r), std::bit_cast<__m512i>(v.r), 4);
+        else if constexpr (std::is_same_v<T, double> && N == 8)
+            return _mm512_i32scatter_pd(base, std::bit_cast<__m256i>(indices.r), std::bit_cast<__m512d>(v.r), 8);
+#    if defined(__AVX512VL__)
+        else if constexpr (std::is_same_v<T, float> && N == 8)
+            return _mm256_i32scatter_ps(base, std::bit_cast<__m256i>(indices.r), std::bit_cast<__m256>(v.r), 4);
+        else if constexpr (std::is_same_v<T, std::int32_t> && N == 8)
+            return _mm256_i32scatter_epi32(base, std::bit_cast<__m256i>(indices.r), std::bit_cast<__m256i>(v.r), 4);
+#    endif
+    }
+#endif
+    for (int i = 0; i < N; ++i)
+        base[indices[i]] = v[i];
+}
+
+// ---- interleaved xyz -----------------------------------------------
+// AoS float3 <-> SoA lanes: load3 reads 3*N elements {x0,y0,z0,x1,...}
+// and returns {x, y, z}; store3 writes them back interleaved.
+//   auto [x, y, z] = load3<f32x8>(positions + 3 * i);
+
+namespace detail
+{
+template <typename V, int... Is>
+constexpr std::array<V, 3> load3_lanes(const typename V::scalar_type* p, std::integer_sequence<int, Is...>)
+{
+    using raw_type = V::raw_type;
+    return {V{raw_type{p[3 * Is]...}}, V{raw_type{p[3 * Is + 1]...}}, V{raw_type{p[3 * Is + 2]...}}};
+}
+} // namespace detail
+
+export template <typename V>
+constexpr std::array<V, 3> load3(const typename V::scalar_type* p)
+{
+    return detail::load3_lanes<V>(p, std::make_integer_sequence<int, V::lanes>{});
+}
+
+export template <typename T, int N>
+constexpr void store3(T* p, vec<T, N> x, vec<T, N> y, vec<T, N> z)
+{
+    for (int i = 0; i < N; ++i)
+    {
+        p[3 * i]     = x[i];
+        p[3 * i + 1] = y[i];
+        p[3 * i + 2] = z[i];
+    }
+}
+
+// ---- streaming (non-temporal) stores -------------------------------
+// Writes around the cache for large outputs that are not read back soon
+// (baked noise grids, skinned vertex streams). p must be aligned to the
+// full vector width. Issue stream_fence() once after the loop, before the
+// data is handed to another thread. Falls back to a plain store when the
+// width has no movntps/movntdq form on the target.
+
+export template <typename T, int N>
+inline void stream(T* p, vec<T, N> v)
+{
+    constexpr std::size_t bytes = sizeof(typename vec<T, N>::raw_type);
+#if defined(__AVX512F__)
+    if constexpr (bytes == 64 && std::is_same_v<T, float>)
+        return _mm512_stream_ps(p, std::bit_cast<__m512>(v.r));
+    else if constexpr (bytes == 64 && std::is_same_v<T, double>)
+        return _mm512_stream_pd(p, std::bit_cast<__m512d>(v.r));
+    else if constexpr (bytes == 64 && std::is_integral_v<T>)
+        return _mm512_stream_si512(reinterpret_cast<__m512i*>(p), std::bit_cast<__m512i>(v.r));
+#endif
+#if defined(__AVX__)
+    if constexpr (bytes == 32 && std::is_same_v<T, float>)
+        return _mm256_stream_ps(p, std::bit_cast<__m256>(v.r));
+    else if constexpr (bytes == 32 && std::is_same_v<T, double>)
+        return _mm256_stream_pd(p, std::bit_cast<__m256d>(v.r));
+    else if constexpr (bytes == 32 && std::is_integral_v<T>)
+        return _mm256_stream_si256(reinterpret_cast<__m256i*>(p), std::bit_cast<__m256i>(v.r));
+#endif
+#if defined(__SSE2__)
+    if constexpr (bytes == 16 && std::is_same_v<T, float>)
+        return _mm_stream_ps(p, std::bit_cast<__m128>(v.r));
+    else if constexpr (bytes == 16 && std::is_same_v<T, double>)
+        return _mm_stream_pd(p, std::bit_cast<__m128d>(v.r));
+    else if constexpr (bytes == 16 && std::is_integral_v<T>)
+        return _mm_stream_si128(reinterpret_cast<__m128i*>(p), std::bit_cast<__m128i>(v.r));
+#endif
+    v.store(p);
+}
+
+export inline void stream_fence()
+{
+#if defined(__SSE2__)
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+#endif
+}
+
+// ---- horizontal reductions ------------------------------------------
+// Folded in log2(N) rotate+op steps at full width: lane 0 ends up holding
+// the result (the other lanes hold partial folds and are dropped). The
+// float sums therefore associate as a tree, not left to right.
+
+namespace detail
+{
+// lane i takes lane (i + Shift) % N
+template <int Shift, typename R, int... Is>
+constexpr R rotate_lanes(R r, std::integer_sequence<int, Is...>)
+{
+    return __builtin_shufflevector(r, r, ((Is + Shift) % static_cast<int>(sizeof...(Is)))...);
+}
+
+// lane i takes lane i - Shift, the lowest Shift lanes become zero
+template <int Shift, typename R, int... Is>
+constexpr R shift_up_lanes(R r, std::integer_sequence<int, Is...>)
+{
+    return __builtin_shufflevector(r, R{}, (Is < Shift ? static_cast<int>(sizeof...(Is)) : Is - Shift)...);
+}
+
+template <int Width, typename T, int N, typename Op>
+constexpr vec<T, N> fold_lanes(vec<T, N> v, Op op)
+{
+    if constexpr (Width == 1)
+        return v;
+    else
+        return fold_lanes<Width / 2>(op(v, vec<T, N>{rotate_lanes<Width / 2>(v.r, std::make_integer_sequence<int, N>{})}), op);
+}
+
+// finite from the exponent bits: Release builds use -ffast-math, where std::isfinite folds to
+// true, and input validation must still see NaN and infinity
+constexpr bool is_finite(const double value) noexcept
+{
+    constexpr std::uint64_t exponent{0x7FF0000000000000U};
+    return (std::bit_cast<std::uint64_t>(value) & exponent) != exponent;
+}
+
+// min / max for the reductions: a NaN in either operand wins, so one NaN lane makes the
+// result NaN whatever its position. Plain min / max keep the second operand instead.
+template <typename T, int N>
+constexpr vec<T, N> min_nan(vec<T, N> a, vec<T, N> b)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return vec<T, N>{typename vec<T, N>::raw_type((a.r < b.r) | (a.r != a.r) ? a.r : b.r)};
+    else
+        return min(a, b);
+}
+
+template <typename T, int N>
+constexpr vec<T, N> max_nan(vec<T, N> a, vec<T, N> b)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return vec<T, N>{typename vec<T, N>::raw_type((a.r > b.r) | (a.r != a.r) ? a.r : b.r)};
+    else
+        return max(a, b);
+}
+
+// index of the lowest set bit, N when no lane matched
+template <int N>
+constexpr int first_lane(std::uint64_t bits)
+{
+    static_assert(N < 64);
+    return std::countr_zero(bits | (std::uint64_t{1} << N));
+}
+} // namespace detail
+
+export template <typename T, int N>
+constexpr T reduce_add(vec<T, N> v)
+{
+    return detail::fold_lanes<N>(v, [](vec<T, N> a, vec<T, N> b) { return a + b; })[0];
+}
+
+export template <typename T, int N>
+constexpr T reduce_min(vec<T, N> v)
+{
+    return detail::fold_lanes<N>(v, [](vec<T, N> a, vec<T, N> b) { return detail::min_nan(a, b); })[0];
+}
+
+export template <typename T, int N>
+constexpr T reduce_max(vec<T, N> v)
+{
+    return detail::fold_lanes<N>(v, [](vec<T, N> a, vec<T, N> b) { return detail::max_nan(a, b); })[0];
+}
+
+// reduce_min / reduce_max are NaN when any lane is NaN, so argmin / argmax give the lowest
+// lane holding the minimum / maximum, or N when a lane is NaN.
+export template <typename T, int N>
+constexpr int argmin(vec<T, N> v)
+{
+    return detail::first_lane<N>(movemask(v.r == vec<T, N>::splat(reduce_min(v)).r));
+}
+
+export template <typename T, int N>
+constexpr int argmax(vec<T, N> v)
+{
+    return detail::first_lane<N>(movemask(v.r == vec<T, N>::splat(reduce_max(v)).r));
+}
+
+// ---- prefix sums ----------------------------------------------------
+// In-register Hillis-Steele scan, log2(N) shift+add steps:
+//   inclusive_scan({1, 2, 3, 4}) == {1, 3, 6, 10}
+//   exclusive_scan({1, 2, 3, 4}) == {0, 1, 3, 6}
+// Carry a running total across a loop with  offset += splat(v_scanned[N - 1]).
+
+namespace detail
+{
+template <int Shift, typename T, int N>
+constexpr vec<T, N> scan_steps(vec<T, N> v)
+{
+    if constexpr (Shift >= N)
+        return v;
+    else
+        return scan_steps<Shift * 2>(v + vec<T, N>{shift_up_lanes<Shift>(v.r, std::make_integer_sequence<int, N>{})});
+}
+} // namespace detail
+
+export template <typename T, int N>
+constexpr vec<T, N> inclusive_scan(vec<T, N> v)
+{
+    return detail::scan_steps<1>(v);
+}
+
+export template <typename T, int N>
+constexpr vec<T, N> exclusive_scan(vec<T, N> v)
+{
+    return vec<T, N>{detail::shift_up_lanes<1>(inclusive_scan(v).r, std::make_integer_sequence<int, N>{})};
+}
+
+// ---- shuffles -------------------------------------------------------
+// Compile-time lane moves go through __builtin_shufflevector, so the
+// compiler picks the cheapest shufps/vpermilps/vpermt2ps/blend form.
+//   shuffle<3, 2, 1, 0>(v)       reverse
+//   shuffle<0, 4, 1, 5>(a, b)    indices 0..N-1 pick from a, N..2N-1 from b
+//   blend<0b0101>(a, b)          bit i set takes lane i from b
+// permute() is the runtime counterpart: lane i takes v[indices[i] % N].
+
+export template <int... Is, typename T, int N>
+    requires(sizeof...(Is) == N)
+constexpr vec<T, N> shuffle(vec<T, N> v)
+{
+    static_assert(((Is >= 0 && Is < N) && ...), "shuffle index out of range");
+    return vec<T, N>{__builtin_shufflevector(v.r, v.r, Is...)};
+}
+
+export template <int... Is, typename T, int N>
+    requires(sizeof...(Is) == N)
+constexpr vec<T, N> shuffle(vec<T, N> a, vec<T, N> b)
+{
+    static_assert(((Is >= 0 && Is < 2 * N) && ...), "shuffle index out of range");
+    return vec<T, N>{__builtin_shufflevector(a.r, b.r, Is...)};
+}
+
+namespace detail
+{
+template <std::uint64_t Bits, typename R, int... Is>
+constexpr R blend_lanes(R a, R b, std::integer_sequence<int, Is...>)
+{
+    return __builtin_shufflevector(a, b, (((Bits >> Is) & 1u) != 0 ? static_cast<int>(sizeof...(Is)) + Is : Is)...);
+}
+
+template <typename T, int N, typename Idx, int... Is>
+constexpr vec<T, N> permute_lanes(vec<T, N> v, Idx indices, std::integer_sequence<int, Is...>)
+{
+    return vec<T, N>{typename vec<T, N>::raw_type{v[static_cast<int>(indices[Is]) & (N - 1)]...}};
+}
+} // namespace detail
+
+export template <std::uint64_t Bits, typename T, int N>
+constexpr vec<T, N> blend(vec<T, N> a, vec<T, N> b)
+{
+    static_assert(N == 64 || (Bits >> N) == 0, "blend mask has bits past the last lane");
+    return vec<T, N>{detail::blend_lanes<Bits>(a.r, b.r, std::make_integer_sequence<int, N>{})};
+}
+
+export template <typename T, int N>
+constexpr vec<T, N> permute(vec<T, N> v, vec<detail::lane_int_t<T>, N> indices)
+{
+#if defined(__clang__)
+    return detail::permute_lanes(v, indices.r, std::make_integer_sequence<int, N>{});
+#else
+    return vec<T, N>{__builtin_shuffle(v.r, indices.r)};
+#endif
+}
+
+// ---- interleave -----------------------------------------------------
+// interleave(a, b)   -> {a0 b0 a1 b1 ..., second half}   (unpacklo/unpackhi)
+// deinterleave(a, b) -> {even lanes, odd lanes} of the concatenation a|b,
+// so deinterleave(interleave(x, y)) gives back {x, y}.
+
+namespace detail
+{
+template <int Offset, typename R, int... Is>
+constexpr R zip_lanes(R a, R b, std::integer_sequence<int, Is...>)
+{
+    return __builtin_shufflevector(a, b, (Is % 2 == 0 ? Offset + Is / 2 : static_cast<int>(sizeof...(Is)) + Offset + Is / 2)...);
+}
+
+template <int Offset, typename R, int... Is>
+constexpr R unzip_lanes(R a, R b, std::integer_sequence<int, Is...>)
+{
+    return __builtin_shufflevector(a, b, (2 * Is + Offset)...);
+}
+} // namespace detail
+
+export template <typename T, int N>
+constexpr std::array<vec<T, N>, 2> interleave(vec<T, N> a, vec<T, N> b)
+{
+    constexpr auto lanes = std::make_integer_sequence<int, N>{};
+    return {vec<T, N>{detail::zip_lanes<0>(a.r, b.r, lanes)}, vec<T, N>{detail::zip_lanes<N / 2>(a.r, b.r, lanes)}};
+}
+
+export template <typename T, int N>
+constexpr std::array<vec<T, N>, 2> deinterleave(vec<T, N> a, vec<T, N> b)
+{
+    constexpr auto lanes = std::make_integer_sequence<int, N>{};
+    return {vec<T, N>{detail::unzip_lanes<0>(a.r, b.r, lanes)}, vec<T, N>{detail::unzip_lanes<1>(a.r, b.r, lanes)}};
+}
+
+// ---- widening multiply ----------------------------------------------
+// mul_wide(a, b) -> {high halves, low halves} of the 32 x 32 -> 64-bit lane
+// products, the building block of Philox and multiply-mix hashes. pmuludq
+// only multiplies the even lanes, so the odd ones take a second pass after a
+// 64-bit shift and the two are merged back; plain a * b on u64 lanes would
+// compile to the three-multiply emulation of pmullq instead. Runtime
+// dispatched kernels pass mul_even_avx2 / mul_even_avx512 as MulEven.
+
+namespace detail
+{
+// low 32 bits times low 32 bits of every 64-bit lane
+template <typename R>
+constexpr R mul_even(R a, R b)
+{
+#if defined(__SSE2__)
+    if !consteval
+    {
+        if constexpr (sizeof(R) == 16)
+            return std::bit_cast<R>(_mm_mul_epu32(std::bit_cast<__m128i>(a), std::bit_cast<__m128i>(b)));
+#    if defined(__AVX2__)
+        else if constexpr (sizeof(R) == 32)
+            return std::bit_cast<R>(_mm256_mul_epu32(std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+#    endif
+#    if defined(__AVX512F__)
+        // zero-masked: GCC's _mm512_mul_epu32 trips -Wmaybe-uninitialized on its undefined source
+        else if constexpr (sizeof(R) == 64)
+            return std::bit_cast<R>(_mm512_maskz_mul_epu32(0xFF, std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+#    endif
+        else
+        {
+            R out;
+            for (std::size_t i = 0; i < sizeof(R); i += 16)
+            {
+                __m128i ha;
+                __m128i hb;
+                std::memcpy(&ha, reinterpret_cast<const char*>(&a) + i, 16);
+                std::memcpy(&hb, reinterpret_cast<const char*>(&b) + i, 16);
+                const __m128i product{_mm_mul_epu32(ha, hb)};
+                std::memcpy(reinterpret_cast<char*>(&out) + i, &product, 16);
+            }
+            return out;
+        }
+    }
+#endif
+    return (a & 0xFFFFFFFFULL) * (b & 0xFFFFFFFFULL);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+// The runtime dispatched AVX2 / AVX-512 kernels are built on the baseline ISA, so mul_even
+// sees neither __AVX2__ nor __AVX512F__ there and splits into 128-bit halves. These carry the
+// target themselves. Not always_inline: GCC inlines those into their baseline-ISA callers
+// first, which fails on the target mismatch; plain inline lands once the callers are in the
+// kernel.
+inline BALBINO_TARGET_AVX2 raw<std::uint64_t, 4> mul_even_avx2(const raw<std::uint64_t, 4> a, const raw<std::uint64_t, 4> b) noexcept
+{
+    return std::bit_cast<raw<std::uint64_t, 4>>(_mm256_mul_epu32(std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+}
+
+inline BALBINO_TARGET_AVX512 raw<std::uint64_t, 8> mul_even_avx512(const raw<std::uint64_t, 8> a, const raw<std::uint64_t, 8> b) noexcept
+{
+    // zero-masked, as in mul_even
+    return std::bit_cast<raw<std::uint64_t, 8>>(_mm512_maskz_mul_epu32(0xFF, std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+}
+#endif
+} // namespace detail
+
+export template <int N, auto MulEven = detail::mul_even<detail::raw<std::uint64_t, N / 2>>>
+BALBINO_FORCE_INLINE constexpr std::array<vec<std::uint32_t, N>, 2> mul_wide(vec<std::uint32_t, N> a, vec<std::uint32_t, N> b)
+{
+    using narrow = vec<std::uint32_t, N>::raw_type;
+    using wide   = detail::raw<std::uint64_t, N / 2>;
+    const wide wa{std::bit_cast<wide>(a.r)};
+    const wide wb{std::bit_cast<wide>(b.r)};
+    const wide even{MulEven(wa, wb)};
+    const wide odd{MulEven(wide(wa >> 32U), wide(wb >> 32U))};
+    return {vec<std::uint32_t, N>{std::bit_cast<narrow>(wide((even >> 32U) | (odd & 0xFFFFFFFF00000000ULL)))},
+            vec<std::uint32_t, N>{std::bit_cast<narrow>(wide((even & 0xFFFFFFFFULL) | (odd << 32U)))}};
+}
 } // namespace fawn_algebra::simd
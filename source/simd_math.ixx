@@ -0,0 +1,616 @@
+//
+// Copyright (c) 2025.
+// Author: Joran.
+//
+
+module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:SIMDMath;
+import :SIMD;
+import std;
+
+// Vectorised transcendental functions for simd::vec.
+//
+// Every function is a branch-free range reduction followed by a polynomial
+// (the float kernels are the Cephes single precision minimax ones, the
+// double kernels Cephes sin/cos and truncated series on a reduced
+// interval), so every lane costs the same and the whole thing inlines into
+// the caller's loop. Error bounds against the correctly rounded result,
+// over the stated domain (tests/simd_math.cpp keeps these honest):
+//
+//   float                            double
+//   sin, cos, sincos  <= 2.5 ulp     sin, cos, sincos  <= 2 ulp   |x| <= 8192
+//   tan               <= 4 ulp                                    |x| <= 8192
+//   asin, acos        <= 2 ulp                                    [-1, 1]
+//   atan, atan2       <= 3 ulp
+//   exp, exp2         <= 2 ulp       exp               <= 2 ulp   result normal
+//   log, log2         <= 2 ulp       log               <= 2 ulp   x > 0
+//   pow               <= 2 ulp + |y * log2(x)| * 2^-22 relative   (double: 2^-51)
+//
+// The fast_* variants (float only) trade precision for a third of the
+// instructions: degree 3-5 polynomials and a single-step reduction.
+//   fast_sin, fast_cos   abs error <= 2e-4   |x| <= 1e4
+//   fast_exp, fast_exp2  rel error <= 2e-4   result normal
+//   fast_log, fast_log2  abs error <= 2e-4   x normal, > 0
+//
+// With -ffast-math the Cody-Waite reductions still hold (they go through
+// detail::opaque, so they cannot be reassociated), but reciprocal division
+// and free contraction loosen the float bounds by up to 1.5 ulp. Special
+// values (NaN, +-inf, log(0), pow(0, y)) and denormal inputs follow IEEE
+// only without -ffast-math.
+
+namespace fawn_algebra::simd
+{
+namespace detail
+{
+template <typename T>
+struct math_traits;
+
+template <>
+struct math_traits<float>
+{
+    using int_type                         = std::int32_t;
+    static constexpr int mantissa_bits     = 23;
+    static constexpr int exponent_bias     = 127;
+    static constexpr int_type exponent_max = 0xff;
+};
+
+template <>
+struct math_traits<double>
+{
+    using int_type                         = std::int64_t;
+    static constexpr int mantissa_bits     = 52;
+    static constexpr int exponent_bias     = 1023;
+    static constexpr int_type exponent_max = 0x7ff;
+};
+
+template <typename T, int N>
+using int_raw = raw<typename math_traits<T>::int_type, N>;
+
+// per-lane choose on any compare result of the same lane width
+template <typename M, typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> pick(M m, vec<T, N> a, vec<T, N> b)
+{
+    return vec<T, N>{typename vec<T, N>::raw_type(m ? a.r : b.r)};
+}
+
+// Optimisation barrier: the value has to be materialised as computed, which
+// stops -fassociative-math from folding a multi-part constant back into one.
+template <typename V>
+BALBINO_FORCE_INLINE V opaque(V v)
+{
+#if BALBINO_ARCH_X86 && defined(__AVX512F__)
+    constexpr std::size_t register_bytes{64};
+#elif BALBINO_ARCH_X86 && defined(__AVX__)
+    constexpr std::size_t register_bytes{32};
+#else
+    constexpr std::size_t register_bytes{16};
+#endif
+    if constexpr (BALBINO_ARCH_X86 && sizeof(v.r) <= register_bytes)
+    {
+        __asm__("" : "+x"(v.r));
+    }
+    else
+    {
+        __asm__("" : "+m"(v.r));
+    }
+    return v;
+}
+
+// Horner evaluation, coefficients from the highest degree down
+template <typename V, typename... C>
+BALBINO_FORCE_INLINE V horner(V x, typename V::scalar_type c0, C... cs)
+{
+    V result = V::splat(c0);
+    ((result = fma(result, x, V::splat(static_cast<typename V::scalar_type>(cs)))), ...);
+    return result;
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE int_raw<T, N> to_int(vec<T, N> x)
+{
+    return __builtin_convertvector(x.r, int_raw<T, N>);
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> to_float(int_raw<T, N> x)
+{
+    return vec<T, N>{__builtin_convertvector(x, typename vec<T, N>::raw_type)};
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE int_raw<T, N> to_bits(vec<T, N> x)
+{
+    return std::bit_cast<int_raw<T, N>>(x.r);
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> from_bits(int_raw<T, N> bits)
+{
+    return vec<T, N>{std::bit_cast<typename vec<T, N>::raw_type>(bits)};
+}
+
+// Floor through truncation: exact for |x| < 2^31 (float) / 2^63 (double),
+// and unlike the (x + 1.5 * 2^23) - 1.5 * 2^23 trick it survives -ffast-math.
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> floor(vec<T, N> x)
+{
+    const vec<T, N> t = to_float<T, N>(to_int(x));
+    return pick(t.r > x.r, t - T(1), t);
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> round(vec<T, N> x)
+{
+    return floor(x + T(0.5));
+}
+
+// 2^n for integral n inside the normal exponent range
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> pow2i(int_raw<T, N> n)
+{
+    using traits = math_traits<T>;
+    return from_bits<T, N>((n + traits::exponent_bias) << traits::mantissa_bits);
+}
+
+// x * 2^n, split over two factors so results down in the denormal range and
+// up to the largest finite value round exactly once. The factors must not be
+// combined first, 2^half * 2^(n - half) itself can overflow.
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> ldexp(vec<T, N> x, int_raw<T, N> n)
+{
+    const int_raw<T, N> half = n >> 1;
+    return opaque(x * pow2i<T, N>(half)) * pow2i<T, N>(n - half);
+}
+
+// x = m * 2^e with m in [0.5, 1); denormals are lifted into range first
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> frexp(vec<T, N> x, int_raw<T, N>& e)
+{
+    using traits   = math_traits<T>;
+    using int_type = traits::int_type;
+    constexpr int k{traits::mantissa_bits + 2};
+
+    const auto tiny          = x.r < std::numeric_limits<T>::min();
+    const int_raw<T, N> lift = tiny ? int_raw<T, N>{} + k : int_raw<T, N>{};
+    const int_raw<T, N> b    = to_bits(x * pow2i<T, N>(lift));
+
+    e = ((b >> traits::mantissa_bits) & traits::exponent_max) - (traits::exponent_bias - 1) - lift;
+
+    constexpr int_type keep{~(traits::exponent_max << traits::mantissa_bits)};
+    constexpr int_type half{static_cast<int_type>(traits::exponent_bias - 1) << traits::mantissa_bits};
+    return from_bits<T, N>((b & keep) | half);
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> fabs(vec<T, N> x)
+{
+    constexpr typename math_traits<T>::int_type high{std::numeric_limits<typename math_traits<T>::int_type>::min()};
+    return from_bits<T, N>(to_bits(x) & ~high);
+}
+
+// magnitude of m, sign of s
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> copysign(vec<T, N> m, vec<T, N> s)
+{
+    constexpr typename math_traits<T>::int_type high{std::numeric_limits<typename math_traits<T>::int_type>::min()};
+    return from_bits<T, N>((to_bits(m) & ~high) | (to_bits(s) & high));
+}
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> lane_sqrt(vec<T, N> x)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return simd::sqrt(x);
+    }
+    else
+    {
+        vec<T, N> out;
+        for (int i = 0; i < N; ++i)
+            out[i] = std::sqrt(x[i]);
+        return out;
+    }
+}
+
+// ---- sin / cos -------------------------------------------------------
+// Reduce by pi/4 into octant j with a Cody-Waite constant (four parts in
+// float, three in double, each exact when multiplied by j),
+// evaluate both the sine and the cosine polynomial on the remainder and
+// choose per lane.
+
+template <typename T, int N>
+BALBINO_FORCE_INLINE std::array<vec<T, N>, 2> sincos(vec<T, N> x)
+{
+    using V = vec<T, N>;
+    const V ax{fabs(x)};
+
+    int_raw<T, N> j = to_int(ax * T(1.27323954473516268615)); // 4 / pi
+    j               = (j + 1) & ~1;
+    const V y{to_float<T, N>(j)};
+
+    V s;
+    V c;
+    if constexpr (std::is_same_v<T, float>)
+    {
+        const V z{opaque(opaque(opaque(ax - y * 0.78515625F) - y * 2.4187564849853515625e-4F) - y * 3.7747668102383614e-8F) - y * 1.2816720341285448e-12F};
+        const V zz{z * z};
+        s = fma(horner(zz, -1.9515295891E-4F, 8.3321608736E-3F, -1.6666654611E-1F) * zz, z, z);
+        c = fma(horner(zz, 2.443315711809948E-5F, -1.388731625493765E-3F, 4.166664568298827E-2F) * zz, zz, V::splat(1.0F) - zz * 0.5F);
+    }
+    else
+    {
+        const V z{opaque(opaque(ax - y * 7.85398125648498535156E-1) - y * 3.77489470793079817668E-8) - y * 2.69515142907905952645E-15};
+        const V zz{z * z};
+        s = fma(horner(zz, 1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6, -1.98412698295895385996E-4,
+                       8.33333333332211858878E-3, -1.66666666666666307295E-1)
+                    * zz,
+                z, z);
+        c = fma(horner(zz, -1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7, 2.48015872888517045348E-5,
+                       -1.38888888888730564116E-3, 4.16666666666665929218E-2)
+                    * zz,
+                zz, V::splat(T(1)) - zz * T(0.5));
+    }
+
+    // octants 2 and 6 swap the polynomials; 4..7 negate sin, 2..5 negate cos
+    const auto swap     = (j & 2) != 0;
+    const auto sin_flip = ((j & 4) != 0) != (x.r < T(0));
+    const auto cos_flip = ((j + 2) & 4) != 0;
+
+    const V sin_v{pick(swap, c, s)};
+    const V cos_v{pick(swap, s, c)};
+    return {pick(sin_flip, -sin_v, sin_v), pick(cos_flip, -cos_v, cos_v)};
+}
+
+// ---- asin / acos / atan (float) -----------------------------------------
+
+// asin(r) for |r| <= 0.5, z = r * r
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> asin_kernel(vec<float, N> z, vec<float, N> r)
+{
+    return fma(horner(z, 4.2163199048E-2F, 2.4181311049E-2F, 4.5470025998E-2F, 7.4953002686E-2F, 1.6666752422E-1F) * z, r, r);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> atan(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V a{fabs(x)};
+
+    // tan(3pi/8) and tan(pi/8) split [0, inf) into three reduced ranges
+    const auto big = a.r > 2.414213562373095F;
+    const auto mid = a.r > 0.4142135623730950F;
+
+    V base{pick(mid, V::splat(0.78539816339744830962F), V{})};
+    base = pick(big, V::splat(1.57079632679489661923F), base);
+
+    V t{pick(mid, (a - 1.0F) / (a + 1.0F), a)};
+    t = pick(big, V::splat(-1.0F) / pick(big, a, V::splat(1.0F)), t);
+    const V z{t * t};
+
+    return copysign(base + fma(horner(z, 8.05374449538e-2F, -1.38776856032E-1F, 1.99777106478E-1F, -3.33329491539E-1F) * z, t, t), x);
+}
+
+// ---- exp / log ---------------------------------------------------------
+
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> exp(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V xc{clamp(x, V::splat(-103.972084F), V::splat(88.7228394F))};
+
+    const V n{round(xc * 1.44269504088896341F)};
+    // Cody-Waite ln2 split, the high part has 9 significant bits
+    const V r{opaque(xc - n * 0.693359375F) - n * -2.12194440e-4F};
+    const V p{fma(horner(r, 1.9875691500E-4F, 1.3981999507E-3F, 8.3334519073E-3F, 4.1665795894E-2F, 1.6666665459E-1F, 5.0000001201E-1F), r * r, r + 1.0F)};
+    return pick(x.r > 88.7228394F, V::splat(std::numeric_limits<float>::infinity()), ldexp(p, to_int(n)));
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<double, N> exp(vec<double, N> x)
+{
+    using V = vec<double, N>;
+    const V xc{clamp(x, V::splat(-745.13321910194122), V::splat(709.782712893384))};
+
+    const V n{round(xc * 1.4426950408889634074)};
+    const V r{opaque(xc - n * 6.93145751953125E-1) - n * 1.42860682030941723212E-6};
+
+    // |r| <= ln2 / 2: the degree 13 Taylor remainder is below 2^-60
+    const V p{horner(r, 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+                     1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0)};
+    return pick(x.r > 709.782712893384, V::splat(std::numeric_limits<double>::infinity()), ldexp(p, to_int(n)));
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> exp2(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V xc{clamp(x, V::splat(-150.0F), V::splat(128.0F))};
+
+    const V n{round(xc)};
+    const V f{xc - n}; // [-0.5, 0.5]
+    const V p{fma(horner(f, 1.535336188319500E-4F, 1.339887440266574E-3F, 9.618437357674640E-3F, 5.550332471162809E-2F, 2.402264791363012E-1F,
+                         6.931472028550421E-1F),
+                  f, V::splat(1.0F))};
+    return pick(x.r >= 128.0F, V::splat(std::numeric_limits<float>::infinity()), ldexp(p, to_int(n)));
+}
+
+// IEEE results for the lanes a real-domain log cannot handle
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> log_special(vec<T, N> x, vec<T, N> r)
+{
+    using V = vec<T, N>;
+    r       = pick(x.r == std::numeric_limits<T>::infinity(), x, r);
+    r       = pick(x.r == T(0), V::splat(-std::numeric_limits<T>::infinity()), r);
+    return pick(x.r < T(0), V::splat(std::numeric_limits<T>::quiet_NaN()), r);
+}
+
+// m * 2^e with m in [sqrt(1/2), sqrt(2)); returns log(m) split as x + y
+// (x = m - 1 exactly) so log and log2 can each fold e in without losing bits.
+template <int N>
+BALBINO_FORCE_INLINE std::array<vec<float, N>, 3> log_reduce(vec<float, N> in)
+{
+    using V = vec<float, N>;
+    int_raw<float, N> ei;
+    const V m{frexp(in, ei)};
+
+    const auto small = m.r < 0.707106781186547524F;
+    const V e{pick(small, to_float<float, N>(ei) - 1.0F, to_float<float, N>(ei))};
+    const V x{pick(small, m + m, m) - 1.0F};
+    const V z{x * x};
+
+    const V y{fma(z, V::splat(-0.5F),
+                  horner(x, 7.0376836292E-2F, -1.1514610310E-1F, 1.1676998740E-1F, -1.2420140846E-1F, 1.4249322787E-1F, -1.6668057665E-1F, 2.0000714765E-1F,
+                         -2.4999993993E-1F, 3.3333331174E-1F)
+                      * x * z)};
+    return {x, y, e};
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> log(vec<float, N> in)
+{
+    const auto [x, y, e] = log_reduce(in);
+    // ln2 = 0.693359375 - 2.12194440e-4 (Cody-Waite)
+    return log_special(in, fma(e, vec<float, N>::splat(0.693359375F), x + fma(e, vec<float, N>::splat(-2.12194440e-4F), y)));
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> log2(vec<float, N> in)
+{
+    const auto [x, y, e] = log_reduce(in);
+    constexpr float log2ea{0.44269504088896340736F}; // log2(e) - 1
+    return log_special(in, (((y * log2ea + x * log2ea) + y) + x) + e);
+}
+
+template <int N>
+BALBINO_FORCE_INLINE vec<double, N> log(vec<double, N> in)
+{
+    using V = vec<double, N>;
+    int_raw<double, N> ei;
+    const V m0{frexp(in, ei)};
+
+    const auto small = m0.r < 0.70710678118654752440;
+    const V e{pick(small, to_float<double, N>(ei) - 1.0, to_float<double, N>(ei))};
+    const V m{pick(small, m0 + m0, m0)};
+
+    // log(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| <= 0.1716
+    const V s{(m - 1.0) / (m + 1.0)};
+    const V s2{s * s};
+    const V t{horner(s2, 2.0 / 23.0, 2.0 / 21.0, 2.0 / 19.0, 2.0 / 17.0, 2.0 / 15.0, 2.0 / 13.0, 2.0 / 11.0, 2.0 / 9.0, 2.0 / 7.0, 2.0 / 5.0, 2.0 / 3.0) * s2 * s};
+    // ln2 split as in fdlibm, the high part has 32 significant bits
+    return log_special(in, fma(e, V::splat(6.93147180369123816490E-1), (s + s) + fma(e, V::splat(1.90821492927058770002E-10), t)));
+}
+
+// r = |x|^y, fixed up for the sign and special cases: negative x is only
+// defined for integral y, 0^y is 0, 1 or inf.
+template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> pow_special(vec<T, N> x, vec<T, N> y, vec<T, N> r)
+{
+    using V = vec<T, N>;
+
+    const V yi{round(y)};
+    const auto integral = yi.r == y.r;
+    const auto odd      = (to_int(yi) & 1) != 0;
+    r                   = pick((x.r < T(0)) & odd, -r, r);
+    r                   = pick((x.r < T(0)) & ~integral, V::splat(std::numeric_limits<T>::quiet_NaN()), r);
+
+    const V zero_pow{pick(y.r < T(0), V::splat(std::numeric_limits<T>::infinity()), V{})};
+    r = pick(x.r == T(0), pick(odd, copysign(zero_pow, x), zero_pow), r);
+    return pick(y.r == T(0), V::splat(T(1)), r);
+}
+
+// ---- fast variants (float) ----------------------------------------------
+
+// sin on [-pi/2, 3pi/2] after one fold around pi/2, degree 5 odd minimax
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_sin_folded(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    x       = pick(x.r > 1.57079632679489661923F, V::splat(3.14159265358979323846F) - x, x);
+    const V z{x * x};
+    return x * fma(fma(z, V::splat(0.00763374313F), V::splat(-0.166078574F)), z, V::splat(1.0F));
+}
+
+// x - 2pi * k with k = round(x / 2pi), two-part 2pi, lands in [-pi, pi]
+template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_reduce(vec<float, N> x)
+{
+    const vec<float, N> k{round(x * 0.159154943091895335769F)};
+    return opaque(x - k * 6.28125F) - k * 1.9353071795864769253e-3F;
+}
+} // namespace detail
+
+export template <typename T, int N>
+struct sincos_result
+{
+    vec<T, N> sin;
+    vec<T, N> cos;
+};
+
+// ---- trigonometry ------------------------------------------------------
+
+export template <typename T, int N>
+BALBINO_FORCE_INLINE sincos_result<T, N> sincos(vec<T, N> x)
+{
+    const auto [s, c] = detail::sincos(x);
+    return {s, c};
+}
+
+export template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> sin(vec<T, N> x)
+{
+    return detail::sincos(x)[0];
+}
+
+export template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> cos(vec<T, N> x)
+{
+    return detail::sincos(x)[1];
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> tan(vec<float, N> x)
+{
+    const auto [s, c] = detail::sincos(x);
+    return s / c;
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> asin(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V a{detail::fabs(x)};
+
+    // |x| > 0.5: asin(x) = pi/2 - 2 asin(sqrt((1 - |x|) / 2))
+    const auto big = a.r > 0.5F;
+    const V z{detail::pick(big, (V::splat(1.0F) - a) * 0.5F, a * a)};
+    const V p{detail::asin_kernel(z, detail::pick(big, sqrt(z), a))};
+    return detail::copysign(detail::pick(big, (V::splat(1.57079632679489661923F) - (p + p)) + -4.37113883e-8F, p), x);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> acos(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V a{detail::fabs(x)};
+
+    // |x| > 0.5: acos(x) = 2 asin(sqrt((1 - x) / 2)), mirrored around pi for x < 0
+    const auto big = a.r > 0.5F;
+    const V z{detail::pick(big, (V::splat(1.0F) - a) * 0.5F, x * x)};
+    const V p{detail::asin_kernel(z, detail::pick(big, sqrt(z), x))};
+    // pi and pi/2 carry their float rounding error in a second term
+    const V wide{detail::pick(x.r < 0.0F, (V::splat(3.14159265358979323846F) - (p + p)) + -8.74227766e-8F, p + p)};
+    return detail::pick(big, wide, (V::splat(1.57079632679489661923F) - p) + -4.37113883e-8F);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> atan(vec<float, N> x)
+{
+    return detail::atan(x);
+}
+
+// Angle of (x, y) in [-pi, pi]; atan2(0, 0) is 0.
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> atan2(vec<float, N> y, vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const auto zero_x = x.r == 0.0F;
+
+    V r{detail::atan(y / detail::pick(zero_x, V::splat(1.0F), x))};
+    r = detail::pick(x.r < 0.0F, r + detail::copysign(V::splat(3.14159265358979323846F), y), r);
+
+    const V vertical{detail::pick(y.r == 0.0F, V{}, detail::copysign(V::splat(1.57079632679489661923F), y))};
+    return detail::pick(zero_x, vertical, r);
+}
+
+// ---- exponentials and logarithms ---------------------------------------
+
+export template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> exp(vec<T, N> x)
+{
+    return detail::exp(x);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> exp2(vec<float, N> x)
+{
+    return detail::exp2(x);
+}
+
+export template <typename T, int N>
+BALBINO_FORCE_INLINE vec<T, N> log(vec<T, N> x)
+{
+    return detail::log(x);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> log2(vec<float, N> x)
+{
+    return detail::log2(x);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> pow(vec<float, N> x, vec<float, N> y)
+{
+    return detail::pow_special(x, y, detail::exp2(y * detail::log2(detail::fabs(x))));
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<double, N> pow(vec<double, N> x, vec<double, N> y)
+{
+    return detail::pow_special(x, y, detail::exp(y * detail::log(detail::fabs(x))));
+}
+
+// ---- fast, low precision ------------------------------------------------
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_sin(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V r{detail::fast_reduce(x)};
+    // fold [-pi, -pi/2) up to [pi, 3pi/2) so one fold covers the whole range
+    return detail::fast_sin_folded(detail::pick(r.r < -1.57079632679489661923F, r + 6.28318530717958647692F, r));
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_cos(vec<float, N> x)
+{
+    // cos(x) = sin(x + pi/2) after reduction, r + pi/2 lies in [-pi/2, 3pi/2]
+    return detail::fast_sin_folded(detail::fast_reduce(x) + 1.57079632679489661923F);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_exp2(vec<float, N> x)
+{
+    using V = vec<float, N>;
+    const V xc{clamp(x, V::splat(-126.0F), V::splat(127.999F))};
+    const V n{detail::floor(xc)};
+    const V f{xc - n}; // [0, 1)
+    const V p{fma(detail::horner(f, 0.0782679661F, 0.226307687F, 0.695424347F), f, V::splat(1.0F))};
+    return p * detail::pow2i<float, N>(detail::to_int(n));
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_exp(vec<float, N> x)
+{
+    return fast_exp2(x * 1.44269504088896341F);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_log2(vec<float, N> x)
+{
+    using V                     = vec<float, N>;
+    const detail::int_raw<float, N> b{detail::to_bits(x)};
+    const V e{detail::to_float<float, N>(((b >> 23) & 0xff) - 127)};
+    const V m{detail::from_bits<float, N>((b & 0x007fffff) | 0x3f800000) - 1.0F}; // [0, 1)
+    return fma(detail::horner(m, -0.0821306925F, 0.321188932F, -0.677783981F, 1.43872574F), m, e);
+}
+
+export template <int N>
+BALBINO_FORCE_INLINE vec<float, N> fast_log(vec<float, N> x)
+{
+    return fast_log2(x) * 0.693147180559945309417F;
+}
+} // namespace fawn_algebra::simd
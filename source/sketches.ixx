@@ -0,0 +1,1164 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
+
+export module FawnAlgebra:Sketches;
+import :CPU;
+import :Hashing;
+import :SIMD;
+import std;
+
+// Fixed-memory probabilistic summaries of key streams:
+//
+//   BloomFilter      set membership: no false negatives, a chosen false positive rate
+//   CountMinSketch   per-key counts: never under, over by at most epsilon * total with probability 1 - delta
+//   HyperLogLog      distinct keys: relative standard error 1.04 / sqrt(2^precision)
+//   DDSketch         quantiles of a stream of values: each within a chosen relative accuracy
+//
+// Keys are hashed with Hash64 under the sketch's seed: a std::string_view by its characters, any other
+// trivially copyable key by its bytes. That is the hash HashBatch computes, and the *Batch members use
+// it to hash many keys at once in SIMD lanes; the *Hash members take a hash computed elsewhere.
+//
+// Sketches with the same shape and seed merge, so each thread fills its own and they are combined at
+// the end. Serialize writes a sketch as little-endian bytes that Deserialize reads back on any host;
+// Deserialize rejects bytes that are truncated or not that kind of sketch.
+namespace fawn_algebra
+{
+namespace detail
+{
+// keys hashed by their bytes; pointers and arrays would hash the address or the terminator
+template <typename Key>
+concept sketch_key = std::is_trivially_copyable_v<Key> && !std::is_pointer_v<Key> && !std::is_array_v<Key>;
+
+template <sketch_key Key>
+std::uint64_t SketchHash(const Key& key, const std::uint64_t seed) noexcept
+{
+    return Hash64(&key, sizeof(Key), seed);
+}
+
+// hashes keys with HashBatch a chunk at a time and hands fn(first, hashes) each chunk
+template <sketch_key Key, typename Fn>
+void ForEachHashChunk(const std::span<const Key> keys, const std::uint64_t seed, Fn&& fn) noexcept
+{
+    constexpr std::size_t chunk{256};
+    std::array<std::uint64_t, chunk> hashes;
+    for (std::size_t first = 0; first < keys.size(); first += chunk)
+    {
+        const std::size_t count{std::min(chunk, keys.size() - first)};
+        HashBatch(keys.subspan(first, count), std::span{hashes}.first(count), seed);
+        fn(first, std::span<const std::uint64_t>{hashes.data(), count});
+    }
+}
+
+// Serialised sketches are a 64-bit tag naming the kind, 64-bit header fields and the payload words,
+// all little-endian; sparse payloads use LEB128 varints instead of words.
+class sketch_writer
+{
+  public:
+    explicit sketch_writer(const std::uint64_t tag, const std::size_t payloadBytes)
+    {
+        m_bytes.reserve(64 + payloadBytes);
+        Put(tag);
+    }
+
+    void Put(const std::uint64_t value)
+    {
+        const std::size_t at{m_bytes.size()};
+        m_bytes.resize(at + sizeof(value));
+        WriteLE64(reinterpret_cast<std::uint8_t*>(m_bytes.data() + at), value);
+    }
+
+    template <std::unsigned_integral Word>
+    void PutWords(const std::span<const Word> words)
+    {
+        const std::size_t at{m_bytes.size()};
+        m_bytes.resize(at + words.size_bytes());
+        std::memcpy(m_bytes.data() + at, words.data(), words.size_bytes());
+        if constexpr (std::endian::native == std::endian::big && sizeof(Word) > 1)
+        {
+            for (std::size_t i = 0; i < words.size(); ++i)
+            {
+                const Word word{std::byteswap(words[i])};
+                std::memcpy(m_bytes.data() + at + i * sizeof(Word), &word, sizeof(Word));
+            }
+        }
+    }
+
+    void PutVarint(std::uint64_t value)
+    {
+        for (; value >= 0x80U; value >>= 7U)
+        {
+            m_bytes.push_back(static_cast<std::byte>((value & 0x7FU) | 0x80U));
+        }
+        m_bytes.push_back(static_cast<std::byte>(value));
+    }
+
+    [[nodiscard]] std::vector<std::byte> Take() noexcept
+    {
+        return std::move(m_bytes);
+    }
+
+  private:
+    std::vector<std::byte> m_bytes;
+};
+
+class sketch_reader
+{
+  public:
+    explicit sketch_reader(const std::span<const std::byte> bytes) noexcept
+        : m_bytes{bytes}
+    {
+    }
+
+    [[nodiscard]] bool Get(std::uint64_t& value) noexcept
+    {
+        if (m_bytes.size() < sizeof(value))
+        {
+            return false;
+        }
+        value   = ReadLE64(m_bytes.data());
+        m_bytes = m_bytes.subspan(sizeof(value));
+        return true;
+    }
+
+    template <std::unsigned_integral Word>
+    [[nodiscard]] bool GetWords(const std::span<Word> words) noexcept
+    {
+        if (m_bytes.size() < words.size_bytes())
+        {
+            return false;
+        }
+        std::memcpy(words.data(), m_bytes.data(), words.size_bytes());
+        if constexpr (std::endian::native == std::endian::big && sizeof(Word) > 1)
+        {
+            for (Word& word : words)
+            {
+                word = std::byteswap(word);
+            }
+        }
+        m_bytes = m_bytes.subspan(words.size_bytes());
+        return true;
+    }
+
+    [[nodiscard]] bool GetVarint(std::uint64_t& value) noexcept
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64U && !m_bytes.empty(); shift += 7U)
+        {
+            const auto byte{std::to_integer<std::uint64_t>(m_bytes.front())};
+            m_bytes = m_bytes.subspan(1);
+            value |= (byte & 0x7FU) << shift;
+            if ((byte & 0x80U) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept
+    {
+        return m_bytes.empty();
+    }
+
+  private:
+    std::span<const std::byte> m_bytes;
+};
+
+inline constexpr std::uint64_t bloom_tag{0x314D4F4C424E5746ULL};        // "FWNBLOM1"
+inline constexpr std::uint64_t count_min_tag{0x31534D43424E5746ULL};    // "FWNBCMS1"
+inline constexpr std::uint64_t hyper_log_log_tag{0x314C4C48424E5746ULL}; // "FWNBHLL1"
+inline constexpr std::uint64_t dd_sketch_tag{0x31534444424E5746ULL};     // "FWNBDDS1"
+
+// Split-block Bloom filter: a key sets one bit in each of the eight 32-bit words of one 32-byte
+// block, so an insert or a query touches one cache line and is a handful of u32x8 operations.
+using bloom_block = simd::u32x8;
+
+// the block from the high half of the hash, without a modulo: (h * blocks) / 2^32
+BALBINO_FORCE_INLINE std::size_t BloomBlock(const std::uint64_t hash, const std::size_t blocks) noexcept
+{
+    return static_cast<std::size_t>(((hash >> 32U) * blocks) >> 32U);
+}
+
+// the eight bits from the low half, one per word: the top 5 bits of the half times an odd salt
+BALBINO_FORCE_INLINE simd::raw_u32x8 BloomMask(const std::uint64_t hash) noexcept
+{
+    constexpr simd::raw_u32x8 salt{0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU, 0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U};
+    constexpr simd::raw_u32x8 one{1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U};
+    const simd::raw_u32x8 low{simd::raw_u32x8{} + static_cast<std::uint32_t>(hash)};
+    return one << ((low * salt) >> 27U);
+}
+
+BALBINO_FORCE_INLINE bool BloomTest(const bloom_block& block, const std::uint64_t hash) noexcept
+{
+    const auto missing{std::bit_cast<simd::detail::raw<std::uint64_t, 4>>(BloomMask(hash) & ~block.r)};
+    return ((missing[0] | missing[1]) | (missing[2] | missing[3])) == 0;
+}
+
+using BloomInsertFn = void (*)(bloom_block*, std::size_t, const std::uint64_t*, std::size_t) noexcept;
+using BloomQueryFn  = std::size_t (*)(const bloom_block*, std::size_t, const std::uint64_t*, std::size_t, bool*) noexcept;
+
+// the same loops for every level; under AVX2 the mask's variable shifts are one vpsllvd
+BALBINO_FORCE_INLINE void BloomInsertKernel(bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n) noexcept
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        bloom_block& block{blocks[BloomBlock(hashes[i], count)]};
+        block.r |= BloomMask(hashes[i]);
+    }
+}
+
+BALBINO_FORCE_INLINE std::size_t BloomQueryKernel(const bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n, bool* found) noexcept
+{
+    std::size_t hits{};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        found[i] = BloomTest(blocks[BloomBlock(hashes[i], count)], hashes[i]);
+        hits += found[i] ? 1 : 0;
+    }
+    return hits;
+}
+
+inline void BloomInsertBaseline(bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n) noexcept
+{
+    BloomInsertKernel(blocks, count, hashes, n);
+}
+
+inline std::size_t BloomQueryBaseline(const bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n, bool* found) noexcept
+{
+    return BloomQueryKernel(blocks, count, hashes, n, found);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+BALBINO_TARGET_AVX2 inline void BloomInsertAvx2(bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n) noexcept
+{
+    BloomInsertKernel(blocks, count, hashes, n);
+}
+
+BALBINO_TARGET_AVX2 inline std::size_t BloomQueryAvx2(const bloom_block* blocks, const std::size_t count, const std::uint64_t* hashes, const std::size_t n, bool* found) noexcept
+{
+    return BloomQueryKernel(blocks, count, hashes, n, found);
+}
+#endif
+
+inline BloomInsertFn BloomInsertKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const BloomInsertFn kernel = DispatchTable<BloomInsertFn>{BloomInsertBaseline, nullptr, BloomInsertAvx2, nullptr}.Select(ActiveSimdLevel());
+#else
+    static const BloomInsertFn kernel = BloomInsertBaseline;
+#endif
+    return kernel;
+}
+
+inline BloomQueryFn BloomQueryKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const BloomQueryFn kernel = DispatchTable<BloomQueryFn>{BloomQueryBaseline, nullptr, BloomQueryAvx2, nullptr}.Select(ActiveSimdLevel());
+#else
+    static const BloomQueryFn kernel = BloomQueryBaseline;
+#endif
+    return kernel;
+}
+
+// Ertl's corrections for empty and saturated registers ("New cardinality estimation algorithms for
+// HyperLogLog sketches", 2017), which keep the estimate unbiased from 0 up without bias tables
+inline double HyperLogLogSigma(double x) noexcept
+{
+    if (x == 1.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y{1.0};
+    double z{x};
+    for (double previous = -1.0; z != previous;)
+    {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    }
+    return z;
+}
+
+inline double HyperLogLogTau(double x) noexcept
+{
+    if (x == 0.0 || x == 1.0)
+    {
+        return 0.0;
+    }
+    double y{1.0};
+    double z{1.0 - x};
+    for (double previous = -1.0; z != previous;)
+    {
+        x = std::sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    }
+    return z / 3.0;
+}
+
+// DDSketch buckets of one sign: bucket i counts the magnitudes in (gamma^(i-1), gamma^i]. Counts
+// live in a window around the occupied buckets [min, max], which never spans more than maxBuckets:
+// a bucket beyond that folds the lowest buckets into one, so only the smallest magnitudes lose
+// their accuracy guarantee.
+class dd_store
+{
+  public:
+    void Add(std::int64_t index, const std::uint64_t count, const std::int64_t maxBuckets)
+    {
+        std::uint64_t folded{};
+        if (m_total == 0)
+        {
+            m_min = index;
+            m_max = index;
+        }
+        else if (index < m_min)
+        {
+            index = std::max(index, m_max - maxBuckets + 1);
+            m_min = std::min(m_min, index);
+        }
+        else if (index > m_max)
+        {
+            const std::int64_t lowest{index - maxBuckets + 1};
+            if (lowest > m_min)
+            {
+                for (std::int64_t i = m_min; i <= std::min(lowest - 1, m_max); ++i)
+                {
+                    folded += std::exchange(At(i), 0);
+                }
+                m_min = lowest;
+            }
+            m_max = index;
+        }
+        Cover();
+        At(m_min) += folded;
+        At(index) += count;
+        m_total += count;
+    }
+
+    void Merge(const dd_store& other, const std::int64_t maxBuckets)
+    {
+        for (std::int64_t i = other.m_min; other.m_total != 0 && i <= other.m_max; ++i)
+        {
+            if (const std::uint64_t count{other.Count(i)}; count != 0)
+            {
+                Add(i, count, maxBuckets);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t Count(const std::int64_t index) const noexcept
+    {
+        return index < m_offset || index >= m_offset + static_cast<std::int64_t>(m_counts.size()) ? 0 : m_counts[static_cast<std::size_t>(index - m_offset)];
+    }
+
+    [[nodiscard]] std::uint64_t Total() const noexcept
+    {
+        return m_total;
+    }
+
+    [[nodiscard]] std::int64_t Min() const noexcept
+    {
+        return m_min;
+    }
+
+    [[nodiscard]] std::int64_t Max() const noexcept
+    {
+        return m_max;
+    }
+
+    [[nodiscard]] std::size_t Buckets() const noexcept
+    {
+        return m_total == 0 ? 0 : static_cast<std::size_t>(m_max - m_min + 1);
+    }
+
+    // the lowest occupied index and the counts from there to the highest, as varints
+    void Write(sketch_writer& writer) const
+    {
+        writer.Put(static_cast<std::uint64_t>(m_min));
+        writer.PutVarint(Buckets());
+        for (std::int64_t i = m_min; m_total != 0 && i <= m_max; ++i)
+        {
+            writer.PutVarint(Count(i));
+        }
+    }
+
+    [[nodiscard]] bool Read(sketch_reader& reader, const std::int64_t maxBuckets)
+    {
+        std::uint64_t min{};
+        std::uint64_t buckets{};
+        if (!reader.Get(min) || !reader.GetVarint(buckets) || buckets > static_cast<std::uint64_t>(maxBuckets))
+        {
+            return false;
+        }
+        // indices of finite doubles stay far inside +-2^40 for any accepted accuracy
+        const auto first{static_cast<std::int64_t>(min)};
+        if (buckets != 0 && (first < -(std::int64_t{1} << 40) || first > (std::int64_t{1} << 40)))
+        {
+            return false;
+        }
+        for (std::uint64_t i = 0; i < buckets; ++i)
+        {
+            std::uint64_t count{};
+            if (!reader.GetVarint(count) || ((i == 0 || i + 1 == buckets) && count == 0) || m_total + count < m_total)
+            {
+                return false;
+            }
+            if (count != 0)
+            {
+                Add(first + static_cast<std::int64_t>(i), count, maxBuckets);
+            }
+        }
+        return true;
+    }
+
+  private:
+    static constexpr std::int64_t slack{64};
+
+    std::uint64_t& At(const std::int64_t index) noexcept
+    {
+        return m_counts[static_cast<std::size_t>(index - m_offset)];
+    }
+
+    // grows or slides the window to hold [m_min, m_max] with some room either side, so a stream
+    // drifting up or down moves it once every slack buckets
+    void Cover()
+    {
+        if (m_min >= m_offset && m_max < m_offset + static_cast<std::int64_t>(m_counts.size()))
+        {
+            return;
+        }
+        const std::int64_t offset{m_min - slack};
+        std::vector<std::uint64_t> counts(static_cast<std::size_t>(m_max - m_min + 1 + 2 * slack));
+        for (std::int64_t i = std::max(m_offset, offset); i < m_offset + static_cast<std::int64_t>(m_counts.size()) && i < offset + static_cast<std::int64_t>(counts.size()); ++i)
+        {
+            counts[static_cast<std::size_t>(i - offset)] = m_counts[static_cast<std::size_t>(i - m_offset)];
+        }
+        m_counts = std::move(counts);
+        m_offset = offset;
+    }
+
+    std::vector<std::uint64_t> m_counts;
+    std::int64_t m_offset{};
+    std::int64_t m_min{};
+    std::int64_t m_max{};
+    std::uint64_t m_total{};
+};
+} // namespace detail
+
+export class BloomFilter
+{
+  public:
+    // sized so expectedKeys keys give at most falsePositiveRate, which is clamped to 1e-9 or more
+    BloomFilter(const std::size_t expectedKeys, const double falsePositiveRate, const std::uint64_t seed = 0)
+        : m_blocks(BlocksFor(expectedKeys, falsePositiveRate))
+        , m_seed{seed}
+    {
+    }
+
+    // Expected false positive rate with keys inserted into blocks 32-byte blocks. The keys per block
+    // are Poisson, and with i keys in a block each word has a bit set with 1 - (31/32)^i.
+    [[nodiscard]] static double FalsePositiveRate(const std::size_t keys, const std::size_t blocks) noexcept
+    {
+        const double lambda{static_cast<double>(keys) / static_cast<double>(std::max<std::size_t>(blocks, 1))};
+        const double spread{12.0 * std::sqrt(lambda) + 32.0};
+        double rate{};
+        for (double i = std::max(0.0, std::floor(lambda - spread)); i <= lambda + spread; i += 1.0)
+        {
+            const double poisson{std::exp(i * std::log(std::max(lambda, 1e-300)) - lambda - std::lgamma(i + 1.0))};
+            rate += poisson * std::pow(1.0 - std::pow(31.0 / 32.0, i), 8.0);
+        }
+        return rate;
+    }
+
+    // the fewest blocks that keep expectedKeys keys at or under falsePositiveRate
+    [[nodiscard]] static std::size_t BlocksFor(const std::size_t expectedKeys, const double falsePositiveRate) noexcept
+    {
+        const double target{std::max(falsePositiveRate, 1e-9)};
+        std::size_t high{1};
+        while (FalsePositiveRate(expectedKeys, high) > target && high < (std::size_t{1} << 32U))
+        {
+            high *= 2;
+        }
+        std::size_t low{high / 2 + 1};
+        while (low < high)
+        {
+            const std::size_t middle{low + (high - low) / 2};
+            if (FalsePositiveRate(expectedKeys, middle) > target)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return high;
+    }
+
+    void InsertHash(const std::uint64_t hash) noexcept
+    {
+        detail::BloomInsertKernel(m_blocks.data(), m_blocks.size(), &hash, 1);
+    }
+
+    void Insert(const std::string_view key) noexcept
+    {
+        InsertHash(Hash64(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    void Insert(const Key& key) noexcept
+    {
+        InsertHash(detail::SketchHash(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    void InsertBatch(const std::span<const Key> keys) noexcept
+    {
+        const detail::BloomInsertFn kernel{detail::BloomInsertKernelFor()};
+        detail::ForEachHashChunk(keys, m_seed, [&](std::size_t, const std::span<const std::uint64_t> hashes) {
+            kernel(m_blocks.data(), m_blocks.size(), hashes.data(), hashes.size());
+        });
+    }
+
+    [[nodiscard]] bool ContainsHash(const std::uint64_t hash) const noexcept
+    {
+        return detail::BloomTest(m_blocks[detail::BloomBlock(hash, m_blocks.size())], hash);
+    }
+
+    [[nodiscard]] bool Contains(const std::string_view key) const noexcept
+    {
+        return ContainsHash(Hash64(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    [[nodiscard]] bool Contains(const Key& key) const noexcept
+    {
+        return ContainsHash(detail::SketchHash(key, m_seed));
+    }
+
+    // found[i] = Contains(keys[i]) for the first min(keys.size(), found.size()) keys; how many were found
+    template <detail::sketch_key Key>
+    std::size_t ContainsBatch(const std::span<const Key> keys, const std::span<bool> found) const noexcept
+    {
+        const detail::BloomQueryFn kernel{detail::BloomQueryKernelFor()};
+        std::size_t hits{};
+        detail::ForEachHashChunk(keys.first(std::min(keys.size(), found.size())), m_seed, [&](const std::size_t first, const std::span<const std::uint64_t> hashes) {
+            hits += kernel(m_blocks.data(), m_blocks.size(), hashes.data(), hashes.size(), found.data() + first);
+        });
+        return hits;
+    }
+
+    // union; false, and nothing changes, unless other has the same block count and seed
+    bool Merge(const BloomFilter& other) noexcept
+    {
+        if (other.m_blocks.size() != m_blocks.size() || other.m_seed != m_seed)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        {
+            m_blocks[i].r |= other.m_blocks[i].r;
+        }
+        return true;
+    }
+
+    void Clear() noexcept
+    {
+        std::ranges::fill(m_blocks, detail::bloom_block{});
+    }
+
+    [[nodiscard]] std::size_t Blocks() const noexcept
+    {
+        return m_blocks.size();
+    }
+
+    [[nodiscard]] std::size_t Bytes() const noexcept
+    {
+        return m_blocks.size() * sizeof(detail::bloom_block);
+    }
+
+    [[nodiscard]] std::uint64_t Seed() const noexcept
+    {
+        return m_seed;
+    }
+
+    [[nodiscard]] std::vector<std::byte> Serialize() const
+    {
+        detail::sketch_writer writer{detail::bloom_tag, Bytes()};
+        writer.Put(m_seed);
+        writer.Put(m_blocks.size());
+        writer.PutWords(std::span{reinterpret_cast<const std::uint32_t*>(m_blocks.data()), m_blocks.size() * 8});
+        return writer.Take();
+    }
+
+    [[nodiscard]] static std::optional<BloomFilter> Deserialize(const std::span<const std::byte> bytes)
+    {
+        detail::sketch_reader reader{bytes};
+        std::uint64_t tag{};
+        std::uint64_t seed{};
+        std::uint64_t blocks{};
+        if (!reader.Get(tag) || tag != detail::bloom_tag || !reader.Get(seed) || !reader.Get(blocks) || blocks == 0 || blocks > bytes.size() / sizeof(detail::bloom_block))
+        {
+            return std::nullopt;
+        }
+        BloomFilter filter{static_cast<std::size_t>(blocks), seed};
+        if (!reader.GetWords(std::span{reinterpret_cast<std::uint32_t*>(filter.m_blocks.data()), filter.m_blocks.size() * 8}) || !reader.AtEnd())
+        {
+            return std::nullopt;
+        }
+        return filter;
+    }
+
+  private:
+    BloomFilter(const std::size_t blocks, const std::uint64_t seed)
+        : m_blocks(blocks)
+        , m_seed{seed}
+    {
+    }
+
+    std::vector<detail::bloom_block> m_blocks;
+    std::uint64_t m_seed;
+};
+
+export class CountMinSketch
+{
+  public:
+    // width 2^ceil(log2(e / epsilon)), at most 2^32, and depth ceil(ln(1 / delta)) rows, 1 to 32
+    CountMinSketch(const double epsilon, const double delta, const std::uint64_t seed = 0)
+        : CountMinSketch{std::bit_ceil(static_cast<std::size_t>(std::ceil(std::numbers::e / std::max(epsilon, std::numbers::e / 4294967296.0)))),
+                         static_cast<std::size_t>(std::clamp(std::ceil(std::log(1.0 / std::clamp(delta, 1e-14, 0.5))), 1.0, 32.0)), seed}
+    {
+    }
+
+    // Each row counts a key at (low + row * high) mod width, low and high the halves of its hash,
+    // so one hash serves every row.
+    void AddHash(const std::uint64_t hash, const std::uint64_t count = 1) noexcept
+    {
+        const std::uint32_t low{static_cast<std::uint32_t>(hash)};
+        const std::uint32_t high{static_cast<std::uint32_t>(hash >> 32U) | 1U};
+        const std::size_t mask{m_width - 1};
+        for (std::size_t row = 0; row < m_depth; ++row)
+        {
+            m_counters[row * m_width + ((low + row * high) & mask)] += count;
+        }
+        m_total += count;
+    }
+
+    void Add(const std::string_view key, const std::uint64_t count = 1) noexcept
+    {
+        AddHash(Hash64(key, m_seed), count);
+    }
+
+    template <detail::sketch_key Key>
+    void Add(const Key& key, const std::uint64_t count = 1) noexcept
+    {
+        AddHash(detail::SketchHash(key, m_seed), count);
+    }
+
+    template <detail::sketch_key Key>
+    void AddBatch(const std::span<const Key> keys, const std::uint64_t count = 1) noexcept
+    {
+        detail::ForEachHashChunk(keys, m_seed, [&](std::size_t, const std::span<const std::uint64_t> hashes) {
+            for (const std::uint64_t hash : hashes)
+            {
+                AddHash(hash, count);
+            }
+        });
+    }
+
+    // the smallest of the key's counters: at least its true count
+    [[nodiscard]] std::uint64_t EstimateHash(const std::uint64_t hash) const noexcept
+    {
+        const std::uint32_t low{static_cast<std::uint32_t>(hash)};
+        const std::uint32_t high{static_cast<std::uint32_t>(hash >> 32U) | 1U};
+        const std::size_t mask{m_width - 1};
+        std::uint64_t estimate{std::numeric_limits<std::uint64_t>::max()};
+        for (std::size_t row = 0; row < m_depth; ++row)
+        {
+            estimate = std::min(estimate, m_counters[row * m_width + ((low + row * high) & mask)]);
+        }
+        return estimate;
+    }
+
+    [[nodiscard]] std::uint64_t Estimate(const std::string_view key) const noexcept
+    {
+        return EstimateHash(Hash64(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    [[nodiscard]] std::uint64_t Estimate(const Key& key) const noexcept
+    {
+        return EstimateHash(detail::SketchHash(key, m_seed));
+    }
+
+    // out[i] = Estimate(keys[i]) for the first min(keys.size(), out.size()) keys
+    template <detail::sketch_key Key>
+    void EstimateBatch(const std::span<const Key> keys, const std::span<std::uint64_t> out) const noexcept
+    {
+        detail::ForEachHashChunk(keys.first(std::min(keys.size(), out.size())), m_seed, [&](const std::size_t first, const std::span<const std::uint64_t> hashes) {
+            for (std::size_t i = 0; i < hashes.size(); ++i)
+            {
+                out[first + i] = EstimateHash(hashes[i]);
+            }
+        });
+    }
+
+    // sum; false, and nothing changes, unless other has the same width, depth and seed
+    bool Merge(const CountMinSketch& other) noexcept
+    {
+        if (other.m_width != m_width || other.m_depth != m_depth || other.m_seed != m_seed)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < m_counters.size(); ++i)
+        {
+            m_counters[i] += other.m_counters[i];
+        }
+        m_total += other.m_total;
+        return true;
+    }
+
+    void Clear() noexcept
+    {
+        std::ranges::fill(m_counters, 0);
+        m_total = 0;
+    }
+
+    // sum of all counts added
+    [[nodiscard]] std::uint64_t TotalCount() const noexcept
+    {
+        return m_total;
+    }
+
+    [[nodiscard]] std::size_t Width() const noexcept
+    {
+        return m_width;
+    }
+
+    [[nodiscard]] std::size_t Depth() const noexcept
+    {
+        return m_depth;
+    }
+
+    [[nodiscard]] std::uint64_t Seed() const noexcept
+    {
+        return m_seed;
+    }
+
+    [[nodiscard]] std::vector<std::byte> Serialize() const
+    {
+        detail::sketch_writer writer{detail::count_min_tag, m_counters.size() * sizeof(std::uint64_t)};
+        writer.Put(m_seed);
+        writer.Put(m_width);
+        writer.Put(m_depth);
+        writer.Put(m_total);
+        writer.PutWords(std::span<const std::uint64_t>{m_counters});
+        return writer.Take();
+    }
+
+    [[nodiscard]] static std::optional<CountMinSketch> Deserialize(const std::span<const std::byte> bytes)
+    {
+        detail::sketch_reader reader{bytes};
+        std::uint64_t tag{};
+        std::uint64_t seed{};
+        std::uint64_t width{};
+        std::uint64_t depth{};
+        std::uint64_t total{};
+        if (!reader.Get(tag) || tag != detail::count_min_tag || !reader.Get(seed) || !reader.Get(width) || !reader.Get(depth) || !reader.Get(total) ||
+            !std::has_single_bit(width) || width > (std::uint64_t{1} << 32U) || depth == 0 || depth > 32 || width * depth > bytes.size() / sizeof(std::uint64_t))
+        {
+            return std::nullopt;
+        }
+        CountMinSketch sketch{static_cast<std::size_t>(width), static_cast<std::size_t>(depth), seed};
+        sketch.m_total = total;
+        if (!reader.GetWords(std::span{sketch.m_counters}) || !reader.AtEnd())
+        {
+            return std::nullopt;
+        }
+        return sketch;
+    }
+
+  private:
+    CountMinSketch(const std::size_t width, const std::size_t depth, const std::uint64_t seed)
+        : m_counters(width * depth)
+        , m_width{width}
+        , m_depth{depth}
+        , m_seed{seed}
+    {
+    }
+
+    std::vector<std::uint64_t> m_counters;
+    std::size_t m_width;
+    std::size_t m_depth;
+    std::uint64_t m_seed;
+    std::uint64_t m_total{};
+};
+
+export class HyperLogLog
+{
+  public:
+    // 2^precision one-byte registers, precision clamped to 4 to 18
+    explicit HyperLogLog(const int precision = 14, const std::uint64_t seed = 0)
+        : m_registers(std::size_t{1} << static_cast<unsigned>(std::clamp(precision, 4, 18)))
+        , m_precision{std::clamp(precision, 4, 18)}
+        , m_seed{seed}
+    {
+    }
+
+    // the top precision bits pick a register, which keeps the longest run of leading zeros seen in
+    // the rest, plus one
+    void AddHash(const std::uint64_t hash) noexcept
+    {
+        const auto p{static_cast<unsigned>(m_precision)};
+        const std::size_t index{static_cast<std::size_t>(hash >> (64U - p))};
+        const auto rank{static_cast<std::uint8_t>(std::countl_zero((hash << p) | (std::uint64_t{1} << (p - 1U))) + 1)};
+        m_registers[index] = std::max(m_registers[index], rank);
+    }
+
+    void Add(const std::string_view key) noexcept
+    {
+        AddHash(Hash64(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    void Add(const Key& key) noexcept
+    {
+        AddHash(detail::SketchHash(key, m_seed));
+    }
+
+    template <detail::sketch_key Key>
+    void AddBatch(const std::span<const Key> keys) noexcept
+    {
+        detail::ForEachHashChunk(keys, m_seed, [&](std::size_t, const std::span<const std::uint64_t> hashes) {
+            for (const std::uint64_t hash : hashes)
+            {
+                AddHash(hash);
+            }
+        });
+    }
+
+    // distinct keys added; 0 when empty
+    [[nodiscard]] double Estimate() const noexcept
+    {
+        const int q{64 - m_precision};
+        std::array<std::uint32_t, 66> histogram{};
+        for (const std::uint8_t value : m_registers)
+        {
+            ++histogram[value];
+        }
+        const auto m{static_cast<double>(m_registers.size())};
+        double z{m * detail::HyperLogLogTau(1.0 - histogram[static_cast<std::size_t>(q + 1)] / m)};
+        for (int k = q; k >= 1; --k)
+        {
+            z = 0.5 * (z + histogram[static_cast<std::size_t>(k)]);
+        }
+        z += m * detail::HyperLogLogSigma(histogram[0] / m);
+        return 0.5 / std::numbers::ln2 * m * m / z;
+    }
+
+    // union; false, and nothing changes, unless other has the same precision and seed
+    bool Merge(const HyperLogLog& other) noexcept
+    {
+        if (other.m_precision != m_precision || other.m_seed != m_seed)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < m_registers.size(); ++i)
+        {
+            m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+        }
+        return true;
+    }
+
+    void Clear() noexcept
+    {
+        std::ranges::fill(m_registers, std::uint8_t{});
+    }
+
+    [[nodiscard]] int Precision() const noexcept
+    {
+        return m_precision;
+    }
+
+    [[nodiscard]] std::uint64_t Seed() const noexcept
+    {
+        return m_seed;
+    }
+
+    // 1.04 / sqrt(2^precision)
+    [[nodiscard]] double StandardError() const noexcept
+    {
+        return 1.04 / std::sqrt(static_cast<double>(m_registers.size()));
+    }
+
+    [[nodiscard]] std::vector<std::byte> Serialize() const
+    {
+        detail::sketch_writer writer{detail::hyper_log_log_tag, m_registers.size()};
+        writer.Put(m_seed);
+        writer.Put(static_cast<std::uint64_t>(m_precision));
+        writer.PutWords(std::span<const std::uint8_t>{m_registers});
+        return writer.Take();
+    }
+
+    [[nodiscard]] static std::optional<HyperLogLog> Deserialize(const std::span<const std::byte> bytes)
+    {
+        detail::sketch_reader reader{bytes};
+        std::uint64_t tag{};
+        std::uint64_t seed{};
+        std::uint64_t precision{};
+        if (!reader.Get(tag) || tag != detail::hyper_log_log_tag || !reader.Get(seed) || !reader.Get(precision) || precision < 4 || precision > 18)
+        {
+            return std::nullopt;
+        }
+        HyperLogLog sketch{static_cast<int>(precision), seed};
+        if (!reader.GetWords(std::span{sketch.m_registers}) || !reader.AtEnd() ||
+            std::ranges::any_of(sketch.m_registers, [&](const std::uint8_t value) { return value > 65 - sketch.m_precision; }))
+        {
+            return std::nullopt;
+        }
+        return sketch;
+    }
+
+  private:
+    std::vector<std::uint8_t> m_registers;
+    int m_precision;
+    std::uint64_t m_seed;
+};
+
+// Masson, Rim and Lee, "DDSketch: A fast and fully-mergeable quantile sketch with relative-error
+// guarantees" (2019). Magnitudes are counted in logarithmic buckets (gamma^(i-1), gamma^i] with
+// gamma = (1 + alpha) / (1 - alpha), one store for positive values and one for negative ones, so
+// every quantile comes back within alpha of the true value relative to it: p99 of latencies from a
+// microsecond to a minute at alpha = 1% in under a thousand buckets, whatever the stream length.
+// Merging adds the bucket counts and is exact: merged sketches answer as one that saw both streams.
+export class DDSketch
+{
+  public:
+    // relativeAccuracy clamped to 1e-6 to 0.5, maxBuckets per sign to 16 to 2^20
+    explicit DDSketch(const double relativeAccuracy = 0.01, const std::size_t maxBuckets = 2048)
+        : m_accuracy{std::clamp(relativeAccuracy, 1e-6, 0.5)}
+        , m_maxBuckets{static_cast<std::int64_t>(std::clamp<std::size_t>(maxBuckets, 16, std::size_t{1} << 20U))}
+        , m_gamma{(1.0 + m_accuracy) / (1.0 - m_accuracy)}
+        , m_multiplier{1.0 / std::log(m_gamma)}
+    {
+    }
+
+    // NaN and infinities are ignored; magnitudes below the smallest normal double count as zero
+    void Add(const double value, const std::uint64_t count = 1)
+    {
+        if (!simd::detail::is_finite(value) || count == 0)
+        {
+            return;
+        }
+        if (value >= std::numeric_limits<double>::min())
+        {
+            m_positive.Add(Index(value), count, m_maxBuckets);
+        }
+        else if (value <= -std::numeric_limits<double>::min())
+        {
+            m_negative.Add(Index(-value), count, m_maxBuckets);
+        }
+        else
+        {
+            m_zeros += count;
+        }
+        m_count += count;
+        m_sum += value * static_cast<double>(count);
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void AddBatch(const std::span<const double> values)
+    {
+        for (const double value : values)
+        {
+            Add(value);
+        }
+    }
+
+    // The value of rank p (n - 1), the lower of the two order statistics when that falls between
+    // them, within RelativeAccuracy() of it when its bucket was never folded. p = 0 and p = 1 give
+    // the exact minimum and maximum, an empty sketch 0.
+    [[nodiscard]] double Quantile(const double p) const noexcept
+    {
+        if (m_count == 0)
+        {
+            return 0.0;
+        }
+        const double q{std::clamp(p, 0.0, 1.0)};
+        if (q == 0.0 || q == 1.0)
+        {
+            return q == 0.0 ? m_min : m_max;
+        }
+        const double rank{q * static_cast<double>(m_count - 1)};
+        // buckets in value order: negatives from the largest magnitude down, zeros, positives up
+        double seen{};
+        for (std::int64_t i = m_negative.Max(); m_negative.Total() != 0 && i >= m_negative.Min(); --i)
+        {
+            seen += static_cast<double>(m_negative.Count(i));
+            if (seen > rank)
+            {
+                return std::clamp(-Value(i), m_min, m_max);
+            }
+        }
+        seen += static_cast<double>(m_zeros);
+        if (seen > rank)
+        {
+            return 0.0;
+        }
+        for (std::int64_t i = m_positive.Min(); i < m_positive.Max(); ++i)
+        {
+            seen += static_cast<double>(m_positive.Count(i));
+            if (seen > rank)
+            {
+                return std::clamp(Value(i), m_min, m_max);
+            }
+        }
+        return std::clamp(Value(m_positive.Max()), m_min, m_max);
+    }
+
+    // sum of the counts; false, and nothing changes, unless other has the same accuracy and bucket limit
+    bool Merge(const DDSketch& other)
+    {
+        if (other.m_accuracy != m_accuracy || other.m_maxBuckets != m_maxBuckets)
+        {
+            return false;
+        }
+        m_positive.Merge(other.m_positive, m_maxBuckets);
+        m_negative.Merge(other.m_negative, m_maxBuckets);
+        m_zeros += other.m_zeros;
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+        return true;
+    }
+
+    void Clear() noexcept
+    {
+        *this = DDSketch{m_accuracy, static_cast<std::size_t>(m_maxBuckets)};
+    }
+
+    [[nodiscard]] std::uint64_t Count() const noexcept
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] double Sum() const noexcept
+    {
+        return m_sum;
+    }
+
+    // +infinity when empty
+    [[nodiscard]] double Min() const noexcept
+    {
+        return m_min;
+    }
+
+    // -infinity when empty
+    [[nodiscard]] double Max() const noexcept
+    {
+        return m_max;
+    }
+
+    [[nodiscard]] double RelativeAccuracy() const noexcept
+    {
+        return m_accuracy;
+    }
+
+    [[nodiscard]] std::size_t MaxBuckets() const noexcept
+    {
+        return static_cast<std::size_t>(m_maxBuckets);
+    }
+
+    // occupied bucket range of both signs, what the serialised counts take
+    [[nodiscard]] std::size_t Buckets() const noexcept
+    {
+        return m_positive.Buckets() + m_negative.Buckets();
+    }
+
+    [[nodiscard]] std::vector<std::byte> Serialize() const
+    {
+        detail::sketch_writer writer{detail::dd_sketch_tag, 2 * Buckets()};
+        writer.Put(std::bit_cast<std::uint64_t>(m_accuracy));
+        writer.Put(static_cast<std::uint64_t>(m_maxBuckets));
+        writer.Put(m_count);
+        writer.Put(m_zeros);
+        writer.Put(std::bit_cast<std::uint64_t>(m_sum));
+        writer.Put(std::bit_cast<std::uint64_t>(m_min));
+        writer.Put(std::bit_cast<std::uint64_t>(m_max));
+        m_positive.Write(writer);
+        m_negative.Write(writer);
+        return writer.Take();
+    }
+
+    [[nodiscard]] static std::optional<DDSketch> Deserialize(const std::span<const std::byte> bytes)
+    {
+        detail::sketch_reader reader{bytes};
+        std::uint64_t tag{};
+        std::uint64_t accuracy{};
+        std::uint64_t maxBuckets{};
+        std::uint64_t count{};
+        std::uint64_t zeros{};
+        std::uint64_t sum{};
+        std::uint64_t min{};
+        std::uint64_t max{};
+        if (!reader.Get(tag) || tag != detail::dd_sketch_tag || !reader.Get(accuracy) || !reader.Get(maxBuckets) || !reader.Get(count) || !reader.Get(zeros) ||
+            !reader.Get(sum) || !reader.Get(min) || !reader.Get(max))
+        {
+            return std::nullopt;
+        }
+        DDSketch sketch{std::bit_cast<double>(accuracy), static_cast<std::size_t>(maxBuckets)};
+        if (!(sketch.m_accuracy >= 1e-6) || std::bit_cast<std::uint64_t>(sketch.m_accuracy) != accuracy || static_cast<std::uint64_t>(sketch.m_maxBuckets) != maxBuckets ||
+            !sketch.m_positive.Read(reader, sketch.m_maxBuckets) || !sketch.m_negative.Read(reader, sketch.m_maxBuckets) || !reader.AtEnd())
+        {
+            return std::nullopt;
+        }
+        sketch.m_count = count;
+        sketch.m_zeros = zeros;
+        sketch.m_sum   = std::bit_cast<double>(sum);
+        sketch.m_min   = std::bit_cast<double>(min);
+        sketch.m_max   = std::bit_cast<double>(max);
+        const bool empty{count == 0 && min == std::bit_cast<std::uint64_t>(std::numeric_limits<double>::infinity()) &&
+                         max == std::bit_cast<std::uint64_t>(-std::numeric_limits<double>::infinity())};
+        const bool filled{count != 0 && simd::detail::is_finite(sketch.m_min) && simd::detail::is_finite(sketch.m_max) && sketch.m_min <= sketch.m_max};
+        if (sketch.m_positive.Total() + sketch.m_negative.Total() + zeros != count || !(empty || filled))
+        {
+            return std::nullopt;
+        }
+        return sketch;
+    }
+
+  private:
+    [[nodiscard]] std::int64_t Index(const double magnitude) const noexcept
+    {
+        return static_cast<std::int64_t>(std::ceil(std::log(magnitude) * m_multiplier));
+    }
+
+    // 2 gamma^i / (gamma + 1) is within alpha of every magnitude in (gamma^(i-1), gamma^i]
+    [[nodiscard]] double Value(const std::int64_t index) const noexcept
+    {
+        return 2.0 * std::exp(static_cast<double>(index) / m_multiplier) / (m_gamma + 1.0);
+    }
+
+    double m_accuracy;
+    std::int64_t m_maxBuckets;
+    double m_gamma;
+    double m_multiplier;
+    detail::dd_store m_positive;
+    detail::dd_store m_negative;
+    std::uint64_t m_zeros{};
+    std::uint64_t m_count{};
+    double m_sum{};
+    double m_min{std::numeric_limits<double>::infinity()};
+    double m_max{-std::numeric_limits<double>::infinity()};
+};
+} // namespace fawn_algebra
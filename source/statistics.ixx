@@ -4,9 +4,14 @@
 //
 
 module;
+#include "config/architecture.hpp"
+#include "config/compiler.hpp"
 
 export module FawnAlgebra:Statistics;
 import :Constants;
+import :CPU;
+import :Random;
+import :SIMD;
 import std;
 
 namespace fawn_algebra
@@ -56,7 +61,8 @@ constexpr auto FrequencyTable(Container a) noexcept
  *
  * @tparam Container The type of the container.
  * @tparam T The type of the elements in the container.
- * @param a The container whose first quartile is to be calculated.
+ * @param a The container whose first quartile is to be calculated, sorted ascending; Quantiles
+ *          works on unsorted values.
  * @return The first quartile (Q1).
  */
 export template <typename Container, typename T = Container::value_type>
@@ -71,7 +77,8 @@ constexpr auto QuartilesQ1(const Container& a) noexcept
  *
  * @tparam Container The type of the container.
  * @tparam T The type of the elements in the container.
- * @param a The container whose second quartile (Q2) or median is to be calculated.
+ * @param a The container whose second quartile (Q2) or median is to be calculated, sorted
+ *          ascending; Quantiles works on unsorted values.
  * @return The second quartile (Q2) or median.
  */
 export template <typename Container, typename T = Container::value_type>
@@ -86,7 +93,8 @@ constexpr auto QuartilesQ2(const Container& a) noexcept
  *
  * @tparam Container The type of the container.
  * @tparam T The type of the elements in the container.
- * @param a The container whose third quartile (Q3) is to be calculated.
+ * @param a The container whose third quartile (Q3) is to be calculated, sorted ascending;
+ *          Quantiles works on unsorted values.
  * @return The third quartile (Q3).
  */
 export template <typename Container, typename T = Container::value_type>
@@ -114,7 +122,8 @@ constexpr auto Mean(const Container& a) noexcept -> T
  *
  * @tparam Container The type of the container.
  * @tparam T The type of the elements in the container.
- * @param a The container whose median is to be calculated.
+ * @param a The container whose median is to be calculated, sorted ascending; Quantile works on
+ *          unsorted values.
  * @return The median of the elements.
  */
 export template <typename Container, typename T = Container::value_type>
@@ -213,7 +222,8 @@ constexpr auto Range(const Container& a) noexcept
  *
  * @tparam Container The type of the container.
  * @tparam T The type of the elements in the container.
- * @param a The container whose interquartile range is to be calculated.
+ * @param a The container whose interquartile range is to be calculated, sorted ascending;
+ *          Quantiles works on unsorted values.
  * @return The interquartile range (IQR).
  */
 export template <typename Container, typename T = Container::value_type>
@@ -392,11 +402,1063 @@ constexpr auto ChiSquareTest(const Container& O, const Container& E)
     return static_cast<T>(sum);
 }
 
+/**
+ * @brief Single-pass mean, variance, skewness, kurtosis, min and max of a stream of values.
+ *
+ * Push updates the central moments in O(1) with Welford's recurrence, extended to the third and fourth
+ * moments (Terriberry), so values never need to be stored and no large sums cancel. Merge combines two
+ * accumulators with Chan et al.'s pairwise formulas (Pebay for the higher moments): accumulate each
+ * thread's or chunk's values separately, merge them, and the result matches pushing everything into one.
+ *
+ * @tparam T The floating point type the moments are kept in.
+ */
+export template <std::floating_point T = double>
+class OnlineStats
+{
+  public:
+    constexpr OnlineStats() noexcept = default;
+
+    /**
+     * @brief Adds one value.
+     *
+     * @param value The value to add.
+     */
+    constexpr void Push(const T value) noexcept
+    {
+        const T previous{static_cast<T>(m_count)};
+        ++m_count;
+        const T n{static_cast<T>(m_count)};
+        const T delta{value - m_mean};
+        const T deltaN{delta / n};
+        const T deltaN2{deltaN * deltaN};
+        const T term{delta * deltaN * previous};
+        m_mean += deltaN;
+        m_m4 += term * deltaN2 * (n * n - 3 * n + 3) + 6 * deltaN2 * m_m2 - 4 * deltaN * m_m3;
+        m_m3 += term * deltaN * (n - 2) - 3 * deltaN * m_m2;
+        m_m2 += term;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    /**
+     * @brief Adds every value of a range.
+     *
+     * @param values The values to add.
+     */
+    constexpr void Push(const std::span<const T> values) noexcept
+    {
+        for (const T value : values)
+        {
+            Push(value);
+        }
+    }
+
+    /**
+     * @brief Adds the values another accumulator has seen, as if they were pushed here.
+     *
+     * @param other The accumulator to merge in; it is left unchanged.
+     */
+    constexpr void Merge(const OnlineStats& other) noexcept
+    {
+        if (other.m_count == 0)
+        {
+            return;
+        }
+        if (m_count == 0)
+        {
+            *this = other;
+            return;
+        }
+        const T a{static_cast<T>(m_count)};
+        const T b{static_cast<T>(other.m_count)};
+        const T n{a + b};
+        const T delta{other.m_mean - m_mean};
+        const T delta2{delta * delta};
+        const T m2{m_m2 + other.m_m2 + delta2 * a * b / n};
+        const T m3{m_m3 + other.m_m3 + delta2 * delta * a * b * (a - b) / (n * n) + 3 * delta * (a * other.m_m2 - b * m_m2) / n};
+        m_m4 += other.m_m4 + delta2 * delta2 * a * b * (a * a - a * b + b * b) / (n * n * n) + 6 * delta2 * (a * a * other.m_m2 + b * b * m_m2) / (n * n) +
+                4 * delta * (a * other.m_m3 - b * m_m3) / n;
+        m_m3 = m3;
+        m_m2 = m2;
+        m_mean += delta * b / n;
+        m_count += other.m_count;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    /**
+     * @brief Forgets every value pushed so far.
+     */
+    constexpr void Reset() noexcept
+    {
+        *this = OnlineStats{};
+    }
+
+    /**
+     * @return The number of values pushed.
+     */
+    [[nodiscard]] constexpr std::uint64_t Count() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * @return The mean, 0 when no values were pushed.
+     */
+    [[nodiscard]] constexpr T Mean() const noexcept
+    {
+        return m_mean;
+    }
+
+    /**
+     * @return The population variance, 0 for fewer than two values.
+     */
+    [[nodiscard]] constexpr T VariancePopulation() const noexcept
+    {
+        return m_count < 2 ? T{} : m_m2 / static_cast<T>(m_count);
+    }
+
+    /**
+     * @return The sample (Bessel-corrected) variance, 0 for fewer than two values.
+     */
+    [[nodiscard]] constexpr T VarianceSample() const noexcept
+    {
+        return m_count < 2 ? T{} : m_m2 / static_cast<T>(m_count - 1);
+    }
+
+    /**
+     * @return The population standard deviation.
+     */
+    [[nodiscard]] constexpr T StandardDeviationPopulation() const noexcept
+    {
+        return std::sqrt(VariancePopulation());
+    }
+
+    /**
+     * @return The sample standard deviation.
+     */
+    [[nodiscard]] constexpr T StandardDeviationSample() const noexcept
+    {
+        return std::sqrt(VarianceSample());
+    }
+
+    /**
+     * @return The population skewness m3 / m2^(3/2), 0 when all values are equal.
+     */
+    [[nodiscard]] constexpr T Skewness() const noexcept
+    {
+        return m_m2 <= T{} ? T{} : std::sqrt(static_cast<T>(m_count)) * m_m3 / (m_m2 * std::sqrt(m_m2));
+    }
+
+    /**
+     * @return The population excess kurtosis m4 / m2^2 - 3, 0 when all values are equal.
+     */
+    [[nodiscard]] constexpr T Kurtosis() const noexcept
+    {
+        return m_m2 <= T{} ? T{} : static_cast<T>(m_count) * m_m4 / (m_m2 * m_m2) - 3;
+    }
+
+    /**
+     * @return The smallest value, +infinity when no values were pushed.
+     */
+    [[nodiscard]] constexpr T Min() const noexcept
+    {
+        return m_min;
+    }
+
+    /**
+     * @return The largest value, -infinity when no values were pushed.
+     */
+    [[nodiscard]] constexpr T Max() const noexcept
+    {
+        return m_max;
+    }
+
+    /**
+     * @return Max() - Min(), 0 when no values were pushed.
+     */
+    [[nodiscard]] constexpr T Range() const noexcept
+    {
+        return m_count == 0 ? T{} : m_max - m_min;
+    }
+
+  private:
+    std::uint64_t m_count{};
+    T m_mean{};
+    T m_m2{}; // sums of the 2nd, 3rd and 4th powers of the deviations from the mean
+    T m_m3{};
+    T m_m4{};
+    T m_min{std::numeric_limits<T>::infinity()};
+    T m_max{-std::numeric_limits<T>::infinity()};
+};
+
+/**
+ * @brief Threading for the parallel Sum, Mean, VariancePopulation, VarianceSample and Range overloads.
+ */
+export struct ReductionSettings
+{
+    // 0 uses one thread per hardware thread; inputs below about a quarter million values per
+    // thread use fewer, down to the calling thread alone
+    std::uint32_t threads{};
+};
+
+namespace detail
+{
+// values per block: a multiple of four accumulators of the widest vector
+inline constexpr std::size_t reduce_block{256};
+inline constexpr std::size_t reduce_min_chunk{std::size_t{1} << 18U};
+
+template <typename T>
+concept reducible = std::same_as<T, float> || std::same_as<T, double>;
+
+// f32x4 / f64x2 for the baseline, f32x8 / f64x4 under AVX2: wider vectors than the target has
+// split into scalar code
+template <typename T, int Bytes>
+using reduce_vec = simd::vec<T, Bytes / static_cast<int>(sizeof(T))>;
+
+// Neumaier's compensated sum
+struct compensated_sum
+{
+    double sum{};
+    double carry{};
+
+    constexpr void Add(const double value) noexcept
+    {
+        const double total{sum + value};
+        carry += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+        sum = total;
+    }
+
+    constexpr void Add(const compensated_sum& other) noexcept
+    {
+        Add(other.sum);
+        carry += other.carry;
+    }
+
+    [[nodiscard]] constexpr double Value() const noexcept
+    {
+        return sum + carry;
+    }
+};
+
+// count, mean and sum of squared deviations of a run of values, merged with Chan et al.'s formulas
+struct reduce_moments
+{
+    double count{};
+    double mean{};
+    double m2{};
+
+    constexpr void Merge(const reduce_moments& other) noexcept
+    {
+        if (other.count == 0.0)
+        {
+            return;
+        }
+        const double n{count + other.count};
+        const double delta{other.mean - mean};
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * count * other.count / n;
+        count = n;
+    }
+};
+
+// moments of the values from the sums of their deviations from shift and of the squares
+template <reducible T>
+BALBINO_FORCE_INLINE reduce_moments ShiftedMoments(const T* values, const std::size_t n, const T shift) noexcept
+{
+    T sum{};
+    T squares{};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const T d{values[i] - shift};
+        sum += d;
+        squares += d * d;
+    }
+    const double count{static_cast<double>(n)};
+    return {count, static_cast<double>(shift) + static_cast<double>(sum) / count, std::max(0.0, static_cast<double>(squares) - static_cast<double>(sum) * static_cast<double>(sum) / count)};
+}
+
+// each lane adds at most 32 values per block, so in float the rounding stays at a few ulps of the
+// block's size; the blocks themselves are added in double
+template <int Bytes, reducible T>
+BALBINO_FORCE_INLINE T BlockSum(const T* values) noexcept
+{
+    using V = reduce_vec<T, Bytes>;
+    constexpr std::size_t lanes{V::lanes};
+    V a0{};
+    V a1{};
+    V a2{};
+    V a3{};
+    for (std::size_t i = 0; i < reduce_block; i += 4 * lanes)
+    {
+        a0 += V::load(values + i);
+        a1 += V::load(values + i + lanes);
+        a2 += V::load(values + i + 2 * lanes);
+        a3 += V::load(values + i + 3 * lanes);
+    }
+    return simd::reduce_add((a0 + a1) + (a2 + a3));
+}
+
+// the block shifted by its first value, which keeps the squares from cancelling when the values sit
+// far from zero
+template <int Bytes, reducible T>
+BALBINO_FORCE_INLINE reduce_moments BlockMoments(const T* values) noexcept
+{
+    using V = reduce_vec<T, Bytes>;
+    constexpr std::size_t lanes{V::lanes};
+    const V shift{V::splat(values[0])};
+    V s0{};
+    V s1{};
+    V q0{};
+    V q1{};
+    for (std::size_t i = 0; i < reduce_block; i += 2 * lanes)
+    {
+        const V d0{V::load(values + i) - shift};
+        const V d1{V::load(values + i + lanes) - shift};
+        s0 += d0;
+        s1 += d1;
+        q0 += d0 * d0;
+        q1 += d1 * d1;
+    }
+    const double count{static_cast<double>(reduce_block)};
+    const double sum{static_cast<double>(simd::reduce_add(s0 + s1))};
+    const double squares{static_cast<double>(simd::reduce_add(q0 + q1))};
+    return {count, static_cast<double>(values[0]) + sum / count, std::max(0.0, squares - sum * sum / count)};
+}
+
+template <int Bytes, reducible T>
+BALBINO_FORCE_INLINE compensated_sum SumKernel(const T* values, const std::size_t n) noexcept
+{
+    compensated_sum sum;
+    std::size_t i{};
+    for (; i + reduce_block <= n; i += reduce_block)
+    {
+        sum.Add(static_cast<double>(BlockSum<Bytes>(values + i)));
+    }
+    for (; i < n; ++i)
+    {
+        sum.Add(static_cast<double>(values[i]));
+    }
+    return sum;
+}
+
+template <int Bytes, reducible T>
+BALBINO_FORCE_INLINE reduce_moments MomentsKernel(const T* values, const std::size_t n) noexcept
+{
+    reduce_moments moments;
+    std::size_t i{};
+    for (; i + reduce_block <= n; i += reduce_block)
+    {
+        moments.Merge(BlockMoments<Bytes>(values + i));
+    }
+    if (i < n)
+    {
+        moments.Merge(ShiftedMoments(values + i, n - i, values[i]));
+    }
+    return moments;
+}
+
+template <int Bytes, reducible T>
+BALBINO_FORCE_INLINE std::pair<T, T> RangeKernel(const T* values, const std::size_t n) noexcept
+{
+    using V = reduce_vec<T, Bytes>;
+    constexpr std::size_t lanes{V::lanes};
+    V lo0{V::splat(std::numeric_limits<T>::max())};
+    V lo1{lo0};
+    V hi0{V::splat(std::numeric_limits<T>::lowest())};
+    V hi1{hi0};
+    std::size_t i{};
+    for (; i + 2 * lanes <= n; i += 2 * lanes)
+    {
+        const V v0{V::load(values + i)};
+        const V v1{V::load(values + i + lanes)};
+        lo0 = simd::min(lo0, v0);
+        lo1 = simd::min(lo1, v1);
+        hi0 = simd::max(hi0, v0);
+        hi1 = simd::max(hi1, v1);
+    }
+    T lo{simd::reduce_min(simd::min(lo0, lo1))};
+    T hi{simd::reduce_max(simd::max(hi0, hi1))};
+    for (; i < n; ++i)
+    {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+    return {lo, hi};
+}
+
+template <typename T>
+using ReduceSumFn = compensated_sum (*)(const T*, std::size_t) noexcept;
+template <typename T>
+using ReduceMomentsFn = reduce_moments (*)(const T*, std::size_t) noexcept;
+template <typename T>
+using ReduceRangeFn = std::pair<T, T> (*)(const T*, std::size_t) noexcept;
+
+template <reducible T>
+compensated_sum ReduceSumBaseline(const T* values, const std::size_t n) noexcept
+{
+    return SumKernel<16>(values, n);
+}
+
+template <reducible T>
+reduce_moments ReduceMomentsBaseline(const T* values, const std::size_t n) noexcept
+{
+    return MomentsKernel<16>(values, n);
+}
+
+template <reducible T>
+std::pair<T, T> ReduceRangeBaseline(const T* values, const std::size_t n) noexcept
+{
+    return RangeKernel<16>(values, n);
+}
+
+#if BALBINO_RUNTIME_DISPATCH
+template <reducible T>
+BALBINO_TARGET_AVX2 compensated_sum ReduceSumAvx2(const T* values, const std::size_t n) noexcept
+{
+    return SumKernel<32>(values, n);
+}
+
+template <reducible T>
+BALBINO_TARGET_AVX2 reduce_moments ReduceMomentsAvx2(const T* values, const std::size_t n) noexcept
+{
+    return MomentsKernel<32>(values, n);
+}
+
+template <reducible T>
+BALBINO_TARGET_AVX2 std::pair<T, T> ReduceRangeAvx2(const T* values, const std::size_t n) noexcept
+{
+    return RangeKernel<32>(values, n);
+}
+#endif
+
+template <reducible T>
+ReduceSumFn<T> ReduceSumKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const ReduceSumFn<T> kernel = DispatchTable<ReduceSumFn<T>>{ReduceSumBaseline<T>, nullptr, ReduceSumAvx2<T>, nullptr}.Select(ActiveSimdLevel());
+#else
+    static const ReduceSumFn<T> kernel = ReduceSumBaseline<T>;
+#endif
+    return kernel;
+}
+
+template <reducible T>
+ReduceMomentsFn<T> ReduceMomentsKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const ReduceMomentsFn<T> kernel = DispatchTable<ReduceMomentsFn<T>>{ReduceMomentsBaseline<T>, nullptr, ReduceMomentsAvx2<T>, nullptr}.Select(ActiveSimdLevel());
+#else
+    static const ReduceMomentsFn<T> kernel = ReduceMomentsBaseline<T>;
+#endif
+    return kernel;
+}
+
+template <reducible T>
+ReduceRangeFn<T> ReduceRangeKernelFor() noexcept
+{
+#if BALBINO_RUNTIME_DISPATCH
+    static const ReduceRangeFn<T> kernel = DispatchTable<ReduceRangeFn<T>>{ReduceRangeBaseline<T>, nullptr, ReduceRangeAvx2<T>, nullptr}.Select(ActiveSimdLevel());
+#else
+    static const ReduceRangeFn<T> kernel = ReduceRangeBaseline<T>;
+#endif
+    return kernel;
+}
+
+inline std::size_t ReduceThreads(const std::size_t size, const ReductionSettings& settings) noexcept
+{
+    const std::size_t wanted{settings.threads != 0 ? settings.threads : std::max(1U, std::thread::hardware_concurrency())};
+    return std::clamp<std::size_t>(size / reduce_min_chunk, 1, wanted);
+}
+
+// Splits values into block aligned chunks, one per thread, and runs reduce(index, chunk) on each:
+// the calling thread takes the first chunk. The partials come back in chunk order, so for a given
+// thread count the merged result does not depend on timing, and two calls see the same chunks.
+template <typename T, typename Reduce>
+auto ReduceChunks(const std::span<const T> values, const ReductionSettings& settings, Reduce&& reduce)
+{
+    const std::size_t threads{ReduceThreads(values.size(), settings)};
+    const std::size_t step{(values.size() / threads + reduce_block - 1) / reduce_block * reduce_block};
+    const auto chunk{[&](const std::size_t index) {
+        const std::size_t first{std::min(index * step, values.size())};
+        return reduce(index, values.subspan(first, std::min(step, values.size() - first)));
+    }};
+
+    std::vector<std::invoke_result_t<decltype(chunk)&, std::size_t>> partials(threads);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] { partials[t] = chunk(t); });
+        }
+        partials[0] = chunk(0);
+    }
+    return partials;
+}
+
+template <typename Partial, typename T>
+std::vector<Partial> ReduceChunks(const std::span<const T> values, const ReductionSettings& settings, Partial (*kernel)(const T*, std::size_t) noexcept)
+{
+    return ReduceChunks(values, settings, [kernel](std::size_t, const std::span<const T> chunk) noexcept { return kernel(chunk.data(), chunk.size()); });
+}
+
+template <reducible T>
+reduce_moments ReduceMoments(const std::span<const T> values, const ReductionSettings& settings)
+{
+    reduce_moments moments;
+    for (const reduce_moments& partial : ReduceChunks(values, settings, ReduceMomentsKernelFor<T>()))
+    {
+        moments.Merge(partial);
+    }
+    return moments;
+}
+} // namespace detail
+
+/**
+ * @brief Sums a contiguous array of floats or doubles on several threads.
+ *
+ * Each thread reads its chunk in blocks of 256 values through four vector accumulators (f32x8 or f64x4
+ * under AVX2) and adds the block sums in double with Neumaier's compensation, so the result stays
+ * close to the correctly rounded sum where std::accumulate in float drifts by whole percents on 100M
+ * values.
+ *
+ * @tparam Container A contiguous container of float or double.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose elements are to be summed.
+ * @param settings The number of threads to use.
+ * @return The sum of the elements, 0 for an empty container.
+ */
+export template <std::ranges::contiguous_range Container, typename T = std::ranges::range_value_t<Container>>
+    requires detail::reducible<T>
+auto Sum(const Container& a, const ReductionSettings& settings) -> T
+{
+    detail::compensated_sum sum;
+    for (const detail::compensated_sum& partial : detail::ReduceChunks(std::span<const T>{a}, settings, detail::ReduceSumKernelFor<T>()))
+    {
+        sum.Add(partial);
+    }
+    return static_cast<T>(sum.Value());
+}
+
+/**
+ * @brief Calculates the mean of a contiguous array of floats or doubles on several threads.
+ *
+ * @tparam Container A contiguous container of float or double.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose mean is to be calculated.
+ * @param settings The number of threads to use.
+ * @return The mean of the elements, 0 for an empty container.
+ */
+export template <std::ranges::contiguous_range Container, typename T = std::ranges::range_value_t<Container>>
+    requires detail::reducible<T>
+auto Mean(const Container& a, const ReductionSettings& settings) -> T
+{
+    return std::empty(a) ? T{} : static_cast<T>(static_cast<double>(Sum(a, settings)) / static_cast<double>(std::size(a)));
+}
+
+/**
+ * @brief Calculates the population variance of a contiguous array of floats or doubles on several threads.
+ *
+ * One pass over memory: every block of 256 values yields its count, mean and sum of squared deviations,
+ * and the blocks are merged with Chan et al.'s formulas, as OnlineStats::Merge does.
+ *
+ * @tparam Container A contiguous container of float or double.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose population variance is to be calculated.
+ * @param settings The number of threads to use.
+ * @return The population variance of the elements, 0 for an empty container.
+ */
+export template <std::ranges::contiguous_range Container, typename T = std::ranges::range_value_t<Container>>
+    requires detail::reducible<T>
+auto VariancePopulation(const Container& a, const ReductionSettings& settings) -> T
+{
+    const detail::reduce_moments moments{detail::ReduceMoments(std::span<const T>{a}, settings)};
+    return moments.count == 0.0 ? T{} : static_cast<T>(moments.m2 / moments.count);
+}
+
+/**
+ * @brief Calculates the sample variance of a contiguous array of floats or doubles on several threads.
+ *
+ * @tparam Container A contiguous container of float or double.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose sample variance is to be calculated.
+ * @param settings The number of threads to use.
+ * @return The sample variance of the elements, 0 for fewer than two elements.
+ */
+export template <std::ranges::contiguous_range Container, typename T = std::ranges::range_value_t<Container>>
+    requires detail::reducible<T>
+auto VarianceSample(const Container& a, const ReductionSettings& settings) -> T
+{
+    const detail::reduce_moments moments{detail::ReduceMoments(std::span<const T>{a}, settings)};
+    return moments.count <= 1.0 ? T{} : static_cast<T>(moments.m2 / (moments.count - 1.0));
+}
+
+/**
+ * @brief Calculates the range of a contiguous array of floats or doubles on several threads.
+ *
+ * Minimum and maximum come from the same pass, in two pairs of vector accumulators.
+ *
+ * @tparam Container A contiguous container of float or double.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose range is to be calculated.
+ * @param settings The number of threads to use.
+ * @return The range of the elements, 0 for an empty container.
+ */
+export template <std::ranges::contiguous_range Container, typename T = std::ranges::range_value_t<Container>>
+    requires detail::reducible<T>
+auto Range(const Container& a, const ReductionSettings& settings) -> T
+{
+    if (std::empty(a))
+    {
+        return T{};
+    }
+    T lo{std::numeric_limits<T>::max()};
+    T hi{std::numeric_limits<T>::lowest()};
+    for (const auto& [chunkLo, chunkHi] : detail::ReduceChunks(std::span<const T>{a}, settings, detail::ReduceRangeKernelFor<T>()))
+    {
+        lo = std::min(lo, chunkLo);
+        hi = std::max(hi, chunkHi);
+    }
+    return hi - lo;
+}
+
+namespace detail
+{
+inline constexpr std::size_t select_small{32};
+inline constexpr std::size_t select_sample_from{600};
+
+// Floyd and Rivest's SELECT ("Expected time bounds for selection", 1975) for several ranks at once:
+// each step moves a pivot that should land near the middle wanted rank to it, partitions
+// data[left, right] around it and carries on in the sides that still hold wanted ranks. Past depth
+// steps the range is sorted instead, the way introselect falls back to heapsort, which keeps the
+// worst case at O(n log n).
+template <typename T>
+void SelectRanksIn(T* data, std::size_t left, std::size_t right, const std::size_t* ranks, std::size_t count, int depth) noexcept
+{
+    while (count > 0)
+    {
+        if (right - left < select_small || depth == 0)
+        {
+            std::sort(data + left, data + right + 1);
+            return;
+        }
+        --depth;
+        const std::size_t k{ranks[count / 2]};
+        const std::size_t n{right - left + 1};
+        if (n > select_sample_from)
+        {
+            // selecting k within a sample of about n^(2/3) values around it puts an estimate of the
+            // k-th value at data[k]
+            const double size{static_cast<double>(n)};
+            const double i{static_cast<double>(k - left)};
+            const double z{std::log(size)};
+            const double s{0.5 * std::exp(2.0 * z / 3.0)};
+            const double sd{0.5 * std::sqrt(z * s * (size - s) / size) * (i < size / 2.0 ? -1.0 : 1.0)};
+            const auto sampleLeft{static_cast<std::size_t>(std::max(static_cast<double>(left), static_cast<double>(k) - i * s / size + sd))};
+            const auto sampleRight{static_cast<std::size_t>(std::min(static_cast<double>(right), static_cast<double>(k) + (size - i) * s / size + sd))};
+            SelectRanksIn(data, sampleLeft, sampleRight, &k, 1, depth);
+        }
+        else
+        {
+            const std::size_t middle{left + n / 2};
+            if (data[middle] < data[left])
+            {
+                std::swap(data[middle], data[left]);
+            }
+            if (data[right] < data[middle])
+            {
+                std::swap(data[right], data[middle]);
+                if (data[middle] < data[left])
+                {
+                    std::swap(data[middle], data[left]);
+                }
+            }
+            std::swap(data[middle], data[k]);
+        }
+
+        // the pivot and a value no smaller than it guard both ends, so the scans need no bounds
+        // checks; values equal to the pivot stop both scans, which keeps runs of duplicates balanced
+        const T pivot{data[k]};
+        std::swap(data[left], data[k]);
+        if (pivot < data[right])
+        {
+            std::swap(data[right], data[left]);
+        }
+        std::size_t i{left};
+        std::size_t j{right};
+        while (i < j)
+        {
+            std::swap(data[i], data[j]);
+            ++i;
+            --j;
+            while (data[i] < pivot)
+            {
+                ++i;
+            }
+            while (pivot < data[j])
+            {
+                --j;
+            }
+        }
+        if (!(data[left] < pivot))
+        {
+            std::swap(data[left], data[j]);
+        }
+        else
+        {
+            ++j;
+            std::swap(data[j], data[right]);
+        }
+
+        // data[j] is in place: the ranks below it go left, the ranks above it right; the side with
+        // fewer values recurses so the stack stays logarithmic
+        const std::size_t below{static_cast<std::size_t>(std::lower_bound(ranks, ranks + count, j) - ranks)};
+        const std::size_t above{static_cast<std::size_t>(std::upper_bound(ranks, ranks + count, j) - ranks)};
+        if (j - left < right - j)
+        {
+            if (below > 0)
+            {
+                SelectRanksIn(data, left, j - 1, ranks, below, depth);
+            }
+            left = j + 1;
+            ranks += above;
+            count -= above;
+        }
+        else
+        {
+            if (above < count)
+            {
+                SelectRanksIn(data, j + 1, right, ranks + above, count - above, depth);
+            }
+            right = j - 1;
+            count = below;
+        }
+    }
+}
+
+// R-7 (Hyndman and Fan), NumPy's default: quantile p sits at h = p (n - 1), between the order
+// statistics floor(h) and floor(h) + 1
+struct quantile_position
+{
+    std::size_t rank;
+    double fraction;
+};
+
+constexpr quantile_position QuantilePosition(const double p, const std::size_t size) noexcept
+{
+    const double h{std::clamp(p, 0.0, 1.0) * static_cast<double>(size - 1)};
+    const std::size_t rank{std::min(static_cast<std::size_t>(h), size - 1)};
+    return {rank, h - static_cast<double>(rank)};
+}
+
+// the ranks the probabilities need, ascending and without repeats
+inline std::vector<std::size_t> QuantileRanks(const std::span<const double> probabilities, const std::size_t size)
+{
+    std::vector<std::size_t> ranks;
+    ranks.reserve(2 * probabilities.size());
+    for (const double p : probabilities)
+    {
+        const auto [rank, fraction]{QuantilePosition(p, size)};
+        ranks.push_back(rank);
+        if (fraction > 0.0)
+        {
+            ranks.push_back(rank + 1);
+        }
+    }
+    std::ranges::sort(ranks);
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    return ranks;
+}
+
+template <typename T>
+T QuantileValue(const std::span<const std::size_t> ranks, const std::span<const T> values, const double p, const std::size_t size) noexcept
+{
+    const auto [rank, fraction]{QuantilePosition(p, size)};
+    const std::size_t at{static_cast<std::size_t>(std::lower_bound(ranks.begin(), ranks.end(), rank) - ranks.begin())};
+    if (fraction == 0.0)
+    {
+        return values[at];
+    }
+    if constexpr (std::floating_point<T>)
+    {
+        return values[at] + static_cast<T>(fraction) * (values[at + 1] - values[at]);
+    }
+    else
+    {
+        return static_cast<T>(static_cast<double>(values[at]) + fraction * (static_cast<double>(values[at + 1]) - static_cast<double>(values[at])));
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Partially orders values so each of the given ranks holds the value a full sort would put there.
+ *
+ * std::nth_element for several ranks in one partitioning pass, in expected O(n): every value left of a
+ * selected rank compares no greater, every value right of it no smaller. Pivots come from Floyd and
+ * Rivest's sampling, and a depth limit bounds the worst case at O(n log n) as in introselect.
+ *
+ * @tparam T The type of the elements; compared with operator<, so floating point values must not be NaN.
+ * @param values The values to reorder.
+ * @param ranks The ranks to select, ascending, each below values.size().
+ */
+export template <typename T>
+void SelectRanks(const std::span<T> values, const std::span<const std::size_t> ranks) noexcept
+{
+    if (values.size() > 1 && !ranks.empty())
+    {
+        detail::SelectRanksIn(values.data(), 0, values.size() - 1, ranks.data(), ranks.size(), 2 * static_cast<int>(std::bit_width(values.size())));
+    }
+}
+
+/**
+ * @brief Calculates several quantiles of unsorted values by selection, without sorting them.
+ *
+ * Quantile p interpolates linearly between the order statistics around p (n - 1) (Hyndman and Fan's
+ * type 7, NumPy's default), so p = 0.5 is the usual median and 0 and 1 are the minimum and maximum.
+ * All quantiles come from one SelectRanks call, in expected O(n) where sorting first is O(n log n).
+ *
+ * @tparam T The type of the elements.
+ * @param values The values, reordered in place.
+ * @param probabilities The quantiles to calculate, in [0, 1], in any order.
+ * @param out The quantile for each probability, T{} for empty values; as long as probabilities.
+ */
+export template <typename T>
+void Quantiles(const std::type_identity_t<std::span<T>> values, const std::span<const double> probabilities, const std::span<T> out)
+{
+    if (values.empty())
+    {
+        std::ranges::fill(out, T{});
+        return;
+    }
+    const std::vector<std::size_t> ranks{detail::QuantileRanks(probabilities, values.size())};
+    SelectRanks(values, ranks);
+    std::vector<T> selected(ranks.size());
+    for (std::size_t i = 0; i < ranks.size(); ++i)
+    {
+        selected[i] = values[ranks[i]];
+    }
+    for (std::size_t i = 0; i < probabilities.size() && i < out.size(); ++i)
+    {
+        out[i] = detail::QuantileValue(std::span<const std::size_t>{ranks}, std::span<const T>{selected}, probabilities[i], values.size());
+    }
+}
+
+/**
+ * @brief Calculates several quantiles of large unsorted values on several threads, leaving them untouched.
+ *
+ * A random sample brackets each wanted rank between two sample values. One parallel pass counts the
+ * values below and inside each bracket, a second copies the values inside the brackets, a few
+ * percent of the input, and SelectRanks finishes on that copy. In the rare case a bracket misses its
+ * rank, or the input is too small to split, the values are copied and selected on the calling thread.
+ * Both passes compare every value with every bracket, so this is for a handful of quantiles such as
+ * p50, p90, p99 and p99.9.
+ *
+ * @tparam T The type of the elements.
+ * @param values The values.
+ * @param probabilities The quantiles to calculate, in [0, 1], in any order.
+ * @param out The quantile for each probability, T{} for empty values; as long as probabilities.
+ * @param settings The number of threads to use.
+ */
+export template <typename T>
+void Quantiles(const std::type_identity_t<std::span<const T>> values, const std::span<const double> probabilities, const std::span<T> out, const ReductionSettings& settings)
+{
+    const auto serial{[&] {
+        std::vector<T> copy(values.begin(), values.end());
+        Quantiles<T>(copy, probabilities, out);
+    }};
+    if (detail::ReduceThreads(values.size(), settings) == 1 || probabilities.empty())
+    {
+        serial();
+        return;
+    }
+
+    const std::size_t size{values.size()};
+    const std::vector<std::size_t> ranks{detail::QuantileRanks(probabilities, size)};
+
+    // rank r is about the (r + 0.5) / n quantile of the sample, give or take sqrt(q (1 - q) s)
+    // sample positions; a bound four of those away misses about once in 30000
+    constexpr std::size_t sampleSize{std::size_t{1} << 16U};
+    std::vector<T> sample(sampleSize);
+    Xoshiro256StarStar rng(0x5E1EC7ULL);
+    for (T& value : sample)
+    {
+        value = values[static_cast<std::size_t>(UniformBounded(rng, std::uint64_t{size}))];
+    }
+    std::ranges::sort(sample);
+    constexpr T lowest{std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest()};
+    constexpr T highest{std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max()};
+    std::vector<std::pair<T, T>> brackets;
+    for (const std::size_t rank : ranks)
+    {
+        const double q{(static_cast<double>(rank) + 0.5) / static_cast<double>(size)};
+        const double centre{q * static_cast<double>(sampleSize)};
+        const double spread{4.0 * std::sqrt(q * (1.0 - q) * static_cast<double>(sampleSize)) + 2.0};
+        const double low{std::floor(centre - spread)};
+        const double high{std::ceil(centre + spread)};
+        brackets.emplace_back(low < 0.0 ? lowest : sample[static_cast<std::size_t>(low)], high >= static_cast<double>(sampleSize) ? highest : sample[static_cast<std::size_t>(high)]);
+    }
+    std::ranges::sort(brackets);
+    std::size_t merged{};
+    for (std::size_t b = 1; b < brackets.size(); ++b)
+    {
+        if (brackets[b].first <= brackets[merged].second)
+        {
+            brackets[merged].second = std::max(brackets[merged].second, brackets[b].second);
+        }
+        else
+        {
+            brackets[++merged] = brackets[b];
+        }
+    }
+    brackets.resize(merged + 1);
+
+    std::vector<T> lows(brackets.size());
+    std::vector<T> highs(brackets.size());
+    for (std::size_t b = 0; b < brackets.size(); ++b)
+    {
+        lows[b]  = brackets[b].first;
+        highs[b] = brackets[b].second;
+    }
+
+    // per chunk and bracket, the values at or above its low and the values above its high; one
+    // bracket at a time over cache sized blocks, so the counts stay in registers and the compares
+    // vectorise instead of a histogram increment per value
+    constexpr std::size_t countBlock{4096};
+    const auto counts{detail::ReduceChunks(values, settings, [&](std::size_t, const std::span<const T> chunk) {
+        std::vector<std::size_t> count(2 * lows.size());
+        for (std::size_t first = 0; first < chunk.size(); first += countBlock)
+        {
+            const std::span<const T> block{chunk.subspan(first, std::min(countBlock, chunk.size() - first))};
+            for (std::size_t b = 0; b < lows.size(); ++b)
+            {
+                const T low{lows[b]};
+                const T high{highs[b]};
+                std::size_t atLeast{};
+                std::size_t above{};
+                for (const T value : block)
+                {
+                    atLeast += static_cast<std::size_t>(low <= value);
+                    above += static_cast<std::size_t>(high < value);
+                }
+                count[2 * b] += atLeast;
+                count[2 * b + 1] += above;
+            }
+        }
+        return count;
+    })};
+
+    // bracket b holds the ranks [below[b], below[b] + inside); a wanted rank outside every bracket
+    // means the sample misled us
+    std::vector<std::size_t> below(brackets.size());
+    std::vector<std::size_t> bracketStart(brackets.size() + 1);
+    for (std::size_t b = 0; b < brackets.size(); ++b)
+    {
+        std::size_t atLeast{};
+        std::size_t above{};
+        for (const std::vector<std::size_t>& count : counts)
+        {
+            atLeast += count[2 * b];
+            above += count[2 * b + 1];
+        }
+        below[b]            = size - atLeast;
+        bracketStart[b + 1] = bracketStart[b] + (atLeast - above);
+    }
+    for (const std::size_t rank : ranks)
+    {
+        const std::size_t b{static_cast<std::size_t>(std::ranges::upper_bound(below, rank) - below.begin())};
+        if (b == 0 || rank >= below[b - 1] + (bracketStart[b] - bracketStart[b - 1]))
+        {
+            serial();
+            return;
+        }
+    }
+    std::vector<std::vector<std::size_t>> cursors(counts.size(), std::vector<std::size_t>(brackets.size()));
+    for (std::size_t b = 0; b < brackets.size(); ++b)
+    {
+        std::size_t cursor{bracketStart[b]};
+        for (std::size_t c = 0; c < counts.size(); ++c)
+        {
+            cursors[c][b] = cursor;
+            cursor += counts[c][2 * b] - counts[c][2 * b + 1];
+        }
+    }
+
+    // counting the bounds at or below a value gives 2b + 1 inside bracket b and an even number
+    // between brackets; like the counts, one bracket at a time over small blocks so it vectorises
+    constexpr std::size_t gatherBlock{256};
+    std::vector<T> inside(bracketStart.back());
+    detail::ReduceChunks(values, settings, [&](const std::size_t index, const std::span<const T> chunk) {
+        std::vector<std::size_t>& cursor{cursors[index]};
+        std::array<std::uint32_t, gatherBlock> bucket{};
+        for (std::size_t first = 0; first < chunk.size(); first += gatherBlock)
+        {
+            const std::span<const T> block{chunk.subspan(first, std::min(gatherBlock, chunk.size() - first))};
+            std::ranges::fill(bucket, 0U);
+            for (std::size_t b = 0; b < lows.size(); ++b)
+            {
+                const T low{lows[b]};
+                const T high{highs[b]};
+                for (std::size_t i = 0; i < block.size(); ++i)
+                {
+                    bucket[i] += static_cast<std::uint32_t>(low <= block[i]) + static_cast<std::uint32_t>(high < block[i]);
+                }
+            }
+            for (std::size_t i = 0; i < block.size(); ++i)
+            {
+                if (bucket[i] % 2 == 1)
+                {
+                    inside[cursor[bucket[i] / 2]++] = block[i];
+                }
+            }
+        }
+        return std::size_t{};
+    });
+
+    // select within each bracket, at the ranks shifted past the values below it
+    std::vector<T> selected(ranks.size());
+    std::vector<std::size_t> local;
+    std::size_t r{};
+    for (std::size_t b = 0; b < brackets.size(); ++b)
+    {
+        local.clear();
+        for (; r < ranks.size() && ranks[r] < below[b] + (bracketStart[b + 1] - bracketStart[b]); ++r)
+        {
+            local.push_back(ranks[r] - below[b]);
+        }
+        const std::span<T> segment{std::span{inside}.subspan(bracketStart[b], bracketStart[b + 1] - bracketStart[b])};
+        SelectRanks(segment, std::span<const std::size_t>{local});
+        for (std::size_t i = 0; i < local.size(); ++i)
+        {
+            selected[r - local.size() + i] = segment[local[i]];
+        }
+    }
+    for (std::size_t i = 0; i < probabilities.size() && i < out.size(); ++i)
+    {
+        out[i] = detail::QuantileValue(std::span<const std::size_t>{ranks}, std::span<const T>{selected}, probabilities[i], size);
+    }
+}
+
+/**
+ * @brief Calculates one quantile of unsorted values, see Quantiles.
+ *
+ * @tparam Container The type of the container.
+ * @tparam T The type of the elements in the container.
+ * @param a The container whose quantile is to be calculated.
+ * @param p The quantile, in [0, 1]; 0.5 is the median.
+ * @return The quantile, T{} for an empty container.
+ */
+export template <typename Container, typename T = Container::value_type>
+auto Quantile(Container a, const double p) -> T
+{
+    T result{};
+    Quantiles<T>(std::span<T>{a}, std::span<const double>{&p, 1}, std::span<T>{&result, 1});
+    return result;
+}
+
 // todo : chiSquareTable
 // todo : tDistribution
 // todo : tTable
-// todo : skewness
-// todo : kurtosis
 // todo : correlation
 // todo : regression
 // todo : t test
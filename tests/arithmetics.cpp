@@ -5,6 +5,11 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 
+#include "config/architecture.hpp"
+#if BALBINO_SIMD_SSE
+#    include <immintrin.h>
+#endif
+
 import FawnAlgebra;
 import std;
 using namespace fawn_algebra;
@@ -88,3 +93,202 @@ TEST_CASE("Vec: Vector math operations", "[Vector]")
         REQUIRE_THAT(squareRoot[1], Catch::Matchers::WithinAbs(5.f, 1e5f));
     }
 }
+
+TEST_CASE("DualQuat: Rigid transforms and skinning", "[DualQuaternion]")
+{
+    const quatf rotation{quatf::FromAxisAngle(float3{0.0f, 0.0f, 1.0f}, std::numbers::pi_v<float> * 0.5f)};
+    const float3 translation{1.0f, 2.0f, 3.0f};
+    const dualquatf dq{dualquatf::FromRotationTranslation(rotation, translation)};
+
+    SECTION("Transform")
+    {
+        const float3 p{dq.TransformPoint(float3{1.0f, 0.0f, 0.0f})};
+        REQUIRE_THAT(p.x, Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+        REQUIRE_THAT(p.y, Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+        REQUIRE_THAT(p.z, Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+
+        const float3 t{dq.Translation()};
+        REQUIRE_THAT(t.x, Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+        REQUIRE_THAT(t.y, Catch::Matchers::WithinAbs(2.0f, 1e-5f));
+        REQUIRE_THAT(t.z, Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+    }
+    SECTION("Composition")
+    {
+        const dualquatf other{dualquatf::FromRotationTranslation(quatf::FromAxisAngle(float3{1.0f, 0.0f, 0.0f}, 0.3f), float3{-2.0f, 0.5f, 4.0f})};
+        const float3 p{0.25f, -1.5f, 2.0f};
+        const float3 expected{dq.TransformPoint(other.TransformPoint(p))};
+        const float3 composed{(dq * other).TransformPoint(p)};
+        REQUIRE_THAT(composed.x, Catch::Matchers::WithinAbs(expected.x, 1e-5f));
+        REQUIRE_THAT(composed.y, Catch::Matchers::WithinAbs(expected.y, 1e-5f));
+        REQUIRE_THAT(composed.z, Catch::Matchers::WithinAbs(expected.z, 1e-5f));
+
+        const float3 back{(dq.Inverse() * dq).TransformPoint(p)};
+        REQUIRE_THAT(back.x, Catch::Matchers::WithinAbs(p.x, 1e-5f));
+        REQUIRE_THAT(back.y, Catch::Matchers::WithinAbs(p.y, 1e-5f));
+        REQUIRE_THAT(back.z, Catch::Matchers::WithinAbs(p.z, 1e-5f));
+    }
+    SECTION("Matrix round trip")
+    {
+        const float4x4 m{dq.ToMat4()};
+        const dualquatf fromMatrix{dualquatf::FromMat4(m)};
+        const float3 p{0.5f, 1.0f, -2.0f};
+        const float3 expected{dq.TransformPoint(p)};
+        const float3 result{fromMatrix.TransformPoint(p)};
+        REQUIRE_THAT(result.x, Catch::Matchers::WithinAbs(expected.x, 1e-5f));
+        REQUIRE_THAT(result.y, Catch::Matchers::WithinAbs(expected.y, 1e-5f));
+        REQUIRE_THAT(result.z, Catch::Matchers::WithinAbs(expected.z, 1e-5f));
+        REQUIRE_THAT(m[3][0], Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+        REQUIRE_THAT(m[3][1], Catch::Matchers::WithinAbs(2.0f, 1e-5f));
+        REQUIRE_THAT(m[3][2], Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+    }
+    SECTION("Linear blend skinning matches scalar blend")
+    {
+        const std::array<dualquatf, 3> bones{dq, dualquatf::FromTranslation(float3{0.0f, -1.0f, 0.5f}),
+                                             dualquatf::FromRotation(quatf::FromAxisAngle(float3{0.0f, 1.0f, 0.0f}, -2.5f)) * -1.0f};
+        constexpr std::size_t count{19};
+        std::array<float, count> x{}, y{}, z{}, w0{}, w1{}, w2{}, w3{};
+        std::array<std::uint32_t, count> b0{}, b1{}, b2{}, b3{};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float f{static_cast<float>(i)};
+            x[i]  = f * 0.5f - 3.0f;
+            y[i]  = 1.0f - f * 0.25f;
+            z[i]  = f * 0.125f;
+            b0[i] = static_cast<std::uint32_t>(i % 3);
+            b1[i] = static_cast<std::uint32_t>((i + 1) % 3);
+            b2[i] = static_cast<std::uint32_t>((i + 2) % 3);
+            b3[i] = 0;
+            w0[i] = 0.5f;
+            w1[i] = 0.25f + 0.01f * f;
+            w2[i] = 0.25f - 0.01f * f;
+            w3[i] = 0.0f;
+        }
+        // vertices without influence keep their position, in the SIMD body and in the scalar tail
+        for (const std::size_t i : {std::size_t{3}, std::size_t{17}})
+        {
+            w0[i] = w1[i] = w2[i] = 0.0f;
+        }
+
+        const SkinningStreams streams{x, y, z, {b0, b1, b2, b3}, {w0, w1, w2, w3}};
+        std::array<float, count> outX{}, outY{}, outZ{};
+        SkinDualQuatLinearBlend(bones, streams, outX, outY, outZ);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::array<dualquatf, 4> influences{bones[b0[i]], bones[b1[i]], bones[b2[i]], bones[b3[i]]};
+            const std::array<float, 4> weights{w0[i], w1[i], w2[i], w3[i]};
+            const float3 expected{dualquatf::LinearBlend(influences, weights).TransformPoint(float3{x[i], y[i], z[i]})};
+            CHECK_THAT(outX[i], Catch::Matchers::WithinAbs(expected.x, 1e-4f));
+            CHECK_THAT(outY[i], Catch::Matchers::WithinAbs(expected.y, 1e-4f));
+            CHECK_THAT(outZ[i], Catch::Matchers::WithinAbs(expected.z, 1e-4f));
+        }
+        REQUIRE(outX[3] == x[3]);
+        REQUIRE(outY[3] == y[3]);
+        REQUIRE(outZ[3] == z[3]);
+        REQUIRE(outX[17] == x[17]);
+    }
+}
+
+#if BALBINO_SIMD_SSE
+namespace
+{
+quadf_simd ToSimd(const quatf& q)
+{
+    return quadf_simd{q.a, q.e23, q.e31, q.e12};
+}
+
+dualquatf_simd ToSimd(const dualquatf& dq)
+{
+    return dualquatf_simd{ToSimd(dq.real), ToSimd(dq.dual)};
+}
+
+std::array<float, 4> Lanes(const __m128 v)
+{
+    std::array<float, 4> out{};
+    _mm_storeu_ps(out.data(), v);
+    return out;
+}
+
+void CheckQuat(const quadf_simd& actual, const quatf& expected)
+{
+    const std::array<float, 4> lanes{Lanes(actual.data)};
+    CHECK_THAT(lanes[0], Catch::Matchers::WithinAbs(expected.a, 1e-5f));
+    CHECK_THAT(lanes[1], Catch::Matchers::WithinAbs(expected.e23, 1e-5f));
+    CHECK_THAT(lanes[2], Catch::Matchers::WithinAbs(expected.e31, 1e-5f));
+    CHECK_THAT(lanes[3], Catch::Matchers::WithinAbs(expected.e12, 1e-5f));
+}
+} // namespace
+
+TEST_CASE("QuatSimd: Multiply matches Quat", "[Quaternion]")
+{
+    // every component distinct and non-zero, so a term paired with the wrong lane of q2 shows up
+    const quatf a{0.5f, -1.25f, 2.0f, 0.75f};
+    const quatf b{-0.3f, 0.9f, 1.7f, -2.2f};
+    CheckQuat(quadf_simd::Multiply(ToSimd(a), ToSimd(b)), a * b);
+    CheckQuat(quadf_simd::Multiply(ToSimd(b), ToSimd(a)), b * a);
+
+    const quatf x{quatf::FromAxisAngle(float3{1.0f, 0.0f, 0.0f}, 0.7f)};
+    const quatf z{quatf::FromAxisAngle(float3{0.0f, 0.0f, 1.0f}, -1.1f)};
+    CheckQuat(quadf_simd::Multiply(ToSimd(x), ToSimd(z)), x * z);
+}
+
+TEST_CASE("DualQuatSimd: Matches DualQuat", "[DualQuaternion]")
+{
+    const dualquatf a{dualquatf::FromRotationTranslation(quatf::FromAxisAngle(float3{0.0f, 0.0f, 1.0f}, std::numbers::pi_v<float> * 0.5f), float3{1.0f, 2.0f, 3.0f})};
+    const dualquatf b{dualquatf::FromRotationTranslation(quatf::FromAxisAngle(float3{0.6f, 0.0f, 0.8f}, 0.3f), float3{-2.0f, 0.5f, 4.0f})};
+    const float3 p{0.25f, -1.5f, 2.0f};
+
+    SECTION("Construction")
+    {
+        const dualquatf_simd simd{dualquatf_simd::FromRotationTranslation(ToSimd(b.real), _mm_setr_ps(-2.0f, 0.5f, 4.0f, 0.0f))};
+        CheckQuat(simd.real, b.real);
+        CheckQuat(simd.dual, b.dual);
+    }
+    SECTION("Composition")
+    {
+        const dualquatf expected{a * b};
+        const dualquatf_simd composed{ToSimd(a) * ToSimd(b)};
+        CheckQuat(composed.real, expected.real);
+        CheckQuat(composed.dual, expected.dual);
+    }
+    SECTION("Transform point")
+    {
+        for (const dualquatf& dq : {a, b, a * b})
+        {
+            const float3 expected{dq.TransformPoint(p)};
+            const std::array<float, 4> result{Lanes(ToSimd(dq).TransformPoint(ToSimd(dq), _mm_setr_ps(p.x, p.y, p.z, 0.0f)))};
+            CHECK_THAT(result[0], Catch::Matchers::WithinAbs(expected.x, 1e-5f));
+            CHECK_THAT(result[1], Catch::Matchers::WithinAbs(expected.y, 1e-5f));
+            CHECK_THAT(result[2], Catch::Matchers::WithinAbs(expected.z, 1e-5f));
+        }
+    }
+    SECTION("ToMat4")
+    {
+        const float4x4 expected{(a * b).ToMat4()};
+        const float4x4 result{ToSimd(a * b).ToMat4()};
+        for (std::uint8_t column = 0; column < 4; ++column)
+        {
+            for (std::uint8_t row = 0; row < 4; ++row)
+            {
+                CHECK_THAT(result[column][row], Catch::Matchers::WithinAbs(expected[column][row], 1e-5f));
+            }
+        }
+    }
+    SECTION("Normalize")
+    {
+        const dualquatf scaled{a * 3.0f};
+        const dualquatf_simd normalized{ToSimd(scaled).Normalize()};
+        CheckQuat(normalized.real, scaled.Normalize().real);
+        CheckQuat(normalized.dual, scaled.Normalize().dual);
+
+        // a denormal real part gives the identity, as the scalar path does
+        const dualquatf tiny{a * 1e-20f};
+        REQUIRE(tiny.real.LengthSqr() > 0.0f);
+        REQUIRE(tiny.real.LengthSqr() < std::numeric_limits<float>::min());
+        const dualquatf_simd identity{ToSimd(tiny).Normalize()};
+        CheckQuat(identity.real, tiny.Normalize().real);
+        CheckQuat(identity.dual, quatf{0.0f, 0.0f, 0.0f, 0.0f});
+        CHECK(std::isfinite(Lanes(identity.real.data)[0]));
+    }
+}
+#endif
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2025.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+int Scalar()
+{
+    return 0;
+}
+int Sse42()
+{
+    return 1;
+}
+int Avx2()
+{
+    return 2;
+}
+int Avx512()
+{
+    return 3;
+}
+} // namespace
+
+TEST_CASE("CPU: feature detection", "[CPU]")
+{
+    const CpuFeatures& features{DetectedCpuFeatures()};
+    const SimdLevel detected{DetectedSimdLevel()};
+
+    SECTION("Levels imply their features")
+    {
+        if (detected >= SimdLevel::SSE42)
+        {
+            REQUIRE(features.sse42);
+            REQUIRE(features.popcnt);
+        }
+        if (detected >= SimdLevel::AVX2)
+        {
+            REQUIRE(features.avx2);
+            REQUIRE(features.fma);
+        }
+        if (detected >= SimdLevel::AVX512)
+        {
+            REQUIRE(features.avx512f);
+            REQUIRE(features.avx512bw);
+        }
+    }
+    SECTION("Active level is the detected level capped by FAWN_ALGEBRA_SIMD_LEVEL")
+    {
+        // read only: the level is process wide and the dispatched kernels cache their choice
+        SimdLevel expected{detected};
+        if (const char* env = std::getenv("FAWN_ALGEBRA_SIMD_LEVEL"); env != nullptr)
+        {
+            if (const std::optional<SimdLevel> requested{SimdLevelFromString(env)}; requested.has_value())
+            {
+                expected = std::min(*requested, detected);
+            }
+        }
+        REQUIRE(ActiveSimdLevel() == expected);
+    }
+    SECTION("Names round trip")
+    {
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            REQUIRE(SimdLevelFromString(ToString(level)) == level);
+        }
+        REQUIRE_FALSE(SimdLevelFromString("sse9").has_value());
+        REQUIRE_FALSE(SimdLevelFromString("").has_value());
+        REQUIRE_FALSE(SimdLevelFromString("AVX2").has_value());
+        REQUIRE_FALSE(SimdLevelFromString("avx2 ").has_value());
+    }
+}
+
+TEST_CASE("CPU: dispatch table", "[CPU]")
+{
+    constexpr DispatchTable<int (*)()> table{Scalar, nullptr, Avx2, nullptr};
+    REQUIRE(table.Select(SimdLevel::Scalar)() == 0);
+    REQUIRE(table.Select(SimdLevel::SSE42)() == 0);
+    REQUIRE(table.Select(SimdLevel::AVX2)() == 2);
+    REQUIRE(table.Select(SimdLevel::AVX512)() == 2);
+
+    // every level picks its own entry when there is one, the next one down otherwise
+    constexpr DispatchTable<int (*)()> full{Scalar, Sse42, Avx2, Avx512};
+    constexpr DispatchTable<int (*)()> sparse{Scalar, nullptr, nullptr, Avx512};
+    constexpr std::array levels{SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        REQUIRE(full.Select(levels[i])() == static_cast<int>(i));
+        REQUIRE(sparse.Select(levels[i])() == (levels[i] == SimdLevel::AVX512 ? 3 : 0));
+    }
+    static_assert(full.Select(SimdLevel::AVX2) == &Avx2);
+    static_assert(DispatchTable<int (*)()>{Scalar, nullptr, nullptr, nullptr}.Select(SimdLevel::AVX512) == &Scalar);
+}
@@ -0,0 +1,368 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+struct moments
+{
+    double mean;
+    double variance;
+    double skewness;
+    double kurtosis;
+};
+
+template <typename Range>
+moments Moments(const Range& values)
+{
+    double sum{};
+    for (const auto value : values)
+    {
+        sum += static_cast<double>(value);
+    }
+    const double n{static_cast<double>(std::ranges::size(values))};
+    const double mean{sum / n};
+    double m2{};
+    double m3{};
+    double m4{};
+    for (const auto value : values)
+    {
+        const double d{static_cast<double>(value) - mean};
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+    m2 /= n;
+    m3 /= n;
+    m4 /= n;
+    return {mean, m2, m3 / std::pow(m2, 1.5), m4 / (m2 * m2) - 3.0};
+}
+
+// 64-bit draws counting up from a chosen start, to aim at a particular threshold
+struct counting_engine
+{
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept
+    {
+        const result_type value{next};
+        next += step;
+        return value;
+    }
+
+    result_type next;
+    result_type step;
+};
+} // namespace
+
+TEST_CASE("Distributions: ziggurat normal", "[distributions]")
+{
+    Xoshiro256StarStar rng(7);
+    std::vector<double> values(200000);
+    for (double& value : values)
+    {
+        value = SampleNormal(rng);
+    }
+    const moments m{Moments(values)};
+    REQUIRE(m.mean == Catch::Approx(0.0).margin(0.01));
+    REQUIRE(m.variance == Catch::Approx(1.0).margin(0.015));
+    REQUIRE(m.skewness == Catch::Approx(0.0).margin(0.03));
+    REQUIRE(m.kurtosis == Catch::Approx(0.0).margin(0.06));
+
+    // the tail beyond R = 3.654 is reached, at about its true rate of 2.6e-4
+    const auto tail{std::ranges::count_if(values, [](const double v) { return std::abs(v) > 3.6541528853610088; })};
+    REQUIRE(tail > 20);
+    REQUIRE(tail < 110);
+
+    PCG32 pcg(3);
+    const float shifted{SampleNormal<float>(pcg, 10.0F, 0.0F)};
+    REQUIRE(shifted == 10.0F);
+}
+
+TEST_CASE("Distributions: ziggurat exponential", "[distributions]")
+{
+    PCG32 rng(11);
+    std::vector<double> values(200000);
+    for (double& value : values)
+    {
+        value = SampleExponential(rng, 2.0);
+    }
+    REQUIRE(std::ranges::min(values) >= 0.0);
+    const moments m{Moments(values)};
+    REQUIRE(m.mean == Catch::Approx(0.5).margin(0.005));
+    REQUIRE(m.variance == Catch::Approx(0.25).margin(0.005));
+    REQUIRE(m.skewness == Catch::Approx(2.0).margin(0.1));
+
+    // memoryless tail past R = 7.697 for rate 1, i.e. 3.85 here
+    const auto tail{std::ranges::count_if(values, [](const double v) { return v > 3.8485587350655249; })};
+    REQUIRE(tail > 50);
+    REQUIRE(tail < 130);
+}
+
+TEST_CASE("Distributions: batch normal", "[distributions]")
+{
+    SECTION("Philox matches its own FillNormal")
+    {
+        Philox4x32 a(5, 1);
+        Philox4x32 b(5, 1);
+        std::vector<float> expected(1001);
+        std::vector<float> actual(1001);
+        a.FillNormal(std::span{expected});
+        FillNormal(b, std::span{actual});
+        REQUIRE(expected == actual);
+        REQUIRE(a == b);
+    }
+    SECTION("any engine, float and double")
+    {
+        Xoshiro256StarStar rng(9);
+        std::vector<float> singles(100001);
+        FillNormal(rng, std::span{singles}, 3.0F, 2.0F);
+        const moments m{Moments(singles)};
+        REQUIRE(m.mean == Catch::Approx(3.0).margin(0.02));
+        REQUIRE(m.variance == Catch::Approx(4.0).margin(0.06));
+
+        std::vector<double> doubles(100001);
+        FillNormal(rng, std::span{doubles});
+        const moments d{Moments(doubles)};
+        REQUIRE(d.mean == Catch::Approx(0.0).margin(0.01));
+        REQUIRE(d.variance == Catch::Approx(1.0).margin(0.015));
+        REQUIRE(std::ranges::all_of(doubles, [](const double v) { return std::isfinite(v); }));
+    }
+}
+
+TEST_CASE("Distributions: batch exponential", "[distributions]")
+{
+    Philox4x32 rng(21);
+    std::vector<float> singles(100003);
+    FillExponential(rng, std::span{singles}, 4.0F);
+    REQUIRE(std::ranges::all_of(singles, [](const float v) { return v >= 0.0F && std::isfinite(v); }));
+    const moments m{Moments(singles)};
+    REQUIRE(m.mean == Catch::Approx(0.25).margin(0.003));
+    REQUIRE(m.variance == Catch::Approx(0.0625).margin(0.002));
+
+    PCG32 pcg(2);
+    std::vector<double> doubles(100003);
+    FillExponential(pcg, std::span{doubles});
+    const moments d{Moments(doubles)};
+    REQUIRE(d.mean == Catch::Approx(1.0).margin(0.01));
+    REQUIRE(d.variance == Catch::Approx(1.0).margin(0.03));
+
+    // the SIMD uniforms and log against the scalar form over several stages and a ragged tail
+    Xoshiro256StarStar a(8);
+    Xoshiro256StarStar b(8);
+    std::vector<float> floats(3001);
+    FillExponential(a, std::span{floats}, 2.0F);
+    for (const float value : floats)
+    {
+        const float u{static_cast<float>((UniformBits32(b) >> 8U) + 1U) * 0x1.0p-24F};
+        REQUIRE(value == Catch::Approx(-std::log(u) / 2.0F).epsilon(1e-5).margin(1e-6));
+    }
+    std::vector<double> wides(3001);
+    FillExponential(a, std::span{wides}, 2.0);
+    for (const double value : wides)
+    {
+        const double u{static_cast<double>((UniformBits64(b) >> 11U) + 1U) * 0x1.0p-53};
+        REQUIRE(value == Catch::Approx(-std::log(u) / 2.0).epsilon(1e-12).margin(1e-14));
+    }
+}
+
+TEST_CASE("Distributions: Poisson", "[distributions]")
+{
+    Xoshiro256StarStar rng(13);
+    for (const double lambda : {0.5, 4.0, 12.0, 150.0, 10000.0})
+    {
+        std::vector<std::uint64_t> values(50000);
+        for (std::uint64_t& value : values)
+        {
+            value = SamplePoisson(rng, lambda);
+        }
+        const moments m{Moments(values)};
+        const double error{4.0 * std::sqrt(lambda / 50000.0)};
+        INFO("lambda " << lambda);
+        REQUIRE(m.mean == Catch::Approx(lambda).margin(error));
+        REQUIRE(m.variance == Catch::Approx(lambda).epsilon(0.04));
+    }
+
+    // small lambda: the frequencies themselves
+    std::array<int, 4> counts{};
+    for (int i = 0; i < 100000; ++i)
+    {
+        const std::uint64_t k{SamplePoisson(rng, 1.0)};
+        if (k < counts.size())
+        {
+            ++counts[k];
+        }
+    }
+    REQUIRE(counts[0] / 100000.0 == Catch::Approx(std::exp(-1.0)).margin(0.006));
+    REQUIRE(counts[1] / 100000.0 == Catch::Approx(std::exp(-1.0)).margin(0.006));
+    REQUIRE(counts[2] / 100000.0 == Catch::Approx(std::exp(-1.0) / 2.0).margin(0.005));
+    REQUIRE(counts[3] / 100000.0 == Catch::Approx(std::exp(-1.0) / 6.0).margin(0.003));
+}
+
+TEST_CASE("Distributions: gamma and beta", "[distributions]")
+{
+    Philox4x32 rng(17);
+    for (const double shape : {0.3, 1.0, 2.5, 40.0})
+    {
+        std::vector<double> values(100000);
+        for (double& value : values)
+        {
+            value = SampleGamma(rng, shape, 2.0);
+        }
+        INFO("shape " << shape);
+        REQUIRE(std::ranges::min(values) >= 0.0);
+        const moments m{Moments(values)};
+        REQUIRE(m.mean == Catch::Approx(2.0 * shape).epsilon(0.02));
+        REQUIRE(m.variance == Catch::Approx(4.0 * shape).epsilon(0.06));
+    }
+
+    std::vector<double> values(100000);
+    for (double& value : values)
+    {
+        value = SampleBeta(rng, 2.0, 5.0);
+    }
+    REQUIRE(std::ranges::min(values) >= 0.0);
+    REQUIRE(std::ranges::max(values) <= 1.0);
+    const moments m{Moments(values)};
+    REQUIRE(m.mean == Catch::Approx(2.0 / 7.0).margin(0.003));
+    REQUIRE(m.variance == Catch::Approx(10.0 / (49.0 * 8.0)).margin(0.001));
+}
+
+TEST_CASE("Distributions: alias table", "[distributions]")
+{
+    constexpr std::array weights{1.0, 0.0, 3.0, 6.0, 0.5, 9.5};
+    const AliasTable table{std::span{weights}};
+    REQUIRE(table.Size() == weights.size());
+
+    PCG32 rng(1);
+    constexpr int samples{200000};
+    std::array<int, weights.size()> counts{};
+    for (int i = 0; i < samples; ++i)
+    {
+        ++counts[table.Sample(rng)];
+    }
+    REQUIRE(counts[1] == 0);
+    for (std::size_t i{}; i < weights.size(); ++i)
+    {
+        INFO("outcome " << i);
+        REQUIRE(counts[i] / static_cast<double>(samples) == Catch::Approx(weights[i] / 20.0).margin(0.004));
+    }
+
+    SECTION("batch matches single draws")
+    {
+        Philox4x32 a(4);
+        Philox4x32 b(4);
+        std::vector<std::uint32_t> batch(1500);
+        table.Sample(a, std::span{batch});
+        for (const std::uint32_t outcome : batch)
+        {
+            REQUIRE(outcome == table.Sample(b));
+        }
+
+        Xoshiro256StarStar c(4);
+        Xoshiro256StarStar d(4);
+        table.Sample(c, std::span{batch});
+        for (const std::uint32_t outcome : batch)
+        {
+            REQUIRE(outcome == table.Sample(d));
+        }
+    }
+    SECTION("batch matches single draws on a large table")
+    {
+        // uneven weights with zeros, so both coin outcomes and many aliases occur; the carry into
+        // the column word comes about n / 2^33 of the time, so enough draws to see it, and an
+        // odd count leaves a scalar tail after the SIMD steps
+        Xoshiro256StarStar weights_rng(17);
+        std::vector<double> uneven(100003);
+        for (double& weight : uneven)
+        {
+            const std::uint64_t bits{weights_rng()};
+            weight = (bits & 7U) == 0 ? 0.0 : static_cast<double>(bits >> 40U);
+        }
+        const AliasTable large{std::span{uneven}};
+        Philox4x32 a(6);
+        Philox4x32 b(6);
+        std::vector<std::uint32_t> batch((1U << 20U) + 3U);
+        large.Sample(a, std::span{batch});
+        std::vector<std::uint32_t> singles(batch.size());
+        for (std::uint32_t& outcome : singles)
+        {
+            outcome = large.Sample(b);
+        }
+        REQUIRE(std::ranges::equal(batch, singles));
+        REQUIRE(std::ranges::all_of(batch, [&](const std::uint32_t outcome) { return uneven[outcome] > 0.0; }));
+    }
+    SECTION("batch matches single draws across a threshold")
+    {
+        // weights 1 : 2 give column 0 the threshold 2/3 * 2^64 = 0xAAAAAAAAAAAAA800; these draws
+        // land on column 0 with the coin's high word equal to the threshold's, so only the low
+        // words decide
+        const std::vector<double> pair{1.0, 2.0};
+        const AliasTable near{std::span{pair}};
+        counting_engine a{0x5555555555555000U, 8};
+        counting_engine b{a};
+        std::vector<std::uint32_t> batch(1024);
+        near.Sample(a, std::span{batch});
+        for (const std::uint32_t outcome : batch)
+        {
+            REQUIRE(outcome == near.Sample(b));
+        }
+        REQUIRE(std::ranges::count(batch, 0U) == 128);
+    }
+    SECTION("uniform weights")
+    {
+        const std::vector<double> flat(7, 2.0);
+        const AliasTable uniform{std::span{flat}};
+        std::array<int, 7> hits{};
+        for (int i = 0; i < 70000; ++i)
+        {
+            ++hits[uniform.Sample(rng)];
+        }
+        for (const int hit : hits)
+        {
+            REQUIRE(hit == Catch::Approx(10000).margin(400));
+        }
+    }
+    SECTION("weights without a distribution give an empty table")
+    {
+        REQUIRE(AliasTable{}.Empty());
+        REQUIRE(AliasTable{std::span<const double>{}}.Empty());
+        constexpr double inf{std::numeric_limits<double>::infinity()};
+        const std::vector<std::vector<double>> invalid{
+            {0.0, 0.0, 0.0}, {1.0, -0.5, 2.0}, {1.0, std::numeric_limits<double>::quiet_NaN()}, {1.0, inf}, {1e308, 1e308}};
+        for (const std::vector<double>& rejected : invalid)
+        {
+            const AliasTable empty{std::span{rejected}};
+            REQUIRE(empty.Empty());
+            REQUIRE(empty.Size() == 0);
+        }
+        std::vector<std::uint32_t> none;
+        AliasTable{}.Sample(rng, std::span{none});
+
+        // one nonzero weight is enough
+        const std::array single{0.0, 0.0, 4.0};
+        const AliasTable certain{std::span{single}};
+        REQUIRE_FALSE(certain.Empty());
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(certain.Sample(rng) == 2);
+        }
+    }
+}
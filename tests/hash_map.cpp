@@ -0,0 +1,389 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+// a key whose std::hash would be the identity, with the value counting live copies
+struct tracked
+{
+    static inline int live{};
+
+    int value{};
+
+    explicit tracked(const int v)
+        : value{v}
+    {
+        ++live;
+    }
+
+    tracked(const tracked& other)
+        : value{other.value}
+    {
+        ++live;
+    }
+
+    tracked(tracked&& other) noexcept
+        : value{other.value}
+    {
+        ++live;
+    }
+
+    tracked& operator=(const tracked&) = default;
+    tracked& operator=(tracked&&)      = default;
+
+    ~tracked()
+    {
+        --live;
+    }
+};
+
+// throws from the int constructor for negative values, and from the copy made when copiesLeft
+// reaches 0; with no move constructor, a rehash copies it
+struct fragile
+{
+    static inline int live{};
+    static inline int copiesLeft{-1};
+
+    int value{};
+
+    explicit fragile(const int v)
+        : value{v}
+    {
+        if (v < 0)
+        {
+            throw std::runtime_error{"fragile"};
+        }
+        ++live;
+    }
+
+    fragile(const fragile& other)
+        : value{other.value}
+    {
+        if (copiesLeft == 0)
+        {
+            throw std::runtime_error{"fragile copy"};
+        }
+        copiesLeft -= copiesLeft > 0 ? 1 : 0;
+        ++live;
+    }
+
+    fragile& operator=(const fragile&) = default;
+
+    ~fragile()
+    {
+        --live;
+    }
+};
+} // namespace
+
+TEST_CASE("FlatHashMap: insert, find, erase", "[hash_map]")
+{
+    FlatHashMap<std::uint64_t, int> map;
+    REQUIRE(map.Empty());
+    REQUIRE(map.Capacity() == 0);
+    REQUIRE(map.Find(3) == map.end());
+    REQUIRE(map.Erase(3) == 0);
+
+    REQUIRE(map.Insert({3, 30}).second);
+    REQUIRE_FALSE(map.Insert({3, 31}).second);
+    REQUIRE(map.Find(3)->second == 30);
+    REQUIRE(map.InsertOrAssign(3, 32).first->second == 32);
+    REQUIRE(map.TryEmplace(4, 40).second);
+    map[5] += 50;
+    REQUIRE(map.Size() == 3);
+    REQUIRE(map.Capacity() == 16);
+    REQUIRE(map[5] == 50);
+    REQUIRE(map.Contains(4));
+    REQUIRE(map.Erase(4) == 1);
+    REQUIRE_FALSE(map.Contains(4));
+    REQUIRE(map.Size() == 2);
+
+    SECTION("agrees with std::unordered_map under random churn")
+    {
+        // few distinct keys, so erases and reinserts keep leaving deleted slots behind
+        std::unordered_map<std::uint64_t, int> expected{{3, 32}, {5, 50}};
+        Xoshiro256StarStar rng(17);
+        for (int i = 0; i < 200000; ++i)
+        {
+            const std::uint64_t key{rng() % 3000};
+            switch (rng() % 3)
+            {
+            case 0:
+                REQUIRE(map.InsertOrAssign(key, i).second == expected.insert_or_assign(key, i).second);
+                break;
+            case 1:
+                REQUIRE(map.Erase(key) == expected.erase(key));
+                break;
+            default:
+            {
+                const auto found{map.Find(key)};
+                REQUIRE((found == map.end()) == !expected.contains(key));
+                if (found != map.end())
+                {
+                    REQUIRE(found->second == expected.at(key));
+                }
+            }
+            }
+        }
+        REQUIRE(map.Size() == expected.size());
+        REQUIRE(map.Capacity() <= 4096);
+        std::size_t visited{};
+        for (const auto& [key, value] : map)
+        {
+            REQUIRE(expected.at(key) == value);
+            ++visited;
+        }
+        REQUIRE(visited == expected.size());
+    }
+    SECTION("erase while iterating")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            map[static_cast<std::uint64_t>(i)] = i;
+        }
+        for (auto it = map.begin(); it != map.end();)
+        {
+            it = it->second % 2 == 0 ? map.Erase(it) : std::next(it);
+        }
+        REQUIRE(map.Size() == 50);
+        REQUIRE(std::ranges::all_of(map, [](const auto& element) { return element.second % 2 == 1; }));
+    }
+}
+
+TEST_CASE("FlatHashMap: 7/8 load", "[hash_map]")
+{
+    FlatHashMap<std::uint32_t, std::uint32_t> map;
+    map.Reserve(14336);
+    REQUIRE(map.Capacity() == 16384);
+
+    // sequential integers: std::hash is the identity here
+    for (std::uint32_t i = 0; i < 14336; ++i)
+    {
+        map[i] = ~i;
+    }
+    REQUIRE(map.Capacity() == 16384);
+    REQUIRE(map.LoadFactor() == Catch::Approx(0.875));
+    for (std::uint32_t i = 0; i < 14336; ++i)
+    {
+        REQUIRE(map.Find(i)->second == ~i);
+    }
+    REQUIRE_FALSE(map.Contains(14336));
+
+    // one more grows
+    map[14336] = 0;
+    REQUIRE(map.Capacity() == 32768);
+    REQUIRE(map.Size() == 14337);
+
+    SECTION("churn reuses deleted slots instead of growing")
+    {
+        map.Erase(14336);
+        for (std::uint32_t round = 0; round < 8; ++round)
+        {
+            for (std::uint32_t i = 0; i < 14336; ++i)
+            {
+                map.Erase(i + round * 14336);
+                map[i + (round + 1) * 14336] = i;
+            }
+        }
+        REQUIRE(map.Size() == 14336);
+        REQUIRE(map.Capacity() == 32768);
+    }
+    SECTION("clear keeps the capacity")
+    {
+        map.Clear();
+        REQUIRE(map.Empty());
+        REQUIRE(map.Capacity() == 32768);
+        REQUIRE(map.begin() == map.end());
+        REQUIRE_FALSE(map.Contains(5));
+    }
+}
+
+TEST_CASE("FlatHashMap: keys", "[hash_map]")
+{
+    SECTION("Vec keys through std::hash")
+    {
+        FlatHashMap<int3, int> cells;
+        for (int z = -4; z < 4; ++z)
+        {
+            for (int y = -8; y < 8; ++y)
+            {
+                for (int x = -8; x < 8; ++x)
+                {
+                    cells[int3{x, y, z}] = x * 100 + y * 10 + z;
+                }
+            }
+        }
+        REQUIRE(cells.Size() == 16 * 16 * 8);
+        // no two cells share a hash, which xor-ing the coordinate hashes used to give
+        FlatHashSet<std::size_t> hashes;
+        for (const auto& [cell, value] : cells)
+        {
+            hashes.Insert(std::hash<int3>{}(cell));
+        }
+        REQUIRE(hashes.Size() == cells.Size());
+        REQUIRE(cells.Find(int3{-3, 7, 2})->second == -300 + 70 + 2);
+        REQUIRE_FALSE(cells.Contains(int3{8, 0, 0}));
+        FlatHashSet<float3> points;
+        REQUIRE(points.Insert(float3{1.0F, 2.0F, 3.0F}).second);
+        REQUIRE_FALSE(points.Insert(float3{1.0F, 2.0F, 3.0F}).second);
+        REQUIRE(points.Contains(float3{1.0F, 2.0F, 3.0F}));
+    }
+    SECTION("string keys, string_view lookups")
+    {
+        FlatHashMap<std::string, int, StringHash> names;
+        names["alpha"] = 1;
+        names[std::string(40, 'b')] = 2;
+        REQUIRE(names.Find(std::string_view{"alpha"})->second == 1);
+        REQUIRE(names.Contains("alpha"));
+        REQUIRE(names.Contains(std::string_view{std::string(40, 'b')}));
+        REQUIRE_FALSE(names.Contains(std::string_view{"alph"}));
+        REQUIRE(names.Erase(std::string_view{"alpha"}) == 1);
+        REQUIRE(names.Size() == 1);
+    }
+    SECTION("elements are destroyed exactly once")
+    {
+        {
+            FlatHashMap<int, tracked> map;
+            for (int i = 0; i < 1000; ++i)
+            {
+                map.TryEmplace(i, i);
+            }
+            REQUIRE(tracked::live == 1000);
+            for (int i = 0; i < 1000; i += 3)
+            {
+                map.Erase(i);
+            }
+            REQUIRE(tracked::live == 666);
+            FlatHashMap<int, tracked> copy{map};
+            REQUIRE(tracked::live == 2 * 666);
+            const FlatHashMap<int, tracked> moved{std::move(copy)};
+            REQUIRE(tracked::live == 2 * 666);
+            REQUIRE(moved.Find(998)->second.value == 998);
+            REQUIRE(copy.Empty());
+            map = moved;
+            REQUIRE(tracked::live == 2 * 666);
+            map.Clear();
+            REQUIRE(tracked::live == 666);
+        }
+        REQUIRE(tracked::live == 0);
+    }
+    SECTION("a throwing constructor leaves the table as it was")
+    {
+        {
+            FlatHashMap<int, fragile> map;
+            for (int i = 0; i < 10; ++i)
+            {
+                map.TryEmplace(i, i);
+            }
+            REQUIRE_THROWS(map.TryEmplace(10, -1));
+            REQUIRE(map.Size() == 10);
+            REQUIRE_FALSE(map.Contains(10));
+            REQUIRE(std::ranges::distance(map) == 10);
+            REQUIRE(fragile::live == 10);
+            REQUIRE(map.TryEmplace(10, 10).second);
+
+            // the copy constructor throws part way through
+            fragile::copiesLeft = 5;
+            REQUIRE_THROWS(FlatHashMap<int, fragile>{map});
+            REQUIRE(fragile::live == 11);
+
+            // a rehash throws part way through: the full table keeps every element
+            fragile::copiesLeft = -1;
+            map.Clear();
+            for (int i = 0; map.LoadFactor() < 0.875F; ++i)
+            {
+                map.TryEmplace(i, i);
+            }
+            const std::size_t size{map.Size()};
+            fragile::copiesLeft = 3;
+            REQUIRE_THROWS(map.TryEmplace(1000, 1000));
+            fragile::copiesLeft = -1;
+            REQUIRE(map.Size() == size);
+            REQUIRE(fragile::live == static_cast<int>(size));
+            for (int i = 0; i < static_cast<int>(size); ++i)
+            {
+                REQUIRE(map.Find(i)->second.value == i);
+            }
+            REQUIRE(map.TryEmplace(1000, 1000).second);
+            REQUIRE(map.Size() == size + 1);
+        }
+        REQUIRE(fragile::live == 0);
+    }
+}
+
+TEST_CASE("FlatHashSet", "[hash_map]")
+{
+    FlatHashSet<std::string, StringHash> words;
+    for (const std::string_view word : {"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"})
+    {
+        words.Insert(std::string{word});
+    }
+    REQUIRE(words.Size() == 8);
+    REQUIRE(words.Contains(std::string_view{"fox"}));
+    std::vector<std::string> sorted(words.begin(), words.end());
+    std::ranges::sort(sorted);
+    REQUIRE(sorted == std::vector<std::string>{"brown", "dog", "fox", "jumps", "lazy", "over", "quick", "the"});
+    FlatHashSet<std::string, StringHash> other;
+    other.Swap(words);
+    REQUIRE(words.Empty());
+    REQUIRE(other.Erase(std::string_view{"the"}) == 1);
+    REQUIRE(other.Size() == 7);
+}
+
+TEST_CASE("FlatHashMap: throughput", "[.][benchmark][hash_map]")
+{
+    constexpr std::size_t count{1 << 20};
+    Xoshiro256StarStar rng(3);
+    std::vector<std::uint64_t> keys(count);
+    std::vector<std::uint64_t> misses(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        keys[i]   = rng();
+        misses[i] = rng();
+    }
+
+    const auto measure{[&]<typename Map>(const char* name, Map map) {
+        // fills to 7/8 of a 2^20 slot table
+        const std::size_t filled{count - count / 8};
+        const auto start{std::chrono::steady_clock::now()};
+        for (std::size_t i = 0; i < filled; ++i)
+        {
+            map[keys[i]] = i;
+        }
+        const auto inserted{std::chrono::steady_clock::now()};
+        std::uint64_t sink{};
+        for (std::size_t i = 0; i < filled; ++i)
+        {
+            sink += map.find(keys[i])->second;
+        }
+        const auto hit{std::chrono::steady_clock::now()};
+        for (std::size_t i = 0; i < filled; ++i)
+        {
+            sink += map.find(misses[i]) == map.end() ? 1 : 0;
+        }
+        const auto missed{std::chrono::steady_clock::now()};
+        const auto rate{[&](const auto from, const auto to) {
+            return static_cast<double>(filled) / std::chrono::duration<double>(to - from).count() / 1e6;
+        }};
+        WARN(name << ": insert " << rate(start, inserted) << ", hit " << rate(inserted, hit) << ", miss " << rate(hit, missed) << " Mops/s" << (sink == 0 ? " " : ""));
+    }};
+
+    // find is spelled Find here; a thin adapter keeps one measure loop
+    struct flat : FlatHashMap<std::uint64_t, std::size_t>
+    {
+        auto find(const std::uint64_t key)
+        {
+            return Find(key);
+        }
+    };
+    measure("std::unordered_map", std::unordered_map<std::uint64_t, std::size_t>{});
+    measure("FlatHashMap", flat{});
+}
@@ -84,6 +84,286 @@ TEST_CASE("Hash: hashword2 with array computes correct hashes", "[hash]")
 //     REQUIRE( isOk );
 // }
 
+namespace
+{
+// the input xxHash's own sanity checks hash; the XXH3 references below come from xxHash 0.8
+std::vector<std::byte> SanityBuffer(const std::size_t size)
+{
+    std::vector<std::byte> buffer(size);
+    std::uint64_t generator{2654435761U};
+    for (std::byte& b : buffer)
+    {
+        b = static_cast<std::byte>(generator >> 56U);
+        generator *= 11400714785074694797ULL;
+    }
+    return buffer;
+}
+} // namespace
+
+TEST_CASE("Hash: XXH3 matches the reference", "[hash]")
+{
+    struct reference
+    {
+        std::size_t length;
+        std::uint64_t seed;
+        std::uint64_t hash64;
+        Hash128Value hash128;
+    };
+    constexpr reference references[]{
+        {0, 0, 0x2D06800538D394C2ULL, {0x6001C324468D497FULL, 0x99AA06D3014798D8ULL}},
+        {0, 0x9E3779B185EBCA8DULL, 0xA8A6B918B2F0364AULL, {0xA986DFC5D7605BFEULL, 0x00FEAA732A3CE25EULL}},
+        {1, 0, 0xC44BDFF4074EECDBULL, {0xC44BDFF4074EECDBULL, 0xA6CD5E9392000F6AULL}},
+        {1, 0x9E3779B185EBCA8DULL, 0x032BE332DD766EF8ULL, {0x032BE332DD766EF8ULL, 0x20E49ABCC53B3842ULL}},
+        {3, 0, 0x54247382A8D6B94DULL, {0x54247382A8D6B94DULL, 0x20EFC49FF02422EAULL}},
+        {3, 0x9E3779B185EBCA8DULL, 0x634B8990B4976373ULL, {0x634B8990B4976373ULL, 0x1C7ECF6A308CF00EULL}},
+        {4, 0, 0xE5DC74BC51848A51ULL, {0x2E7D8D6876A39FE9ULL, 0x970D585AC632BF8EULL}},
+        {4, 0x9E3779B185EBCA8DULL, 0xAA2E7ECCB0C8F747ULL, {0xBFAF51F1E67E0B0FULL, 0x3D53E5DFD837D927ULL}},
+        {8, 0, 0x24CCC9ACAA9F65E4ULL, {0x64C69CAB4BB21DC5ULL, 0x47A7F080D82BB456ULL}},
+        {8, 0x9E3779B185EBCA8DULL, 0x8F973410999B8F6BULL, {0x7B29471DC729B5FFULL, 0xF50CEC145BCD5C5AULL}},
+        {9, 0, 0x14D5001C15DD3F2BULL, {0xED7CCBC501EB7501ULL, 0x564EF6078950D457ULL}},
+        {9, 0x9E3779B185EBCA8DULL, 0xB3AE7333D9013F60ULL, {0xAEF5DFC0AC9F9044ULL, 0x6B380B43FFA61042ULL}},
+        {16, 0, 0x981B17D36C7498C9ULL, {0x562980258A998629ULL, 0xC68C368ECF8A9C05ULL}},
+        {16, 0x9E3779B185EBCA8DULL, 0x663F29333B4DB6B1ULL, {0x0346D13A7A5498C7ULL, 0x6FFCB80CD33085C8ULL}},
+        {17, 0, 0x796F5ACD3A60F862ULL, {0xABBC12D11973D7DBULL, 0x955FA78643ED3669ULL}},
+        {17, 0x9E3779B185EBCA8DULL, 0xF3EC5067F4306DB3ULL, {0x980A14119985A7DFULL, 0xD77681219E464828ULL}},
+        {64, 0, 0x9CB48487720EC49DULL, {0xEFDB6A44690721A9ULL, 0x6D90E81A9B0FD622ULL}},
+        {64, 0x9E3779B185EBCA8DULL, 0x4FE8895DB9B8C077ULL, {0x9405BA2AFFA95CEBULL, 0x37B738968D40BDA5ULL}},
+        {65, 0, 0xFD81AAC4BEBC3883ULL, {0xFE2F650FA500EC6EULL, 0x6C074D65E54DB85AULL}},
+        {65, 0x9E3779B185EBCA8DULL, 0xAD80AEEC1FC9E0A7ULL, {0x9D60C345E5C297CDULL, 0x72503A6FA8D07ADBULL}},
+        {128, 0, 0xFCFF24126754D861ULL, {0xEBB15E34A7FB5AB1ULL, 0x39992220E045260AULL}},
+        {128, 0x9E3779B185EBCA8DULL, 0x73FDE75280646649ULL, {0x8394F5C51F1D8246ULL, 0xA0F7CCB68EE02ADDULL}},
+        {129, 0, 0x98F1B0A679A2CA29ULL, {0x86C9E3BC8F0A3B5CULL, 0x03815FC91F1B30B6ULL}},
+        {129, 0x9E3779B185EBCA8DULL, 0x21FFFDBCA099C844ULL, {0xD4AAE26FCEC7DC03ULL, 0xAD559266067C0BF3ULL}},
+        {240, 0, 0x81C3C2B67F568CCFULL, {0x5C9AAE94C8EBE5A0ULL, 0xAA4202DAA2769DC8ULL}},
+        {240, 0x9E3779B185EBCA8DULL, 0xCC0F58C27EF3D8EEULL, {0x604E98DB085C1864ULL, 0x29D2133D6EA58C5BULL}},
+        {241, 0, 0xC5A639ECD2030E5EULL, {0xC5A639ECD2030E5EULL, 0x99A80ECF0ECFC647ULL}},
+        {241, 0x9E3779B185EBCA8DULL, 0xDDA9B0A161D4829AULL, {0xDDA9B0A161D4829AULL, 0xEC64AFAE6A137582ULL}},
+        {1024, 0, 0xDD85C9B5C1109C5CULL, {0xDD85C9B5C1109C5CULL, 0x0D30D24071C64C57ULL}},
+        {1024, 0x9E3779B185EBCA8DULL, 0xEF368A8A2EBABAEFULL, {0xEF368A8A2EBABAEFULL, 0x17600EFE2B493A18ULL}},
+        {1025, 0, 0xD870C0FA13211C6AULL, {0xD870C0FA13211C6AULL, 0xFD3EE4FE7F2954C6ULL}},
+        {1025, 0x9E3779B185EBCA8DULL, 0x96792BCF9AF88519ULL, {0x96792BCF9AF88519ULL, 0x2C383949F57BF7E1ULL}},
+        {2048, 0, 0xDD59E2C3A5F038E0ULL, {0xDD59E2C3A5F038E0ULL, 0xF736557FD47073A5ULL}},
+        {2048, 0x9E3779B185EBCA8DULL, 0x66F81670669ABABCULL, {0x66F81670669ABABCULL, 0x23CC3A2E75EBAAEAULL}},
+        {2367, 0, 0xCB37AEB9E5D361EDULL, {0xCB37AEB9E5D361EDULL, 0xE89C0F6FF369B427ULL}},
+        {2367, 0x9E3779B185EBCA8DULL, 0xD2DB3415B942B42AULL, {0xD2DB3415B942B42AULL, 0xCCB7A94CCA1A6496ULL}},
+        {100000, 0, 0x34D658192A014311ULL, {0x34D658192A014311ULL, 0x351330331BC078FBULL}},
+        {100000, 0x9E3779B185EBCA8DULL, 0x0682260A8A5AFE82ULL, {0x0682260A8A5AFE82ULL, 0x5A7AE76762E52B20ULL}},
+    };
+    const std::vector<std::byte> buffer{SanityBuffer(100000)};
+    for (const reference& r : references)
+    {
+        CAPTURE(r.length, r.seed);
+        const std::span<const std::byte> data{buffer.data(), r.length};
+        REQUIRE(Hash64(data, r.seed) == r.hash64);
+        REQUIRE(Hash128(data, r.seed) == r.hash128);
+        REQUIRE(Hash64(buffer.data(), r.length, r.seed) == r.hash64);
+    }
+}
+
+TEST_CASE("Hash: XXH3 in constant expressions", "[hash]")
+{
+    static_assert(Hash64("") == 0x2D06800538D394C2ULL);
+    static_assert(Hash64("hello world") == 0xD447B1EA40E6988BULL);
+    static_assert(Hash128("hello world") == Hash128Value{0xA99B8775CC15B6C7ULL, 0xDF8D09E93F874900ULL});
+
+    // long inputs take the scalar accumulator path at compile time and the SIMD one at runtime
+    constexpr std::string_view text{"The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. "
+                                    "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. "
+                                    "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog."};
+    static_assert(text.size() > 240);
+    constexpr std::uint64_t compiled{Hash64(text, 7)};
+    constexpr Hash128Value compiled128{Hash128(text, 7)};
+    std::string_view runtime{text};
+    REQUIRE(Hash64(runtime, 7) == compiled);
+    REQUIRE(Hash128(runtime, 7) == compiled128);
+    REQUIRE(Hash64(std::as_bytes(std::span{runtime}), 7) == compiled);
+}
+
+TEST_CASE("Hash: Hasher matches one-shot hashing", "[hash]")
+{
+    const std::vector<std::byte> buffer{SanityBuffer(20000)};
+    const std::span<const std::byte> all{buffer};
+
+    SECTION("any chunking")
+    {
+        constexpr std::size_t lengths[]{0, 1, 17, 240, 241, 256, 257, 320, 1023, 1024, 1025, 4096, 4097, 20000};
+        constexpr std::size_t chunks[]{1, 7, 63, 64, 65, 255, 256, 257, 1000, 20000};
+        for (const std::size_t length : lengths)
+        {
+            for (const std::size_t chunk : chunks)
+            {
+                CAPTURE(length, chunk);
+                Hasher hasher{0x9E3779B185EBCA8DULL};
+                for (std::size_t offset = 0; offset < length; offset += chunk)
+                {
+                    hasher.Update(all.subspan(offset, std::min(chunk, length - offset)));
+                }
+                REQUIRE(hasher.Length() == length);
+                REQUIRE(hasher.Finalize() == Hash64(all.first(length), 0x9E3779B185EBCA8DULL));
+                REQUIRE(hasher.Finalize128() == Hash128(all.first(length), 0x9E3779B185EBCA8DULL));
+            }
+        }
+    }
+    SECTION("uneven pieces")
+    {
+        Hasher hasher;
+        std::size_t offset{};
+        for (std::size_t piece = 1; offset + piece <= all.size(); piece = piece * 3 % 997 + 1)
+        {
+            hasher.Update(buffer.data() + offset, piece);
+            offset += piece;
+            REQUIRE(hasher.Finalize() == Hash64(all.first(offset)));
+        }
+    }
+    SECTION("finalizing and reset")
+    {
+        Hasher hasher{5};
+        hasher.Update(all.first(300));
+        REQUIRE(hasher.Finalize() == Hash64(all.first(300), 5));
+        hasher.Update(all.subspan(300, 700));
+        REQUIRE(hasher.Finalize() == Hash64(all.first(1000), 5));
+        hasher.Reset();
+        hasher.Update(all.first(10));
+        REQUIRE(hasher.Finalize() == Hash64(all.first(10)));
+    }
+
+    constexpr auto streamed{[](const std::string_view text) {
+        Hasher hasher{7};
+        for (std::size_t offset = 0; offset < text.size(); offset += 50)
+        {
+            hasher.Update(text.substr(offset, 50));
+        }
+        return hasher.Finalize();
+    }};
+    constexpr std::string_view text{"The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. "
+                                    "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. "
+                                    "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog."};
+    static_assert(streamed(text) == Hash64(text, 7));
+    static_assert(streamed("hello world") == Hash64(std::string_view{"hello world"}, 7));
+}
+
+TEST_CASE("Hash: HashBatch matches Hash64", "[hash]")
+{
+    const std::vector<std::byte> buffer{SanityBuffer(1 << 16)};
+    const auto check{[&]<typename Key>(std::type_identity<Key>) {
+        for (const std::uint64_t seed : {std::uint64_t{0}, std::uint64_t{0x9E3779B185EBCA8DULL}})
+        {
+            // 37: whole groups for every lane count and a leftover
+            std::vector<Key> keys(37);
+            std::memcpy(keys.data(), buffer.data(), keys.size() * sizeof(Key));
+            std::vector<std::uint64_t> out(keys.size());
+            HashBatch(std::span<const Key>{keys}, std::span{out}, seed);
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                CAPTURE(sizeof(Key), seed, i);
+                REQUIRE(out[i] == Hash64(&keys[i], sizeof(Key), seed));
+            }
+        }
+    }};
+    check(std::type_identity<std::uint8_t>{});
+    check(std::type_identity<std::array<std::uint8_t, 3>>{});
+    check(std::type_identity<std::uint32_t>{});
+    check(std::type_identity<std::array<std::uint8_t, 7>>{});
+    check(std::type_identity<std::uint64_t>{});
+    check(std::type_identity<int3>{});
+    check(std::type_identity<std::array<char, 16>>{});
+    check(std::type_identity<std::array<std::uint64_t, 3>>{});
+    check(std::type_identity<std::array<std::uint64_t, 8>>{});
+    check(std::type_identity<std::array<std::uint8_t, 100>>{});
+    check(std::type_identity<std::array<std::uint8_t, 128>>{});
+    check(std::type_identity<std::array<std::uint8_t, 200>>{});
+    check(std::type_identity<std::array<std::uint8_t, 300>>{});
+
+    // out shorter than keys: only its keys are hashed
+    const std::uint64_t keys[]{1, 2, 3};
+    std::uint64_t out[2]{};
+    HashBatch(std::span<const std::uint64_t>{keys}, std::span<std::uint64_t>{out});
+    REQUIRE(out[1] == Hash64(&keys[1], sizeof(std::uint64_t)));
+
+    // mutable spans and containers deduce the key type too
+    std::vector<int3> points{{1, 2, 3}, {4, 5, 6}};
+    std::array<std::uint64_t, 2> hashes{};
+    HashBatch(points, hashes);
+    REQUIRE(hashes[1] == Hash64(&points[1], sizeof(int3)));
+    hashes = {};
+    HashBatch(std::span{points}, hashes);
+    REQUIRE(hashes[0] == Hash64(&points[0], sizeof(int3)));
+    hashes = {};
+    HashBatch(keys, hashes, 7);
+    REQUIRE(hashes[0] == Hash64(&keys[0], sizeof(std::uint64_t), 7));
+}
+
+TEST_CASE("Hash: throughput", "[.][benchmark][hash]")
+{
+    const std::vector<std::byte> buffer{SanityBuffer(1 << 20)};
+
+    const auto measure{[&](const char* name, const std::size_t length, auto&& hash) {
+        std::uint64_t sink{};
+        std::size_t bytes{};
+        const auto start{std::chrono::steady_clock::now()};
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds{500})
+        {
+            for (std::size_t offset = 0; offset + length <= buffer.size(); offset += length)
+            {
+                sink += hash(buffer.data() + offset, length);
+            }
+            bytes += buffer.size() / length * length;
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        WARN(name << ", " << length << " byte keys (" << ToString(ActiveSimdLevel()) << "): " << static_cast<double>(bytes) / elapsed.count() / 1e9 << " GB/s"
+                  << (sink == 0 ? " " : ""));
+    }};
+
+    for (const std::size_t length : {std::size_t{16}, std::size_t{64}, std::size_t{1024}, buffer.size()})
+    {
+        measure("HashLittle", length, [](const std::byte* p, const std::size_t n) { return HashLittle(p, n, 0); });
+        measure("Hash64", length, [](const std::byte* p, const std::size_t n) { return Hash64(p, n); });
+        measure("Hash128", length, [](const std::byte* p, const std::size_t n) { return Hash128(p, n).low; });
+        measure("Hasher, 4 KiB reads", length, [](const std::byte* p, const std::size_t n) {
+            Hasher hasher;
+            for (std::size_t offset = 0; offset < n; offset += 4096)
+            {
+                hasher.Update(p + offset, std::min<std::size_t>(4096, n - offset));
+            }
+            return hasher.Finalize();
+        });
+    }
+}
+
+TEST_CASE("Hash: batch throughput", "[.][benchmark][hash]")
+{
+    const std::vector<std::byte> buffer{SanityBuffer(1 << 20)};
+    const auto measure{[&]<typename Key>(const char* name, std::type_identity<Key>) {
+        std::vector<Key> keys(buffer.size() / sizeof(Key));
+        std::memcpy(keys.data(), buffer.data(), keys.size() * sizeof(Key));
+        std::vector<std::uint64_t> out(keys.size());
+        const auto run{[&](auto&& hash) {
+            std::size_t hashed{};
+            const auto start{std::chrono::steady_clock::now()};
+            while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds{300})
+            {
+                hash();
+                hashed += keys.size();
+            }
+            const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+            return static_cast<double>(hashed) / elapsed.count() / 1e6;
+        }};
+        const double single{run([&] {
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                out[i] = Hash64(&keys[i], sizeof(Key));
+            }
+        })};
+        const double batch{run([&] { HashBatch(std::span<const Key>{keys}, std::span{out}); })};
+        WARN(name << " (" << ToString(ActiveSimdLevel()) << "): Hash64 " << single << " Mkeys/s, HashBatch " << batch << " Mkeys/s" << (out[0] == 0 ? " " : ""));
+    }};
+    measure("8 byte keys", std::type_identity<std::uint64_t>{});
+    measure("int3 keys", std::type_identity<int3>{});
+    measure("16 byte keys", std::type_identity<std::array<char, 16>>{});
+    measure("32 byte keys", std::type_identity<std::array<std::uint64_t, 4>>{});
+    measure("64 byte keys", std::type_identity<std::array<std::uint64_t, 8>>{});
+}
+
 TEST_CASE("Float: uintToFloatExcl conversion works", "[float]")
 {
     REQUIRE(UintToFloatExcl(0) == Catch::Approx(0.0f));
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+// every one of the first `count` points falls in its own 1/count-wide stratum
+template <typename Sample>
+bool Stratified(const std::uint32_t count, Sample sample)
+{
+    std::vector<bool> hit(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const auto cell{static_cast<std::uint32_t>(sample(i) * static_cast<float>(count))};
+        if (cell >= count || hit[cell])
+        {
+            return false;
+        }
+        hit[cell] = true;
+    }
+    return true;
+}
+
+// the first b^k radical inverses are exactly the multiples of 1/b^k, in some order
+template <typename Sample>
+bool OnLattice(const std::uint32_t count, Sample sample)
+{
+    std::vector<bool> hit(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const double scaled{static_cast<double>(sample(i)) * count};
+        const auto cell{static_cast<std::uint32_t>(std::lround(scaled))};
+        if (cell >= count || hit[cell] || std::abs(scaled - cell) > 0.25)
+        {
+            return false;
+        }
+        hit[cell] = true;
+    }
+    return true;
+}
+
+// every elementary interval of area 1/2^m over the first 2^m points holds exactly one point
+template <typename Generator>
+bool ElementaryIntervals(const Generator& generator, const std::uint32_t m)
+{
+    const std::uint32_t count{1U << m};
+    for (std::uint32_t xBits = 0; xBits <= m; ++xBits)
+    {
+        const std::uint32_t columns{1U << xBits};
+        const std::uint32_t rows{count >> xBits};
+        std::vector<bool> hit(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const float2 p{generator.Sample2(i)};
+            const auto cell{static_cast<std::uint32_t>(p.y * static_cast<float>(rows)) * columns + static_cast<std::uint32_t>(p.x * static_cast<float>(columns))};
+            if (hit[cell])
+            {
+                return false;
+            }
+            hit[cell] = true;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("LowDiscrepancy: Sobol", "[low_discrepancy]")
+{
+    constexpr Sobol sobol;
+    static_assert(sobol.SampleBits(0, 7) == 0U);
+    static_assert(sobol.SampleBits(1, 0) == 0x80000000U);
+    REQUIRE(sobol.Sample2(1) == float2{0.5F, 0.5F});
+    REQUIRE(sobol.Sample2(2) == float2{0.25F, 0.75F});
+    REQUIRE(sobol.Sample2(3) == float2{0.75F, 0.25F});
+    // m = {1, 3} on x^2 + x + 1
+    REQUIRE(sobol.Sample(2, 2) == 0.75F);
+    REQUIRE(sobol.Sample(3, 2) == 0.25F);
+
+    const Sobol scrambled{42};
+    REQUIRE(scrambled.Sample2(0) != float2{0.0F, 0.0F});
+    REQUIRE(ElementaryIntervals(sobol, 10));
+    REQUIRE(ElementaryIntervals(scrambled, 10));
+    for (std::uint32_t d = 0; d < Sobol::max_dimensions; ++d)
+    {
+        INFO("dimension " << d);
+        REQUIRE(Stratified(1024, [&](const std::uint32_t i) { return sobol.Sample(i, d); }));
+        REQUIRE(Stratified(1024, [&](const std::uint32_t i) { return scrambled.Sample(i, d); }));
+    }
+
+    SECTION("batch matches random access")
+    {
+        for (const Sobol& generator : {sobol, scrambled})
+        {
+            std::vector<float3> points(1000);
+            generator.Fill(77, std::span{points}, 5);
+            std::vector<float> line(1000);
+            generator.Fill(77, std::span{line}, 6);
+            for (std::uint32_t i = 0; i < points.size(); ++i)
+            {
+                REQUIRE(points[i] == generator.Sample3(77 + i, 5));
+                REQUIRE(line[i] == points[i].y);
+            }
+        }
+    }
+}
+
+TEST_CASE("LowDiscrepancy: Halton", "[low_discrepancy]")
+{
+    const Halton halton{8};
+    REQUIRE(halton.Dimensions() == 8);
+    REQUIRE(halton.Sample2(1) == float2{0.5F, 1.0F / 3.0F});
+    REQUIRE(halton.Sample2(5) == float2{0.625F, 7.0F / 9.0F});
+    REQUIRE(halton.Sample(7, 2) == Catch::Approx(11.0 / 25.0));
+
+    const Halton plain{64};
+    const Halton scrambled{64, 9};
+    REQUIRE(scrambled.Sample(1, 0) == 0.5F);
+    int permuted{};
+    for (std::uint32_t d = 1; d < 64; ++d)
+    {
+        permuted += scrambled.Sample(1, d) != plain.Sample(1, d) ? 1 : 0;
+    }
+    REQUIRE(permuted > 50);
+
+    constexpr std::array<std::uint32_t, 4> counts{1024, 729, 625, 343};
+    for (std::uint32_t d = 0; d < counts.size(); ++d)
+    {
+        REQUIRE(OnLattice(counts[d], [&](const std::uint32_t i) { return halton.Sample(i, d); }));
+        REQUIRE(OnLattice(counts[d], [&](const std::uint32_t i) { return scrambled.Sample(i, d); }));
+    }
+    REQUIRE(OnLattice(311 * 311, [&](const std::uint32_t i) { return scrambled.Sample(i, 63); }));
+
+    std::vector<float3> points(500);
+    scrambled.Fill(1000, std::span{points});
+    for (std::uint32_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE(points[i] == scrambled.Sample3(1000 + i));
+    }
+}
+
+TEST_CASE("LowDiscrepancy: Rd", "[low_discrepancy]")
+{
+    const Rd r2{R2()};
+    REQUIRE(r2.Dimensions() == 2);
+    REQUIRE(r2.Sample2(0) == float2{0.5F, 0.5F});
+    // alpha = (1 / 1.3247..., 1 / 1.3247...^2)
+    REQUIRE(r2.Sample(1, 0) == Catch::Approx(0.5 + 0.75487766624669276 - 1.0).margin(1e-6));
+    REQUIRE(r2.Sample(1, 1) == Catch::Approx(0.5 + 0.56984029099805327 - 1.0).margin(1e-6));
+
+    // exact far out: point 2^32 - 1 matches a long-double evaluation
+    const std::uint32_t last{std::numeric_limits<std::uint32_t>::max()};
+    const long double alpha{0.75487766624669276L};
+    long double integer;
+    const long double expected{std::modf(0.5L + last * alpha, &integer)};
+    REQUIRE(r2.Sample(last, 0) == Catch::Approx(static_cast<double>(expected)).margin(1e-5));
+
+    // gaps between sorted 1D points take at most three lengths (three-distance theorem)
+    std::vector<float> line(1000);
+    r2.Fill(0, std::span{line}, 0);
+    std::ranges::sort(line);
+    std::vector<float> gaps;
+    for (std::size_t i = 1; i < line.size(); ++i)
+    {
+        const float gap{line[i] - line[i - 1]};
+        if (std::ranges::none_of(gaps, [&](const float known) { return std::abs(known - gap) < 1e-5F; }))
+        {
+            gaps.push_back(gap);
+        }
+    }
+    REQUIRE(gaps.size() <= 3);
+
+    const Rd seeded{5, 3};
+    std::vector<float2> points(999);
+    seeded.Fill(12345, std::span{points}, 3);
+    for (std::uint32_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE(points[i] == seeded.Sample2(12345 + i, 3));
+    }
+}
+
+TEST_CASE("LowDiscrepancy: blue noise", "[low_discrepancy]")
+{
+    const auto tile{BlueNoise::Tile()};
+    std::vector<std::uint16_t> sorted(tile.begin(), tile.end());
+    std::ranges::sort(sorted);
+    for (std::uint32_t i = 0; i < sorted.size(); ++i)
+    {
+        REQUIRE(sorted[i] == i);
+    }
+
+    // the first 1/16 of the ranks sit close to a 4-pixel grid: no two of them are adjacent
+    constexpr int size{BlueNoise::tile_size};
+    std::vector<std::array<int, 2>> early;
+    for (int i = 0; i < size * size; ++i)
+    {
+        if (tile[static_cast<std::size_t>(i)] < size * size / 16)
+        {
+            early.push_back({i % size, i / size});
+        }
+    }
+    int closest{size * size};
+    for (std::size_t a = 0; a < early.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < early.size(); ++b)
+        {
+            const int dx{std::min(std::abs(early[a][0] - early[b][0]), size - std::abs(early[a][0] - early[b][0]))};
+            const int dy{std::min(std::abs(early[a][1] - early[b][1]), size - std::abs(early[a][1] - early[b][1]))};
+            closest = std::min(closest, dx * dx + dy * dy);
+        }
+    }
+    REQUIRE(closest >= 4);
+
+    const BlueNoise noise{11};
+    REQUIRE(noise.Sample(3, 5, 0) == (static_cast<float>(tile[5 * size + 3]) + 0.5F) / 4096.0F);
+    REQUIRE(noise.Sample(67, 69, 0) == noise.Sample(3, 5, 0));
+    std::vector<float> row(150);
+    noise.Fill(10, 20, 7, std::span{row}, 2);
+    for (std::uint32_t i = 0; i < row.size(); ++i)
+    {
+        REQUIRE(row[i] == noise.Sample(10 + i, 20, 7, 2));
+        REQUIRE(row[i] >= 0.0F);
+        REQUIRE(row[i] < 1.0F);
+    }
+    std::vector<float2> pairs(70);
+    std::vector<float3> triples(70);
+    noise.Fill(60, 1, 3, std::span{pairs});
+    noise.Fill(60, 1, 3, std::span{triples}, 4);
+    for (std::uint32_t i = 0; i < pairs.size(); ++i)
+    {
+        REQUIRE(pairs[i] == noise.Sample2(60 + i, 1, 3));
+        REQUIRE(triples[i] == noise.Sample3(60 + i, 1, 3, 4));
+    }
+}
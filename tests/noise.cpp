@@ -0,0 +1,310 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+TEST_CASE("Noise: Perlin", "[noise]")
+{
+    SECTION("zero on the lattice")
+    {
+        for (int i = -3; i <= 3; ++i)
+        {
+            REQUIRE(Perlin(static_cast<float>(i), static_cast<float>(2 * i)) == 0.0F);
+            REQUIRE(Perlin(static_cast<float>(i), -7.0F, static_cast<float>(i * i), 9U) == 0.0F);
+        }
+    }
+    SECTION("range and continuity")
+    {
+        PCG32 rng(3);
+        float peak2{};
+        float peak3{};
+        for (int i = 0; i < 20000; ++i)
+        {
+            const float x{UniformFloat(rng) * 200.0F - 100.0F};
+            const float y{UniformFloat(rng) * 200.0F - 100.0F};
+            const float z{UniformFloat(rng) * 200.0F - 100.0F};
+            const float n2{Perlin(x, y)};
+            const float n3{Perlin(x, y, z)};
+            peak2 = std::max(peak2, std::abs(n2));
+            peak3 = std::max(peak3, std::abs(n3));
+            REQUIRE(std::abs(Perlin(x + 1e-3F, y) - n2) < 1e-2F);
+            REQUIRE(std::abs(Perlin(x, y, z + 1e-3F) - n3) < 1e-2F);
+        }
+        REQUIRE(peak2 <= 1.0F);
+        REQUIRE(peak3 <= 1.0F);
+        REQUIRE(peak2 > 0.5F);
+        REQUIRE(peak3 > 0.5F);
+    }
+    SECTION("seeds give different fields")
+    {
+        int same{};
+        for (int i = 0; i < 100; ++i)
+        {
+            const float x{static_cast<float>(i) * 0.37F + 0.5F};
+            same += Perlin(x, 0.25F, 1U) == Perlin(x, 0.25F, 2U) ? 1 : 0;
+        }
+        REQUIRE(same < 5);
+    }
+    SECTION("lanes match single points")
+    {
+        const simd::f32x8 x{-3.5F, -0.25F, 0.0F, 0.75F, 1.5F, 17.125F, 1000.3F, -1000.7F};
+        const simd::f32x8 y{2.0F, 0.1F, -0.9F, 5.5F, 3.25F, -8.0F, 0.5F, 123.456F};
+        const simd::f32x8 z{0.3F, 0.6F, 0.9F, 1.2F, 1.5F, 1.8F, 2.1F, 2.4F};
+        const simd::f32x8 n2{Perlin(x, y, 5U)};
+        const simd::f32x8 n3{Perlin(x, y, z, 5U)};
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(n2[i] == Catch::Approx(Perlin(x[i], y[i], 5U)).margin(1e-6));
+            REQUIRE(n3[i] == Catch::Approx(Perlin(x[i], y[i], z[i], 5U)).margin(1e-6));
+        }
+    }
+}
+
+TEST_CASE("Noise: simplex", "[noise]")
+{
+    PCG32 rng(5);
+    std::array<float, 3> peak{};
+    for (int i = 0; i < 20000; ++i)
+    {
+        const float x{UniformFloat(rng) * 200.0F - 100.0F};
+        const float y{UniformFloat(rng) * 200.0F - 100.0F};
+        const float z{UniformFloat(rng) * 200.0F - 100.0F};
+        const float w{UniformFloat(rng) * 200.0F - 100.0F};
+        const std::array<float, 3> n{Simplex(x, y), Simplex(x, y, z), Simplex(x, y, z, w)};
+        for (std::size_t d = 0; d < n.size(); ++d)
+        {
+            peak[d] = std::max(peak[d], std::abs(n[d]));
+        }
+        REQUIRE(std::abs(Simplex(x + 1e-3F, y) - n[0]) < 1e-2F);
+        REQUIRE(std::abs(Simplex(x, y, z + 1e-3F) - n[1]) < 1e-2F);
+        REQUIRE(std::abs(Simplex(x, y, z, w + 1e-3F) - n[2]) < 1e-2F);
+    }
+    for (const float p : peak)
+    {
+        REQUIRE(p <= 1.0F);
+        REQUIRE(p > 0.5F);
+    }
+
+    SECTION("seeds give different fields")
+    {
+        int same{};
+        for (int i = 0; i < 100; ++i)
+        {
+            const float x{static_cast<float>(i) * 0.37F + 0.5F};
+            same += Simplex(x, 0.25F, 1.5F, 1U) == Simplex(x, 0.25F, 1.5F, 2U) ? 1 : 0;
+        }
+        REQUIRE(same < 5);
+    }
+    SECTION("lanes match single points")
+    {
+        const simd::f32x8 x{-3.5F, -0.25F, 0.0F, 0.75F, 1.5F, 17.125F, 1000.3F, -1000.7F};
+        const simd::f32x8 y{2.0F, 0.1F, -0.9F, 5.5F, 3.25F, -8.0F, 0.5F, 123.456F};
+        const simd::f32x8 z{0.3F, 0.6F, 0.9F, 1.2F, 1.5F, 1.8F, 2.1F, 2.4F};
+        const simd::f32x8 n2{Simplex(x, y, 3U)};
+        const simd::f32x8 n3{Simplex(x, y, z, 3U)};
+        const simd::f32x8 n4{Simplex(x, y, z, x * 0.5F, 3U)};
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(n2[i] == Catch::Approx(Simplex(x[i], y[i], 3U)).margin(1e-6));
+            REQUIRE(n3[i] == Catch::Approx(Simplex(x[i], y[i], z[i], 3U)).margin(1e-6));
+            REQUIRE(n4[i] == Catch::Approx(Simplex(x[i], y[i], z[i], x[i] * 0.5F, 3U)).margin(1e-6));
+        }
+    }
+}
+
+TEST_CASE("Noise: Worley", "[noise]")
+{
+    PCG32 rng(6);
+    float nearest{1.0F};
+    for (int i = 0; i < 20000; ++i)
+    {
+        const float x{UniformFloat(rng) * 200.0F - 100.0F};
+        const float y{UniformFloat(rng) * 200.0F - 100.0F};
+        const float z{UniformFloat(rng) * 200.0F - 100.0F};
+        const WorleyDistances<float> a{Worley(x, y, 9U)};
+        const WorleyDistances<float> b{Worley(x, y, z, 9U)};
+        REQUIRE(a.f1 >= 0.0F);
+        REQUIRE(a.f1 <= a.f2);
+        REQUIRE(b.f1 <= b.f2);
+        nearest = std::min(nearest, a.f1);
+
+        // distances to fixed points change no faster than the sample moves
+        const float dx{0.01F};
+        const WorleyDistances<float> a2{Worley(x + dx, y, 9U)};
+        const WorleyDistances<float> b2{Worley(x, y, z + dx, 9U)};
+        REQUIRE(std::abs(a2.f1 - a.f1) <= dx * 1.01F);
+        REQUIRE(std::abs(a2.f2 - a.f2) <= dx * 1.01F);
+        REQUIRE(std::abs(b2.f1 - b.f1) <= dx * 1.01F);
+        REQUIRE(std::abs(b2.f2 - b.f2) <= dx * 1.01F);
+    }
+    REQUIRE(nearest < 0.05F);
+
+    const simd::f32x4 x{-3.5F, 0.25F, 17.0F, 1000.3F};
+    const simd::f32x4 y{2.0F, -0.9F, 3.25F, 0.5F};
+    const WorleyDistances<simd::f32x4> lanes{Worley(x, y, x, 2U)};
+    for (int i = 0; i < 4; ++i)
+    {
+        const WorleyDistances<float> single{Worley(x[i], y[i], x[i], 2U)};
+        REQUIRE(lanes.f1[i] == single.f1);
+        REQUIRE(lanes.f2[i] == single.f2);
+    }
+}
+
+TEST_CASE("Noise: periodic", "[noise]")
+{
+    constexpr std::uint32_t period{5};
+    const float shift{static_cast<float>(period)};
+    PCG32 rng(10);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float x{UniformFloat(rng) * 20.0F - 10.0F};
+        const float y{UniformFloat(rng) * 20.0F - 10.0F};
+        const float z{UniformFloat(rng) * 20.0F - 10.0F};
+        const WorleyDistances<float> a{Worley(x, y, 1U, period)};
+        const WorleyDistances<float> b{Worley(x + shift, y - 2.0F * shift, 1U, period)};
+        REQUIRE(b.f1 == Catch::Approx(a.f1).margin(1e-4));
+        REQUIRE(b.f2 == Catch::Approx(a.f2).margin(1e-4));
+        REQUIRE(Worley(x, y, z - shift, 1U, period).f1 == Catch::Approx(Worley(x, y, z, 1U, period).f1).margin(1e-4));
+    }
+
+    // 4 octaves at lacunarity 2 over a 64 texel tile: the opposite edges continue each other
+    const NoiseSettings tiled{.seed = 3, .frequency = 4.0F / 64.0F, .octaves = 4, .period = 4};
+    constexpr std::uint32_t size{64};
+    std::vector<float> tile(size * size);
+    FillGrid2D(std::span{tile}, size, size, float2{}, float2{1.0F, 1.0F}, tiled);
+    for (std::uint32_t j = 0; j < size; ++j)
+    {
+        REQUIRE(Noise(static_cast<float>(size), static_cast<float>(j), tiled) == Catch::Approx(tile[j * size]).margin(1e-5));
+        REQUIRE(Noise(static_cast<float>(j), -1.0F, tiled) == Catch::Approx(tile[(size - 1) * size + j]).margin(1e-5));
+    }
+    const NoiseSettings volume{.kind = NoiseKind::Perlin, .frequency = 0.5F, .period = 3};
+    REQUIRE(Noise(0.3F, 1.7F, 2.2F + 6.0F, volume) == Catch::Approx(Noise(0.3F, 1.7F, 2.2F, volume)).margin(1e-5));
+    REQUIRE(Noise(0.3F + 6.0F, 1.7F, 2.2F, volume) != Catch::Approx(Noise(0.3F + 6.0F, 1.7F, 2.2F)).margin(1e-5));
+}
+
+TEST_CASE("Noise: fractals", "[noise]")
+{
+    PCG32 rng(8);
+    NoiseSettings fbm{};
+    NoiseSettings ridged{.kind = NoiseKind::Ridged, .octaves = 5};
+    NoiseSettings turbulence{.kind = NoiseKind::Turbulence, .frequency = 0.5F};
+    double sum{};
+    constexpr int count{5000};
+    for (int i = 0; i < count; ++i)
+    {
+        const float x{UniformFloat(rng) * 64.0F};
+        const float y{UniformFloat(rng) * 64.0F};
+        const float f{Noise(x, y, fbm)};
+        const float r{Noise(x, y, 0.5F, ridged)};
+        const float t{Noise(x, y, turbulence)};
+        REQUIRE(std::abs(f) <= 1.0F);
+        REQUIRE(std::abs(r) <= 1.0F);
+        REQUIRE(t >= 0.0F);
+        REQUIRE(t <= 1.0F);
+        sum += f;
+    }
+    REQUIRE(sum / count == Catch::Approx(0.0).margin(0.03));
+
+    const NoiseSettings single{.kind = NoiseKind::Perlin, .seed = 4, .frequency = 2.0F};
+    REQUIRE(Noise(0.3F, 0.75F, single) == Perlin(0.3F * 2.0F, 1.5F, 4U));
+}
+
+TEST_CASE("Noise: grids", "[noise]")
+{
+    const NoiseSettings settings{.kind = NoiseKind::Ridged, .seed = 12, .frequency = 0.05F, .octaves = 4};
+
+    constexpr std::uint32_t width{37};
+    constexpr std::uint32_t height{5};
+    std::vector<float> tile(width * height + 1, -2.0F);
+    FillGrid2D(std::span{tile}.first(width * height), width, height, float2{-10.0F, 4.0F}, float2{0.5F, 0.25F}, settings);
+    REQUIRE(tile.back() == -2.0F);
+    for (std::uint32_t j = 0; j < height; ++j)
+    {
+        for (std::uint32_t i = 0; i < width; ++i)
+        {
+            const float x{static_cast<float>(i) * 0.5F - 10.0F};
+            const float y{static_cast<float>(j) * 0.25F + 4.0F};
+            REQUIRE(tile[j * width + i] == Catch::Approx(Noise(x, y, settings)).margin(1e-5));
+        }
+    }
+
+    const NoiseSettings simplex{.basis = NoiseBasis::Simplex, .seed = 2, .frequency = 0.1F, .octaves = 3};
+    FillGrid2D(std::span{tile}.first(width * height), width, height, float2{3.0F, -4.0F}, float2{1.0F, 1.0F}, simplex);
+    REQUIRE(tile[2 * width + 7] == Catch::Approx(Noise(10.0F, -2.0F, simplex)).margin(1e-5));
+    const NoiseSettings single{.kind = NoiseKind::Perlin, .basis = NoiseBasis::Simplex, .seed = 2, .frequency = 0.5F};
+    REQUIRE(Noise(3.0F, 5.0F, single) == Simplex(1.5F, 2.5F, 2U));
+    REQUIRE(Noise(3.0F, 5.0F, 1.0F, single) == Simplex(1.5F, 2.5F, 0.5F, 2U));
+
+    constexpr std::uint32_t depth{3};
+    std::vector<float> volume(width * height * depth);
+    FillGrid3D(std::span{volume}, width, height, depth, float3{1.0F, 2.0F, 3.0F}, float3{0.125F, 1.0F, 0.5F});
+    for (std::uint32_t k = 0; k < depth; ++k)
+    {
+        for (std::uint32_t j = 0; j < height; ++j)
+        {
+            for (std::uint32_t i = 0; i < width; ++i)
+            {
+                const float3 p{1.0F + static_cast<float>(i) * 0.125F, 2.0F + static_cast<float>(j), 3.0F + static_cast<float>(k) * 0.5F};
+                REQUIRE(volume[(k * height + j) * width + i] == Catch::Approx(Noise(p.x, p.y, p.z)).margin(1e-5));
+            }
+        }
+    }
+}
+
+TEST_CASE("Noise: throughput", "[.][benchmark][noise]")
+{
+    constexpr std::uint32_t size{512};
+    std::vector<float> tile(size * size);
+    const NoiseSettings perlin{.kind = NoiseKind::Perlin, .frequency = 1.0F / 32.0F};
+    const NoiseSettings fbm{.frequency = 1.0F / 64.0F};
+
+    const auto measure{[&](const char* name, auto&& fill, const double samplesPerCall) {
+        const auto start{std::chrono::steady_clock::now()};
+        int calls{};
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds{500})
+        {
+            fill();
+            ++calls;
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        WARN(name << " (" << ToString(ActiveSimdLevel()) << "): " << samplesPerCall * calls / elapsed.count() / 1e6 << " M samples/s");
+    }};
+
+    measure("Perlin 2D grid", [&] { FillGrid2D(std::span{tile}, size, size, float2{}, float2{1.0F, 1.0F}, perlin); }, size * size);
+    measure("Perlin 3D grid", [&] { FillGrid3D(std::span{tile}, size, size / 8, 8, float3{}, float3{1.0F, 1.0F, 1.0F}, perlin); }, size * size);
+    measure("fBm 2D grid, 6 octaves", [&] { FillGrid2D(std::span{tile}, size, size, float2{}, float2{1.0F, 1.0F}, fbm); }, size * size);
+    const NoiseSettings simplex{.kind = NoiseKind::Perlin, .basis = NoiseBasis::Simplex, .frequency = 1.0F / 32.0F};
+    measure("Simplex 2D grid", [&] { FillGrid2D(std::span{tile}, size, size, float2{}, float2{1.0F, 1.0F}, simplex); }, size * size);
+    measure("Simplex 3D grid", [&] { FillGrid3D(std::span{tile}, size, size / 8, 8, float3{}, float3{1.0F, 1.0F, 1.0F}, simplex); }, size * size);
+    measure("Worley 2D, 8 lanes", [&] {
+        const simd::f32x8 lanes{0.0F, 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F};
+        for (std::uint32_t j = 0; j < size; ++j)
+        {
+            for (std::uint32_t i = 0; i < size; i += 8)
+            {
+                const WorleyDistances<simd::f32x8> d{Worley((lanes + static_cast<float>(i)) * 0.05F, simd::f32x8::splat(static_cast<float>(j) * 0.05F))};
+                d.f1.store(tile.data() + j * size + i);
+            }
+        }
+    }, size * size);
+    measure("Perlin 3D single points", [&] {
+        float sink{};
+        for (std::uint32_t i = 0; i < size * size; ++i)
+        {
+            sink += Perlin(static_cast<float>(i % size) * 0.03F, static_cast<float>(i / size) * 0.03F, 0.5F);
+        }
+        tile[0] = sink;
+    }, size * size);
+
+    BENCHMARK("FillGrid2D 512 x 512 fBm")
+    {
+        FillGrid2D(std::span{tile}, size, size, float2{}, float2{1.0F, 1.0F}, fbm);
+        return tile[size];
+    };
+}
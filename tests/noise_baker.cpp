@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+TEST_CASE("NoiseBaker: chunks", "[noise_baker]")
+{
+    const NoiseSettings settings{.kind = NoiseKind::Fbm, .seed = 5U, .frequency = 0.05F, .octaves = 3};
+    NoiseBaker baker{{.chunkSize = {16, 8, 4}, .texelSize = {0.5F, 0.5F, 1.0F}, .cacheChunks = 4, .threads = 2}};
+    REQUIRE(baker.Settings().chunkSize.z == 1);
+    REQUIRE(baker.ChunkTexels() == 16 * 8);
+
+    SECTION("a chunk is the grid at its origin")
+    {
+        const auto chunk{baker.Chunk({-2, 3, 0}, settings)};
+        REQUIRE(chunk->coord == int3{-2, 3, 0});
+        REQUIRE(chunk->texels.size() == baker.ChunkTexels());
+        std::vector<float> expected(baker.ChunkTexels());
+        FillGrid2D(expected, 16, 8, {-16.0F, 12.0F}, {0.5F, 0.5F}, settings);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            REQUIRE(chunk->texels[i] == Catch::Approx(expected[i]).margin(1e-6));
+        }
+    }
+    SECTION("neighbouring chunks continue each other")
+    {
+        const auto left{baker.Chunk({0, 0, 0}, settings)};
+        const auto right{baker.Chunk({1, 0, 0}, settings)};
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            REQUIRE(right->texels[j * 16] == Catch::Approx(Noise(8.0F, static_cast<float>(j) * 0.5F, settings)).margin(1e-6));
+            REQUIRE(std::abs(right->texels[j * 16] - left->texels[j * 16 + 15]) < 0.1F);
+        }
+    }
+    SECTION("cache")
+    {
+        const auto first{baker.Chunk({0, 0, 0}, settings)};
+        REQUIRE(baker.CacheMisses() == 1);
+        REQUIRE(baker.Chunk({0, 0, 0}, settings) == first);
+        REQUIRE(baker.CacheHits() == 1);
+
+        // other settings are another chunk
+        NoiseSettings other{settings};
+        other.seed = 6U;
+        REQUIRE(baker.Chunk({0, 0, 0}, other) != first);
+        REQUIRE(baker.CacheMisses() == 2);
+
+        // four chunks fit; the fifth evicts the least recently used
+        static_cast<void>(baker.Chunk({1, 0, 0}, settings));
+        static_cast<void>(baker.Chunk({2, 0, 0}, settings));
+        static_cast<void>(baker.Chunk({0, 0, 0}, settings));
+        REQUIRE(baker.CacheHits() == 2);
+        static_cast<void>(baker.Chunk({3, 0, 0}, settings));
+        const auto evicted{baker.Chunk({0, 0, 0}, other)};
+        REQUIRE(baker.CacheMisses() == 6);
+        REQUIRE(evicted->texels == baker.Chunk({0, 0, 0}, other)->texels);
+        REQUIRE(baker.CacheHits() == 3);
+        REQUIRE(first->texels.size() == baker.ChunkTexels());
+    }
+}
+
+TEST_CASE("NoiseBaker: Bake", "[noise_baker]")
+{
+    const NoiseSettings settings{.kind = NoiseKind::Ridged, .basis = NoiseBasis::Simplex, .seed = 11U, .frequency = 0.03F, .octaves = 4};
+
+    SECTION("callback sees every chunk once")
+    {
+        NoiseBaker baker{{.chunkSize = {8, 8, 1}, .threads = 3}};
+        std::mutex mutex;
+        std::set<std::array<std::int32_t, 3>> seen;
+        const NoiseBakeJob job{baker.Bake({-1, -1, 0}, {4, 3, 1}, settings, [&](const NoiseChunk& chunk) {
+            const std::scoped_lock lock{mutex};
+            REQUIRE(seen.insert({chunk.coord.x, chunk.coord.y, chunk.coord.z}).second);
+        })};
+        job.Wait();
+        REQUIRE(job.Done());
+        REQUIRE(seen.size() == 12);
+        REQUIRE(seen.contains({-1, -1, 0}));
+        REQUIRE(seen.contains({2, 1, 0}));
+        REQUIRE(baker.CacheMisses() == 12);
+
+        REQUIRE(baker.Bake({0, 0, 0}, {0, 2, 1}, settings, [](const NoiseChunk&) {}).Done());
+        REQUIRE(NoiseBakeJob{}.Done());
+    }
+    SECTION("region into one array")
+    {
+        NoiseBaker baker{{.chunkSize = {16, 16, 1}, .texelSize = {0.25F, 0.25F, 1.0F}, .cacheChunks = 0}};
+        std::vector<float> region(48 * 32);
+        baker.Bake({2, -1, 0}, {3, 2, 1}, settings, region).Wait();
+        std::vector<float> expected(region.size());
+        FillGrid2D(expected, 48, 32, {8.0F, -4.0F}, {0.25F, 0.25F}, settings);
+        for (std::size_t i = 0; i < region.size(); ++i)
+        {
+            REQUIRE(region[i] == Catch::Approx(expected[i]).margin(1e-5));
+        }
+        REQUIRE(baker.CacheHits() == 0);
+    }
+    SECTION("volume")
+    {
+        const NoiseSettings fbm{.seed = 2U, .frequency = 0.1F, .octaves = 2};
+        NoiseBaker baker{{.chunkSize = {8, 4, 4}, .volume = true, .threads = 2}};
+        REQUIRE(baker.ChunkTexels() == 8 * 4 * 4);
+        std::vector<float> region(16 * 8 * 8);
+        const NoiseBakeJob job{baker.Bake({0, -1, 1}, {2, 2, 2}, fbm, region)};
+        job.Wait();
+        std::vector<float> expected(region.size());
+        FillGrid3D(expected, 16, 8, 8, {0.0F, -4.0F, 4.0F}, {1.0F, 1.0F, 1.0F}, fbm);
+        for (std::size_t i = 0; i < region.size(); ++i)
+        {
+            REQUIRE(region[i] == Catch::Approx(expected[i]).margin(1e-5));
+        }
+    }
+    SECTION("destroying the baker finishes queued chunks")
+    {
+        std::atomic<int> baked{};
+        {
+            NoiseBaker baker{{.chunkSize = {32, 32, 1}, .threads = 1}};
+            static_cast<void>(baker.Bake({0, 0, 0}, {6, 6, 1}, settings, [&](const NoiseChunk&) { baked.fetch_add(1); }));
+        }
+        REQUIRE(baked.load() == 36);
+    }
+}
+
+TEST_CASE("NoiseBaker: failures", "[noise_baker]")
+{
+    const NoiseSettings settings{.seed = 3U, .frequency = 0.1F, .octaves = 2};
+
+    SECTION("a chunk that fails to bake throws every time and is not cached")
+    {
+        // 2^62 texels: the texel vector throws before anything is allocated
+        NoiseBaker baker{{.chunkSize = {1U << 31U, 1U << 31U, 1}, .threads = 2}};
+        REQUIRE_THROWS_AS(baker.Chunk({0, 0, 0}, settings), std::length_error);
+        REQUIRE_THROWS_AS(baker.Chunk({0, 0, 0}, settings), std::length_error);
+        REQUIRE(baker.CacheMisses() == 2);
+        REQUIRE(baker.CacheHits() == 0);
+
+        std::atomic<int> called{};
+        const NoiseBakeJob job{baker.Bake({0, 0, 0}, {2, 2, 1}, settings, [&](const NoiseChunk&) { called.fetch_add(1); })};
+        REQUIRE_THROWS_AS(job.Wait(), std::length_error);
+        REQUIRE(job.Done());
+        REQUIRE(called.load() == 0);
+    }
+    SECTION("a throwing callback fails the job, the other chunks still run")
+    {
+        NoiseBaker baker{{.chunkSize = {8, 8, 1}, .threads = 3}};
+        std::atomic<int> called{};
+        const NoiseBakeJob job{baker.Bake({0, 0, 0}, {3, 3, 1}, settings, [&](const NoiseChunk& chunk) {
+            called.fetch_add(1);
+            if (chunk.coord == int3{1, 1, 0})
+            {
+                throw std::runtime_error{"callback"};
+            }
+        })};
+        REQUIRE_THROWS_AS(job.Wait(), std::runtime_error);
+        REQUIRE(called.load() == 9);
+        REQUIRE(baker.Chunk({1, 1, 0}, settings)->texels.size() == 64);
+        REQUIRE(baker.CacheHits() == 1);
+    }
+}
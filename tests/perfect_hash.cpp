@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+constexpr std::string_view attributes[]{"position", "normal", "tangent", "bitangent", "uv0", "uv1", "color", "joints", "weights"};
+constexpr PerfectHash attributeTable{attributes};
+
+enum class Filter
+{
+    Nearest,
+    Linear,
+    Cubic,
+};
+
+constexpr std::pair<std::string_view, Filter> filters[]{{"nearest", Filter::Nearest}, {"linear", Filter::Linear}, {"cubic", Filter::Cubic}};
+constexpr PerfectHashMap filterByName{filters};
+
+// 1000 generated names, "p0" to "p999"
+constexpr std::size_t generated_count{1000};
+
+constexpr auto generated_names{[] {
+    std::array<std::array<char, 6>, generated_count> names{};
+    for (std::size_t i = 0; i < generated_count; ++i)
+    {
+        std::size_t length{1};
+        for (std::size_t rest = i; rest >= 10; rest /= 10)
+        {
+            ++length;
+        }
+        names[i][0] = 'p';
+        for (std::size_t digit = 0, rest = i; digit < length; ++digit, rest /= 10)
+        {
+            names[i][length - digit] = static_cast<char>('0' + rest % 10);
+        }
+    }
+    return names;
+}()};
+
+constexpr auto generated_keys{[] {
+    std::array<std::string_view, generated_count> keys{};
+    for (std::size_t i = 0; i < generated_count; ++i)
+    {
+        keys[i] = std::string_view{generated_names[i].data()};
+    }
+    return keys;
+}()};
+
+constexpr PerfectHash generatedTable{generated_keys};
+} // namespace
+
+// lookups work in constant expressions too
+static_assert(attributeTable.Index("normal") == 1);
+static_assert(attributeTable.Index("weights") == 8);
+static_assert(!attributeTable.Contains("normals"));
+static_assert(*filterByName.Find("cubic") == Filter::Cubic);
+static_assert(generatedTable.Index("p123") == 123);
+
+TEST_CASE("PerfectHash: every key finds its index", "[perfect_hash]")
+{
+    REQUIRE(attributeTable.Size() == 9);
+    for (std::size_t i = 0; i < std::size(attributes); ++i)
+    {
+        REQUIRE(attributeTable.Index(std::string{attributes[i]}) == i);
+    }
+    for (std::size_t i = 0; i < generated_count; ++i)
+    {
+        REQUIRE(generatedTable.Index(generated_keys[i]) == i);
+    }
+    REQUIRE(generated_keys[7] == "p7");
+    REQUIRE(generated_keys[999] == "p999");
+}
+
+TEST_CASE("PerfectHash: other strings are not found", "[perfect_hash]")
+{
+    for (const std::string_view other : {std::string_view{""}, std::string_view{"p"}, std::string_view{"uv2"}, std::string_view{"Position"}, std::string_view{"position "},
+                                         std::string_view{"p1000"}, std::string_view{"p00"}, std::string_view{"weights\0", 8}})
+    {
+        REQUIRE_FALSE(attributeTable.Contains(other));
+        REQUIRE(generatedTable.Index(other) == PerfectHash<generated_count>::npos);
+    }
+    for (std::size_t i = 1000; i < 100000; ++i)
+    {
+        REQUIRE_FALSE(generatedTable.Contains("p" + std::to_string(i)));
+    }
+}
+
+TEST_CASE("PerfectHashMap", "[perfect_hash]")
+{
+    REQUIRE(filterByName.Size() == 3);
+    REQUIRE(*filterByName.Find(std::string{"linear"}) == Filter::Linear);
+    REQUIRE(filterByName.Find("bilinear") == nullptr);
+    REQUIRE(filterByName.ValueOr("anisotropic", Filter::Nearest) == Filter::Nearest);
+    REQUIRE(filterByName.ValueOr("cubic", Filter::Nearest) == Filter::Cubic);
+}
+
+TEST_CASE("PerfectHash: throughput", "[.][benchmark][perfect_hash]")
+{
+    std::vector<std::string> queries;
+    Xoshiro256StarStar rng(5);
+    for (std::size_t i = 0; i < 1 << 20; ++i)
+    {
+        queries.push_back("p" + std::to_string(rng() % 1200));
+    }
+    std::unordered_map<std::string_view, std::size_t> unordered;
+    FlatHashMap<std::string_view, std::size_t, StringHash> flat;
+    for (std::size_t i = 0; i < generated_count; ++i)
+    {
+        unordered[generated_keys[i]] = i;
+        flat[generated_keys[i]]      = i;
+    }
+    const auto measure{[&](const char* name, auto&& lookup) {
+        std::size_t sink{};
+        const auto start{std::chrono::steady_clock::now()};
+        for (const std::string& query : queries)
+        {
+            sink += lookup(query);
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        WARN(name << ": " << static_cast<double>(queries.size()) / elapsed.count() / 1e6 << " Mlookups/s" << (sink == 0 ? " " : ""));
+    }};
+    measure("std::unordered_map", [&](const std::string_view key) {
+        const auto it{unordered.find(key)};
+        return it == unordered.end() ? std::size_t{0} : it->second;
+    });
+    measure("FlatHashMap", [&](const std::string_view key) {
+        const auto it{flat.Find(key)};
+        return it == flat.end() ? std::size_t{0} : it->second;
+    });
+    measure("PerfectHash", [&](const std::string_view key) {
+        const std::size_t index{generatedTable.Index(key)};
+        return index == PerfectHash<generated_count>::npos ? std::size_t{0} : index;
+    });
+}
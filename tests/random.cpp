@@ -67,3 +67,364 @@ TEST_CASE("Random: nextBytes", "[random]")
     REQUIRE(data[2] == 4921);
     REQUIRE(data[3] == 39526);
 }
+
+static_assert(FullRangeGenerator<SplitMix64>);
+static_assert(FullRangeGenerator<PCG32>);
+static_assert(FullRangeGenerator<Xoshiro256StarStar>);
+static_assert(FullRangeGenerator<Philox4x32>);
+static_assert(FullRangeGenerator<Threefry2x64>);
+static_assert(FullRangeGenerator<std::mt19937>);
+static_assert(!FullRangeGenerator<std::minstd_rand>);
+
+TEST_CASE("Engines: reference outputs", "[random]")
+{
+    SECTION("SplitMix64")
+    {
+        SplitMix64 rng{0};
+        REQUIRE(rng() == 0xE220A8397B1DCDAFULL);
+    }
+
+    SECTION("PCG32")
+    {
+        // pcg32-demo, seeded with (42, 54)
+        PCG32 rng{42, 54};
+        REQUIRE(rng() == 0xA15C02B7U);
+        REQUIRE(rng() == 0x7B47F409U);
+        REQUIRE(rng() == 0xBA1D3330U);
+        REQUIRE(rng() == 0x83D2F293U);
+    }
+
+    SECTION("Xoshiro256StarStar")
+    {
+        Xoshiro256StarStar rng{std::array<std::uint64_t, 4>{1, 2, 3, 4}};
+        REQUIRE(rng() == 11520ULL);
+        REQUIRE(rng() == 0ULL);
+        REQUIRE(rng() == 1509978240ULL);
+    }
+
+    SECTION("Philox4x32")
+    {
+        // Random123 known-answer vectors
+        REQUIRE(Philox4x32::Block({0, 0, 0, 0}, {0, 0}) == Philox4x32::counter_type{0x6627E8D5U, 0xE169C58DU, 0xBC57AC4CU, 0x9B00DBD8U});
+        REQUIRE(Philox4x32::Block({0x243F6A88U, 0x85A308D3U, 0x13198A2EU, 0x03707344U}, {0xA4093822U, 0x299F31D0U}) ==
+                Philox4x32::counter_type{0xD16CFE09U, 0x94FDCCEBU, 0x5001E420U, 0x24126EA1U});
+
+        Philox4x32 rng{};
+        REQUIRE(rng() == 0x6627E8D5U);
+        for (int i = 0; i < 3; ++i)
+            rng();
+        REQUIRE(rng() == Philox4x32::Block({1, 0, 0, 0}, {0, 0})[0]);
+    }
+
+    SECTION("Threefry2x64")
+    {
+        REQUIRE(Threefry2x64::Block({0, 0}, {0, 0}) == Threefry2x64::counter_type{0xC2B6E3A8C2C69865ULL, 0x6F81ED42F350084DULL});
+
+        Threefry2x64 rng{};
+        REQUIRE(rng() == 0xC2B6E3A8C2C69865ULL);
+        REQUIRE(rng() == 0x6F81ED42F350084DULL);
+        REQUIRE(rng() == Threefry2x64::Block({1, 0}, {0, 0})[0]);
+    }
+}
+
+TEST_CASE("Engines: bounded ranges are unbiased", "[random]")
+{
+    // 3 * 2^30 splits the 2^32 draws unevenly; a plain modulo lands in the bottom third half the time
+    Xoshiro256StarStar rng{7};
+    constexpr std::uint32_t range{3U << 30U};
+    int low{};
+    constexpr int samples{30000};
+    for (int i = 0; i < samples; ++i)
+    {
+        const std::uint32_t value{UniformBounded(rng, range)};
+        REQUIRE(value < range);
+        low += value < (1U << 30U) ? 1 : 0;
+    }
+    REQUIRE(std::abs(static_cast<double>(low) / samples - 1.0 / 3.0) < 0.015);
+
+    PCG32 pcg{3};
+    std::array<int, 6> counts{};
+    for (int i = 0; i < 60000; ++i)
+        ++counts[static_cast<std::size_t>(UniformRange(pcg, -3, 3) + 3)];
+    for (const int count : counts)
+        REQUIRE(std::abs(count - 10000) < 500);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::uint64_t value{UniformRange(pcg, 100ULL, 200ULL)};
+        REQUIRE(value >= 100ULL);
+        REQUIRE(value < 200ULL);
+    }
+}
+
+TEST_CASE("Engines: float conversion", "[random]")
+{
+    struct AllOnes
+    {
+        using result_type = std::uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~0ULL; }
+        result_type operator()() { return ~0ULL; }
+    };
+    AllOnes ones;
+    REQUIRE(UniformFloat(ones) == 1.0F - 0x1.0p-24F);
+    REQUIRE(UniformDouble(ones) == 1.0 - 0x1.0p-53);
+
+    Philox4x32 rng{11};
+    double sum{};
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float f{UniformFloat(rng)};
+        REQUIRE(f >= 0.0F);
+        REQUIRE(f < 1.0F);
+        REQUIRE(f * 0x1.0p24F == std::floor(f * 0x1.0p24F));
+        sum += UniformDouble(rng);
+        const float r{UniformReal(rng, -2.0F, 2.0F)};
+        REQUIRE(r >= -2.0F);
+        REQUIRE(r < 2.0F);
+    }
+    REQUIRE(sum / 10000.0 == Catch::Approx(0.5).margin(0.01));
+
+    // plugs into <random>
+    Threefry2x64 tf{5};
+    std::uniform_int_distribution<int> dist{1, 6};
+    const int roll{dist(tf)};
+    REQUIRE(roll >= 1);
+    REQUIRE(roll <= 6);
+}
+
+TEST_CASE("Philox4x32: bulk fill matches the scalar stream", "[random]")
+{
+    for (const std::size_t skip : {0U, 1U, 3U})
+    {
+        for (const std::size_t count : {0U, 5U, 31U, 64U, 200U, 4099U})
+        {
+            Philox4x32 bulk{99, 7};
+            Philox4x32 scalar{99, 7};
+            for (std::size_t i = 0; i < skip; ++i)
+            {
+                bulk();
+                scalar();
+            }
+
+            std::vector<std::uint32_t> words(count);
+            bulk.Fill(std::span{words});
+            for (const std::uint32_t word : words)
+                REQUIRE(word == scalar());
+
+            std::vector<float> floats(count);
+            bulk.Fill(std::span{floats});
+            for (const float f : floats)
+                REQUIRE(f == UniformFloat(scalar));
+
+            std::vector<std::uint64_t> wide(count);
+            bulk.Fill(std::span{wide});
+            for (const std::uint64_t w : wide)
+                REQUIRE(w == UniformBits64(scalar));
+
+            std::vector<double> doubles(count);
+            bulk.Fill(std::span{doubles});
+            for (const double d : doubles)
+                REQUIRE(d == UniformDouble(scalar));
+
+            REQUIRE(bulk == scalar);
+        }
+    }
+}
+
+TEST_CASE("Philox4x32: bulk normals", "[random]")
+{
+    constexpr std::size_t count{1 << 16};
+    std::vector<float> whole(count);
+    Philox4x32 rng{2024};
+    rng.FillNormal(std::span{whole});
+
+    // splitting the request on a pair boundary does not change the stream
+    std::vector<float> split(count);
+    Philox4x32 other{2024};
+    other.FillNormal(std::span{split}.first(1000));
+    other.FillNormal(std::span{split}.subspan(1000));
+    REQUIRE(whole == split);
+    REQUIRE(rng == other);
+
+    double mean{};
+    double square{};
+    for (const float z : whole)
+    {
+        mean += z;
+        square += static_cast<double>(z) * z;
+    }
+    mean /= count;
+    square /= count;
+    CHECK(std::abs(mean) < 0.02);
+    CHECK(square == Catch::Approx(1.0).margin(0.02));
+
+    // the same pairs through scalar libm
+    Philox4x32 reference{2024};
+    for (std::size_t i = 0; i < 64; i += 2)
+    {
+        const double u1{static_cast<double>((UniformBits32(reference) >> 8U) + 1U) * 0x1.0p-24};
+        const double u2{static_cast<double>(UniformFloat(reference))};
+        const double radius{std::sqrt(-2.0 * std::log(u1))};
+        CHECK(whole[i] == Catch::Approx(radius * std::cos(6.283185307179586 * u2)).margin(1e-5));
+        CHECK(whole[i + 1] == Catch::Approx(radius * std::sin(6.283185307179586 * u2)).margin(1e-5));
+    }
+
+    std::vector<double> odd(1001);
+    Philox4x32 dbl{5};
+    dbl.FillNormal(std::span{odd});
+    Philox4x32 dblReference{5};
+    const double u1{static_cast<double>((UniformBits64(dblReference) >> 11U) + 1U) * 0x1.0p-53};
+    const double u2{UniformDouble(dblReference)};
+    CHECK(odd[0] == Catch::Approx(std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2)).epsilon(1e-12));
+    // 1001 normals consume 501 pairs of two 64-bit draws, the first of which is above
+    for (int i = 0; i < 500 * 4; ++i)
+        dblReference();
+    REQUIRE(dbl == dblReference);
+}
+
+TEST_CASE("Engines: discard skips exactly", "[random]")
+{
+    for (const std::uint64_t count : {0ULL, 1ULL, 3ULL, 4ULL, 5ULL, 1001ULL})
+    {
+        PCG32 pcg{17, 3};
+        PCG32 pcgStep{17, 3};
+        pcg.Discard(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            pcgStep();
+        REQUIRE(pcg == pcgStep);
+
+        SplitMix64 split{17};
+        SplitMix64 splitStep{17};
+        split.Discard(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            splitStep();
+        REQUIRE(split == splitStep);
+
+        Philox4x32 philox{17};
+        Philox4x32 philoxStep{17};
+        philox();
+        philoxStep();
+        philox.Discard(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            philoxStep();
+        REQUIRE(philox() == philoxStep());
+
+        Threefry2x64 threefry{17};
+        Threefry2x64 threefryStep{17};
+        threefry.Discard(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            threefryStep();
+        REQUIRE(threefry() == threefryStep());
+    }
+
+    // the counter carries into the next word
+    Philox4x32 far{1};
+    far.Discard(4ULL << 32U);
+    REQUIRE(far() == Philox4x32::Block({0, 1, 0, 0}, {1, 0})[0]);
+}
+
+TEST_CASE("Engines: jumps and splits", "[random]")
+{
+    // a jump is a power of the transition, so it commutes with stepping
+    Xoshiro256StarStar a{42};
+    Xoshiro256StarStar b{42};
+    a.Jump();
+    a();
+    b();
+    b.Jump();
+    REQUIRE(a == b);
+
+    Xoshiro256StarStar c{42};
+    c.LongJump();
+    REQUIRE(c != Xoshiro256StarStar{42});
+    REQUIRE(c != a);
+}
+
+TEST_CASE("Engines: parent, child and grandchild streams differ", "[random]")
+{
+    const auto check{[]<typename Engine>(const Engine parent)
+                     {
+                         REQUIRE(parent.Split(3) == parent.Split(3));
+
+                         // the first draws of the parent, Split(i) and Split(i).Split(j) for small i and j
+                         const auto head{[](Engine engine)
+                                         {
+                                             std::array<typename Engine::result_type, 4> draws{};
+                                             for (auto& draw : draws)
+                                                 draw = engine();
+                                             return draws;
+                                         }};
+                         std::set<std::array<typename Engine::result_type, 4>> streams{head(parent)};
+                         std::size_t count{1};
+                         for (std::uint64_t i = 0; i < 4; ++i)
+                         {
+                             const Engine child{parent.Split(i)};
+                             streams.insert(head(child));
+                             ++count;
+                             for (std::uint64_t j = 0; j < 4; ++j)
+                             {
+                                 streams.insert(head(child.Split(j)));
+                                 ++count;
+                             }
+                         }
+                         REQUIRE(streams.size() == count);
+
+                         // a child is not the parent at some later position either
+                         Engine walker{parent};
+                         const auto child{head(parent.Split(0))};
+                         for (int i = 0; i < 1000; ++i)
+                         {
+                             REQUIRE(head(walker) != child);
+                             walker();
+                         }
+                     }};
+    check(PCG32{9});
+    check(Xoshiro256StarStar{9});
+    check(Philox4x32{9});
+    check(Threefry2x64{9});
+}
+
+TEST_CASE("RandomStreamPool: streams do not depend on scheduling", "[random]")
+{
+    constexpr std::size_t tasks{64};
+    const RandomStreamPool pool{2025};
+
+    std::array<std::uint64_t, tasks> serial{};
+    for (std::size_t task = 0; task < tasks; ++task)
+    {
+        Philox4x32 rng{pool.Stream(task)};
+        for (int i = 0; i < 1000; ++i)
+            serial[task] += rng();
+    }
+
+    // the same tasks on four threads, each walking the indices in a different order
+    std::array<std::uint64_t, tasks> parallel{};
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t worker = 0; worker < 4; ++worker)
+        {
+            workers.emplace_back(
+                [&, worker]
+                {
+                    for (std::size_t k = 0; k < tasks / 4; ++k)
+                    {
+                        const std::size_t task{(worker % 2 == 0 ? k : tasks / 4 - 1 - k) * 4 + worker};
+                        Philox4x32 rng{pool.Stream(task)};
+                        std::uint64_t sum{};
+                        for (int i = 0; i < 1000; ++i)
+                            sum += rng();
+                        parallel[task] = sum;
+                    }
+                });
+        }
+    }
+    REQUIRE(serial == parallel);
+
+    std::set<std::uint64_t> distinct(serial.begin(), serial.end());
+    REQUIRE(distinct.size() == tasks);
+
+    const RandomStreamPool<Xoshiro256StarStar> xoshiro{2025};
+    REQUIRE(xoshiro.Stream(3) == xoshiro.Stream(3));
+    REQUIRE(xoshiro.Stream(3) != xoshiro.Stream(4));
+}
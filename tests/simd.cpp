@@ -162,6 +162,70 @@ static_assert(ls == 1.0f * 1.0f + 5.0f * 5.0f + -3.0f * -3.0f + 8.0f * 8.0f);
 
 } // namespace check_ops
 
+namespace check_mask
+{
+
+static_assert(sizeof(raw_f32x16) == 64);
+static_assert(sizeof(raw_i32x16) == 64);
+static_assert(sizeof(raw_f64x8) == 64);
+static_assert(sizeof(mask16) == 2);
+static_assert(sizeof(mask8) == 1);
+
+constexpr f32x16 a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+constexpr mask16 odd = to_mask(a.r > f32x16::splat(7.5f).r);
+static_assert(odd.bits == 0xFF00);
+static_assert(odd.count() == 8 && odd.any() && !odd.all());
+static_assert((~odd).bits == 0x00FF);
+static_assert(mask16::first(3).bits == 0x0007);
+static_assert(mask16::first(16).all());
+static_assert(mask4::first(0).none());
+
+constexpr f32x16 picked = select(odd, a, f32x16::splat(-1.0f));
+static_assert(picked[7] == -1.0f && picked[8] == 8.0f && picked[15] == 15.0f);
+
+constexpr u8x16 bytes = u8x16::splat(1);
+constexpr u8x16 picked_bytes = select(mask16::from_bits(0x8001), bytes, u8x16::splat(0));
+static_assert(picked_bytes[0] == 1 && picked_bytes[1] == 0 && picked_bytes[15] == 1);
+
+} // namespace check_mask
+
+namespace check_horizontal
+{
+
+constexpr f32x8 a{3.0f, -1.0f, 4.0f, 1.0f, -5.0f, 9.0f, 2.0f, 6.0f};
+static_assert(reduce_add(a) == 19.0f);
+static_assert(reduce_min(a) == -5.0f && argmin(a) == 4);
+static_assert(reduce_max(a) == 9.0f && argmax(a) == 5);
+static_assert(argmax(i32x4{7, 2, 7, 1}) == 0);
+
+constexpr i32x8 counts{1, 2, 3, 4, 5, 6, 7, 8};
+constexpr i32x8 inclusive = inclusive_scan(counts);
+constexpr i32x8 exclusive = exclusive_scan(counts);
+static_assert(inclusive[0] == 1 && inclusive[3] == 10 && inclusive[7] == 36);
+static_assert(exclusive[0] == 0 && exclusive[3] == 6 && exclusive[7] == 28);
+
+constexpr f32x4 q{1.0f, 2.0f, 3.0f, 4.0f};
+constexpr f32x4 r{5.0f, 6.0f, 7.0f, 8.0f};
+constexpr f32x4 reversed = shuffle<3, 2, 1, 0>(q);
+static_assert(reversed[0] == 4.0f && reversed[3] == 1.0f);
+constexpr f32x4 mixed = shuffle<0, 4, 3, 7>(q, r);
+static_assert(mixed[0] == 1.0f && mixed[1] == 5.0f && mixed[2] == 4.0f && mixed[3] == 8.0f);
+constexpr f32x4 blended = blend<0b0101>(q, r);
+static_assert(blended[0] == 5.0f && blended[1] == 2.0f && blended[2] == 7.0f && blended[3] == 4.0f);
+constexpr f32x4 permuted = permute(q, i32x4{2, 2, 0, 5});
+static_assert(permuted[0] == 3.0f && permuted[1] == 3.0f && permuted[2] == 1.0f && permuted[3] == 2.0f);
+
+constexpr auto zipped = interleave(q, r);
+static_assert(zipped[0][0] == 1.0f && zipped[0][1] == 5.0f && zipped[0][2] == 2.0f && zipped[1][0] == 3.0f && zipped[1][3] == 8.0f);
+constexpr auto unzipped = deinterleave(zipped[0], zipped[1]);
+static_assert(unzipped[0][2] == 3.0f && unzipped[1][2] == 7.0f);
+
+static_assert(movemask(q.r > f32x4::splat(2.5f).r) == 0b1100);
+static_assert(any(q.r > f32x4::splat(3.5f).r) && !all(q.r > f32x4::splat(3.5f).r));
+static_assert(popcount(a.r > f32x8::splat(0.0f).r) == 6);
+
+} // namespace check_horizontal
+
 // ===========================================================================
 // Runtime checks (Catch2)
 // ===========================================================================
@@ -454,3 +518,334 @@ TEST_CASE("normalize produces a unit-length vector", "[ops][normalize]")
     CHECK(n[0] == Catch::Approx(0.6f));
     CHECK(n[1] == Catch::Approx(0.8f));
 }
+
+TEST_CASE("16-lane vectors match narrower semantics", "[vec][f32x16]")
+{
+    const f32x16 a{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const f32x16 b = f32x16::splat(17.0f) - a;
+    const f32x16 sum = a + b;
+    for (int i = 0; i < 16; ++i)
+        CHECK(sum[i] == 17.0f);
+
+    const f32x16 roots = sqrt(a * a);
+    const f32x16 neg   = abs(-a);
+    for (int i = 0; i < 16; ++i)
+    {
+        CHECK(roots[i] == Catch::Approx(a[i]));
+        CHECK(neg[i] == a[i]);
+    }
+
+    const f64x8 d = f64x8::splat(0.5) * f64x8{2, 4, 6, 8, 10, 12, 14, 16};
+    CHECK(d[0] == 1.0);
+    CHECK(d[7] == 8.0);
+
+    const i32x16 ints = i32x16::splat(3) * i32x16::splat(-2);
+    CHECK(ints[15] == -6);
+}
+
+TEST_CASE("masked load/store touch only selected lanes", "[vec][mask]")
+{
+    float src[16];
+    float dst[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        src[i] = static_cast<float>(i);
+        dst[i] = -1.0f;
+    }
+
+    SECTION("load_masked keeps the fallback in unselected lanes")
+    {
+        const f32x16 v = load_masked(src, mask16::first(5), f32x16::splat(42.0f));
+        CHECK(v[0] == 0.0f);
+        CHECK(v[4] == 4.0f);
+        CHECK(v[5] == 42.0f);
+        CHECK(v[15] == 42.0f);
+    }
+    SECTION("store_masked leaves unselected memory untouched")
+    {
+        store_masked(dst, mask16::from_bits(0x8001), f32x16::load(src));
+        CHECK(dst[0] == 0.0f);
+        CHECK(dst[1] == -1.0f);
+        CHECK(dst[14] == -1.0f);
+        CHECK(dst[15] == 15.0f);
+    }
+    SECTION("integer lanes")
+    {
+        std::int32_t ints[16]{};
+        store_masked(ints, mask16::first(2), i32x16::splat(9));
+        CHECK(ints[0] == 9);
+        CHECK(ints[1] == 9);
+        CHECK(ints[2] == 0);
+
+        const i32x8 narrow = load_masked(ints, mask8::first(1), i32x8::splat(-3));
+        CHECK(narrow[0] == 9);
+        CHECK(narrow[1] == -3);
+    }
+}
+
+TEST_CASE("compress_store packs selected lanes in order", "[vec][mask]")
+{
+    const f32x16 values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const mask16 keep = to_mask(values.r > f32x16::splat(9.5f).r) | mask16::from_bits(0x0005);
+
+    float out[16]{};
+    const int written = compress_store(out, keep, values);
+    REQUIRE(written == 8);
+    const float expected[8]{0, 2, 10, 11, 12, 13, 14, 15};
+    for (int i = 0; i < written; ++i)
+        CHECK(out[i] == expected[i]);
+    CHECK(out[8] == 0.0f);
+
+    std::int32_t ids[8]{};
+    const int kept = compress_store(ids, mask8::from_bits(0b10100010), i32x8{10, 11, 12, 13, 14, 15, 16, 17});
+    REQUIRE(kept == 3);
+    CHECK(ids[0] == 11);
+    CHECK(ids[1] == 15);
+    CHECK(ids[2] == 17);
+}
+
+TEST_CASE("load_partial/store_partial stay inside the tail", "[vec][load][store]")
+{
+    const float src[3]{1.0f, 2.0f, 3.0f};
+    const f32x8 v = f32x8::load_partial(src, 3, -1.0f);
+    CHECK(v[0] == 1.0f);
+    CHECK(v[2] == 3.0f);
+    CHECK(v[3] == -1.0f);
+    CHECK(v[7] == -1.0f);
+
+    float dst[4]{0.0f, 0.0f, 0.0f, 9.0f};
+    v.store_partial(dst, 3);
+    CHECK(dst[2] == 3.0f);
+    CHECK(dst[3] == 9.0f);
+
+    const f32x16 wide = f32x16::load_partial(src, 2);
+    CHECK(wide[1] == 2.0f);
+    CHECK(wide[2] == 0.0f);
+}
+
+TEST_CASE("gather/scatter follow the index vector", "[vec][gather]")
+{
+    float table[32];
+    double wide[32];
+    std::int32_t ints[32];
+    for (int i = 0; i < 32; ++i)
+    {
+        table[i] = static_cast<float>(i) * 0.5f;
+        wide[i]  = static_cast<double>(i) * 2.0;
+        ints[i]  = 100 + i;
+    }
+
+    const i32x8 idx8{31, 0, 7, 7, 12, 3, 20, 1};
+    const f32x8 g8 = gather(table, idx8);
+    const i32x8 gi = gather(ints, idx8);
+    for (int i = 0; i < 8; ++i)
+    {
+        CHECK(g8[i] == table[idx8[i]]);
+        CHECK(gi[i] == ints[idx8[i]]);
+    }
+
+    const i32x4 idx4{5, 1, 30, 2};
+    const f64x4 gd = gather(wide, idx4);
+    const f32x4 g4 = gather(table, idx4);
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(gd[i] == wide[idx4[i]]);
+        CHECK(g4[i] == table[idx4[i]]);
+    }
+
+    const i32x16 idx16{0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30};
+    const f32x16 g16 = gather(table, idx16);
+    CHECK(g16[15] == 15.0f);
+
+    float out[32]{};
+    scatter(out, idx16, g16);
+    CHECK(out[30] == 15.0f);
+    CHECK(out[31] == 0.0f);
+
+    std::int32_t intOut[8]{};
+    scatter(intOut, i32x4{3, 1, 3, 0}, i32x4{1, 2, 3, 4});
+    CHECK(intOut[3] == 3); // highest lane wins on duplicates
+    CHECK(intOut[1] == 2);
+    CHECK(intOut[0] == 4);
+}
+
+TEST_CASE("load3/store3 deinterleave xyz triples", "[vec][load][store]")
+{
+    float aos[24];
+    for (int i = 0; i < 24; ++i)
+        aos[i] = static_cast<float>(i);
+
+    const auto [x, y, z] = load3<f32x8>(aos);
+    for (int i = 0; i < 8; ++i)
+    {
+        CHECK(x[i] == static_cast<float>(3 * i));
+        CHECK(y[i] == static_cast<float>(3 * i + 1));
+        CHECK(z[i] == static_cast<float>(3 * i + 2));
+    }
+
+    float back[24]{};
+    store3(back, x, y, z);
+    for (int i = 0; i < 24; ++i)
+        CHECK(back[i] == aos[i]);
+}
+
+TEST_CASE("stream stores land in memory after the fence", "[vec][store]")
+{
+    alignas(64) float f[16]{};
+    alignas(64) std::int32_t n[8]{};
+    alignas(64) double d[2]{};
+
+    stream(f, f32x16::splat(2.0f));
+    stream(f, f32x4{1.0f, 2.0f, 3.0f, 4.0f});
+    stream(n, i32x8::splat(7));
+    stream(d, f64x2{0.5, 1.5});
+    stream_fence();
+
+    CHECK(f[0] == 1.0f);
+    CHECK(f[3] == 4.0f);
+    CHECK(f[4] == 2.0f);
+    CHECK(f[15] == 2.0f);
+    CHECK(n[7] == 7);
+    CHECK(d[1] == 1.5);
+}
+
+TEST_CASE("horizontal reductions fold every lane", "[vec][reduce]")
+{
+    SECTION("all widths agree with a scalar loop")
+    {
+        f32x16 v;
+        float sum = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            v[i] = static_cast<float>((i * 7) % 11) - 3.0f;
+            sum += v[i];
+        }
+        CHECK(reduce_add(v) == sum);
+        CHECK(reduce_min(v) == -3.0f);
+        CHECK(argmin(v) == 0);
+        CHECK(reduce_max(v) == 7.0f);
+        CHECK(argmax(v) == 3);
+        CHECK(reduce_add(f64x2{0.25, 0.5}) == 0.75);
+        CHECK(reduce_max(u8x16::splat(3)) == 3);
+    }
+
+#if !defined(__FAST_MATH__)
+    SECTION("argmin reports N when the minimum is NaN")
+    {
+        constexpr float nan{std::numeric_limits<float>::quiet_NaN()};
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            f32x4 v{1.0f, 2.0f, 3.0f, 4.0f};
+            v[lane] = nan;
+            CHECK(std::isnan(reduce_min(v)));
+            CHECK(std::isnan(reduce_max(v)));
+            CHECK(argmin(v) == 4);
+            CHECK(argmax(v) == 4);
+        }
+        f32x16 wide{f32x16::splat(1.0f)};
+        wide[11] = nan;
+        CHECK(argmin(wide) == 16);
+        CHECK(argmax(wide) == 16);
+    }
+#endif
+}
+
+TEST_CASE("prefix sums carry across a loop", "[vec][scan]")
+{
+    std::int32_t input[32];
+    std::int32_t output[32];
+    for (int i = 0; i < 32; ++i)
+        input[i] = i % 5;
+
+    i32x8 carry{};
+    for (int i = 0; i < 32; i += 8)
+    {
+        const i32x8 scanned = inclusive_scan(i32x8::load(input + i)) + carry;
+        scanned.store(output + i);
+        carry = i32x8::splat(scanned[7]);
+    }
+
+    std::int32_t expected = 0;
+    for (int i = 0; i < 32; ++i)
+    {
+        expected += input[i];
+        CHECK(output[i] == expected);
+    }
+
+    const f32x16 ones = f32x16::splat(1.0f);
+    const f32x16 ex   = exclusive_scan(ones);
+    for (int i = 0; i < 16; ++i)
+        CHECK(ex[i] == static_cast<float>(i));
+}
+
+TEST_CASE("shuffles and compare queries at runtime", "[vec][shuffle]")
+{
+    f32x8 a;
+    f32x8 b;
+    for (int i = 0; i < 8; ++i)
+    {
+        a[i] = static_cast<float>(i);
+        b[i] = static_cast<float>(10 + i);
+    }
+
+    const f32x8 rotated = shuffle<1, 2, 3, 4, 5, 6, 7, 0>(a);
+    CHECK(rotated[0] == 1.0f);
+    CHECK(rotated[7] == 0.0f);
+
+    const f32x8 blended = blend<0xF0>(a, b);
+    CHECK(blended[3] == 3.0f);
+    CHECK(blended[4] == 14.0f);
+
+    i32x8 reverse;
+    for (int i = 0; i < 8; ++i)
+        reverse[i] = 7 - i;
+    const f32x8 permuted = permute(a, reverse);
+    for (int i = 0; i < 8; ++i)
+        CHECK(permuted[i] == a[7 - i]);
+
+    const auto [lo, hi] = interleave(a, b);
+    CHECK(lo[0] == 0.0f);
+    CHECK(lo[1] == 10.0f);
+    CHECK(hi[0] == 4.0f);
+    CHECK(hi[7] == 17.0f);
+    const auto [even, odd] = deinterleave(lo, hi);
+    for (int i = 0; i < 8; ++i)
+    {
+        CHECK(even[i] == a[i]);
+        CHECK(odd[i] == b[i]);
+    }
+
+    const auto above = a.r > f32x8::splat(4.5f).r;
+    CHECK(movemask(above) == 0xE0u);
+    CHECK(popcount(above) == 3);
+    CHECK(any(above));
+    CHECK_FALSE(all(above));
+    CHECK(all(a.r >= f32x8::splat(0.0f).r));
+    CHECK(movemask(f64x4{1.0, -1.0, 2.0, -2.0}.r < f64x4::splat(0.0).r) == 0b1010u);
+    CHECK(movemask(u8x16::splat(9).r == u8x16::splat(9).r) == 0xFFFFu);
+    CHECK(to_mask(above).bits == 0xE0);
+}
+
+TEST_CASE("mul_wide returns both halves of every lane product", "[vec][mul]")
+{
+    u32x8 a;
+    u32x8 b;
+    for (int i = 0; i < 8; ++i)
+    {
+        a[i] = 0xFFFFFFFFu - static_cast<std::uint32_t>(i) * 0x01234567u;
+        b[i] = 0xD2511F53u + static_cast<std::uint32_t>(i) * 977u;
+    }
+    const auto [hi, lo] = mul_wide(a, b);
+    for (int i = 0; i < 8; ++i)
+    {
+        const std::uint64_t product = static_cast<std::uint64_t>(a[i]) * b[i];
+        CHECK(hi[i] == static_cast<std::uint32_t>(product >> 32));
+        CHECK(lo[i] == static_cast<std::uint32_t>(product));
+    }
+
+    const auto [hi4, lo4] = mul_wide(u32x4{1u, 2u, 0x80000000u, 0xFFFFFFFFu}, u32x4::splat(0xFFFFFFFFu));
+    CHECK(hi4[3] == 0xFFFFFFFEu);
+    CHECK(lo4[3] == 1u);
+    CHECK(hi4[2] == 0x7FFFFFFFu);
+    CHECK(lo4[0] == 0xFFFFFFFFu);
+}
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+
+using namespace fawn_algebra;
+using namespace fawn_algebra::simd;
+
+namespace
+{
+#if defined(__FAST_MATH__)
+// reciprocal division and free contraction cost up to 1.5 ulp extra in the float kernels
+constexpr double slack{1.5};
+#else
+constexpr double slack{0.0};
+#endif
+
+// distance to the libm reference in units of the spacing of T at the reference;
+// both sides are scaled to [1, 2) first, so flush-to-zero builds measure the same
+template <typename T>
+double UlpError(const T result, const double reference)
+{
+    const int exponent{std::max(std::ilogb(static_cast<T>(reference)), std::numeric_limits<T>::min_exponent - 1)};
+    const double scaled{std::abs(std::ldexp(static_cast<double>(result), -exponent) - std::ldexp(reference, -exponent))};
+    return scaled * std::ldexp(1.0, std::numeric_limits<T>::digits - 1);
+}
+
+// evenly spaced samples over [lo, hi], processed 8 lanes at a time
+template <typename Fn, typename Ref>
+double MaxUlpF(const float lo, const float hi, const int count, Fn fn, Ref ref)
+{
+    double worst{};
+    for (int i = 0; i < count; i += 8)
+    {
+        f32x8 x;
+        for (int l = 0; l < 8; ++l)
+            x[l] = lo + (hi - lo) * static_cast<float>(i + l) / static_cast<float>(count);
+        const f32x8 y{fn(x)};
+        for (int l = 0; l < 8; ++l)
+            worst = std::max(worst, UlpError(y[l], ref(static_cast<double>(x[l]))));
+    }
+    return worst;
+}
+
+template <typename Fn, typename Ref>
+double MaxAbsF(const float lo, const float hi, const int count, Fn fn, Ref ref)
+{
+    double worst{};
+    for (int i = 0; i < count; i += 8)
+    {
+        f32x8 x;
+        for (int l = 0; l < 8; ++l)
+            x[l] = lo + (hi - lo) * static_cast<float>(i + l) / static_cast<float>(count);
+        const f32x8 y{fn(x)};
+        for (int l = 0; l < 8; ++l)
+            worst = std::max(worst, std::abs(static_cast<double>(y[l]) - ref(static_cast<double>(x[l]))));
+    }
+    return worst;
+}
+
+template <typename Fn, typename Ref>
+double MaxUlpD(const double lo, const double hi, const int count, Fn fn, Ref ref)
+{
+    double worst{};
+    for (int i = 0; i < count; i += 4)
+    {
+        f64x4 x;
+        for (int l = 0; l < 4; ++l)
+            x[l] = lo + (hi - lo) * static_cast<double>(i + l) / static_cast<double>(count);
+        const f64x4 y{fn(x)};
+        for (int l = 0; l < 4; ++l)
+            worst = std::max(worst, UlpError(y[l], ref(x[l])));
+    }
+    return worst;
+}
+} // namespace
+
+TEST_CASE("simd math float accuracy", "[simd][math]")
+{
+    constexpr int count{1 << 18};
+
+    SECTION("sin cos")
+    {
+        CHECK(MaxUlpF(-8192.0F, 8192.0F, count, [](f32x8 x) { return sin(x); }, [](double x) { return std::sin(x); }) <= 2.5 + slack);
+        CHECK(MaxUlpF(-8192.0F, 8192.0F, count, [](f32x8 x) { return cos(x); }, [](double x) { return std::cos(x); }) <= 2.5 + slack);
+        CHECK(MaxUlpF(-4.0F, 4.0F, count, [](f32x8 x) { return sin(x); }, [](double x) { return std::sin(x); }) <= 2.0 + slack);
+
+        const auto [s, c] = sincos(f32x4{0.5F, -1.0F, 3.0F, 100.0F});
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(s[i] == sin(f32x4{0.5F, -1.0F, 3.0F, 100.0F})[i]);
+            CHECK(c[i] == cos(f32x4{0.5F, -1.0F, 3.0F, 100.0F})[i]);
+        }
+    }
+
+    SECTION("tan")
+    {
+        CHECK(MaxUlpF(-8192.0F, 8192.0F, count, [](f32x8 x) { return tan(x); }, [](double x) { return std::tan(x); }) <= 4.0 + slack);
+    }
+
+    SECTION("asin acos atan")
+    {
+        CHECK(MaxUlpF(-1.0F, 1.0F, count, [](f32x8 x) { return asin(x); }, [](double x) { return std::asin(x); }) <= 2.0 + slack);
+        CHECK(MaxUlpF(-1.0F, 1.0F, count, [](f32x8 x) { return acos(x); }, [](double x) { return std::acos(x); }) <= 2.0 + slack);
+        CHECK(MaxUlpF(-100.0F, 100.0F, count, [](f32x8 x) { return atan(x); }, [](double x) { return std::atan(x); }) <= 3.0 + slack);
+    }
+
+    SECTION("atan2")
+    {
+        double worst{};
+        for (int i = -64; i <= 64; ++i)
+        {
+            for (int j = -64; j <= 64; j += 8)
+            {
+                f32x8 y{f32x8::splat(static_cast<float>(i) * 0.37F)};
+                f32x8 x;
+                for (int l = 0; l < 8; ++l)
+                    x[l] = static_cast<float>(j + l) * 0.29F;
+                const f32x8 r{atan2(y, x)};
+                for (int l = 0; l < 8; ++l)
+                {
+                    if (x[l] == 0.0F && y[l] == 0.0F)
+                        CHECK(r[l] == 0.0F);
+                    else
+                        worst = std::max(worst, UlpError(r[l], std::atan2(static_cast<double>(y[l]), static_cast<double>(x[l]))));
+                }
+            }
+        }
+        CHECK(worst <= 3.0 + slack);
+    }
+
+    SECTION("exp exp2")
+    {
+        CHECK(MaxUlpF(-87.0F, 88.5F, count, [](f32x8 x) { return exp(x); }, [](double x) { return std::exp(x); }) <= 2.0 + slack);
+        CHECK(MaxUlpF(-126.0F, 127.9F, count, [](f32x8 x) { return exp2(x); }, [](double x) { return std::exp2(x); }) <= 2.0 + slack);
+
+        const f32x4 edges{exp(f32x4{0.0F, 100.0F, -200.0F, 1.0F})};
+        CHECK(edges[0] == 1.0F);
+        CHECK(edges[2] == 0.0F);
+        CHECK(edges[3] == Catch::Approx(2.718281828F));
+#if !defined(__FAST_MATH__)
+        CHECK(std::isinf(edges[1]));
+#endif
+    }
+
+    SECTION("log log2")
+    {
+        CHECK(MaxUlpF(1e-3F, 1e3F, count, [](f32x8 x) { return log(x); }, [](double x) { return std::log(x); }) <= 2.0 + slack);
+        CHECK(MaxUlpF(0.5F, 2.0F, count, [](f32x8 x) { return log(x); }, [](double x) { return std::log(x); }) <= 2.0 + slack);
+        CHECK(MaxUlpF(1e-3F, 1e3F, count, [](f32x8 x) { return log2(x); }, [](double x) { return std::log2(x); }) <= 2.0 + slack);
+
+#if !defined(__FAST_MATH__)
+        // denormal inputs, which flush-to-zero builds read as 0
+        const f32x4 tiny{1e-40F, 1e-45F, 3e-39F, std::numeric_limits<float>::min()};
+        const f32x4 l{log(tiny)};
+        for (int i = 0; i < 4; ++i)
+            CHECK(UlpError(l[i], std::log(static_cast<double>(tiny[i]))) <= 2.0);
+#endif
+    }
+
+    SECTION("pow")
+    {
+        double worst{};
+        for (int i = 1; i <= 256; ++i)
+        {
+            const f32x8 x{f32x8::splat(static_cast<float>(i) * 0.0625F)};
+            const f32x8 y{-4.0F, -1.5F, -0.5F, 0.25F, 1.0F, 2.5F, 3.0F, 7.0F};
+            const f32x8 r{pow(x, y)};
+            for (int l = 0; l < 8; ++l)
+            {
+                const double ref = std::pow(static_cast<double>(x[l]), static_cast<double>(y[l]));
+                const double bound{2.0 + std::abs(static_cast<double>(y[l]) * std::log2(static_cast<double>(x[l]))) * 2.0};
+                worst = std::max(worst, UlpError(r[l], ref) / bound);
+            }
+        }
+        CHECK(worst <= 1.0);
+
+        const f32x8 special{pow(f32x8{-2.0F, -2.0F, -2.0F, 0.0F, 0.0F, 0.0F, 5.0F, 1.0F}, f32x8{3.0F, 2.0F, 0.5F, 2.0F, -1.0F, 0.0F, 0.0F, 1e6F})};
+        CHECK(special[0] == Catch::Approx(-8.0F));
+        CHECK(special[1] == Catch::Approx(4.0F));
+        CHECK(special[3] == 0.0F);
+        CHECK(special[5] == 1.0F);
+        CHECK(special[6] == 1.0F);
+        CHECK(special[7] == 1.0F);
+#if !defined(__FAST_MATH__)
+        CHECK(std::isnan(special[2]));
+        CHECK(std::isinf(special[4]));
+#endif
+    }
+}
+
+TEST_CASE("simd math double accuracy", "[simd][math]")
+{
+    constexpr int count{1 << 16};
+
+    CHECK(MaxUlpD(-8192.0, 8192.0, count, [](f64x4 x) { return sin(x); }, [](double x) { return std::sin(x); }) <= 2.0);
+    CHECK(MaxUlpD(-8192.0, 8192.0, count, [](f64x4 x) { return cos(x); }, [](double x) { return std::cos(x); }) <= 2.0);
+    CHECK(MaxUlpD(-700.0, 700.0, count, [](f64x4 x) { return exp(x); }, [](double x) { return std::exp(x); }) <= 2.0);
+    CHECK(MaxUlpD(1e-6, 1e6, count, [](f64x4 x) { return log(x); }, [](double x) { return std::log(x); }) <= 2.0);
+    CHECK(MaxUlpD(0.5, 2.0, count, [](f64x4 x) { return log(x); }, [](double x) { return std::log(x); }) <= 2.0);
+
+    const f64x2 p{pow(f64x2{2.0, -3.0}, f64x2{10.0, 3.0})};
+    CHECK(p[0] == Catch::Approx(1024.0));
+    CHECK(p[1] == Catch::Approx(-27.0));
+}
+
+TEST_CASE("simd math fast variants", "[simd][math]")
+{
+    constexpr int count{1 << 18};
+
+    CHECK(MaxAbsF(-1e4F, 1e4F, count, [](f32x8 x) { return fast_sin(x); }, [](double x) { return std::sin(x); }) <= 2e-4);
+    CHECK(MaxAbsF(-1e4F, 1e4F, count, [](f32x8 x) { return fast_cos(x); }, [](double x) { return std::cos(x); }) <= 2e-4);
+    CHECK(MaxAbsF(1e-3F, 1e3F, count, [](f32x8 x) { return fast_log2(x); }, [](double x) { return std::log2(x); }) <= 2e-4);
+    CHECK(MaxAbsF(1e-3F, 1e3F, count, [](f32x8 x) { return fast_log(x); }, [](double x) { return std::log(x); }) <= 2e-4);
+
+    double worst{};
+    for (int i = 0; i < count; i += 8)
+    {
+        f32x8 x;
+        for (int l = 0; l < 8; ++l)
+            x[l] = -80.0F + 160.0F * static_cast<float>(i + l) / static_cast<float>(count);
+        const f32x8 e{fast_exp(x)};
+        const f32x8 e2{fast_exp2(x)};
+        for (int l = 0; l < 8; ++l)
+        {
+            worst = std::max(worst, std::abs(static_cast<double>(e[l]) / std::exp(static_cast<double>(x[l])) - 1.0));
+            worst = std::max(worst, std::abs(static_cast<double>(e2[l]) / std::exp2(static_cast<double>(x[l])) - 1.0));
+        }
+    }
+    CHECK(worst <= 2e-4);
+}
@@ -0,0 +1,379 @@
+//
+// Copyright (c) 2026.
+// Author: Joran.
+//
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+import FawnAlgebra;
+import std;
+using namespace fawn_algebra;
+
+namespace
+{
+std::vector<std::uint64_t> RandomKeys(const std::size_t count, const std::uint64_t seed)
+{
+    Xoshiro256StarStar rng(seed);
+    std::vector<std::uint64_t> keys(count);
+    for (std::uint64_t& key : keys)
+    {
+        key = rng();
+    }
+    return keys;
+}
+} // namespace
+
+TEST_CASE("Sketches: BloomFilter", "[sketches]")
+{
+    const std::vector<std::uint64_t> keys{RandomKeys(100000, 1)};
+    const std::vector<std::uint64_t> others{RandomKeys(100000, 2)};
+    BloomFilter filter{keys.size(), 0.01, 7};
+    REQUIRE(BloomFilter::FalsePositiveRate(keys.size(), filter.Blocks()) <= 0.01);
+    REQUIRE(BloomFilter::FalsePositiveRate(keys.size(), filter.Blocks() - 1) > 0.01);
+    REQUIRE(filter.Bytes() == filter.Blocks() * 32);
+
+    SECTION("no false negatives, about the asked false positive rate")
+    {
+        filter.InsertBatch(std::span<const std::uint64_t>{keys});
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            REQUIRE(filter.Contains(keys[i]));
+        }
+        std::size_t falsePositives{};
+        for (const std::uint64_t key : others)
+        {
+            falsePositives += filter.Contains(key) ? 1 : 0;
+        }
+        const double rate{static_cast<double>(falsePositives) / static_cast<double>(others.size())};
+        REQUIRE(rate > 0.006);
+        REQUIRE(rate < 0.0115);
+
+        // the batch query agrees key by key
+        auto flags{std::make_unique<bool[]>(others.size())};
+        REQUIRE(filter.ContainsBatch(std::span<const std::uint64_t>{others}, std::span{flags.get(), others.size()}) == falsePositives);
+        for (std::size_t i = 0; i < others.size(); ++i)
+        {
+            REQUIRE(flags[i] == filter.Contains(others[i]));
+        }
+    }
+    SECTION("batch insert sets the same bits as single inserts")
+    {
+        BloomFilter single{keys.size(), 0.01, 7};
+        for (const std::uint64_t key : keys)
+        {
+            single.Insert(key);
+        }
+        filter.InsertBatch(std::span<const std::uint64_t>{keys});
+        REQUIRE(single.Serialize() == filter.Serialize());
+    }
+    SECTION("strings")
+    {
+        filter.Insert("position");
+        filter.Insert(std::string{"normal"});
+        REQUIRE(filter.Contains(std::string_view{"position"}));
+        REQUIRE(filter.Contains("normal"));
+        REQUIRE(filter.ContainsHash(Hash64(std::string_view{"normal"}, 7)));
+    }
+    SECTION("merge is the union")
+    {
+        BloomFilter left{keys.size(), 0.01, 7};
+        BloomFilter right{keys.size(), 0.01, 7};
+        left.InsertBatch(std::span<const std::uint64_t>{keys}.first(50000));
+        right.InsertBatch(std::span<const std::uint64_t>{keys}.subspan(50000));
+        REQUIRE(left.Merge(right));
+        filter.InsertBatch(std::span<const std::uint64_t>{keys});
+        REQUIRE(left.Serialize() == filter.Serialize());
+        REQUIRE_FALSE(left.Merge(BloomFilter{keys.size(), 0.01, 8}));
+        REQUIRE_FALSE(left.Merge(BloomFilter{keys.size(), 0.001, 7}));
+    }
+    SECTION("serialisation")
+    {
+        filter.InsertBatch(std::span<const std::uint64_t>{keys});
+        const std::vector<std::byte> bytes{filter.Serialize()};
+        REQUIRE(bytes.size() == 24 + filter.Bytes());
+        const std::optional<BloomFilter> copy{BloomFilter::Deserialize(bytes)};
+        REQUIRE(copy.has_value());
+        REQUIRE(copy->Seed() == 7);
+        REQUIRE(copy->Contains(keys[123]));
+        REQUIRE(copy->Serialize() == bytes);
+        REQUIRE_FALSE(BloomFilter::Deserialize(std::span{bytes}.first(bytes.size() - 1)).has_value());
+        REQUIRE_FALSE(HyperLogLog::Deserialize(bytes).has_value());
+        REQUIRE_FALSE(BloomFilter::Deserialize({}).has_value());
+    }
+}
+
+TEST_CASE("Sketches: CountMinSketch", "[sketches]")
+{
+    CountMinSketch sketch{0.001, 0.01, 3};
+    REQUIRE(sketch.Width() == 4096);
+    REQUIRE(sketch.Depth() == 5);
+
+    // Zipf-like stream: key k appears 10000 / k times
+    std::vector<std::uint32_t> stream;
+    for (std::uint32_t key = 1; key <= 5000; ++key)
+    {
+        stream.insert(stream.end(), 10000 / key, key);
+    }
+    sketch.AddBatch(std::span<const std::uint32_t>{stream});
+    REQUIRE(sketch.TotalCount() == stream.size());
+
+    SECTION("never under, rarely over by more than epsilon * total")
+    {
+        std::size_t beyond{};
+        for (std::uint32_t key = 1; key <= 5000; ++key)
+        {
+            const std::uint64_t estimate{sketch.Estimate(key)};
+            REQUIRE(estimate >= 10000 / key);
+            beyond += estimate - 10000 / key > static_cast<std::uint64_t>(0.001 * static_cast<double>(stream.size())) ? 1 : 0;
+        }
+        REQUIRE(beyond <= 50);
+        REQUIRE(sketch.Estimate(1U) < 10000 + 100);
+
+        std::vector<std::uint64_t> estimates(5000);
+        std::vector<std::uint32_t> keys(5000);
+        std::iota(keys.begin(), keys.end(), 1U);
+        sketch.EstimateBatch(std::span<const std::uint32_t>{keys}, std::span{estimates});
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            REQUIRE(estimates[i] == sketch.Estimate(keys[i]));
+        }
+    }
+    SECTION("merge adds")
+    {
+        CountMinSketch other{0.001, 0.01, 3};
+        other.Add(std::string_view{"frame"}, 40);
+        other.Add(std::uint32_t{1}, 5);
+        const std::uint64_t before{sketch.Estimate(std::uint32_t{1})};
+        REQUIRE(sketch.Merge(other));
+        REQUIRE(sketch.Estimate(std::uint32_t{1}) == before + 5);
+        REQUIRE(sketch.Estimate("frame") >= 40);
+        REQUIRE(sketch.TotalCount() == stream.size() + 45);
+        REQUIRE_FALSE(sketch.Merge(CountMinSketch{0.01, 0.01, 3}));
+    }
+    SECTION("serialisation")
+    {
+        const std::vector<std::byte> bytes{sketch.Serialize()};
+        const std::optional<CountMinSketch> copy{CountMinSketch::Deserialize(bytes)};
+        REQUIRE(copy.has_value());
+        REQUIRE(copy->TotalCount() == sketch.TotalCount());
+        REQUIRE(copy->Estimate(std::uint32_t{7}) == sketch.Estimate(std::uint32_t{7}));
+        REQUIRE_FALSE(CountMinSketch::Deserialize(std::span{bytes}.first(100)).has_value());
+    }
+}
+
+TEST_CASE("Sketches: HyperLogLog", "[sketches]")
+{
+    HyperLogLog sketch{12, 5};
+    REQUIRE(sketch.Estimate() == 0.0);
+    sketch.Add("one");
+    REQUIRE(sketch.Estimate() == Catch::Approx(1.0).margin(0.01));
+
+    SECTION("within a few standard errors from small to large counts")
+    {
+        HyperLogLog counter{12, 5};
+        Xoshiro256StarStar rng(11);
+        std::size_t added{};
+        for (const std::size_t target : {std::size_t{100}, std::size_t{3000}, std::size_t{40000}, std::size_t{1000000}})
+        {
+            for (; added < target; ++added)
+            {
+                counter.Add(rng());
+            }
+            const double error{std::abs(counter.Estimate() / static_cast<double>(target) - 1.0)};
+            REQUIRE(error < 4.0 * counter.StandardError());
+        }
+    }
+    SECTION("duplicates and merge")
+    {
+        const std::vector<std::uint64_t> keys{RandomKeys(50000, 3)};
+        HyperLogLog left{12, 5};
+        HyperLogLog right{12, 5};
+        left.AddBatch(std::span<const std::uint64_t>{keys}.first(30000));
+        right.AddBatch(std::span<const std::uint64_t>{keys}.subspan(20000));
+        // twice the same keys is the same sketch
+        HyperLogLog twice{right};
+        twice.AddBatch(std::span<const std::uint64_t>{keys}.subspan(20000));
+        REQUIRE(twice.Serialize() == right.Serialize());
+
+        REQUIRE(left.Merge(right));
+        HyperLogLog all{12, 5};
+        for (const std::uint64_t key : keys)
+        {
+            all.Add(key);
+        }
+        REQUIRE(left.Serialize() == all.Serialize());
+        REQUIRE(all.Estimate() == Catch::Approx(50000.0).epsilon(4.0 * all.StandardError()));
+        REQUIRE_FALSE(left.Merge(HyperLogLog{11, 5}));
+    }
+    SECTION("serialisation")
+    {
+        const std::vector<std::byte> bytes{sketch.Serialize()};
+        REQUIRE(bytes.size() == 24 + 4096);
+        const std::optional<HyperLogLog> copy{HyperLogLog::Deserialize(bytes)};
+        REQUIRE(copy.has_value());
+        REQUIRE(copy->Precision() == 12);
+        REQUIRE(copy->Estimate() == sketch.Estimate());
+        std::vector<std::byte> corrupt{bytes};
+        corrupt.back() = std::byte{200};
+        REQUIRE_FALSE(HyperLogLog::Deserialize(corrupt).has_value());
+    }
+}
+
+TEST_CASE("Sketches: DDSketch", "[sketches]")
+{
+    // latencies from about a microsecond to a minute, log-normal around a millisecond
+    Xoshiro256StarStar rng(13);
+    std::vector<double> latencies(1000000);
+    for (double& latency : latencies)
+    {
+        latency = 1e-3 * std::exp(2.5 * SampleNormal(rng));
+    }
+    DDSketch sketch{0.01};
+    sketch.AddBatch(latencies);
+    std::vector<double> sorted(latencies);
+    std::ranges::sort(sorted);
+    const auto exact{[](const std::vector<double>& values, const double p) { return values[static_cast<std::size_t>(p * static_cast<double>(values.size() - 1))]; }};
+    const std::array probabilities{0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999};
+
+    REQUIRE(sketch.Count() == latencies.size());
+    REQUIRE(sketch.Min() == sorted.front());
+    REQUIRE(sketch.Max() == sorted.back());
+    REQUIRE(sketch.Quantile(0.0) == sorted.front());
+    REQUIRE(sketch.Quantile(1.0) == sorted.back());
+    REQUIRE(sketch.Buckets() < 1500);
+
+    SECTION("every quantile within the relative accuracy")
+    {
+        for (const double p : probabilities)
+        {
+            const double expected{exact(sorted, p)};
+            REQUIRE(std::abs(sketch.Quantile(p) - expected) <= 0.01 * (1.0 + 1e-9) * expected);
+        }
+    }
+    SECTION("negative values and zeros")
+    {
+        DDSketch mixed{0.02};
+        std::vector<double> values;
+        for (std::size_t i = 0; i < 30000; ++i)
+        {
+            values.push_back(i % 3 == 0 ? -latencies[i] : i % 3 == 1 ? latencies[i] : 0.0);
+        }
+        mixed.AddBatch(values);
+        mixed.Add(std::numeric_limits<double>::quiet_NaN());
+        mixed.Add(std::numeric_limits<double>::infinity());
+        REQUIRE(mixed.Count() == values.size());
+        std::ranges::sort(values);
+        for (const double p : probabilities)
+        {
+            const double expected{exact(values, p)};
+            REQUIRE(std::abs(mixed.Quantile(p) - expected) <= 0.02 * (1.0 + 1e-9) * std::abs(expected));
+        }
+        REQUIRE(mixed.Quantile(0.5) == 0.0);
+    }
+    SECTION("merging per-thread sketches")
+    {
+        std::array<DDSketch, 4> parts;
+        for (std::size_t i = 0; i < latencies.size(); ++i)
+        {
+            parts[i % parts.size()].Add(latencies[i]);
+        }
+        DDSketch merged;
+        for (const DDSketch& part : parts)
+        {
+            REQUIRE(merged.Merge(part));
+        }
+        REQUIRE(merged.Count() == sketch.Count());
+        REQUIRE(merged.Sum() == Catch::Approx(sketch.Sum()));
+        for (const double p : probabilities)
+        {
+            REQUIRE(merged.Quantile(p) == sketch.Quantile(p));
+        }
+        REQUIRE_FALSE(merged.Merge(DDSketch{0.02}));
+        REQUIRE_FALSE(merged.Merge(DDSketch{0.01, 100}));
+    }
+    SECTION("bounded buckets fold the smallest values")
+    {
+        DDSketch bounded{0.01, 100};
+        bounded.AddBatch(latencies);
+        REQUIRE(bounded.Buckets() <= 100);
+        // the top 100 buckets reach down a factor 1.0202^99, about 7, from the maximum
+        for (const double p : {0.99999, 0.999995})
+        {
+            const double expected{exact(sorted, p)};
+            REQUIRE(expected > sorted.back() / 7.0);
+            REQUIRE(std::abs(bounded.Quantile(p) - expected) <= 0.01 * (1.0 + 1e-9) * expected);
+        }
+        REQUIRE(bounded.Quantile(0.5) > exact(sorted, 0.5));
+    }
+    SECTION("serialisation")
+    {
+        const std::vector<std::byte> bytes{sketch.Serialize()};
+        // one or two varint bytes per bucket instead of eight
+        REQUIRE(bytes.size() < 80 + 3 * sketch.Buckets());
+        const std::optional<DDSketch> copy{DDSketch::Deserialize(bytes)};
+        REQUIRE(copy.has_value());
+        REQUIRE(copy->Count() == sketch.Count());
+        REQUIRE(copy->Sum() == sketch.Sum());
+        REQUIRE(copy->RelativeAccuracy() == sketch.RelativeAccuracy());
+        for (const double p : probabilities)
+        {
+            REQUIRE(copy->Quantile(p) == sketch.Quantile(p));
+        }
+        REQUIRE(copy->Serialize() == bytes);
+        REQUIRE_FALSE(DDSketch::Deserialize(std::span{bytes}.first(bytes.size() - 1)).has_value());
+        REQUIRE_FALSE(DDSketch::Deserialize(HyperLogLog{}.Serialize()).has_value());
+        const std::optional<DDSketch> empty{DDSketch::Deserialize(DDSketch{}.Serialize())};
+        REQUIRE(empty.has_value());
+        REQUIRE(empty->Count() == 0);
+        REQUIRE(empty->Quantile(0.5) == 0.0);
+    }
+}
+
+TEST_CASE("Sketches: throughput", "[.][benchmark][sketches]")
+{
+    const std::vector<std::uint64_t> keys{RandomKeys(1 << 22, 9)};
+    const auto rate{[&](auto&& work) {
+        const auto start{std::chrono::steady_clock::now()};
+        work();
+        return static_cast<double>(keys.size()) / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 1e6;
+    }};
+    const std::span<const std::uint64_t> all{keys};
+
+    // about 5 MiB of filter: most blocks miss the cache
+    BloomFilter single{keys.size(), 0.01};
+    BloomFilter batch{keys.size(), 0.01};
+    const double insert{rate([&] {
+        for (const std::uint64_t key : keys)
+        {
+            single.Insert(key);
+        }
+    })};
+    const double insertBatch{rate([&] { batch.InsertBatch(all); })};
+    std::size_t hits{};
+    const double query{rate([&] {
+        for (const std::uint64_t key : keys)
+        {
+            hits += single.Contains(key) ? 1 : 0;
+        }
+    })};
+    auto found{std::make_unique<bool[]>(keys.size())};
+    const double queryBatch{rate([&] { hits += batch.ContainsBatch(all, std::span{found.get(), keys.size()}); })};
+    WARN("BloomFilter (" << ToString(ActiveSimdLevel()) << "), " << single.Bytes() / 1024 << " KiB: insert " << insert << ", InsertBatch " << insertBatch << ", contains " << query
+                         << ", ContainsBatch " << queryBatch << " Mkeys/s" << (hits == 0 ? " " : ""));
+
+    CountMinSketch counts{0.0001, 0.001};
+    HyperLogLog distinct{14};
+    const double add{rate([&] { counts.AddBatch(all); })};
+    const double addDistinct{rate([&] { distinct.AddBatch(all); })};
+    WARN("CountMinSketch AddBatch " << add << ", HyperLogLog AddBatch " << addDistinct << " Mkeys/s" << (distinct.Estimate() == 0.0 ? " " : ""));
+
+    std::vector<double> latencies(keys.size());
+    Xoshiro256StarStar rng(10);
+    for (double& latency : latencies)
+    {
+        latency = 1e-3 * std::exp(2.5 * SampleNormal(rng));
+    }
+    DDSketch quantiles;
+    const double addQuantiles{rate([&] { quantiles.AddBatch(latencies); })};
+    WARN("DDSketch AddBatch " << addQuantiles << " Mvalues/s, " << quantiles.Buckets() << " buckets, " << quantiles.Serialize().size() << " bytes serialised");
+}
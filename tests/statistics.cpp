@@ -71,3 +71,305 @@ TEST_CASE("statistics")
     REQUIRE_THAT(fawn_algebra::PoissonDistribution(2, 0.61), Catch::Matchers::WithinAbs(0.1010904292, 1e-6));
     REQUIRE_THAT(fawn_algebra::ChiSquareTest(array1, array2), Catch::Matchers::WithinAbs(7, 1e-6));
 }
+
+TEST_CASE("statistics: OnlineStats")
+{
+    // log-normal samples around a large offset: skewed, heavy tailed, and a naive sum of squares cancels
+    fawn_algebra::Xoshiro256StarStar rng(21);
+    std::vector<double> values(100000);
+    for (double& value : values)
+    {
+        value = 1e9 + std::exp(fawn_algebra::SampleNormal(rng));
+    }
+
+    // two-pass reference
+    const double n{static_cast<double>(values.size())};
+    double mean{};
+    for (const double value : values)
+    {
+        mean += (value - 1e9) / n;
+    }
+    mean += 1e9;
+    double m2{};
+    double m3{};
+    double m4{};
+    for (const double value : values)
+    {
+        const double d{value - mean};
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+
+    fawn_algebra::OnlineStats<double> stats;
+    stats.Push(std::span<const double>{values});
+    REQUIRE(stats.Count() == values.size());
+    REQUIRE(stats.Mean() == Catch::Approx(mean).epsilon(1e-13));
+    REQUIRE(stats.VariancePopulation() == Catch::Approx(m2 / n).epsilon(1e-7));
+    REQUIRE(stats.VarianceSample() == Catch::Approx(m2 / (n - 1)).epsilon(1e-7));
+    REQUIRE(stats.Skewness() == Catch::Approx(std::sqrt(n) * m3 / std::pow(m2, 1.5)).epsilon(1e-6));
+    REQUIRE(stats.Kurtosis() == Catch::Approx(n * m4 / (m2 * m2) - 3).epsilon(1e-6));
+    REQUIRE(stats.Min() == std::ranges::min(values));
+    REQUIRE(stats.Max() == std::ranges::max(values));
+    REQUIRE(stats.Range() == std::ranges::max(values) - std::ranges::min(values));
+
+    SECTION("merging partial accumulators")
+    {
+        // uneven chunks, one of them empty, merged in a tree
+        std::array<fawn_algebra::OnlineStats<double>, 4> parts;
+        const std::array<std::size_t, 5> bounds{0, 7, 7, 60000, values.size()};
+        for (std::size_t i = 0; i < parts.size(); ++i)
+        {
+            parts[i].Push(std::span<const double>{values}.subspan(bounds[i], bounds[i + 1] - bounds[i]));
+        }
+        parts[0].Merge(parts[1]);
+        parts[2].Merge(parts[3]);
+        parts[0].Merge(parts[2]);
+        REQUIRE(parts[0].Count() == stats.Count());
+        REQUIRE(parts[0].Mean() == Catch::Approx(stats.Mean()).epsilon(1e-13));
+        REQUIRE(parts[0].VarianceSample() == Catch::Approx(stats.VarianceSample()).epsilon(1e-7));
+        REQUIRE(parts[0].Skewness() == Catch::Approx(stats.Skewness()).epsilon(1e-6));
+        REQUIRE(parts[0].Kurtosis() == Catch::Approx(stats.Kurtosis()).epsilon(1e-6));
+        REQUIRE(parts[0].Min() == stats.Min());
+        REQUIRE(parts[0].Max() == stats.Max());
+    }
+    SECTION("few values")
+    {
+        fawn_algebra::OnlineStats<float> few;
+        REQUIRE(few.Mean() == 0.0F);
+        REQUIRE(few.Range() == 0.0F);
+        few.Push(3.0F);
+        REQUIRE(few.Mean() == 3.0F);
+        REQUIRE(few.VarianceSample() == 0.0F);
+        REQUIRE(few.Skewness() == 0.0F);
+        few.Push(5.0F);
+        REQUIRE(few.Mean() == 4.0F);
+        REQUIRE(few.VariancePopulation() == 1.0F);
+        REQUIRE(few.VarianceSample() == 2.0F);
+        few.Reset();
+        REQUIRE(few.Count() == 0);
+    }
+}
+
+// the accumulator works in constant expressions
+static_assert([] {
+    fawn_algebra::OnlineStats<double> stats;
+    for (const double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+    {
+        stats.Push(value);
+    }
+    return stats.Mean() == 5.0 && std::abs(stats.VariancePopulation() - 4.0) < 1e-12;
+}());
+
+TEST_CASE("statistics: parallel reductions")
+{
+    // an uneven length around a large offset, so the chunks, blocks and tails all show up and a
+    // naive sum of squares cancels
+    fawn_algebra::Xoshiro256StarStar rng(5);
+    std::vector<double> values(3000017);
+    for (double& value : values)
+    {
+        value = 1e6 + 10.0 * fawn_algebra::SampleNormal(rng);
+    }
+    std::vector<float> floats(values.begin(), values.end());
+
+    // long double references
+    const auto reference{[](const auto& data) {
+        long double sum{};
+        for (const auto value : data)
+        {
+            sum += value;
+        }
+        const long double n{static_cast<long double>(data.size())};
+        const long double mean{sum / n};
+        long double m2{};
+        for (const auto value : data)
+        {
+            m2 += (value - mean) * (value - mean);
+        }
+        return std::array{static_cast<double>(sum), static_cast<double>(mean), static_cast<double>(m2 / n), static_cast<double>(m2 / (n - 1))};
+    }};
+    const std::array expected{reference(values)};
+    const std::array expectedFloat{reference(floats)};
+
+    for (const std::uint32_t threads : {1U, 4U, 0U})
+    {
+        const fawn_algebra::ReductionSettings settings{threads};
+        REQUIRE(fawn_algebra::Sum(values, settings) == Catch::Approx(expected[0]).epsilon(1e-15));
+        REQUIRE(fawn_algebra::Mean(values, settings) == Catch::Approx(expected[1]).epsilon(1e-15));
+        REQUIRE(fawn_algebra::VariancePopulation(values, settings) == Catch::Approx(expected[2]).epsilon(1e-9));
+        REQUIRE(fawn_algebra::VarianceSample(values, settings) == Catch::Approx(expected[3]).epsilon(1e-9));
+        REQUIRE(fawn_algebra::Range(values, settings) == std::ranges::max(values) - std::ranges::min(values));
+
+        // float input is summed to float precision, where a float std::accumulate is off by percents
+        REQUIRE(fawn_algebra::Sum(floats, settings) == Catch::Approx(expectedFloat[0]).epsilon(1e-7));
+        REQUIRE(fawn_algebra::Mean(floats, settings) == Catch::Approx(expectedFloat[1]).epsilon(1e-7));
+        REQUIRE(fawn_algebra::VariancePopulation(floats, settings) == Catch::Approx(expectedFloat[2]).epsilon(1e-4));
+        REQUIRE(fawn_algebra::Range(floats, settings) == std::ranges::max(floats) - std::ranges::min(floats));
+    }
+
+    // the same block sums, merged in another order
+    REQUIRE(fawn_algebra::Sum(values, {4}) == Catch::Approx(fawn_algebra::Sum(values, {1})).epsilon(1e-16));
+
+    SECTION("few values")
+    {
+        const fawn_algebra::ReductionSettings settings{};
+        const std::vector<float> empty;
+        REQUIRE(fawn_algebra::Sum(empty, settings) == 0.0F);
+        REQUIRE(fawn_algebra::Mean(empty, settings) == 0.0F);
+        REQUIRE(fawn_algebra::VarianceSample(empty, settings) == 0.0F);
+        REQUIRE(fawn_algebra::Range(empty, settings) == 0.0F);
+        const std::array few{3.0, 5.0, -1.0};
+        REQUIRE(fawn_algebra::Sum(few, settings) == 7.0);
+        REQUIRE(fawn_algebra::VariancePopulation(few, settings) == Catch::Approx(56.0 / 9.0));
+        REQUIRE(fawn_algebra::VarianceSample(few, settings) == Catch::Approx(28.0 / 3.0));
+        REQUIRE(fawn_algebra::Range(few, settings) == 6.0);
+        REQUIRE(fawn_algebra::VarianceSample(std::span{few}.first(1), settings) == 0.0);
+    }
+}
+
+TEST_CASE("statistics: reduction throughput", "[.][benchmark][statistics]")
+{
+    std::vector<float> values(std::size_t{1} << 25U);
+    fawn_algebra::Xoshiro256StarStar rng(8);
+    for (float& value : values)
+    {
+        value = static_cast<float>(rng() >> 40U);
+    }
+    const double bytes{static_cast<double>(values.size() * sizeof(float))};
+    const auto rate{[&](auto&& work) {
+        const auto start{std::chrono::steady_clock::now()};
+        work();
+        return bytes / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 1e9;
+    }};
+
+    float sink{};
+    const double accumulate{rate([&] { sink += std::accumulate(values.begin(), values.end(), 0.0F); })};
+    const double single{rate([&] { sink += fawn_algebra::Sum(values, {1}); })};
+    const double parallel{rate([&] { sink += fawn_algebra::Sum(values, {}); })};
+    const double variance{rate([&] { sink += fawn_algebra::VariancePopulation(values, {}); })};
+    const double range{rate([&] { sink += fawn_algebra::Range(values, {}); })};
+    WARN("32M floats (" << fawn_algebra::ToString(fawn_algebra::ActiveSimdLevel()) << "): std::accumulate " << accumulate << ", Sum 1 thread " << single << ", Sum " << parallel
+                        << ", VariancePopulation " << variance << ", Range " << range << " GB/s" << (sink == 0.0F ? " " : ""));
+}
+
+TEST_CASE("statistics: selection")
+{
+    // R-7 on a sorted copy
+    const auto expected{[](std::vector<double> sorted, const double p) {
+        std::ranges::sort(sorted);
+        const double h{p * static_cast<double>(sorted.size() - 1)};
+        const auto rank{static_cast<std::size_t>(h)};
+        return rank + 1 < sorted.size() ? sorted[rank] + (h - static_cast<double>(rank)) * (sorted[rank + 1] - sorted[rank]) : sorted[rank];
+    }};
+    const std::array probabilities{0.5, 0.0, 0.25, 0.75, 0.9, 0.99, 0.999, 1.0, 0.1};
+
+    fawn_algebra::Xoshiro256StarStar rng(14);
+    std::vector<double> random(100003);
+    for (double& value : random)
+    {
+        value = fawn_algebra::SampleNormal(rng);
+    }
+    // few distinct values, already sorted, reversed and organ pipe: the cases that hurt quickselect
+    std::vector<double> duplicates(100000);
+    for (double& value : duplicates)
+    {
+        value = static_cast<double>(rng() % 7);
+    }
+    std::vector<double> sorted(random);
+    std::ranges::sort(sorted);
+    std::vector<double> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<double> pipe(sorted);
+    std::reverse(pipe.begin() + static_cast<std::ptrdiff_t>(pipe.size() / 2), pipe.end());
+
+    for (const std::vector<double>* values : {&random, &duplicates, &sorted, &reversed, &pipe})
+    {
+        std::vector<double> work(*values);
+        std::array<double, probabilities.size()> out{};
+        fawn_algebra::Quantiles<double>(work, probabilities, out);
+        std::vector<double> parallel(probabilities.size());
+        fawn_algebra::Quantiles<double>(*values, probabilities, parallel, {});
+        for (std::size_t i = 0; i < probabilities.size(); ++i)
+        {
+            REQUIRE(out[i] == expected(*values, probabilities[i]));
+            REQUIRE(parallel[i] == out[i]);
+        }
+        // only reordered
+        std::vector<double> original(*values);
+        std::ranges::sort(original);
+        std::ranges::sort(work);
+        REQUIRE(work == original);
+    }
+
+    SECTION("SelectRanks partitions around every rank")
+    {
+        std::vector<double> work(random);
+        const std::array<std::size_t, 5> ranks{0, 17, 5000, 5001, 99999};
+        fawn_algebra::SelectRanks(std::span{work}, std::span<const std::size_t>{ranks});
+        for (const std::size_t rank : ranks)
+        {
+            REQUIRE(work[rank] == sorted[rank]);
+            REQUIRE(std::all_of(work.begin(), work.begin() + static_cast<std::ptrdiff_t>(rank), [&](const double v) { return v <= work[rank]; }));
+            REQUIRE(std::all_of(work.begin() + static_cast<std::ptrdiff_t>(rank), work.end(), [&](const double v) { return v >= work[rank]; }));
+        }
+    }
+    SECTION("parallel selection over large inputs")
+    {
+        // large enough to split, with integer latencies that repeat a lot
+        std::vector<std::uint32_t> latencies(3000000);
+        for (std::uint32_t& latency : latencies)
+        {
+            latency = static_cast<std::uint32_t>(std::exp(4.0 + fawn_algebra::SampleNormal(rng)));
+        }
+        std::vector<std::uint32_t> copy(latencies);
+        std::array<std::uint32_t, probabilities.size()> serial{};
+        std::array<std::uint32_t, probabilities.size()> parallel{};
+        fawn_algebra::Quantiles<std::uint32_t>(copy, probabilities, serial);
+        for (const std::uint32_t threads : {2U, 4U})
+        {
+            fawn_algebra::Quantiles<std::uint32_t>(latencies, probabilities, parallel, {threads});
+            REQUIRE(parallel == serial);
+        }
+        std::ranges::sort(copy);
+        REQUIRE(serial[0] == copy[copy.size() / 2]);
+        REQUIRE(serial[7] == copy.back());
+    }
+    SECTION("few values")
+    {
+        REQUIRE(fawn_algebra::Quantile(std::vector<double>{}, 0.5) == 0.0);
+        REQUIRE(fawn_algebra::Quantile(std::vector{4.0}, 0.9) == 4.0);
+        REQUIRE(fawn_algebra::Quantile(std::array{3.0, 1.0, 2.0, 4.0}, 0.5) == 2.5);
+        REQUIRE(fawn_algebra::Quantile(std::array{30, 10, 20}, 0.25) == 15);
+        REQUIRE(fawn_algebra::Quantile(std::array{3.0, 1.0, 2.0}, 2.0) == 3.0);
+    }
+}
+
+TEST_CASE("statistics: selection throughput", "[.][benchmark][statistics]")
+{
+    std::vector<double> values(std::size_t{1} << 24U);
+    fawn_algebra::Xoshiro256StarStar rng(2);
+    for (double& value : values)
+    {
+        value = std::exp(fawn_algebra::SampleNormal(rng));
+    }
+    const std::array probabilities{0.5, 0.9, 0.99, 0.999};
+    std::array<double, probabilities.size()> out{};
+    const auto seconds{[&](auto&& work) {
+        std::vector<double> copy(values);
+        const auto start{std::chrono::steady_clock::now()};
+        work(copy);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }};
+
+    const double sort{seconds([](std::vector<double>& copy) { std::ranges::sort(copy); })};
+    const double nth{seconds([&](std::vector<double>& copy) {
+        for (const double p : probabilities)
+        {
+            std::ranges::nth_element(copy, copy.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(copy.size() - 1)));
+        }
+    })};
+    const double select{seconds([&](std::vector<double>& copy) { fawn_algebra::Quantiles<double>(copy, probabilities, out); })};
+    const double parallel{seconds([&](std::vector<double>&) { fawn_algebra::Quantiles<double>(values, probabilities, out, {}); })};
+    WARN("p50/p90/p99/p99.9 of 16M doubles: sort " << sort * 1e3 << " ms, nth_element x4 " << nth * 1e3 << " ms, Quantiles " << select * 1e3 << " ms, parallel Quantiles "
+                                                   << parallel * 1e3 << " ms" << (out[0] == 0.0 ? " " : ""));
+}